@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/model/distance-spectrum-transmit-filter.h"
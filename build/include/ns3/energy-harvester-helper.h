@@ -0,0 +1 @@
+#include "/root/repo/src/energy/helper/energy-harvester-helper.h"
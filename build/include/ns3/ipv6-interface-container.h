@@ -0,0 +1 @@
+#include "/root/repo/src/internet/helper/ipv6-interface-container.h"
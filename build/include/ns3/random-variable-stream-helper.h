@@ -0,0 +1 @@
+#include "/root/repo/src/core/helper/random-variable-stream-helper.h"
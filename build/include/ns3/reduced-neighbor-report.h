@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/reduced-neighbor-report.h"
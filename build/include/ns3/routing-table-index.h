@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/routing-table-index.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/spectrum/helper/spectrum-analyzer-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/stats/model/uinteger-8-probe.h"
@@ -14,6 +14,7 @@
 #include "ipv4-static-routing-helper.h"
 #include "ipv6-static-routing-helper.h"
 
+#include "ns3/abort.h"
 #include "ns3/arp-l3-protocol.h"
 #include "ns3/assert.h"
 #include "ns3/callback.h"
@@ -885,6 +886,9 @@ InternetStackHelper::EnableAsciiIpv4Internal(Ptr<OutputStreamWrapper> stream,
     // once to avoid multiple trace sink calls per event (connect is independent
     // of interface).
     //
+    NS_ABORT_MSG_IF(stream->GetBinaryTraceFile(),
+                    "InternetStackHelper::EnableAsciiIpv4Internal():  "
+                        << "binary trace files are not supported, use an ASCII stream");
     if (!AsciiHooked(ipv4))
     {
         Ptr<Node> node = ipv4->GetObject<Node>();
@@ -1219,6 +1223,9 @@ InternetStackHelper::EnableAsciiIpv6Internal(Ptr<OutputStreamWrapper> stream,
     // once to avoid multiple trace sink calls per event (connect is independent
     // of interface).
     //
+    NS_ABORT_MSG_IF(stream->GetBinaryTraceFile(),
+                    "InternetStackHelper::EnableAsciiIpv6Internal():  "
+                        << "binary trace files are not supported, use an ASCII stream");
     if (!AsciiHooked(ipv6))
     {
         Ptr<Node> node = ipv6->GetObject<Node>();
@@ -76,6 +76,11 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
+     * Only the routes of the nodes whose shortest path computation is
+     * affected by the changes of the topology are actually recomputed (see
+     * GlobalRouteManager::UpdateGlobalRoutes()); the routes of the other nodes
+     * are left untouched.
+     *
      */
     static void RecomputeRoutingTables();
 };
@@ -18,14 +18,24 @@
 #include "ipv4.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
 #include <queue>
+#include <set>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -34,6 +44,43 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * \relates GlobalRouteManagerImpl
+ * \anchor GlobalValueGlobalRoutingThreads
+ * \brief The number of threads computing the global routes.
+ */
+static GlobalValue g_globalRoutingThreads =
+    GlobalValue("GlobalRoutingThreads",
+                "The number of threads the SPF calculations of the routers are spread across "
+                "when the global routes are computed (0 to use one thread per CPU core)",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
+/**
+ * \relates GlobalRouteManagerImpl
+ * \anchor GlobalValueGlobalRoutingOnDemand
+ * \brief Whether the global routes are computed on demand.
+ */
+static GlobalValue g_globalRoutingOnDemand =
+    GlobalValue("GlobalRoutingOnDemand",
+                "Set to true to compute the global routes of a router towards a destination "
+                "when they are looked up, rather than filling the routing tables of all the "
+                "routers when the global routes are computed",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
+/**
+ * \relates GlobalRouteManagerImpl
+ * \anchor GlobalValueGlobalRoutingTreeCacheSize
+ * \brief The number of shortest path trees kept to compute the global routes on demand.
+ */
+static GlobalValue g_globalRoutingTreeCacheSize =
+    GlobalValue("GlobalRoutingTreeCacheSize",
+                "The maximum number of shortest path trees kept, for all the routers, when "
+                "the global routes are computed on demand",
+                UintegerValue(16),
+                MakeUintegerChecker<uint32_t>(1));
+
 /**
  * \brief Stream insertion operator.
  *
@@ -485,14 +532,8 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
-    {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
-    }
-    return nullptr;
+    auto i = m_database.find(addr);
+    return (i != m_database.end()) ? i->second : nullptr;
 }
 
 GlobalRoutingLSA*
@@ -521,196 +562,1489 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 
 // ---------------------------------------------------------------------------
 //
-// GlobalRouteManagerImpl Implementation
+// SPFGraph Implementation
+//
+// ---------------------------------------------------------------------------
+
+SPFGraph::SPFGraph(const GlobalRouteManagerLSDB& lsdb)
+    : m_lsdb(lsdb)
+{
+    NS_LOG_FUNCTION(this << &lsdb);
+
+    for (const auto& [addr, lsa] : lsdb.m_database)
+    {
+        m_vertices.emplace(addr, m_lsas.size());
+        m_lsas.push_back(lsa);
+        m_types.push_back(lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA
+                              ? SPFVertex::VertexNetwork
+                              : SPFVertex::VertexRouter);
+    }
+
+    //
+    // The routers attached to a network-LSA are identified by the address of
+    // their interface on the network, which is the link data of a transit link
+    // record of their router-LSA. Index the first router-LSA (in the LSDB
+    // order) advertising each address, as GetLSAByLinkData() does.
+    //
+    std::map<Ipv4Address, uint32_t> transitLinkData;
+    for (uint32_t v = 0; v < m_lsas.size(); v++)
+    {
+        m_linkOffsets.push_back(m_links.size());
+        for (uint32_t i = 0; i < m_lsas[v]->GetNLinkRecords(); i++)
+        {
+            GlobalRoutingLinkRecord* l = m_lsas[v]->GetLinkRecord(i);
+            m_links.push_back(l);
+            if (l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                transitLinkData.emplace(l->GetLinkData(), v);
+            }
+        }
+    }
+    m_linkOffsets.push_back(m_links.size());
+
+    for (uint32_t v = 0; v < m_lsas.size(); v++)
+    {
+        m_edgeOffsets.push_back(m_edges.size());
+        if (m_types[v] == SPFVertex::VertexRouter)
+        {
+            for (uint32_t i = m_linkOffsets[v]; i < m_linkOffsets[v + 1]; i++)
+            {
+                GlobalRoutingLinkRecord* l = m_links[i];
+                if (l->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint ||
+                    l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                    m_edges.push_back({GetVertex(l->GetLinkId()), l});
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < m_lsas[v]->GetNAttachedRouters(); i++)
+            {
+                auto it = transitLinkData.find(m_lsas[v]->GetAttachedRouter(i));
+                if (it != transitLinkData.end())
+                {
+                    m_edges.push_back({it->second, nullptr});
+                }
+            }
+        }
+    }
+    m_edgeOffsets.push_back(m_edges.size());
+
+    NS_LOG_LOGIC("Built a graph of " << m_lsas.size() << " vertices and " << m_edges.size()
+                                     << " edges");
+}
+
+uint32_t
+SPFGraph::GetNVertices() const
+{
+    return m_lsas.size();
+}
+
+uint32_t
+SPFGraph::GetVertex(Ipv4Address linkStateId) const
+{
+    auto it = m_vertices.find(linkStateId);
+    return (it != m_vertices.end()) ? it->second : NO_VERTEX;
+}
+
+GlobalRoutingLSA*
+SPFGraph::GetLSA(uint32_t v) const
+{
+    return m_lsas[v];
+}
+
+SPFVertex::VertexType
+SPFGraph::GetVertexType(uint32_t v) const
+{
+    return m_types[v];
+}
+
+uint32_t
+SPFGraph::GetNEdges(uint32_t v) const
+{
+    return m_edgeOffsets[v + 1] - m_edgeOffsets[v];
+}
+
+const SPFGraph::Edge&
+SPFGraph::GetEdge(uint32_t v, uint32_t i) const
+{
+    return m_edges[m_edgeOffsets[v] + i];
+}
+
+uint32_t
+SPFGraph::GetNLinkRecords(uint32_t v) const
+{
+    return m_linkOffsets[v + 1] - m_linkOffsets[v];
+}
+
+GlobalRoutingLinkRecord*
+SPFGraph::GetLinkRecord(uint32_t v, uint32_t i) const
+{
+    return m_links[m_linkOffsets[v] + i];
+}
+
+const GlobalRouteManagerLSDB&
+SPFGraph::GetLsdb() const
+{
+    return m_lsdb;
+}
+
+// ---------------------------------------------------------------------------
+//
+// SPFTree Implementation
 //
 // ---------------------------------------------------------------------------
 
-GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
-{
-    NS_LOG_FUNCTION(this);
-    m_lsdb = new GlobalRouteManagerLSDB();
+SPFTree::SPFTree(const SPFGraph& graph)
+    : m_graph(&graph),
+      m_root(SPFGraph::NO_VERTEX),
+      m_status(graph.GetNVertices(), GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED),
+      m_distance(graph.GetNVertices(), SPF_INFINITY),
+      m_sequence(graph.GetNVertices(), 0),
+      m_exits(graph.GetNVertices()),
+      m_parents(graph.GetNVertices()),
+      m_children(graph.GetNVertices()),
+      m_nextSequence(0)
+{
+    NS_LOG_FUNCTION(this << &graph);
+}
+
+void
+SPFTree::Calculate(uint32_t root, Ptr<Ipv4> ipv4)
+{
+    NS_LOG_FUNCTION(this << root << ipv4);
+    NS_ASSERT(root < m_graph->GetNVertices());
+
+    //
+    // Reset the state left by the previous calculation. The vectors keep their
+    // capacity, so that computing the trees of many roots does not allocate.
+    //
+    for (uint32_t v = 0; v < m_graph->GetNVertices(); v++)
+    {
+        m_status[v] = GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED;
+        m_distance[v] = SPF_INFINITY;
+        m_exits[v].clear();
+        m_parents[v].clear();
+        m_children[v].clear();
+    }
+    m_vertices.clear();
+    m_candidates = {};
+    m_nextSequence = 0;
+    m_root = root;
+    m_ipv4 = ipv4;
+
+    m_status[root] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
+    m_distance[root] = 0;
+
+    for (uint32_t v = root;;)
+    {
+        // RFC2328 16.1. (2)
+        Next(v);
+
+        // RFC2328 16.1. (3): pop the closest candidate, skipping the stale
+        // entries left by the vertices whose distance has been lowered
+        while (!m_candidates.empty() &&
+               std::get<2>(m_candidates.top()) != m_sequence[std::get<3>(m_candidates.top())])
+        {
+            m_candidates.pop();
+        }
+        if (m_candidates.empty())
+        {
+            break;
+        }
+        v = std::get<3>(m_candidates.top());
+        m_candidates.pop();
+        NS_LOG_LOGIC("Popped vertex " << m_graph->GetLSA(v)->GetLinkStateId());
+
+        m_status[v] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
+        for (const auto parent : m_parents[v])
+        {
+            m_children[parent].push_back(v);
+        }
+        m_vertices.push_back(v);
+    }
+    m_ipv4 = nullptr;
+}
+
+void
+SPFTree::Next(uint32_t v)
+{
+    NS_LOG_FUNCTION(this << v);
+
+    for (uint32_t i = 0; i < m_graph->GetNEdges(v); i++)
+    {
+        const auto& [w, l] = m_graph->GetEdge(v, i);
+        NS_ASSERT_MSG(w != SPFGraph::NO_VERTEX, "No LSA for link " << l->GetLinkId());
+
+        if (m_status[w] == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        {
+            continue;
+        }
+
+        uint32_t distance = m_distance[v];
+        if (m_graph->GetVertexType(v) == SPFVertex::VertexRouter)
+        {
+            distance += l->GetMetric();
+        }
+
+        if (m_status[w] == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        {
+            NexthopCalculation(v, w, l, m_exits[w]);
+            m_distance[w] = distance;
+            m_parents[w] = {v};
+            m_status[w] = GlobalRoutingLSA::LSA_SPF_CANDIDATE;
+            PushCandidate(w);
+        }
+        else if (m_distance[w] == distance)
+        {
+            // Equal cost multiple paths: merge the root exit directions and
+            // the parents of the two paths
+            m_ecmpExits.clear();
+            NexthopCalculation(v, w, l, m_ecmpExits);
+            auto& exits = m_exits[w];
+            exits.insert(exits.end(), m_ecmpExits.begin(), m_ecmpExits.end());
+            std::sort(exits.begin(), exits.end());
+            exits.erase(std::unique(exits.begin(), exits.end()), exits.end());
+            if (std::find(m_parents[w].begin(), m_parents[w].end(), v) == m_parents[w].end())
+            {
+                m_parents[w].push_back(v);
+            }
+        }
+        else if (m_distance[w] > distance)
+        {
+            // New lower cost path
+            NexthopCalculation(v, w, l, m_exits[w]);
+            m_distance[w] = distance;
+            m_parents[w] = {v};
+            PushCandidate(w);
+        }
+    }
+}
+
+void
+SPFTree::NexthopCalculation(uint32_t v,
+                            uint32_t w,
+                            GlobalRoutingLinkRecord* l,
+                            std::vector<SPFVertex::NodeExit_t>& exits) const
+{
+    NS_LOG_FUNCTION(this << v << w << l);
+
+    //
+    // Returns the first link record of the LSA of w pointing back to v (see
+    // GlobalRouteManagerImpl::SPFGetNextLink), or null if there is none
+    //
+    auto getLinkBack = [this, v, w]() -> GlobalRoutingLinkRecord* {
+        const auto id = m_graph->GetLSA(v)->GetLinkStateId();
+        for (uint32_t i = 0; i < m_graph->GetNLinkRecords(w); i++)
+        {
+            if (m_graph->GetLinkRecord(w, i)->GetLinkId() == id)
+            {
+                return m_graph->GetLinkRecord(w, i);
+            }
+        }
+        return nullptr;
+    };
+
+    if (v == m_root)
+    {
+        if (m_graph->GetVertexType(w) == SPFVertex::VertexRouter)
+        {
+            // the next hop is the address of w on the link to the root
+            NS_ASSERT(l);
+            GlobalRoutingLinkRecord* linkRemote = getLinkBack();
+            NS_ASSERT(linkRemote);
+            exits = {{linkRemote->GetLinkData(), FindOutgoingInterfaceId(l->GetLinkData())}};
+        }
+        else
+        {
+            // w is a directly connected network; no next hop is required
+            GlobalRoutingLSA* w_lsa = m_graph->GetLSA(w);
+            exits = {{Ipv4Address::GetZero(),
+                      FindOutgoingInterfaceId(w_lsa->GetLinkStateId(),
+                                              w_lsa->GetNetworkLSANetworkMask())}};
+        }
+    }
+    else if (m_graph->GetVertexType(v) == SPFVertex::VertexNetwork)
+    {
+        NS_ASSERT(m_exits[v].size() == 1);
+        // the root, if it is a parent of v, is the first one, as it examines
+        // its links before any other vertex
+        if (m_parents[v].front() == m_root)
+        {
+            // v directly connects the root to w: the next hop is the address
+            // of w on v
+            if (GlobalRoutingLinkRecord* linkRemote = getLinkBack())
+            {
+                exits = {{linkRemote->GetLinkData(), m_exits[v].front().second}};
+            }
+        }
+        else
+        {
+            exits = {m_exits[v].front()};
+        }
+    }
+    else
+    {
+        // inherit the root exit directions of v
+        exits = m_exits[v];
+    }
+}
+
+void
+SPFTree::PushCandidate(uint32_t v)
+{
+    NS_LOG_FUNCTION(this << v);
+    m_sequence[v] = m_nextSequence++;
+    m_candidates.emplace(m_distance[v],
+                         m_graph->GetVertexType(v) == SPFVertex::VertexNetwork ? 0 : 1,
+                         m_sequence[v],
+                         v);
+}
+
+int32_t
+SPFTree::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask) const
+{
+    return m_ipv4 ? m_ipv4->GetInterfaceForPrefix(a, amask) : -1;
+}
+
+uint32_t
+SPFTree::GetRoot() const
+{
+    return m_root;
+}
+
+bool
+SPFTree::IsInTree(uint32_t v) const
+{
+    return m_status[v] == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
+}
+
+const std::vector<uint32_t>&
+SPFTree::GetVertices() const
+{
+    return m_vertices;
+}
+
+uint32_t
+SPFTree::GetDistanceFromRoot(uint32_t v) const
+{
+    return m_distance[v];
+}
+
+const std::vector<SPFVertex::NodeExit_t>&
+SPFTree::GetRootExitDirections(uint32_t v) const
+{
+    return m_exits[v];
+}
+
+const std::vector<uint32_t>&
+SPFTree::GetChildren(uint32_t v) const
+{
+    return m_children[v];
+}
+
+const std::vector<uint32_t>&
+SPFTree::GetParents(uint32_t v) const
+{
+    return m_parents[v];
+}
+
+void
+SPFTree::Rebind(const SPFGraph& graph, const std::vector<uint32_t>& newVertex)
+{
+    NS_LOG_FUNCTION(this << &graph);
+    NS_ASSERT(newVertex.size() == m_graph->GetNVertices());
+
+    m_graph = &graph;
+    bool renumbered = (newVertex.size() != graph.GetNVertices());
+    for (uint32_t v = 0; v < newVertex.size() && !renumbered; v++)
+    {
+        renumbered = (newVertex[v] != v);
+    }
+    if (!renumbered)
+    {
+        return;
+    }
+
+    auto renumber = [&newVertex](std::vector<uint32_t>& vertices) {
+        for (auto& v : vertices)
+        {
+            NS_ASSERT(newVertex[v] != SPFGraph::NO_VERTEX);
+            v = newVertex[v];
+        }
+    };
+    const uint32_t n = graph.GetNVertices();
+    std::vector<GlobalRoutingLSA::SPFStatus> status(n, GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
+    std::vector<uint32_t> distance(n, SPF_INFINITY);
+    std::vector<std::vector<SPFVertex::NodeExit_t>> exits(n);
+    std::vector<std::vector<uint32_t>> parents(n);
+    std::vector<std::vector<uint32_t>> children(n);
+    for (uint32_t v = 0; v < newVertex.size(); v++)
+    {
+        if (m_status[v] != GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        {
+            continue;
+        }
+        const auto w = newVertex[v];
+        NS_ASSERT_MSG(w != SPFGraph::NO_VERTEX, "Vertex " << v << " of the tree removed");
+        status[w] = m_status[v];
+        distance[w] = m_distance[v];
+        exits[w] = std::move(m_exits[v]);
+        parents[w] = std::move(m_parents[v]);
+        renumber(parents[w]);
+        children[w] = std::move(m_children[v]);
+        renumber(children[w]);
+    }
+    m_status = std::move(status);
+    m_distance = std::move(distance);
+    m_exits = std::move(exits);
+    m_parents = std::move(parents);
+    m_children = std::move(children);
+    m_sequence.assign(n, 0);
+    renumber(m_vertices);
+    m_root = newVertex[m_root];
+}
+
+/**
+ * \brief Check whether two LSAs carry the same information, i.e., whether the
+ * SPF calculations reading one or the other yield the same routes.
+ *
+ * \param a the first LSA
+ * \param b the second LSA
+ * \returns true if the LSAs carry the same information
+ */
+static bool
+IsSameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNAttachedRouters() != b->GetNAttachedRouters() ||
+        a->GetNLinkRecords() != b->GetNLinkRecords())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNAttachedRouters(); i++)
+    {
+        if (a->GetAttachedRouter(i) != b->GetAttachedRouter(i))
+        {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < a->GetNLinkRecords(); i++)
+    {
+        const GlobalRoutingLinkRecord* la = a->GetLinkRecord(i);
+        const GlobalRoutingLinkRecord* lb = b->GetLinkRecord(i);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Check whether a vertex of a graph has the same LSA and the same
+ * neighbors as a vertex of another graph.
+ *
+ * \param g the first graph
+ * \param v the vertex of the first graph
+ * \param h the second graph
+ * \param w the vertex of the second graph
+ * \returns true if the vertices have the same LSA and the same neighbors
+ */
+static bool
+IsSameVertex(const SPFGraph& g, uint32_t v, const SPFGraph& h, uint32_t w)
+{
+    if (!IsSameLSA(g.GetLSA(v), h.GetLSA(w)) || g.GetNEdges(v) != h.GetNEdges(w))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < g.GetNEdges(v); i++)
+    {
+        const auto x = g.GetEdge(v, i).vertex;
+        const auto y = h.GetEdge(w, i).vertex;
+        if ((x == SPFGraph::NO_VERTEX) != (y == SPFGraph::NO_VERTEX) ||
+            (x != SPFGraph::NO_VERTEX &&
+             g.GetLSA(x)->GetLinkStateId() != h.GetLSA(y)->GetLinkStateId()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// An edge of a vertex: the link state ID of the vertex it leads to, its link data and its cost
+using SPFEdgeKey = std::tuple<Ipv4Address, Ipv4Address, uint32_t>;
+
+/**
+ * \brief Get the edges of a vertex of a graph.
+ *
+ * \param g the graph
+ * \param v the vertex
+ * \returns the edges of the vertex, in the order they are examined by the SPF calculation
+ */
+static std::vector<SPFEdgeKey>
+GetEdgeKeys(const SPFGraph& g, uint32_t v)
+{
+    std::vector<SPFEdgeKey> edges;
+    for (uint32_t i = 0; i < g.GetNEdges(v); i++)
+    {
+        const auto& [w, l] = g.GetEdge(v, i);
+        if (l)
+        {
+            edges.emplace_back(l->GetLinkId(), l->GetLinkData(), l->GetMetric());
+        }
+        else
+        {
+            edges.emplace_back(g.GetLSA(w)->GetLinkStateId(), Ipv4Address::GetZero(), 0);
+        }
+    }
+    return edges;
+}
+
+/**
+ * \brief Get the vertices the changed edges of a vertex lead to.
+ *
+ * An edge is changed if it is not among the edges of the vertex in the other
+ * graph. If the edges found in both graphs are not in the same order, all the
+ * edges are changed, as the SPF calculation may add the vertices they lead to
+ * to the candidate list in another order.
+ *
+ * \param oldEdges the edges of the vertex in the previous graph
+ * \param newEdges the edges of the vertex in the new graph
+ * \returns the link state IDs of the vertices the changed edges lead to
+ */
+static std::set<Ipv4Address>
+GetChangedEdgeTargets(const std::vector<SPFEdgeKey>& oldEdges,
+                      const std::vector<SPFEdgeKey>& newEdges)
+{
+    auto common = [](const std::vector<SPFEdgeKey>& a, const std::vector<SPFEdgeKey>& b) {
+        std::vector<SPFEdgeKey> c;
+        std::copy_if(a.begin(), a.end(), std::back_inserter(c), [&b](const SPFEdgeKey& e) {
+            return std::find(b.begin(), b.end(), e) != b.end();
+        });
+        return c;
+    };
+
+    std::vector<SPFEdgeKey> changed;
+    if (common(oldEdges, newEdges) != common(newEdges, oldEdges))
+    {
+        changed = oldEdges;
+        changed.insert(changed.end(), newEdges.begin(), newEdges.end());
+    }
+    else
+    {
+        auto sortedOld = oldEdges;
+        auto sortedNew = newEdges;
+        std::sort(sortedOld.begin(), sortedOld.end());
+        std::sort(sortedNew.begin(), sortedNew.end());
+        std::set_symmetric_difference(sortedOld.begin(),
+                                      sortedOld.end(),
+                                      sortedNew.begin(),
+                                      sortedNew.end(),
+                                      std::back_inserter(changed));
+    }
+
+    std::set<Ipv4Address> targets;
+    for (const auto& edge : changed)
+    {
+        targets.insert(std::get<0>(edge));
+    }
+    return targets;
+}
+
+/**
+ * \brief Get the addresses of the interfaces of a node, which determine the
+ * outgoing interfaces of its routes.
+ *
+ * \param ipv4 the Ipv4 of the node
+ * \returns the addresses of the interfaces of the node, along with their interface
+ */
+static std::vector<std::pair<uint32_t, Ipv4InterfaceAddress>>
+GetInterfaceAddresses(Ptr<Ipv4> ipv4)
+{
+    std::vector<std::pair<uint32_t, Ipv4InterfaceAddress>> addresses;
+    for (uint32_t i = 0; i < ipv4->GetNInterfaces(); i++)
+    {
+        for (uint32_t j = 0; j < ipv4->GetNAddresses(i); j++)
+        {
+            addresses.emplace_back(i, ipv4->GetAddress(i, j));
+        }
+    }
+    return addresses;
+}
+
+// ---------------------------------------------------------------------------
+//
+// GlobalRouteManagerImpl Implementation
+//
+// ---------------------------------------------------------------------------
+
+GlobalRouteManagerImpl::GlobalRouteManagerImpl()
+    : m_spfroot(nullptr)
+{
+    NS_LOG_FUNCTION(this);
+    m_lsdb = new GlobalRouteManagerLSDB();
+}
+
+GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_lsdb)
+    {
+        delete m_lsdb;
+    }
+}
+
+void
+GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+    m_trees.clear();
+    m_graph.reset();
+    m_rootStates.clear();
+    if (m_lsdb)
+    {
+        delete m_lsdb;
+    }
+    m_lsdb = lsdb;
+}
+
+void
+GlobalRouteManagerImpl::DeleteGlobalRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+        if (!router)
+        {
+            continue;
+        }
+        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+        uint32_t j = 0;
+        uint32_t nRoutes = gr->GetNRoutes();
+        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+        // Each time we delete route 0, the route index shifts downward
+        // We can delete all routes if we delete the route numbered 0
+        // nRoutes times
+        for (j = 0; j < nRoutes; j++)
+        {
+            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
+            gr->RemoveRoute(0);
+        }
+        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        gr->SetRouteRequestCallback(Ipv4GlobalRouting::RouteRequestCallback());
+    }
+    m_trees.clear();
+    m_graph.reset();
+    m_rootStates.clear();
+    if (m_lsdb)
+    {
+        NS_LOG_LOGIC("Deleting LSDB, creating new one");
+        delete m_lsdb;
+        m_lsdb = new GlobalRouteManagerLSDB();
+    }
+}
+
+//
+// In order to build the routing database, we need to walk the list of nodes
+// in the system and look for those that support the GlobalRouter interface.
+// These routers will export a number of Link State Advertisements (LSAs)
+// that describe the links and networks that are "adjacent" (i.e., that are
+// on the other side of a point-to-point link).  We take these LSAs and put
+// add them to the Link State DataBase (LSDB) from which the routes will
+// ultimately be computed.
+//
+void
+GlobalRouteManagerImpl::BuildGlobalRoutingDatabase()
+{
+    NS_LOG_FUNCTION(this);
+    //
+    // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
+    // global router interfaces are, not too surprisingly, our routers.
+    //
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        //
+        // Ignore nodes that aren't participating in routing.
+        //
+        if (!rtr)
+        {
+            continue;
+        }
+        //
+        // You must call DiscoverLSAs () before trying to use any routing info or to
+        // update LSAs.  DiscoverLSAs () drives the process of discovering routes in
+        // the GlobalRouter.  Afterward, you may use GetNumLSAs (), which is a very
+        // computationally inexpensive call.  If you call GetNumLSAs () before calling
+        // DiscoverLSAs () will get zero as the number since no routes have been
+        // found.
+        //
+        Ptr<Ipv4GlobalRouting> grouting = rtr->GetRoutingProtocol();
+        uint32_t numLSAs = rtr->DiscoverLSAs();
+        NS_LOG_LOGIC("Found " << numLSAs << " LSAs");
+
+        for (uint32_t j = 0; j < numLSAs; ++j)
+        {
+            auto lsa = new GlobalRoutingLSA();
+            //
+            // This is the call to actually fetch a Link State Advertisement from the
+            // router.
+            //
+            rtr->GetLSA(j, *lsa);
+            NS_LOG_LOGIC(*lsa);
+            //
+            // Write the newly discovered link state advertisement to the database.
+            //
+            m_lsdb->Insert(lsa->GetLinkStateId(), lsa);
+        }
+    }
+}
+
+//
+// For each node that is a global router (which is determined by the presence
+// of an aggregated GlobalRouter interface), run the Dijkstra SPF calculation
+// on the database rooted at that router, and populate the node forwarding
+// tables.
+//
+// This function parallels RFC2328, Section 16.1.1, and quagga ospfd
+//
+// This calculation yields the set of intra-area routes associated
+// with an area (called hereafter Area A).  A router calculates the
+// shortest-path tree using itself as the root.  The formation
+// of the shortest path tree is done here in two stages.  In the
+// first stage, only links between routers and transit networks are
+// considered.  Using the Dijkstra algorithm, a tree is formed from
+// this subset of the link state database.  In the second stage,
+// leaves are added to the tree by considering the links to stub
+// networks.
+//
+// The area's link state database is represented as a directed graph.
+// The graph's vertices are routers, transit networks and stub networks.
+//
+// The first stage of the procedure (i.e., the Dijkstra algorithm)
+// can now be summarized as follows. At each iteration of the
+// algorithm, there is a list of candidate vertices.  Paths from
+// the root to these vertices have been found, but not necessarily
+// the shortest ones.  However, the paths to the candidate vertex
+// that is closest to the root are guaranteed to be shortest; this
+// vertex is added to the shortest-path tree, removed from the
+// candidate list, and its adjacent vertices are examined for
+// possible addition to/modification of the candidate list.  The
+// algorithm then iterates again.  It terminates when the candidate
+// list becomes empty.
+//
+void
+GlobalRouteManagerImpl::InitializeRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    //
+    // Build the graph of the link state database, shared by all the SPF
+    // calculations.
+    //
+    m_trees.clear();
+    m_graph = std::make_unique<SPFGraph>(*m_lsdb);
+    m_rootStates.clear();
+    m_calculatedRouters.clear();
+
+    BooleanValue onDemand;
+    g_globalRoutingOnDemand.GetValue(onDemand);
+
+    std::vector<Root> roots;
+    //
+    // Walk the list of nodes in the system.
+    //
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        //
+        // Look for the GlobalRouter interface that indicates that the node is
+        // participating in routing.
+        //
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+
+        uint32_t systemId = Simulator::GetSystemId();
+        // Ignore nodes that are not assigned to our systemId (distributed sim)
+        if (node->GetSystemId() != systemId)
+        {
+            continue;
+        }
+
+        //
+        // if the node has a global router interface, then run the global routing
+        // algorithms.
+        //
+        if (rtr && rtr->GetNumLSAs())
+        {
+            uint32_t vertex = m_graph->GetVertex(rtr->GetRouterId());
+            NS_ASSERT_MSG(vertex != SPFGraph::NO_VERTEX,
+                          "No LSA for router " << rtr->GetRouterId());
+            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+            NS_ASSERT_MSG(ipv4,
+                          "GlobalRouteManagerImpl::InitializeRoutes (): "
+                          "GetObject for <Ipv4> interface failed");
+            RootState* state = nullptr;
+            if (!onDemand.Get())
+            {
+                state = &m_rootStates[node->GetId()];
+                m_calculatedRouters.insert(node->GetId());
+            }
+            roots.push_back({vertex, ipv4, rtr->GetRoutingProtocol(), state});
+        }
+    }
+
+    if (onDemand.Get())
+    {
+        //
+        // The stub routers only need their default route. The routes of the
+        // other routers are computed when they are looked up.
+        //
+        NS_LOG_INFO("Computing the routes of " << roots.size() << " routers on demand");
+        for (const auto& root : roots)
+        {
+            if (!CheckForStubNode(*m_graph, root.vertex, root.ipv4, root.gr))
+            {
+                root.gr->SetRouteRequestCallback(
+                    MakeCallback(&GlobalRouteManagerImpl::ComputeRoutesTo,
+                                 this,
+                                 root.vertex,
+                                 root.ipv4));
+            }
+        }
+        return;
+    }
+
+    ComputeRoutes(roots);
+}
+
+void
+GlobalRouteManagerImpl::UpdateRoutes()
+{
+    NS_LOG_FUNCTION(this);
+
+    BooleanValue onDemand;
+    g_globalRoutingOnDemand.GetValue(onDemand);
+    if (!m_graph || onDemand.Get() || m_rootStates.empty())
+    {
+        NS_LOG_LOGIC("No previous SPF calculations, computing all the routes");
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+
+    //
+    // Keep the previous LSDB and its graph, to compare them with the new ones
+    //
+    std::unique_ptr<GlobalRouteManagerLSDB> oldLsdb(m_lsdb);
+    std::unique_ptr<SPFGraph> oldGraph = std::move(m_graph);
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+    m_graph = std::make_unique<SPFGraph>(*m_lsdb);
+
+    //
+    // Find the vertices of the previous graph whose LSA or neighbors have
+    // changed, or that have been removed, and map the others to the vertices
+    // of the new graph. New vertices are only reachable through changed ones.
+    //
+    const uint32_t nOldVertices = oldGraph->GetNVertices();
+    std::vector<bool> changed(nOldVertices, false);
+    std::vector<uint32_t> changedVertices;
+    std::vector<uint32_t> newVertex(nOldVertices);
+    for (uint32_t v = 0; v < nOldVertices; v++)
+    {
+        newVertex[v] = m_graph->GetVertex(oldGraph->GetLSA(v)->GetLinkStateId());
+        if (newVertex[v] == SPFGraph::NO_VERTEX ||
+            !IsSameVertex(*oldGraph, v, *m_graph, newVertex[v]))
+        {
+            changed[v] = true;
+            changedVertices.push_back(v);
+        }
+    }
+
+    //
+    // Collect the changes of the edges of the changed vertices. A removed
+    // vertex, or a network vertex whose mask changed, invalidates the trees it
+    // is in as a whole.
+    //
+    /// The change of the edges from a vertex of the previous graph to another vertex
+    struct EdgeChange
+    {
+        uint32_t from;    //!< the vertex the edges leave
+        uint32_t to;      //!< the vertex the edges lead to (NO_VERTEX if it is new)
+        uint32_t oldCost; //!< the lowest cost of the previous edges (SPF_INFINITY if none)
+        uint32_t newCost; //!< the lowest cost of the new edges (SPF_INFINITY if none)
+    };
+
+    std::vector<uint32_t> removed;
+    std::vector<EdgeChange> edgeChanges;
+    for (const auto v : changedVertices)
+    {
+        const auto w = newVertex[v];
+        if (w == SPFGraph::NO_VERTEX || oldGraph->GetVertexType(v) != m_graph->GetVertexType(w) ||
+            (oldGraph->GetVertexType(v) == SPFVertex::VertexNetwork &&
+             oldGraph->GetLSA(v)->GetNetworkLSANetworkMask() !=
+                 m_graph->GetLSA(w)->GetNetworkLSANetworkMask()))
+        {
+            removed.push_back(v);
+            continue;
+        }
+        const auto oldEdges = GetEdgeKeys(*oldGraph, v);
+        const auto newEdges = GetEdgeKeys(*m_graph, w);
+        auto lowestCost = [](const std::vector<SPFEdgeKey>& edges, Ipv4Address target) {
+            uint32_t cost = SPF_INFINITY;
+            for (const auto& [id, data, metric] : edges)
+            {
+                if (id == target)
+                {
+                    cost = std::min(cost, metric);
+                }
+            }
+            return cost;
+        };
+        for (const auto& target : GetChangedEdgeTargets(oldEdges, newEdges))
+        {
+            edgeChanges.push_back({v,
+                                   oldGraph->GetVertex(target),
+                                   lowestCost(oldEdges, target),
+                                   lowestCost(newEdges, target)});
+        }
+    }
+
+    //
+    // The AS external routes are added in the order of the AS external LSAs:
+    // consider the advertising routers of the LSAs from the first one that
+    // differs as changed
+    //
+    const uint32_t nOldExtLSAs = oldLsdb->GetNumExtLSAs();
+    const uint32_t nNewExtLSAs = m_lsdb->GetNumExtLSAs();
+    uint32_t firstExtChange = 0;
+    while (firstExtChange < std::min(nOldExtLSAs, nNewExtLSAs) &&
+           IsSameLSA(oldLsdb->GetExtLSA(firstExtChange), m_lsdb->GetExtLSA(firstExtChange)))
+    {
+        firstExtChange++;
+    }
+    std::vector<uint32_t> extChanged;
+    auto addExtChanged = [&](GlobalRoutingLSA* extlsa) {
+        uint32_t v = oldGraph->GetVertex(extlsa->GetAdvertisingRouter());
+        if (v != SPFGraph::NO_VERTEX)
+        {
+            extChanged.push_back(v);
+        }
+    };
+    for (uint32_t i = firstExtChange; i < nOldExtLSAs; i++)
+    {
+        addExtChanged(oldLsdb->GetExtLSA(i));
+    }
+    for (uint32_t i = firstExtChange; i < nNewExtLSAs; i++)
+    {
+        addExtChanged(m_lsdb->GetExtLSA(i));
+    }
+    NS_LOG_LOGIC(changedVertices.size() << " LSAs changed, " << edgeChanges.size()
+                                        << " edge changes, " << extChanged.size()
+                                        << " AS external LSAs changed");
+
+    //
+    // Check whether the SPF calculation of a router whose tree is kept in its
+    // state must be run again
+    //
+    auto mustRecompute = [&](const RootState& state, uint32_t root) {
+        if (changed[root])
+        {
+            return true;
+        }
+        if (!state.tree)
+        {
+            // the routes of a stub router depend on its LSA and on the one of its peer
+            for (uint32_t i = 0; i < oldGraph->GetNEdges(root); i++)
+            {
+                const auto w = oldGraph->GetEdge(root, i).vertex;
+                if (w == SPFGraph::NO_VERTEX || changed[w])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        const SPFTree& tree = *state.tree;
+        auto isParent = [&tree](uint32_t v, uint32_t w) {
+            const auto& parents = tree.GetParents(w);
+            return std::find(parents.begin(), parents.end(), v) != parents.end();
+        };
+        if (std::any_of(removed.begin(), removed.end(), [&tree](uint32_t v) {
+                return tree.IsInTree(v);
+            }))
+        {
+            return true;
+        }
+        for (const auto& [from, to, oldCost, newCost] : edgeChanges)
+        {
+            if (!tree.IsInTree(from))
+            {
+                continue;
+            }
+            if (to == SPFGraph::NO_VERTEX || !tree.IsInTree(to))
+            {
+                if (newCost != SPF_INFINITY)
+                {
+                    // a path to a vertex out of the tree
+                    return true;
+                }
+                continue;
+            }
+            if ((oldCost != SPF_INFINITY && isParent(from, to)) ||
+                (newCost != SPF_INFINITY &&
+                 static_cast<uint64_t>(tree.GetDistanceFromRoot(from)) + newCost <=
+                     tree.GetDistanceFromRoot(to)))
+            {
+                // a link of the tree removed or re-weighted, or a path of
+                // equal or lower cost to a vertex of the tree
+                return true;
+            }
+            if (to == root ||
+                (oldGraph->GetVertexType(to) == SPFVertex::VertexNetwork && isParent(root, to)))
+            {
+                // the next hops towards the neighbors of the router are the
+                // addresses on the links of the neighbors to the router
+                return true;
+            }
+        }
+        return false;
+    };
+
+    //
+    // Check whether the routes of a router whose tree is not affected must be
+    // added again, since the LSA of a vertex of its tree changed
+    //
+    auto mustReadd = [&](const SPFTree& tree) {
+        auto inTree = [&tree](uint32_t v) { return tree.IsInTree(v); };
+        return std::any_of(changedVertices.begin(), changedVertices.end(), inTree) ||
+               std::any_of(extChanged.begin(), extChanged.end(), inTree);
+    };
+
+    auto oldRootStates = std::move(m_rootStates);
+    m_rootStates.clear();
+    m_calculatedRouters.clear();
+    std::vector<Root> roots;
+    uint32_t nRouters = 0;
+    uint32_t nReadded = 0;
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        // Ignore nodes that are not assigned to our systemId (distributed sim)
+        if (!rtr || node->GetSystemId() != Simulator::GetSystemId())
+        {
+            continue;
+        }
+
+        Ptr<Ipv4GlobalRouting> gr = rtr->GetRoutingProtocol();
+        auto it = oldRootStates.find(node->GetId());
+        bool readd = false;
+        if (rtr->GetNumLSAs())
+        {
+            nRouters++;
+            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+            NS_ASSERT_MSG(ipv4,
+                          "GlobalRouteManagerImpl::UpdateRoutes (): "
+                          "GetObject for <Ipv4> interface failed");
+            uint32_t oldRoot = oldGraph->GetVertex(rtr->GetRouterId());
+            if (it != oldRootStates.end() && oldRoot != SPFGraph::NO_VERTEX &&
+                it->second.addresses == GetInterfaceAddresses(ipv4) &&
+                !mustRecompute(it->second, oldRoot))
+            {
+                // The tree of the router is not affected, keep it
+                auto& state = m_rootStates[node->GetId()] = std::move(it->second);
+                if (!state.tree)
+                {
+                    continue;
+                }
+                readd = mustReadd(*state.tree);
+                state.tree->Rebind(*m_graph, newVertex);
+                if (!readd)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                uint32_t vertex = m_graph->GetVertex(rtr->GetRouterId());
+                NS_ASSERT_MSG(vertex != SPFGraph::NO_VERTEX,
+                              "No LSA for router " << rtr->GetRouterId());
+                roots.push_back({vertex, ipv4, gr, &m_rootStates[node->GetId()]});
+                m_calculatedRouters.insert(node->GetId());
+            }
+        }
+        else if (it == oldRootStates.end())
+        {
+            continue;
+        }
+        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+        while (gr->GetNRoutes() > 0)
+        {
+            gr->RemoveRoute(0);
+        }
+        if (readd)
+        {
+            // The same routes as the SPF calculation, from the kept tree
+            AddRoutes(*m_graph, *m_rootStates[node->GetId()].tree, gr);
+            nReadded++;
+        }
+    }
+
+    NS_LOG_INFO("Updating the routes of " << roots.size() + nReadded << " out of " << nRouters
+                                          << " routers, " << roots.size()
+                                          << " of them by an SPF calculation");
+    ComputeRoutes(roots);
 }
 
-GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
+void
+GlobalRouteManagerImpl::ComputeRoutes(const std::vector<Root>& roots) const
 {
-    NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    NS_LOG_FUNCTION(this << roots.size());
+
+    //
+    // The SPF calculation of a router only reads the graph and writes to the
+    // routing table of the router, hence the routers can be handed out to
+    // worker threads, each one with its own tree.
+    //
+    UintegerValue value;
+    g_globalRoutingThreads.GetValue(value);
+    std::size_t nThreads = value.Get();
+    if (nThreads == 0)
     {
-        delete m_lsdb;
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = std::max<std::size_t>(std::min(nThreads, roots.size()), 1);
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i; (i = next++) < roots.size();)
+        {
+            ComputeRoutes(*m_graph, roots[i]);
+        }
+    };
+
+    NS_LOG_INFO("About to start SPF calculation for " << roots.size() << " routers using "
+                                                      << nThreads << " threads");
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < nThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
     }
+    NS_LOG_INFO("Finished SPF calculation");
 }
 
 void
-GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
+GlobalRouteManagerImpl::ComputeRoutes(const SPFGraph& graph, const Root& root) const
 {
-    NS_LOG_FUNCTION(this << lsdb);
-    if (m_lsdb)
+    NS_LOG_FUNCTION(this << root.vertex);
+
+    root.state->addresses = GetInterfaceAddresses(root.ipv4);
+    root.state->tree.reset();
+
+    //
+    // Short-circuit the computation for stub nodes, as SPFCalculate() does
+    //
+    if (CheckForStubNode(graph, root.vertex, root.ipv4, root.gr))
     {
-        delete m_lsdb;
+        NS_LOG_LOGIC("SPF calculation truncated for stub node "
+                     << graph.GetLSA(root.vertex)->GetLinkStateId());
+        return;
     }
-    m_lsdb = lsdb;
+
+    //
+    // Keep the tree, to update the routes after a change of the topology
+    //
+    root.state->tree = std::make_unique<SPFTree>(graph);
+    root.state->tree->Calculate(root.vertex, root.ipv4);
+    AddRoutes(graph, *root.state->tree, root.gr);
 }
 
-void
-GlobalRouteManagerImpl::DeleteGlobalRoutes()
+bool
+GlobalRouteManagerImpl::CheckForStubNode(const SPFGraph& graph,
+                                         uint32_t root,
+                                         Ptr<Ipv4> ipv4,
+                                         Ptr<Ipv4GlobalRouting> gr) const
 {
-    NS_LOG_FUNCTION(this);
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    NS_LOG_FUNCTION(this << root);
+    Ipv4Address myRouterId = graph.GetLSA(root)->GetLinkStateId();
+    int transits = 0;
+    GlobalRoutingLinkRecord* transitLink = nullptr;
+    for (uint32_t i = 0; i < graph.GetNLinkRecords(root); i++)
     {
-        Ptr<Node> node = *i;
-        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-        if (!router)
-        {
-            continue;
-        }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
+        GlobalRoutingLinkRecord* l = graph.GetLinkRecord(root, i);
+        if (l->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork ||
+            l->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
         {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
+            transits++;
+            transitLink = l;
         }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
     }
-    if (m_lsdb)
+    if (transits == 0)
     {
-        NS_LOG_LOGIC("Deleting LSDB, creating new one");
-        delete m_lsdb;
-        m_lsdb = new GlobalRouteManagerLSDB();
+        NS_LOG_WARN("all nodes should have at least one transit link:" << myRouterId);
+        return true;
+    }
+    if (transits == 1 && transitLink->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+    {
+        // Install default route to the next hop, which is the link data of the
+        // point-to-point link record of the peer pointing back to us
+        uint32_t w = graph.GetVertex(transitLink->GetLinkId());
+        NS_ASSERT(w != SPFGraph::NO_VERTEX);
+        for (uint32_t j = 0; j < graph.GetNLinkRecords(w); ++j)
+        {
+            GlobalRoutingLinkRecord* lr = graph.GetLinkRecord(w, j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint &&
+                lr->GetLinkId() == myRouterId)
+            {
+                gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
+                                      Ipv4Mask("0.0.0.0"),
+                                      lr->GetLinkData(),
+                                      ipv4->GetInterfaceForPrefix(transitLink->GetLinkData(),
+                                                                  Ipv4Mask("255.255.255.255")));
+                return true;
+            }
+        }
     }
+    return false;
 }
 
-//
-// In order to build the routing database, we need to walk the list of nodes
-// in the system and look for those that support the GlobalRouter interface.
-// These routers will export a number of Link State Advertisements (LSAs)
-// that describe the links and networks that are "adjacent" (i.e., that are
-// on the other side of a point-to-point link).  We take these LSAs and put
-// add them to the Link State DataBase (LSDB) from which the routes will
-// ultimately be computed.
-//
+template <typename F>
 void
-GlobalRouteManagerImpl::BuildGlobalRoutingDatabase()
+GlobalRouteManagerImpl::VisitRoutes(const SPFGraph& graph, const SPFTree& tree, F visit) const
 {
-    NS_LOG_FUNCTION(this);
+
     //
-    // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
-    // global router interfaces are, not too surprisingly, our routers.
+    // Host routes to the point-to-point interfaces of the routers and network
+    // routes to the transit networks, in the order the vertices were added to
+    // the tree (see SPFIntraAddRouter and SPFIntraAddTransit)
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    for (const auto v : tree.GetVertices())
     {
-        Ptr<Node> node = *i;
+        const auto& exits = tree.GetRootExitDirections(v);
+        if (graph.GetVertexType(v) == SPFVertex::VertexRouter)
+        {
+            for (uint32_t j = 0; j < graph.GetNLinkRecords(v); ++j)
+            {
+                GlobalRoutingLinkRecord* lr = graph.GetLinkRecord(v, j);
+                if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
+                {
+                    continue;
+                }
+                for (const auto& [nextHop, outIf] : exits)
+                {
+                    if (outIf >= 0)
+                    {
+                        visit(HOST_ROUTE, lr->GetLinkData(), Ipv4Mask::GetOnes(), nextHop, outIf);
+                    }
+                }
+            }
+        }
+        else
+        {
+            GlobalRoutingLSA* lsa = graph.GetLSA(v);
+            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+            Ipv4Address tempip = lsa->GetLinkStateId().CombineMask(tempmask);
+            for (const auto& [nextHop, outIf] : exits)
+            {
+                if (outIf >= 0)
+                {
+                    visit(NETWORK_ROUTE, tempip, tempmask, nextHop, outIf);
+                }
+            }
+        }
+    }
 
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-        //
-        // Ignore nodes that aren't participating in routing.
-        //
-        if (!rtr)
+    //
+    // Network routes to the stub networks of the routers, visiting the tree
+    // depth first as SPFProcessStubs does
+    //
+    std::vector<bool> processed(graph.GetNVertices(), false);
+    std::vector<std::pair<uint32_t, std::size_t>> stack{{tree.GetRoot(), 0}};
+    while (!stack.empty())
+    {
+        auto& [v, child] = stack.back();
+        if (child == 0 && v != tree.GetRoot() &&
+            graph.GetVertexType(v) == SPFVertex::VertexRouter)
+        {
+            const auto& exits = tree.GetRootExitDirections(v);
+            for (uint32_t i = 0; i < graph.GetNLinkRecords(v); i++)
+            {
+                GlobalRoutingLinkRecord* l = graph.GetLinkRecord(v, i);
+                if (l->GetLinkType() != GlobalRoutingLinkRecord::StubNetwork)
+                {
+                    continue;
+                }
+                Ipv4Mask tempmask(l->GetLinkData().Get());
+                Ipv4Address tempip = l->GetLinkId().CombineMask(tempmask);
+                for (const auto& [nextHop, outIf] : exits)
+                {
+                    if (outIf >= 0)
+                    {
+                        visit(NETWORK_ROUTE, tempip, tempmask, nextHop, outIf);
+                    }
+                }
+            }
+        }
+        const auto& children = tree.GetChildren(v);
+        while (child < children.size() && processed[children[child]])
+        {
+            child++;
+        }
+        if (child == children.size())
         {
+            stack.pop_back();
             continue;
         }
-        //
-        // You must call DiscoverLSAs () before trying to use any routing info or to
-        // update LSAs.  DiscoverLSAs () drives the process of discovering routes in
-        // the GlobalRouter.  Afterward, you may use GetNumLSAs (), which is a very
-        // computationally inexpensive call.  If you call GetNumLSAs () before calling
-        // DiscoverLSAs () will get zero as the number since no routes have been
-        // found.
-        //
-        Ptr<Ipv4GlobalRouting> grouting = rtr->GetRoutingProtocol();
-        uint32_t numLSAs = rtr->DiscoverLSAs();
-        NS_LOG_LOGIC("Found " << numLSAs << " LSAs");
+        const auto w = children[child++];
+        processed[w] = true;
+        stack.emplace_back(w, 0);
+    }
 
-        for (uint32_t j = 0; j < numLSAs; ++j)
+    //
+    // Routes to the AS external networks, through their advertising router
+    // (see ProcessASExternals and SPFAddASExternal)
+    //
+    const auto& lsdb = graph.GetLsdb();
+    for (uint32_t i = 0; i < lsdb.GetNumExtLSAs(); i++)
+    {
+        GlobalRoutingLSA* extlsa = lsdb.GetExtLSA(i);
+        uint32_t v = graph.GetVertex(extlsa->GetAdvertisingRouter());
+        if (v == SPFGraph::NO_VERTEX || v == tree.GetRoot() || !tree.IsInTree(v) ||
+            graph.GetVertexType(v) != SPFVertex::VertexRouter)
         {
-            auto lsa = new GlobalRoutingLSA();
-            //
-            // This is the call to actually fetch a Link State Advertisement from the
-            // router.
-            //
-            rtr->GetLSA(j, *lsa);
-            NS_LOG_LOGIC(*lsa);
-            //
-            // Write the newly discovered link state advertisement to the database.
-            //
-            m_lsdb->Insert(lsa->GetLinkStateId(), lsa);
+            continue;
+        }
+        Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+        Ipv4Address tempip = extlsa->GetLinkStateId().CombineMask(tempmask);
+        for (const auto& [nextHop, outIf] : tree.GetRootExitDirections(v))
+        {
+            if (outIf >= 0)
+            {
+                visit(AS_EXTERNAL_ROUTE, tempip, tempmask, nextHop, outIf);
+            }
         }
     }
 }
 
-//
-// For each node that is a global router (which is determined by the presence
-// of an aggregated GlobalRouter interface), run the Dijkstra SPF calculation
-// on the database rooted at that router, and populate the node forwarding
-// tables.
-//
-// This function parallels RFC2328, Section 16.1.1, and quagga ospfd
-//
-// This calculation yields the set of intra-area routes associated
-// with an area (called hereafter Area A).  A router calculates the
-// shortest-path tree using itself as the root.  The formation
-// of the shortest path tree is done here in two stages.  In the
-// first stage, only links between routers and transit networks are
-// considered.  Using the Dijkstra algorithm, a tree is formed from
-// this subset of the link state database.  In the second stage,
-// leaves are added to the tree by considering the links to stub
-// networks.
-//
-// The area's link state database is represented as a directed graph.
-// The graph's vertices are routers, transit networks and stub networks.
-//
-// The first stage of the procedure (i.e., the Dijkstra algorithm)
-// can now be summarized as follows. At each iteration of the
-// algorithm, there is a list of candidate vertices.  Paths from
-// the root to these vertices have been found, but not necessarily
-// the shortest ones.  However, the paths to the candidate vertex
-// that is closest to the root are guaranteed to be shortest; this
-// vertex is added to the shortest-path tree, removed from the
-// candidate list, and its adjacent vertices are examined for
-// possible addition to/modification of the candidate list.  The
-// algorithm then iterates again.  It terminates when the candidate
-// list becomes empty.
-//
 void
-GlobalRouteManagerImpl::InitializeRoutes()
+GlobalRouteManagerImpl::AddRoutes(const SPFGraph& graph,
+                                  const SPFTree& tree,
+                                  Ptr<Ipv4GlobalRouting> gr) const
 {
-    NS_LOG_FUNCTION(this);
-    //
-    // Walk the list of nodes in the system.
-    //
-    NS_LOG_INFO("About to start SPF calculation");
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
-    {
-        Ptr<Node> node = *i;
-        //
-        // Look for the GlobalRouter interface that indicates that the node is
-        // participating in routing.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+    NS_LOG_FUNCTION(this << tree.GetRoot());
+    VisitRoutes(graph,
+                tree,
+                [&gr](RouteType type,
+                      Ipv4Address network,
+                      Ipv4Mask mask,
+                      Ipv4Address nextHop,
+                      uint32_t outIf) {
+                    switch (type)
+                    {
+                    case HOST_ROUTE:
+                        gr->AddHostRouteTo(network, nextHop, outIf);
+                        break;
+                    case NETWORK_ROUTE:
+                        gr->AddNetworkRouteTo(network, mask, nextHop, outIf);
+                        break;
+                    case AS_EXTERNAL_ROUTE:
+                        gr->AddASExternalRouteTo(network, mask, nextHop, outIf);
+                        break;
+                    }
+                });
+}
 
-        uint32_t systemId = Simulator::GetSystemId();
-        // Ignore nodes that are not assigned to our systemId (distributed sim)
-        if (node->GetSystemId() != systemId)
+void
+GlobalRouteManagerImpl::ComputeRoutesTo(uint32_t root,
+                                        Ptr<Ipv4> ipv4,
+                                        Ipv4Address dest,
+                                        Ipv4GlobalRouting::DestinationRoutes& routes)
+{
+    NS_LOG_FUNCTION(this << root << dest);
+    NS_ASSERT(m_graph);
+
+    auto it = std::find_if(m_trees.begin(), m_trees.end(), [root](const CachedTree& cached) {
+        return cached.root == root;
+    });
+    if (it != m_trees.end())
+    {
+        m_trees.splice(m_trees.begin(), m_trees, it);
+    }
+    else
+    {
+        UintegerValue value;
+        g_globalRoutingTreeCacheSize.GetValue(value);
+        if (m_trees.size() >= value.Get())
         {
-            continue;
+            // recompute the least recently used tree for the router
+            while (m_trees.size() > value.Get())
+            {
+                m_trees.pop_back();
+            }
+            m_trees.splice(m_trees.begin(), m_trees, std::prev(m_trees.end()));
         }
-
-        //
-        // if the node has a global router interface, then run the global routing
-        // algorithms.
-        //
-        if (rtr && rtr->GetNumLSAs())
+        else
         {
-            SPFCalculate(rtr->GetRouterId());
+            m_trees.push_front({root, std::make_unique<SPFTree>(*m_graph)});
         }
+        NS_LOG_LOGIC("SPF calculation for vertex " << root << ", " << m_trees.size()
+                                                   << " trees cached");
+        m_trees.front().root = root;
+        m_trees.front().tree->Calculate(root, ipv4);
     }
-    NS_LOG_INFO("Finished SPF calculation");
+
+    //
+    // Keep the routes matching the destination, as a lookup of the routing
+    // table filled by AddRoutes() would
+    //
+    VisitRoutes(*m_graph,
+                *m_trees.front().tree,
+                [&dest, &routes](RouteType type,
+                                 Ipv4Address network,
+                                 Ipv4Mask mask,
+                                 Ipv4Address nextHop,
+                                 uint32_t outIf) {
+                    if (dest.CombineMask(mask) != network)
+                    {
+                        return;
+                    }
+                    switch (type)
+                    {
+                    case HOST_ROUTE:
+                        routes.hostRoutes.push_back(
+                            Ipv4RoutingTableEntry::CreateHostRouteTo(network, nextHop, outIf));
+                        break;
+                    case NETWORK_ROUTE:
+                        routes.networkRoutes.push_back(
+                            Ipv4RoutingTableEntry::CreateNetworkRouteTo(network,
+                                                                        mask,
+                                                                        nextHop,
+                                                                        outIf));
+                        break;
+                    case AS_EXTERNAL_ROUTE:
+                        routes.ASexternalRoutes.push_back(
+                            Ipv4RoutingTableEntry::CreateNetworkRouteTo(network,
+                                                                        mask,
+                                                                        nextHop,
+                                                                        outIf));
+                        break;
+                    }
+                });
 }
 
 //
@@ -1226,6 +2560,12 @@ GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
     SPFCalculate(root);
 }
 
+const std::set<uint32_t>&
+GlobalRouteManagerImpl::DebugGetCalculatedRouters() const
+{
+    return m_calculatedRouters;
+}
+
 //
 // Used to test if a node is a stub, from an OSPF sense.
 // If there is only one link of type 1 or 2, then a default route
@@ -11,15 +11,21 @@
 #define GLOBAL_ROUTE_MANAGER_IMPL_H
 
 #include "global-router-interface.h"
+#include "ipv4-global-routing.h"
+#include "ipv4.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <tuple>
 #include <vector>
 
 namespace ns3
@@ -670,6 +676,261 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+
+    friend class SPFGraph;
+};
+
+/**
+ * @brief A compact, read-only graph built from the Link State DataBase (LSDB).
+ *
+ * The router-LSAs and network-LSAs of the LSDB are the vertices of the graph
+ * and are identified by an index. For each vertex, the graph stores, in
+ * compressed sparse row (CSR) format, the edges examined by the SPF
+ * calculation (i.e., the point-to-point and transit link records of a
+ * router-LSA and the routers attached to a network-LSA) and the link records
+ * of the LSA, in the order they appear in the LSA. Resolving the link records
+ * into vertex indices once avoids the LSDB lookups of every SPF calculation.
+ *
+ * The graph is not modified by the SPF calculations, hence it can be shared
+ * by SPF calculations running concurrently.
+ */
+class SPFGraph
+{
+  public:
+    /// Index returned for vertices that are not in the graph
+    static constexpr uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+
+    /// An edge of the graph
+    struct Edge
+    {
+        uint32_t vertex;               //!< the index of the vertex the edge leads to
+        GlobalRoutingLinkRecord* link; //!< the link record (null for network-LSAs)
+    };
+
+    /**
+     * @brief Build the graph of the given LSDB.
+     *
+     * The LSDB must not be modified while the graph is in use.
+     *
+     * @param lsdb the Link State DataBase
+     */
+    SPFGraph(const GlobalRouteManagerLSDB& lsdb);
+
+    /**
+     * @returns the number of vertices of the graph
+     */
+    uint32_t GetNVertices() const;
+
+    /**
+     * @brief Get the index of the vertex corresponding to the LSA having the
+     * given link state ID.
+     *
+     * @param linkStateId the link state ID of the LSA
+     * @returns the index of the vertex or NO_VERTEX if there is no such LSA
+     */
+    uint32_t GetVertex(Ipv4Address linkStateId) const;
+
+    /**
+     * @param v the index of a vertex
+     * @returns the LSA corresponding to the given vertex
+     */
+    GlobalRoutingLSA* GetLSA(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex
+     * @returns the type of the given vertex
+     */
+    SPFVertex::VertexType GetVertexType(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex
+     * @returns the number of edges leaving the given vertex
+     */
+    uint32_t GetNEdges(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex
+     * @param i the index of an edge leaving the given vertex
+     * @returns the i-th edge leaving the given vertex
+     */
+    const Edge& GetEdge(uint32_t v, uint32_t i) const;
+
+    /**
+     * @param v the index of a vertex
+     * @returns the number of link records of the LSA of the given vertex
+     */
+    uint32_t GetNLinkRecords(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex
+     * @param i the index of a link record of the LSA of the given vertex
+     * @returns the i-th link record of the LSA of the given vertex
+     */
+    GlobalRoutingLinkRecord* GetLinkRecord(uint32_t v, uint32_t i) const;
+
+    /**
+     * @returns the LSDB the graph has been built from
+     */
+    const GlobalRouteManagerLSDB& GetLsdb() const;
+
+  private:
+    const GlobalRouteManagerLSDB& m_lsdb;          //!< the LSDB
+    std::vector<GlobalRoutingLSA*> m_lsas;         //!< the LSA of each vertex
+    std::vector<SPFVertex::VertexType> m_types;    //!< the type of each vertex
+    std::map<Ipv4Address, uint32_t> m_vertices;    //!< link state ID to vertex index map
+    std::vector<uint32_t> m_edgeOffsets;           //!< index of the first edge of each vertex
+    std::vector<Edge> m_edges;                     //!< the edges of all the vertices
+    std::vector<uint32_t> m_linkOffsets;           //!< index of the first link of each vertex
+    std::vector<GlobalRoutingLinkRecord*> m_links; //!< the link records of all the vertices
+};
+
+/**
+ * @brief The shortest path tree computed by an SPF calculation on an SPFGraph.
+ *
+ * This class runs the same algorithm as GlobalRouteManagerImpl (i.e., the
+ * first stage of RFC2328 16.1), and yields the same tree, the same root exit
+ * directions and the same order of vertices. The state of the calculation is
+ * kept in flat arrays indexed by vertex rather than in the LSAs, so that an
+ * object of this class can be used by a thread to compute the trees of any
+ * number of roots while other threads do the same on the same graph. The
+ * candidate list is a binary heap ordered by distance, vertex type (network
+ * vertices first) and insertion order, which is the order of CandidateQueue.
+ */
+class SPFTree
+{
+  public:
+    /**
+     * @brief Construct an empty shortest path tree for the given graph.
+     *
+     * @param graph the graph
+     */
+    SPFTree(const SPFGraph& graph);
+
+    /**
+     * @brief Compute the shortest path tree rooted at the given vertex.
+     *
+     * @param root the index of the root vertex
+     * @param ipv4 the Ipv4 of the root node, used to find the outgoing interfaces
+     * (may be null, in which case all the outgoing interfaces are -1)
+     */
+    void Calculate(uint32_t root, Ptr<Ipv4> ipv4);
+
+    /**
+     * @returns the index of the root vertex
+     */
+    uint32_t GetRoot() const;
+
+    /**
+     * @param v the index of a vertex
+     * @returns whether the given vertex is in the shortest path tree
+     */
+    bool IsInTree(uint32_t v) const;
+
+    /**
+     * @brief Get the vertices added to the tree, except the root, in the order
+     * they were added (i.e., in increasing distance from the root).
+     *
+     * @returns the vertices added to the tree
+     */
+    const std::vector<uint32_t>& GetVertices() const;
+
+    /**
+     * @param v the index of a vertex in the tree
+     * @returns the distance of the given vertex from the root
+     */
+    uint32_t GetDistanceFromRoot(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex in the tree
+     * @returns the root exit directions (next hop and outgoing interface) of the given vertex
+     */
+    const std::vector<SPFVertex::NodeExit_t>& GetRootExitDirections(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex in the tree
+     * @returns the children of the given vertex, in the order they were added to the tree
+     */
+    const std::vector<uint32_t>& GetChildren(uint32_t v) const;
+
+    /**
+     * @param v the index of a vertex in the tree
+     * @returns the parents of the given vertex, i.e., the vertices the equal cost
+     * shortest paths to the given vertex go through last
+     */
+    const std::vector<uint32_t>& GetParents(uint32_t v) const;
+
+    /**
+     * @brief Move the tree to another graph, whose vertices are those of the
+     * graph of the tree, possibly renumbered, plus or minus vertices not in the
+     * tree.
+     *
+     * @param graph the other graph
+     * @param newVertex the index in the other graph of each vertex of the graph
+     * of the tree (SPFGraph::NO_VERTEX for the vertices that are not in the other
+     * graph)
+     */
+    void Rebind(const SPFGraph& graph, const std::vector<uint32_t>& newVertex);
+
+  private:
+    /**
+     * @brief Examine the edges leaving a vertex just added to the tree and
+     * update the candidate list (see GlobalRouteManagerImpl::SPFNext).
+     *
+     * @param v the index of the vertex
+     */
+    void Next(uint32_t v);
+
+    /**
+     * @brief Calculate the parent, the distance and the root exit directions of
+     * a vertex reached from a vertex in the tree (see
+     * GlobalRouteManagerImpl::SPFNexthopCalculation).
+     *
+     * @param v the index of the vertex in the tree
+     * @param w the index of the vertex reached from v
+     * @param l the link record from v to w (null if v is a network vertex)
+     * @param exits the root exit directions to update
+     */
+    void NexthopCalculation(uint32_t v,
+                            uint32_t w,
+                            GlobalRoutingLinkRecord* l,
+                            std::vector<SPFVertex::NodeExit_t>& exits) const;
+
+    /**
+     * @brief Add a vertex to the candidate list, or move it to the position
+     * corresponding to its new distance if it is already in there.
+     *
+     * @param v the index of the vertex
+     */
+    void PushCandidate(uint32_t v);
+
+    /**
+     * @brief Return the interface of the root node corresponding to the given
+     * address and mask (see GlobalRouteManagerImpl::FindOutgoingInterfaceId).
+     *
+     * @param a the address
+     * @param amask the mask
+     * @returns the interface index or -1 if not found
+     */
+    int32_t FindOutgoingInterfaceId(Ipv4Address a,
+                                    Ipv4Mask amask = Ipv4Mask("255.255.255.255")) const;
+
+    /// candidate list entry: distance, vertex type order, insertion order, vertex
+    using Candidate = std::tuple<uint32_t, uint8_t, uint32_t, uint32_t>;
+
+    const SPFGraph* m_graph;                                          //!< the graph
+    uint32_t m_root;                                                  //!< the root vertex
+    Ptr<Ipv4> m_ipv4;                                                 //!< the Ipv4 of the root
+    std::vector<GlobalRoutingLSA::SPFStatus> m_status;                //!< status of each vertex
+    std::vector<uint32_t> m_distance;                                 //!< distance from the root
+    std::vector<uint32_t> m_sequence;                                 //!< candidate insertion order
+    std::vector<std::vector<SPFVertex::NodeExit_t>> m_exits;          //!< root exit directions
+    std::vector<std::vector<uint32_t>> m_parents;                     //!< parents of each vertex
+    std::vector<std::vector<uint32_t>> m_children;                    //!< children of each vertex
+    std::vector<uint32_t> m_vertices;                                 //!< vertices in the tree
+    uint32_t m_nextSequence;                                          //!< next insertion order
+    std::vector<SPFVertex::NodeExit_t> m_ecmpExits; //!< scratch buffer for equal cost paths
+    /// the candidate list
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> m_candidates;
 };
 
 /**
@@ -711,9 +972,40 @@ class GlobalRouteManagerImpl
     /**
      * @brief Compute routes using a Dijkstra SPF computation and populate
      * per-node forwarding tables
+     *
+     * The SPF calculations of the routers are run on an SPFGraph built from
+     * the LSDB, and are spread across the number of threads given by the
+     * \ref GlobalValueGlobalRoutingThreads "GlobalRoutingThreads" global value.
+     *
+     * If the \ref GlobalValueGlobalRoutingOnDemand "GlobalRoutingOnDemand"
+     * global value is true, only the default routes of the stub routers are
+     * added to the routing tables. The routes of the other routers are
+     * computed when they are looked up (see ComputeRoutesTo()).
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Update the routes after a change of the topology, recomputing
+     * only the shortest path trees affected by the change
+     *
+     * The routing database is rebuilt and compared with the one the routes
+     * were computed on, and the changes of the links of each vertex are
+     * checked against the shortest path tree of each router, which is kept
+     * after the SPF calculation. The tree of a router is computed again only
+     * if the addresses of its interfaces or its own LSA changed, if a changed
+     * LSA removes or re-weights a link of the tree, or offers a path of equal
+     * or lower cost to a vertex of the tree (or a path to a vertex out of the
+     * tree), or changes the next hops towards the neighbors of the router.
+     * Otherwise, if the LSA of a vertex of the tree changed (e.g., its stub
+     * networks) or an AS external LSA advertised by such a vertex changed, the
+     * routes of the router are added again from its tree, which yields the
+     * same routes, in the same order, as a new SPF calculation. If no routes
+     * have been computed by InitializeRoutes() since the last call to
+     * DeleteGlobalRoutes(), or if the routes are computed on demand, the
+     * routes of all the routers are computed again.
+     */
+    virtual void UpdateRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -726,10 +1018,47 @@ class GlobalRouteManagerImpl
      */
     void DebugSPFCalculate(Ipv4Address root);
 
+    /**
+     * @brief Debugging routine; get the routers whose SPF calculation was run
+     * by the last call to InitializeRoutes() or UpdateRoutes()
+     * @returns the node IDs of the routers
+     */
+    const std::set<uint32_t>& DebugGetCalculatedRouters() const;
+
   private:
+    /// The state of the last SPF calculation of a router, used to update its routes
+    struct RootState
+    {
+        /// the shortest path tree of the router (null for stub routers)
+        std::unique_ptr<SPFTree> tree;
+        /// the addresses of the interfaces of the router
+        std::vector<std::pair<uint32_t, Ipv4InterfaceAddress>> addresses;
+    };
+
+    /// A router whose routes are computed
+    struct Root
+    {
+        uint32_t vertex;           //!< the vertex of the router
+        Ptr<Ipv4> ipv4;            //!< the Ipv4 of the router
+        Ptr<Ipv4GlobalRouting> gr; //!< the global routing protocol of the router
+        RootState* state;          //!< the state of the SPF calculation of the router
+    };
+
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
 
+    /// A shortest path tree kept to compute the routes of its root on demand
+    struct CachedTree
+    {
+        uint32_t root;                 //!< the vertex of the root of the tree
+        std::unique_ptr<SPFTree> tree; //!< the tree
+    };
+
+    std::unique_ptr<SPFGraph> m_graph;          //!< the graph the routes were computed on
+    std::map<uint32_t, RootState> m_rootStates; //!< the state of the routers, by node ID
+    std::set<uint32_t> m_calculatedRouters;     //!< the routers whose SPF calculation was run last
+    std::list<CachedTree> m_trees;              //!< the trees of m_graph, most recently used first
+
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
      *
@@ -909,6 +1238,99 @@ class GlobalRouteManagerImpl
      * \return the outgoing interface number
      */
     int32_t FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask = Ipv4Mask("255.255.255.255"));
+
+    /**
+     * \brief Compute the routes of a router on the given graph and add them
+     * to its routing table.
+     *
+     * The routes are the same, and are added in the same order, as the routes
+     * added by SPFCalculate(). This method only accesses the state and the
+     * objects of the root node, hence it can be called concurrently for
+     * different roots.
+     *
+     * The shortest path tree and the addresses of the interfaces of the router
+     * are recorded in the state of the router.
+     *
+     * \param graph the graph of the LSDB
+     * \param root the router
+     */
+    void ComputeRoutes(const SPFGraph& graph, const Root& root) const;
+
+    /**
+     * \brief Compute the routes of the given routers on m_graph, spreading them
+     * across the number of threads given by the GlobalRoutingThreads global value.
+     *
+     * \param roots the routers
+     */
+    void ComputeRoutes(const std::vector<Root>& roots) const;
+
+    /**
+     * \brief Test if a router is a stub, from an OSPF sense, and add a default
+     * route to its routing table if so (see CheckForStubNode()).
+     *
+     * \param graph the graph of the LSDB
+     * \param root the index of the vertex of the router
+     * \param ipv4 the Ipv4 of the router
+     * \param gr the global routing protocol of the router
+     * \returns true if the router is a stub
+     */
+    bool CheckForStubNode(const SPFGraph& graph,
+                          uint32_t root,
+                          Ptr<Ipv4> ipv4,
+                          Ptr<Ipv4GlobalRouting> gr) const;
+
+    /**
+     * \brief Add the routes towards the vertices of a shortest path tree, the
+     * stub networks and the AS external networks to the routing table of the
+     * root of the tree.
+     *
+     * \param graph the graph of the LSDB
+     * \param tree the shortest path tree
+     * \param gr the global routing protocol of the root
+     */
+    void AddRoutes(const SPFGraph& graph, const SPFTree& tree, Ptr<Ipv4GlobalRouting> gr) const;
+
+    /// The kinds of routes computed from a shortest path tree
+    enum RouteType
+    {
+        HOST_ROUTE,       //!< route to a point-to-point interface of a router
+        NETWORK_ROUTE,    //!< route to a transit or stub network
+        AS_EXTERNAL_ROUTE //!< route to an AS external network
+    };
+
+    /**
+     * \brief Visit the routes towards the vertices of a shortest path tree,
+     * the stub networks and the AS external networks, in the order AddRoutes()
+     * adds them to the routing table of the root of the tree.
+     *
+     * \tparam F \deduced the type of the visitor
+     * \param graph the graph of the LSDB
+     * \param tree the shortest path tree
+     * \param visit the visitor, called with the type, the destination network,
+     * the network mask, the next hop and the outgoing interface of each route
+     */
+    template <typename F>
+    void VisitRoutes(const SPFGraph& graph, const SPFTree& tree, F visit) const;
+
+    /**
+     * \brief Compute the routes of a router towards a destination on m_graph.
+     *
+     * The routes are those of the routing table filled by InitializeRoutes()
+     * that match the destination, in the same order. The shortest path trees
+     * of the routers are kept in a cache shared by all the routers, holding at
+     * most as many trees as given by the GlobalRoutingTreeCacheSize global
+     * value, so that the routes towards further destinations do not require
+     * another SPF calculation as long as the tree of the router is cached.
+     *
+     * \param root the vertex of the router
+     * \param ipv4 the Ipv4 of the router
+     * \param dest the destination
+     * \param routes the routes towards the destination
+     */
+    void ComputeRoutesTo(uint32_t root,
+                         Ptr<Ipv4> ipv4,
+                         Ipv4Address dest,
+                         Ipv4GlobalRouting::DestinationRoutes& routes);
 };
 
 } // namespace ns3
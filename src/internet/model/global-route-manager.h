@@ -59,6 +59,13 @@ class GlobalRouteManager
      * per-node forwarding tables
      */
     static void InitializeRoutes();
+
+    /**
+     * @brief Rebuild the routing database and update the per-node forwarding
+     * tables, computing again only the routes of the nodes whose SPF
+     * computation is affected by the changes of the database
+     */
+    static void UpdateGlobalRoutes();
 };
 
 } // namespace ns3
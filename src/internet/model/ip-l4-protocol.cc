@@ -13,6 +13,8 @@
 
 #include "ns3/integer.h"
 #include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/super-segment-tag.h"
 
 namespace ns3
 {
@@ -71,4 +73,14 @@ IpL4Protocol::ReceiveIcmp(Ipv6Address icmpSource,
                          << icmpInfo << payloadSource << payloadDestination << payload);
 }
 
+std::list<Ptr<Packet>>
+IpL4Protocol::Segment(Ptr<Packet> p, const Address& source, const Address& destination)
+{
+    NS_LOG_FUNCTION(this << p << source << destination);
+    Ptr<Packet> segment = p->Copy();
+    SuperSegmentTag superSegment;
+    segment->RemovePacketTag(superSegment);
+    return {segment};
+}
+
 } // namespace ns3
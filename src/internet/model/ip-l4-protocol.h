@@ -18,9 +18,12 @@
 #include "ns3/callback.h"
 #include "ns3/object.h"
 
+#include <list>
+
 namespace ns3
 {
 
+class Address;
 class Packet;
 class Ipv4Address;
 class Ipv4Interface;
@@ -135,6 +138,22 @@ class IpL4Protocol : public Object
                              Ipv6Address payloadDestination,
                              const uint8_t payload[8]);
 
+    /**
+     * \brief Split a super-segment in the segments it stands for
+     *
+     * Called by the network layer when a super-segment (see SuperSegmentTag)
+     * cannot be sent as is on the output device. The base implementation
+     * returns the packet as a single segment.
+     *
+     * \param p the super-segment, without the network header
+     * \param source the source address of the super-segment
+     * \param destination the destination address of the super-segment
+     * \return the segments, without the network header
+     */
+    virtual std::list<Ptr<Packet>> Segment(Ptr<Packet> p,
+                                           const Address& source,
+                                           const Address& destination);
+
     /**
      * \brief callback to send packets over IPv4
      */
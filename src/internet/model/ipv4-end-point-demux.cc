@@ -35,27 +35,29 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_localPorts.clear();
+    m_unconnected.clear();
+    m_connected.clear();
+    m_index.clear();
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.find(port) != m_localPorts.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto localPort = m_localPorts.find(port);
+    if (localPort == m_localPorts.end())
+    {
+        return false;
+    }
+    for (auto i = localPort->second.begin(); i != localPort->second.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
             (*i)->GetBoundNetDevice() == boundNetDevice)
@@ -76,10 +78,7 @@ Ipv4EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(Ipv4Address::GetAny(), port));
 }
 
 Ipv4EndPoint*
@@ -92,10 +91,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -115,10 +111,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv4EndPoint(address, port));
 }
 
 Ipv4EndPoint*
@@ -129,38 +122,44 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // a duplicated endpoint has the same local port and peer, hence the same index key
+    if (const EndPoints* endPoints = FindByPeer(localPort, peerAddress, peerPort))
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = endPoints->begin(); i != endPoints->end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
+                (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
+                ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find(endPoint);
+    if (it == m_index.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
+    }
+    UnindexByPeer(endPoint, it->second);
+    auto localPort = m_localPorts.find(endPoint->GetLocalPort());
+    localPort->second.erase(it->second.localPort);
+    if (localPort->second.empty())
+    {
+        m_localPorts.erase(localPort);
     }
+    m_endPoints.erase(it->second.endPoint);
+    m_index.erase(it);
+    delete endPoint;
 }
 
 /*
@@ -200,131 +199,142 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // only the endpoints whose peer is not set and the endpoints whose peer is the
+    // source of the packet can match
+    const EndPoints* unconnected = FindByPeer(dport, Ipv4Address::GetAny(), 0);
+    const EndPoints* connected = FindByPeer(dport, saddr, sport);
+    for (const EndPoints* endPoints : {unconnected, connected != unconnected ? connected : nullptr})
     {
-        Ipv4EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
+        if (!endPoints)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
             continue;
         }
-
-        if (endP->GetLocalPort() != dport)
+        for (Ipv4EndPoint* endP : *endPoints)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-        if (endP->GetBoundNetDevice())
-        {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            NS_LOG_DEBUG("Looking at endpoint dport="
+                         << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                         << " sport=" << endP->GetPeerPort()
+                         << " saddr=" << endP->GetPeerAddress());
+
+            if (!endP->IsRxEnabled())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-        }
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
+            if (endP->GetLocalPort() != dport)
+            {
+                NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                                  << endP->GetLocalPort()
+                                                  << " does not match packet dport " << dport);
+                continue;
+            }
+            if (endP->GetBoundNetDevice())
+            {
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
+            }
 
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
+            bool localAddressMatchesExact = false;
+            bool localAddressIsAny = false;
+            bool localAddressIsSubnetAny = false;
 
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
-        {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
-            {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            // We have 3 cases:
+            // 1) Exact local / destination address match
+            // 2) Local endpoint bound to Any -> matches anything
+            // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+            // x.y.z.255 in a /24 net) and direct destination match.
 
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
+            if (endP->GetLocalAddress() == daddr)
+            {
+                // Case 1:
+                localAddressMatchesExact = true;
+            }
+            else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
+            {
+                // Case 2:
+                localAddressIsAny = true;
+            }
+            else
+            {
+                // Case 3:
+                for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
                 {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
+                    Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
 
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
+                    Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+                    if (endP->GetLocalAddress() == addrNetpart)
                     {
-                        localAddressIsSubnetAny = true;
+                        NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
+                                     << endP->GetLocalAddress() << "/"
+                                     << addr.GetMask().GetPrefixLength());
+
+                        Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
+                        if (addrNetpart == daddrNetPart)
+                        {
+                            localAddressIsSubnetAny = true;
+                        }
                     }
                 }
+
+                // if no match here, keep looking
+                if (!localAddressIsSubnetAny)
+                {
+                    continue;
+                }
             }
 
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
+            bool remotePortMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
+
+            // If remote does not match either with exact or wildcard,
+            // skip this one
+            if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
             {
                 continue;
             }
-        }
-
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
 
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+            bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
 
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All 4 match - this is the case of an open TCP connection, for example.
+                NS_LOG_LOGIC("Found an endpoint for case 4, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval4.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All but local address - no idea what this case could be.
+                NS_LOG_LOGIC("Found an endpoint for case 3, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remoteAddressMatchesWildCard &&
+                remotePortMatchesWildCard)
+            { // Only local port and local address matches exactly - Not yet opened connection
+                NS_LOG_LOGIC("Found an endpoint for case 2, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
+                remotePortMatchesWildCard)
+            { // Only local port matches exactly - Endpoint open to "any" connection
+                NS_LOG_LOGIC("Found an endpoint for case 1, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval1.push_back(endP);
+            }
         }
     }
 
@@ -363,9 +373,28 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
+
+    // an exact match is indexed by its peer, the source
+    if (const EndPoints* endPoints = FindByPeer(dport, saddr, sport))
+    {
+        for (Ipv4EndPoint* endP : *endPoints)
+        {
+            if (endP->GetLocalAddress() == daddr && endP->GetPeerPort() == sport &&
+                endP->GetPeerAddress() == saddr)
+            {
+                return endP;
+            }
+        }
+    }
+
+    auto localPort = m_localPorts.find(dport);
+    if (localPort == m_localPorts.end())
+    {
+        return nullptr;
+    }
     uint32_t genericity = 3;
     Ipv4EndPoint* generic = nullptr;
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i = localPort->second.begin(); i != localPort->second.end(); i++)
     {
         if ((*i)->GetLocalPort() != dport)
         {
@@ -395,6 +424,79 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     return generic;
 }
 
+std::size_t
+Ipv4EndPointDemux::ConnectionKeyHash::operator()(const ConnectionKey& key) const
+{
+    std::size_t hash = Ipv4AddressHash()(key.peerAddress);
+    return hash ^ ((std::size_t(key.localPort) << 16 | key.peerPort) * 0x9e3779b97f4a7c15ULL);
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    IndexEntry entry;
+    entry.endPoint = m_endPoints.insert(m_endPoints.end(), endPoint);
+    auto& localPort = m_localPorts[endPoint->GetLocalPort()];
+    entry.localPort = localPort.insert(localPort.end(), endPoint);
+    IndexByPeer(endPoint, entry);
+    m_index.emplace(endPoint, entry);
+    endPoint->SetPeerChangedCallback(MakeCallback(&Ipv4EndPointDemux::PeerChanged, this));
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv4EndPointDemux::IndexByPeer(Ipv4EndPoint* endPoint, IndexEntry& entry)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    entry.connected =
+        endPoint->GetPeerAddress() != Ipv4Address::GetAny() && endPoint->GetPeerPort() != 0;
+    entry.key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    entry.bucket = entry.connected ? &m_connected[entry.key] : &m_unconnected[entry.key.localPort];
+    entry.bucketEntry = entry.bucket->insert(entry.bucket->end(), endPoint);
+}
+
+void
+Ipv4EndPointDemux::UnindexByPeer(Ipv4EndPoint* endPoint, IndexEntry& entry)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    entry.bucket->erase(entry.bucketEntry);
+    if (entry.bucket->empty())
+    {
+        if (entry.connected)
+        {
+            m_connected.erase(entry.key);
+        }
+        else
+        {
+            m_unconnected.erase(entry.key.localPort);
+        }
+    }
+}
+
+void
+Ipv4EndPointDemux::PeerChanged(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto it = m_index.find(endPoint);
+    NS_ASSERT_MSG(it != m_index.end(), "Endpoint not allocated by this demux");
+    UnindexByPeer(endPoint, it->second);
+    IndexByPeer(endPoint, it->second);
+}
+
+const Ipv4EndPointDemux::EndPoints*
+Ipv4EndPointDemux::FindByPeer(uint16_t localPort, Ipv4Address peerAddress, uint16_t peerPort) const
+{
+    if (peerAddress != Ipv4Address::GetAny() && peerPort != 0)
+    {
+        auto it = m_connected.find({localPort, peerAddress, peerPort});
+        return it != m_connected.end() ? &it->second : nullptr;
+    }
+    auto it = m_unconnected.find(localPort);
+    return it != m_unconnected.end() ? &it->second : nullptr;
+}
+
 uint16_t
 Ipv4EndPointDemux::AllocateEphemeralPort()
 {
@@ -15,6 +15,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -31,6 +32,11 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are also indexed by local port and, if their peer address and
+ * port are both set (e.g., connected TCP sockets), by local port and peer, so
+ * that a lookup only considers the endpoints that may match, whatever the
+ * number of connections sharing the same local port.
  */
 
 class Ipv4EndPointDemux
@@ -160,6 +166,82 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    /// The local port and the peer of an endpoint whose peer is set
+    struct ConnectionKey
+    {
+        uint16_t localPort;      //!< the local port
+        Ipv4Address peerAddress; //!< the peer address
+        uint16_t peerPort;       //!< the peer port
+
+        /**
+         * \param other another key
+         * \return true if the keys are equal
+         */
+        bool operator==(const ConnectionKey& other) const = default;
+    };
+
+    /// Hash function of the connection keys
+    struct ConnectionKeyHash
+    {
+        /**
+         * \param key a connection key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const ConnectionKey& key) const;
+    };
+
+    /// The position of an endpoint in the containers indexing it
+    struct IndexEntry
+    {
+        EndPointsI endPoint;    //!< the position in the list of all the endpoints
+        EndPointsI localPort;   //!< the position in the endpoints with the same local port
+        bool connected;         //!< whether the endpoint is indexed by peer
+        ConnectionKey key;      //!< the index key (only the local port, if not connected)
+        EndPoints* bucket;      //!< the endpoints with the same index key
+        EndPointsI bucketEntry; //!< the position in the endpoints with the same index key
+    };
+
+    /**
+     * \brief Get the end points indexed with the given local port and peer: the
+     * end points with that peer if it is set, the end points whose peer is not
+     * set otherwise.
+     * \param localPort the local port
+     * \param peerAddress the peer address
+     * \param peerPort the peer port
+     * \return the end points, or a null pointer if there is none
+     */
+    const EndPoints* FindByPeer(uint16_t localPort,
+                                Ipv4Address peerAddress,
+                                uint16_t peerPort) const;
+
+    /**
+     * \brief Add a newly allocated end point to the list and to the indexes.
+     * \param endPoint the end point
+     * \return the end point
+     */
+    Ipv4EndPoint* Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add an end point to the index of its peer (or of its local port,
+     * if its peer is not set).
+     * \param endPoint the end point
+     * \param entry the index entry of the end point
+     */
+    void IndexByPeer(Ipv4EndPoint* endPoint, IndexEntry& entry);
+
+    /**
+     * \brief Remove an end point from the index of its peer (or of its local port).
+     * \param endPoint the end point
+     * \param entry the index entry of the end point
+     */
+    void UnindexByPeer(Ipv4EndPoint* endPoint, IndexEntry& entry);
+
+    /**
+     * \brief Move an end point whose peer has changed to the index of its new peer.
+     * \param endPoint the end point
+     */
+    void PeerChanged(Ipv4EndPoint* endPoint);
+
     /**
      * \brief Allocate an ephemeral port.
      * \returns the ephemeral port
@@ -185,6 +267,26 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The IPv4 end points, by local port.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_localPorts;
+
+    /**
+     * \brief The IPv4 end points whose peer is not set, by local port.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_unconnected;
+
+    /**
+     * \brief The IPv4 end points whose peer is set, by local port and peer.
+     */
+    std::unordered_map<ConnectionKey, EndPoints, ConnectionKeyHash> m_connected;
+
+    /**
+     * \brief The position of the IPv4 end points in the containers above.
+     */
+    std::unordered_map<Ipv4EndPoint*, IndexEntry> m_index;
 };
 
 } // namespace ns3
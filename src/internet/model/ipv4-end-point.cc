@@ -37,6 +37,7 @@ Ipv4EndPoint::~Ipv4EndPoint()
     m_rxCallback.Nullify();
     m_icmpCallback.Nullify();
     m_destroyCallback.Nullify();
+    m_peerChangedCallback.Nullify();
 }
 
 Ipv4Address
@@ -80,6 +81,10 @@ Ipv4EndPoint::SetPeer(Ipv4Address address, uint16_t port)
     NS_LOG_FUNCTION(this << address << port);
     m_peerAddr = address;
     m_peerPort = port;
+    if (!m_peerChangedCallback.IsNull())
+    {
+        m_peerChangedCallback(this);
+    }
 }
 
 void
@@ -119,6 +124,13 @@ Ipv4EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv4EndPoint::SetPeerChangedCallback(Callback<void, Ipv4EndPoint*> callback)
+{
+    NS_LOG_FUNCTION(this << &callback);
+    m_peerChangedCallback = callback;
+}
+
 void
 Ipv4EndPoint::ForwardUp(Ptr<Packet> p,
                         const Ipv4Header& header,
@@ -133,6 +133,15 @@ class Ipv4EndPoint
      * \param callback callback function
      */
     void SetDestroyCallback(Callback<void> callback);
+    /**
+     * \brief Set the callback notified when the peer of the endpoint changes.
+     *
+     * It is used by the Ipv4EndPointDemux owning the endpoint to keep its
+     * index of the endpoints by peer up to date.
+     *
+     * \param callback callback function
+     */
+    void SetPeerChangedCallback(Callback<void, Ipv4EndPoint*> callback);
 
     /**
      * \brief Forward the packet to the upper level.
@@ -220,6 +229,11 @@ class Ipv4EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The peer changed callback.
+     */
+    Callback<void, Ipv4EndPoint*> m_peerChangedCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
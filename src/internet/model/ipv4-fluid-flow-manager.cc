@@ -0,0 +1,344 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ipv4-fluid-flow-manager.h"
+
+#include "ipv4-header.h"
+#include "ipv4-route.h"
+#include "ipv4-routing-protocol.h"
+#include "ipv4.h"
+
+#include "ns3/abort.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ipv4FluidFlowManager");
+
+NS_OBJECT_ENSURE_REGISTERED(Ipv4FluidFlowManager);
+
+TypeId
+Ipv4FluidFlowManager::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::Ipv4FluidFlowManager")
+            .SetParent<Object>()
+            .SetGroupName("Internet")
+            .AddConstructor<Ipv4FluidFlowManager>()
+            .AddAttribute("ForegroundFlows",
+                          "The number of packet-level flows assumed to share each link with the "
+                          "background flows, which get their fair share of the link",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&Ipv4FluidFlowManager::m_foregroundFlows),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddTraceSource("FlowCompleted",
+                            "A background flow transferred all its bytes",
+                            MakeTraceSourceAccessor(&Ipv4FluidFlowManager::m_flowCompletedTrace),
+                            "ns3::Ipv4FluidFlowManager::FlowCompletedTracedCallback");
+    return tid;
+}
+
+Ipv4FluidFlowManager::Ipv4FluidFlowManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ipv4FluidFlowManager::~Ipv4FluidFlowManager()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+Ipv4FluidFlowManager::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_departure.Cancel();
+    m_flows.clear();
+    m_links.clear();
+    m_linkIndex.clear();
+    Object::DoDispose();
+}
+
+uint32_t
+Ipv4FluidFlowManager::AddFlow(Ptr<Node> source, Ipv4Address destination, uint64_t bytes)
+{
+    NS_LOG_FUNCTION(this << source << destination << bytes);
+
+    Advance();
+    Flow flow;
+    flow.links = GetPath(source, destination);
+    NS_ABORT_MSG_IF(flow.links.empty(),
+                    "No link with a data rate from node " << source->GetId() << " to "
+                                                          << destination);
+    for (auto link : flow.links)
+    {
+        m_links[link].nFlows++;
+    }
+    flow.remaining = bytes > 0 ? bytes * 8.0 : std::numeric_limits<double>::infinity();
+    flow.start = Simulator::Now();
+    uint32_t flowId = m_nextFlowId++;
+    m_flows.emplace(flowId, std::move(flow));
+    Allocate();
+    return flowId;
+}
+
+void
+Ipv4FluidFlowManager::RemoveFlow(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+
+    auto it = m_flows.find(flowId);
+    if (it == m_flows.end())
+    {
+        return;
+    }
+    Advance();
+    for (auto link : it->second.links)
+    {
+        m_links[link].nFlows--;
+    }
+    m_flows.erase(it);
+    Allocate();
+}
+
+DataRate
+Ipv4FluidFlowManager::GetFlowRate(uint32_t flowId) const
+{
+    auto it = m_flows.find(flowId);
+    return DataRate(it == m_flows.end() ? 0 : static_cast<uint64_t>(it->second.rate));
+}
+
+DataRate
+Ipv4FluidFlowManager::GetLoad(Ptr<NetDevice> device) const
+{
+    auto it = m_linkIndex.find(device);
+    return DataRate(it == m_linkIndex.end() ? 0 : static_cast<uint64_t>(m_links[it->second].load));
+}
+
+uint32_t
+Ipv4FluidFlowManager::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+std::vector<uint32_t>
+Ipv4FluidFlowManager::GetPath(Ptr<Node> source, Ipv4Address destination)
+{
+    NS_LOG_FUNCTION(this << source << destination);
+
+    std::vector<uint32_t> links;
+    Ptr<Node> node = source;
+    Ipv4Header header;
+    header.SetDestination(destination);
+    // A path longer than the largest TTL is a routing loop
+    for (uint32_t hops = 0; hops < 255; hops++)
+    {
+        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+        NS_ABORT_MSG_UNLESS(ipv4, "Node " << node->GetId() << " has no IPv4 stack");
+        if (ipv4->GetInterfaceForAddress(destination) != -1)
+        {
+            return links;
+        }
+
+        Socket::SocketErrno sockerr;
+        Ptr<Ipv4Route> route =
+            ipv4->GetRoutingProtocol()->RouteOutput(nullptr, header, nullptr, sockerr);
+        NS_ABORT_MSG_UNLESS(route,
+                            "No route to " << destination << " from node " << node->GetId());
+        Ptr<NetDevice> device = route->GetOutputDevice();
+        int32_t link = GetLink(device);
+        if (link >= 0)
+        {
+            links.push_back(link);
+        }
+
+        // The next node owns the next hop address on the channel of the device
+        Ipv4Address nextHop = route->GetGateway();
+        if (nextHop == Ipv4Address::GetZero())
+        {
+            nextHop = destination;
+        }
+        Ptr<Channel> channel = device->GetChannel();
+        Ptr<Node> next;
+        for (std::size_t i = 0; channel && i < channel->GetNDevices() && !next; i++)
+        {
+            Ptr<NetDevice> peer = channel->GetDevice(i);
+            Ptr<Ipv4> peerIpv4 = peer->GetNode()->GetObject<Ipv4>();
+            if (peer != device && peerIpv4 && peerIpv4->GetInterfaceForAddress(nextHop) != -1)
+            {
+                next = peer->GetNode();
+            }
+        }
+        NS_ABORT_MSG_UNLESS(next,
+                            "Next hop " << nextHop << " of node " << node->GetId()
+                                        << " not found on the channel of its output device");
+        node = next;
+    }
+    NS_FATAL_ERROR("Routing loop from node " << source->GetId() << " to " << destination);
+    return links;
+}
+
+int32_t
+Ipv4FluidFlowManager::GetLink(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+
+    auto it = m_linkIndex.find(device);
+    if (it != m_linkIndex.end() && m_links[it->second].nFlows > 0)
+    {
+        return it->second;
+    }
+
+    // The capacity of a link is read when the first flow crosses it
+    DataRateValue rate;
+    if (!device->GetAttributeFailSafe("DataRate", rate) || rate.Get().GetBitRate() == 0)
+    {
+        NS_LOG_LOGIC("Device " << device << " has no data rate, it does not constrain flows");
+        return -1;
+    }
+    if (it == m_linkIndex.end())
+    {
+        it = m_linkIndex.emplace(device, m_links.size()).first;
+        m_links.push_back({device, 0});
+    }
+    m_links[it->second].capacity = rate.Get().GetBitRate();
+    return it->second;
+}
+
+void
+Ipv4FluidFlowManager::Advance()
+{
+    NS_LOG_FUNCTION(this);
+
+    double elapsed = (Simulator::Now() - m_lastUpdate).GetSeconds();
+    m_lastUpdate = Simulator::Now();
+    for (auto& [flowId, flow] : m_flows)
+    {
+        flow.remaining = std::max(flow.remaining - flow.rate * elapsed, 0.0);
+    }
+}
+
+void
+Ipv4FluidFlowManager::Allocate()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Progressive filling: the rates of the flows not yet bottlenecked grow
+    // together, until the fair share of a link is reached, which bottlenecks
+    // the flows crossing it. Each link also carries m_foregroundFlows flows
+    // that cross it only.
+    std::vector<std::vector<Flow*>> linkFlows(m_links.size());
+    for (auto& [flowId, flow] : m_flows)
+    {
+        flow.rate = -1;
+        for (auto link : flow.links)
+        {
+            linkFlows[link].push_back(&flow);
+        }
+    }
+    std::vector<double> residual(m_links.size());
+    std::vector<uint32_t> nFree(m_links.size());
+    for (std::size_t l = 0; l < m_links.size(); l++)
+    {
+        residual[l] = m_links[l].capacity;
+        nFree[l] = m_links[l].nFlows;
+    }
+
+    while (true)
+    {
+        int32_t bottleneck = -1;
+        double share = std::numeric_limits<double>::max();
+        for (std::size_t l = 0; l < m_links.size(); l++)
+        {
+            if (nFree[l] > 0 && residual[l] / (nFree[l] + m_foregroundFlows) < share)
+            {
+                bottleneck = static_cast<int32_t>(l);
+                share = residual[l] / (nFree[l] + m_foregroundFlows);
+            }
+        }
+        if (bottleneck < 0)
+        {
+            break;
+        }
+        for (auto flow : linkFlows[bottleneck])
+        {
+            if (flow->rate >= 0)
+            {
+                continue;
+            }
+            flow->rate = share;
+            for (auto link : flow->links)
+            {
+                residual[link] = std::max(residual[link] - share, 0.0);
+                nFree[link]--;
+            }
+        }
+    }
+
+    // The foreground traffic gets the capacity left by the background flows
+    for (std::size_t l = 0; l < m_links.size(); l++)
+    {
+        Link& link = m_links[l];
+        if (link.nFlows == 0 && link.load == 0)
+        {
+            continue;
+        }
+        link.load = link.nFlows > 0 ? link.capacity - residual[l] : 0;
+        auto rate = static_cast<uint64_t>(link.capacity - link.load);
+        NS_LOG_LOGIC("Link of device " << link.device << " load " << link.load << " bit/s");
+        link.device->SetAttribute("DataRate", DataRateValue(DataRate(rate)));
+    }
+
+    // Schedule the next departure
+    m_departure.Cancel();
+    double next = std::numeric_limits<double>::infinity();
+    for (const auto& [flowId, flow] : m_flows)
+    {
+        next = std::min(next, flow.remaining / flow.rate);
+    }
+    if (std::isfinite(next))
+    {
+        m_departure = Simulator::Schedule(Seconds(next), &Ipv4FluidFlowManager::Depart, this);
+    }
+}
+
+void
+Ipv4FluidFlowManager::Depart()
+{
+    NS_LOG_FUNCTION(this);
+
+    Advance();
+    // The departure time is rounded to the time resolution
+    double resolution = TimeStep(1).GetSeconds();
+    for (auto it = m_flows.begin(); it != m_flows.end();)
+    {
+        Flow& flow = it->second;
+        if (flow.remaining <= flow.rate * resolution)
+        {
+            NS_LOG_LOGIC("Flow " << it->first << " completed");
+            for (auto link : flow.links)
+            {
+                m_links[link].nFlows--;
+            }
+            m_flowCompletedTrace(it->first, Simulator::Now() - flow.start);
+            it = m_flows.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    Allocate();
+}
+
+} // namespace ns3
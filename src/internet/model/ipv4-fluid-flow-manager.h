@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IPV4_FLUID_FLOW_MANAGER_H
+#define IPV4_FLUID_FLOW_MANAGER_H
+
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+#include "ns3/traced-callback.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4
+ *
+ * \brief A flow-level (fluid) model of background TCP traffic.
+ *
+ * The background flows are not simulated packet by packet: each flow is a
+ * rate along the path that the IPv4 routing protocols of the nodes (e.g.,
+ * Ipv4GlobalRouting) select for its destination, which is looked up when the
+ * flow is added. The rates are allocated max-min fairly, as long-lived TCP
+ * flows would share the links, and they are recomputed when a flow is added
+ * and when a flow departs, either because it transferred all its bytes or
+ * because it was removed.
+ *
+ * A link is the transmit side of a NetDevice with a "DataRate" attribute,
+ * such as PointToPointNetDevice and SimpleNetDevice; the devices without it
+ * do not constrain the rates. The packet-level (foreground) traffic feels the
+ * background load as a reduced capacity: the DataRate attribute of each link
+ * is set to its capacity minus the load of the background flows, and it is
+ * restored when no background flow crosses the link any longer. The
+ * capacity is the DataRate of the device when a background flow first
+ * crosses it, hence the DataRate must not be changed otherwise while
+ * background flows are active. As the foreground flows are not known to the
+ * manager, the allocation assumes that each link also carries a number of
+ * foreground flows (the ForegroundFlows attribute), which get their fair
+ * share of the link, so that the background traffic never takes the whole
+ * capacity of a link.
+ *
+ * The allocation takes O(L * (L + F)) time, where L is the number of links
+ * crossed by the background flows and F the number of flows, at each flow
+ * arrival and departure.
+ */
+class Ipv4FluidFlowManager : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    Ipv4FluidFlowManager();
+    ~Ipv4FluidFlowManager() override;
+
+    /**
+     * \brief Add a background flow, starting now.
+     *
+     * \param source the node sending the flow
+     * \param destination the address of the receiver of the flow
+     * \param bytes the bytes to transfer, or 0 for a flow that lasts until it is removed
+     * \return the identifier of the flow
+     */
+    uint32_t AddFlow(Ptr<Node> source, Ipv4Address destination, uint64_t bytes);
+
+    /**
+     * \brief Remove a background flow before it completes.
+     *
+     * Removing a flow that departed already has no effect.
+     *
+     * \param flowId the identifier of the flow
+     */
+    void RemoveFlow(uint32_t flowId);
+
+    /**
+     * \param flowId the identifier of the flow
+     * \return the rate of the flow, or 0 if it departed
+     */
+    DataRate GetFlowRate(uint32_t flowId) const;
+
+    /**
+     * \param device the device transmitting on a link
+     * \return the load of the background flows on the link
+     */
+    DataRate GetLoad(Ptr<NetDevice> device) const;
+
+    /**
+     * \return the number of active background flows
+     */
+    uint32_t GetNFlows() const;
+
+    /**
+     * TracedCallback signature for the completion of a flow.
+     *
+     * \param [in] flowId the identifier of the flow
+     * \param [in] duration the time the flow took to transfer its bytes
+     */
+    typedef void (*FlowCompletedTracedCallback)(uint32_t flowId, Time duration);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// A link crossed by background flows
+    struct Link
+    {
+        Ptr<NetDevice> device; //!< The device transmitting on the link
+        double capacity;       //!< The capacity of the link, in bit/s
+        double load{0};        //!< The load of the background flows, in bit/s
+        uint32_t nFlows{0};    //!< The number of background flows crossing the link
+    };
+
+    /// A background flow
+    struct Flow
+    {
+        std::vector<uint32_t> links; //!< The indexes of the links of the path
+        double remaining;            //!< The bits left to transfer, infinite if unlimited
+        double rate{0};              //!< The rate of the flow, in bit/s
+        Time start;                  //!< The time the flow was added
+    };
+
+    /**
+     * \brief Look up the path of a flow through the routing protocols of the nodes.
+     *
+     * \param source the node sending the flow
+     * \param destination the address of the receiver of the flow
+     * \return the indexes of the links of the path
+     */
+    std::vector<uint32_t> GetPath(Ptr<Node> source, Ipv4Address destination);
+
+    /**
+     * \brief Get the index of the link of a device, adding the link if needed.
+     *
+     * \param device the device transmitting on the link
+     * \return the index of the link, or -1 if the device has no data rate
+     */
+    int32_t GetLink(Ptr<NetDevice> device);
+
+    /**
+     * \brief Account the bits transferred by the flows since the last update.
+     */
+    void Advance();
+
+    /**
+     * \brief Allocate the rates max-min fairly and update the links and the
+     * next departure.
+     */
+    void Allocate();
+
+    /**
+     * \brief Remove the flows that transferred all their bytes and reallocate.
+     */
+    void Depart();
+
+    uint32_t m_foregroundFlows;                          //!< The foreground flows on each link
+    uint32_t m_nextFlowId{0};                            //!< The identifier of the next flow
+    std::map<uint32_t, Flow> m_flows;                    //!< The active flows, by identifier
+    std::vector<Link> m_links;                           //!< The links crossed by the flows
+    std::map<Ptr<NetDevice>, uint32_t> m_linkIndex;      //!< The index of the link of each device
+    Time m_lastUpdate;                                   //!< The time the flows were last advanced
+    EventId m_departure;                                 //!< The next departure of a flow
+    TracedCallback<uint32_t, Time> m_flowCompletedTrace; //!< Trace of the flow completions
+};
+
+} // namespace ns3
+
+#endif /* IPV4_FLUID_FLOW_MANAGER_H */
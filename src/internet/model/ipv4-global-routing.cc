@@ -18,8 +18,10 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <iomanip>
+#include <iterator>
 #include <vector>
 
 namespace ns3
@@ -47,13 +49,20 @@ Ipv4GlobalRouting::GetTypeId()
                           "Interface notification events (up/down, or add/remove address)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_respondToInterfaceEvents),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("RouteCacheSize",
+                          "The maximum number of destinations whose routes are kept in the cache "
+                          "when the global routes are computed on demand",
+                          UintegerValue(256),
+                          MakeUintegerAccessor(&Ipv4GlobalRouting::m_routeCacheSize),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_routeCacheSize(256)
 {
     NS_LOG_FUNCTION(this);
 
@@ -72,6 +81,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    m_hostIndex.Insert(route, dest, Ipv4Mask::GetOnes());
 }
 
 void
@@ -81,6 +91,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    m_hostIndex.Insert(route, dest, Ipv4Mask::GetOnes());
 }
 
 void
@@ -93,6 +104,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    m_networkIndex.Insert(route, network, networkMask);
 }
 
 void
@@ -102,6 +114,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    m_networkIndex.Insert(route, network, networkMask);
 }
 
 void
@@ -114,6 +127,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    m_ASexternalIndex.Insert(route, network, networkMask);
 }
 
 Ptr<Ipv4Route>
@@ -126,66 +140,56 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
-    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
-    {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+    auto onInterface = [this, oif](Ipv4RoutingTableEntry* route) {
+        if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
         {
-            if (oif)
+            NS_LOG_LOGIC("Not on requested interface, skipping");
+            return false;
+        }
+        return true;
+    };
+
+    // the routes computed on demand come after the routes of the table
+    DestinationRoutes* onDemand = m_routeRequest.IsNull() ? nullptr : &GetOnDemandRoutes(dest);
+    auto addOnDemand = [&](std::vector<Ipv4RoutingTableEntry>& routes) {
+        for (auto& route : routes)
+        {
+            if (onInterface(&route))
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
+                allRoutes.push_back(&route);
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
         }
+    };
+
+    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
+    m_hostIndex.GetMatches(dest, onInterface, allRoutes);
+    if (onDemand)
+    {
+        addOnDemand(onDemand->hostRoutes);
     }
+    NS_LOG_LOGIC("Found " << allRoutes.size() << " global host routes");
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        m_networkIndex.GetMatches(dest, onInterface, allRoutes);
+        if (onDemand)
         {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
-            }
+            addOnDemand(onDemand->networkRoutes);
         }
+        NS_LOG_LOGIC("Found " << allRoutes.size() << " global network routes");
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
-        for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+        m_ASexternalIndex.GetMatches(dest, onInterface, allRoutes);
+        if (onDemand)
         {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
-            {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
-                {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
-                }
-                allRoutes.push_back(*k);
-                break;
-            }
+            addOnDemand(onDemand->ASexternalRoutes);
+        }
+        if (!allRoutes.empty())
+        {
+            // only the first external route is used
+            allRoutes.erase(allRoutes.begin() + 1, allRoutes.end());
+            NS_LOG_LOGIC("Found external route" << allRoutes.front());
         }
     }
     if (!allRoutes.empty()) // if route(s) is found
@@ -219,6 +223,56 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     }
 }
 
+Ipv4GlobalRouting::DestinationRoutes&
+Ipv4GlobalRouting::GetOnDemandRoutes(Ipv4Address dest)
+{
+    NS_LOG_FUNCTION(this << dest);
+    if (auto it = m_routeCacheIndex.find(dest); it != m_routeCacheIndex.end())
+    {
+        m_routeCache.splice(m_routeCache.begin(), m_routeCache, it->second);
+        return it->second->second;
+    }
+
+    if (m_routeCache.size() >= m_routeCacheSize)
+    {
+        // evict the least recently used destination, reusing its entry
+        while (m_routeCache.size() > m_routeCacheSize)
+        {
+            m_routeCacheIndex.erase(m_routeCache.back().first);
+            m_routeCache.pop_back();
+        }
+        NS_LOG_LOGIC("Evicting the routes towards " << m_routeCache.back().first);
+        m_routeCacheIndex.erase(m_routeCache.back().first);
+        m_routeCache.splice(m_routeCache.begin(), m_routeCache, std::prev(m_routeCache.end()));
+        m_routeCache.front().first = dest;
+        m_routeCache.front().second.hostRoutes.clear();
+        m_routeCache.front().second.networkRoutes.clear();
+        m_routeCache.front().second.ASexternalRoutes.clear();
+    }
+    else
+    {
+        m_routeCache.emplace_front(dest, DestinationRoutes());
+    }
+    m_routeCacheIndex.emplace(dest, m_routeCache.begin());
+
+    auto& routes = m_routeCache.front().second;
+    m_routeRequest(dest, routes);
+    NS_LOG_LOGIC("Computed " << routes.hostRoutes.size() << " host routes, "
+                             << routes.networkRoutes.size() << " network routes and "
+                             << routes.ASexternalRoutes.size() << " external routes towards "
+                             << dest);
+    return routes;
+}
+
+void
+Ipv4GlobalRouting::SetRouteRequestCallback(RouteRequestCallback cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_routeRequest = cb;
+    m_routeCache.clear();
+    m_routeCacheIndex.clear();
+}
+
 uint32_t
 Ipv4GlobalRouting::GetNRoutes() const
 {
@@ -286,6 +340,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                m_hostIndex.Remove(*i, (*i)->GetDest(), Ipv4Mask::GetOnes());
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -302,6 +357,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            m_networkIndex.Remove(*j, (*j)->GetDestNetwork(), (*j)->GetDestNetworkMask());
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -317,6 +373,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            m_ASexternalIndex.Remove(*k, (*k)->GetDestNetwork(), (*k)->GetDestNetworkMask());
             delete *k;
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
@@ -353,6 +410,10 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostIndex.Clear();
+    m_networkIndex.Clear();
+    m_ASexternalIndex.Clear();
+    SetRouteRequestCallback(RouteRequestCallback());
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -521,9 +582,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -533,9 +592,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -545,9 +602,7 @@ Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
@@ -557,9 +612,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateGlobalRoutes();
     }
 }
 
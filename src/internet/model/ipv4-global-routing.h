@@ -9,14 +9,20 @@
 
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
+#include "ipv4-routing-table-entry.h"
 #include "ipv4.h"
+#include "routing-table-index.h"
 
+#include "ns3/callback.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -54,6 +60,14 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * When the global routes are computed on demand (see the
+ * \ref GlobalValueGlobalRoutingOnDemand "GlobalRoutingOnDemand" global value),
+ * the GlobalRouteManager does not fill the routing table: it sets a callback
+ * (see SetRouteRequestCallback()) which is invoked to compute the routes
+ * towards a destination the first time a packet is routed to it. The routes
+ * are kept in a cache holding the routes towards at most RouteCacheSize
+ * destinations, the least recently used destination being evicted first.
+ *
  * \see Ipv4RoutingProtocol
  * \see GlobalRouteManager
  */
@@ -170,6 +184,34 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     uint32_t GetNRoutes() const;
 
+    /// The routes towards a destination, computed on demand
+    struct DestinationRoutes
+    {
+        std::vector<Ipv4RoutingTableEntry> hostRoutes;       //!< routes to the destination host
+        std::vector<Ipv4RoutingTableEntry> networkRoutes;    //!< routes to its networks
+        std::vector<Ipv4RoutingTableEntry> ASexternalRoutes; //!< external routes to its networks
+    };
+
+    /**
+     * Callback computing the routes towards a destination.
+     * Arguments: the destination, the routes towards the destination (to be filled in).
+     */
+    typedef Callback<void, Ipv4Address, DestinationRoutes&> RouteRequestCallback;
+
+    /**
+     * \brief Set the callback computing the routes towards a destination on demand.
+     *
+     * The routes towards a destination are requested the first time a packet is
+     * routed to it, and are then kept in the route cache. They are looked up after
+     * the routes of the routing table of the same kind (host, network or external
+     * routes), in the order they are returned by the callback. Setting the callback
+     * flushes the route cache; a null callback disables the computation of routes
+     * on demand.
+     *
+     * \param cb the callback
+     */
+    void SetRouteRequestCallback(RouteRequestCallback cb);
+
     /**
      * \brief Get a route from the global unicast routing table.
      *
@@ -262,10 +304,34 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * \brief Get the routes towards a destination from the route cache, requesting
+     * them if they are not in the cache.
+     * \param dest destination address
+     * \return the routes towards the destination
+     */
+    DestinationRoutes& GetOnDemandRoutes(Ipv4Address dest);
+
+    /// index of the routes by destination network
+    typedef RoutingTableIndex<Ipv4Address, Ipv4Mask, Ipv4RoutingTableEntry*> RouteIndex;
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    RouteIndex m_hostIndex;       //!< Index of the routes to hosts
+    RouteIndex m_networkIndex;    //!< Index of the routes to networks
+    RouteIndex m_ASexternalIndex; //!< Index of the external routes
+
+    /// the routes towards the destinations, most recently used first
+    typedef std::list<std::pair<Ipv4Address, DestinationRoutes>> RouteCache;
+
+    RouteRequestCallback m_routeRequest; //!< Callback computing the routes on demand
+    uint32_t m_routeCacheSize;           //!< Maximum number of destinations in the route cache
+    RouteCache m_routeCache;             //!< Routes computed on demand
+    /// Entries of the route cache, by destination
+    std::unordered_map<Ipv4Address, RouteCache::iterator, Ipv4AddressHash> m_routeCacheIndex;
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
@@ -25,8 +25,10 @@
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
+#include "ns3/queue-disc.h"
 #include "ns3/socket.h"
 #include "ns3/string.h"
+#include "ns3/super-segment-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
@@ -980,7 +982,24 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (outInterface->IsUp())
     {
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
-        if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
+        SuperSegmentTag superSegmentTag;
+        bool superSegment = packet->PeekPacketTag(superSegmentTag);
+        Ptr<IpL4Protocol> protocol = GetProtocol(ipHeader.GetProtocol());
+        if (superSegment && protocol && !CanSendSuperSegment(outDev))
+        {
+            // Send the segments of the super-segment instead
+            for (const auto& segment :
+                 protocol->Segment(packet, ipHeader.GetSource(), ipHeader.GetDestination()))
+            {
+                Ipv4Header segmentHeader = ipHeader;
+                segmentHeader.SetPayloadSize(segment->GetSize());
+                NS_ASSERT(!segment->PeekPacketTag(superSegmentTag));
+                SendRealOut(route, segment, segmentHeader);
+            }
+            return;
+        }
+        if (!superSegment &&
+            packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
         {
             std::list<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
@@ -999,6 +1018,19 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     }
 }
 
+bool
+Ipv4L3Protocol::CanSendSuperSegment(Ptr<NetDevice> device) const
+{
+    NS_LOG_FUNCTION(this << device);
+    if (!device->SupportsSuperSegments())
+    {
+        return false;
+    }
+    Ptr<TrafficControlLayer> tc = m_node->GetObject<TrafficControlLayer>();
+    Ptr<QueueDisc> qdisc = tc ? tc->GetRootQueueDiscOnDevice(device) : nullptr;
+    return !qdisc || qdisc->GetNPackets() == 0;
+}
+
 // This function analogous to Linux ip_mr_forward()
 void
 Ipv4L3Protocol::IpMulticastForward(Ptr<Ipv4MulticastRoute> mrtentry,
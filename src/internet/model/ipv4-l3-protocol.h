@@ -329,6 +329,18 @@ class Ipv4L3Protocol : public Ipv4
      */
     void SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4Header& ipHeader);
 
+    /**
+     * \brief Check if a super-segment can be sent as is on a device
+     *
+     * A super-segment is only sent as is on a device that supports
+     * super-segments, and whose root queue disc holds no packet, so that the
+     * packets waiting in a queue disc are single segments.
+     *
+     * \param device the output device
+     * \return true if the super-segment can be sent as is on the device
+     */
+    bool CanSendSuperSegment(Ptr<NetDevice> device) const;
+
     /**
      * \brief Forward a packet.
      * \param rtentry route
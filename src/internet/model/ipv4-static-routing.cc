@@ -68,7 +68,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(routePtr, metric);
     }
 }
 
@@ -86,7 +86,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         auto routePtr = new Ipv4RoutingTableEntry(route);
 
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(routePtr, metric);
     }
 }
 
@@ -141,7 +141,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -213,19 +213,35 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-    {
-        Ipv4RoutingTableEntry* rtentry = j->first;
+    return m_networkIndex.AnyOf(
+        route.GetDestNetwork(),
+        route.GetDestNetworkMask(),
+        [&route, metric](const std::pair<Ipv4RoutingTableEntry*, uint32_t>& j) {
+            Ipv4RoutingTableEntry* rtentry = j.first;
+            return rtentry->GetDest() == route.GetDest() &&
+                   rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
+                   rtentry->GetGateway() == route.GetGateway() &&
+                   rtentry->GetInterface() == route.GetInterface() && j.second == metric;
+        });
+}
 
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
-        {
-            return true;
-        }
-    }
-    return false;
+void
+Ipv4StaticRouting::InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkIndex.Insert(m_networkRoutes.back(),
+                          route->GetDestNetwork(),
+                          route->GetDestNetworkMask());
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    NS_LOG_FUNCTION(this << it->first);
+    m_networkIndex.Remove(*it, it->first->GetDestNetwork(), it->first->GetDestNetworkMask());
+    delete it->first;
+    return m_networkRoutes.erase(it);
 }
 
 Ptr<Ipv4Route>
@@ -250,55 +266,49 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+    // the routes with the longest matching prefix, among which the first host route or
+    // the last route with the shortest metric is selected
+    std::vector<std::pair<Ipv4RoutingTableEntry*, uint32_t>> routes;
+    m_networkIndex.GetLongestMatches(
+        dest,
+        [this, oif](const std::pair<Ipv4RoutingTableEntry*, uint32_t>& route) {
+            if (oif && oif != m_ipv4->GetNetDevice(route.first->GetInterface()))
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
-            }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-                shortest_metric = 0xffffffff;
-            }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
-            {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
-            }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
-            {
-                break;
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                return false;
             }
+            return true;
+        },
+        routes);
+
+    const std::pair<Ipv4RoutingTableEntry*, uint32_t>* selected = nullptr;
+    for (const auto& route : routes)
+    {
+        longest_mask = route.first->GetDestNetworkMask().GetPrefixLength();
+        NS_LOG_LOGIC("Found global network route " << route.first << ", mask length "
+                                                   << longest_mask << ", metric "
+                                                   << route.second);
+        if (route.second > shortest_metric)
+        {
+            NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+            continue;
         }
+        shortest_metric = route.second;
+        selected = &route;
+        if (longest_mask == 32)
+        {
+            break;
+        }
+    }
+    if (selected)
+    {
+        Ipv4RoutingTableEntry* route = selected->first;
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -446,8 +456,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             return;
         }
         tmp++;
@@ -581,6 +590,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkIndex.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -620,8 +630,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -665,8 +674,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -13,6 +13,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "routing-table-index.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -370,6 +371,10 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Index of the network routes by destination network
+    typedef RoutingTableIndex<Ipv4Address, Ipv4Mask, std::pair<Ipv4RoutingTableEntry*, uint32_t>>
+        NetworkRoutesIndex;
+
     /**
      * \brief Checks if a route is already present in the forwarding table.
      * \param route route
@@ -378,6 +383,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a route at the end of the forwarding table for network.
+     * \param route the route, which is deleted when removed from the table
+     * \param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove a route from the forwarding table for network and delete it.
+     * \param it the iterator pointing to the route
+     * \return the iterator following the removed route
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -400,6 +419,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the index of the forwarding table for network.
+     */
+    NetworkRoutesIndex m_networkIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
@@ -34,27 +34,29 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_localPorts.clear();
+    m_unconnected.clear();
+    m_connected.clear();
+    m_index.clear();
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.find(port) != m_localPorts.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto localPort = m_localPorts.find(port);
+    if (localPort == m_localPorts.end())
+    {
+        return false;
+    }
+    for (auto i = localPort->second.begin(); i != localPort->second.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
             (*i)->GetBoundNetDevice() == boundNetDevice)
@@ -75,10 +77,7 @@ Ipv6EndPointDemux::Allocate()
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(Ipv6Address::GetAny(), port));
 }
 
 Ipv6EndPoint*
@@ -91,10 +90,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         NS_LOG_WARN("Ephemeral port allocation failed.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -114,10 +110,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         NS_LOG_WARN("Duplicated endpoint.");
         return nullptr;
     }
-    auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(new Ipv6EndPoint(address, port));
 }
 
 Ipv6EndPoint*
@@ -128,38 +121,44 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // a duplicated endpoint has the same local port and peer, hence the same index key
+    if (const EndPoints* endPoints = FindByPeer(localPort, peerAddress, peerPort))
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = endPoints->begin(); i != endPoints->end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
+                (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
+                ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_index.find(endPoint);
+    if (it == m_index.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
+    }
+    UnindexByPeer(endPoint, it->second);
+    auto localPort = m_localPorts.find(endPoint->GetLocalPort());
+    localPort->second.erase(it->second.localPort);
+    if (localPort->second.empty())
+    {
+        m_localPorts.erase(localPort);
     }
+    m_endPoints.erase(it->second.endPoint);
+    m_index.erase(it);
+    delete endPoint;
 }
 
 /*
@@ -182,92 +181,102 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    // only the endpoints whose peer is not set and the endpoints whose peer is the
+    // source of the packet can match
+    const EndPoints* unconnected = FindByPeer(dport, Ipv6Address::GetAny(), 0);
+    const EndPoints* connected = FindByPeer(dport, saddr, sport);
+    for (const EndPoints* endPoints : {unconnected, connected != unconnected ? connected : nullptr})
     {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
+        if (!endPoints)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
             continue;
         }
-
-        if (endP->GetLocalPort() != dport)
+        for (Ipv6EndPoint* endP : *endPoints)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
+            NS_LOG_DEBUG("Looking at endpoint dport="
+                         << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                         << " sport=" << endP->GetPeerPort()
+                         << " saddr=" << endP->GetPeerAddress());
 
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
+            if (!endP->IsRxEnabled())
             {
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+
+            if (endP->GetLocalPort() != dport)
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
+                NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                                  << endP->GetLocalPort()
+                                                  << " does not match packet dport " << dport);
                 continue;
             }
-        }
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
+            if (endP->GetBoundNetDevice())
+            {
+                if (!incomingInterface)
+                {
+                    continue;
+                }
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
+            }
 
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+            /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+            NS_LOG_DEBUG("dest addr " << daddr);
 
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
+            bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+            bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
+            bool localAddressMatchesAllRouters =
+                endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
 
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
+            /* if no match here, keep looking */
+            if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+                continue;
+            }
+            bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
+
+            /* If remote does not match either with exact or wildcard,i
+               skip this one */
+            if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+                continue;
+            }
+
+            /* Now figure out which return list to add this one to */
+            if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
+                remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+                retval1.push_back(endP);
+            }
+            if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
+                remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All but local address */
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All 4 match */
+                retval4.push_back(endP);
+            }
         }
     }
 
@@ -299,10 +308,28 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    // an exact match is indexed by its peer, the source
+    if (const EndPoints* endPoints = FindByPeer(dport, src, sport))
+    {
+        for (Ipv6EndPoint* endP : *endPoints)
+        {
+            if (endP->GetLocalAddress() == dst && endP->GetPeerPort() == sport &&
+                endP->GetPeerAddress() == src)
+            {
+                return endP;
+            }
+        }
+    }
+
+    auto localPort = m_localPorts.find(dport);
+    if (localPort == m_localPorts.end())
+    {
+        return nullptr;
+    }
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i = localPort->second.begin(); i != localPort->second.end(); i++)
     {
         uint32_t tmp = 0;
 
@@ -337,6 +364,79 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
     return generic;
 }
 
+std::size_t
+Ipv6EndPointDemux::ConnectionKeyHash::operator()(const ConnectionKey& key) const
+{
+    std::size_t hash = Ipv6AddressHash()(key.peerAddress);
+    return hash ^ ((std::size_t(key.localPort) << 16 | key.peerPort) * 0x9e3779b97f4a7c15ULL);
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    IndexEntry entry;
+    entry.endPoint = m_endPoints.insert(m_endPoints.end(), endPoint);
+    auto& localPort = m_localPorts[endPoint->GetLocalPort()];
+    entry.localPort = localPort.insert(localPort.end(), endPoint);
+    IndexByPeer(endPoint, entry);
+    m_index.emplace(endPoint, entry);
+    endPoint->SetPeerChangedCallback(MakeCallback(&Ipv6EndPointDemux::PeerChanged, this));
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv6EndPointDemux::IndexByPeer(Ipv6EndPoint* endPoint, IndexEntry& entry)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    entry.connected =
+        endPoint->GetPeerAddress() != Ipv6Address::GetAny() && endPoint->GetPeerPort() != 0;
+    entry.key = {endPoint->GetLocalPort(), endPoint->GetPeerAddress(), endPoint->GetPeerPort()};
+    entry.bucket = entry.connected ? &m_connected[entry.key] : &m_unconnected[entry.key.localPort];
+    entry.bucketEntry = entry.bucket->insert(entry.bucket->end(), endPoint);
+}
+
+void
+Ipv6EndPointDemux::UnindexByPeer(Ipv6EndPoint* endPoint, IndexEntry& entry)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    entry.bucket->erase(entry.bucketEntry);
+    if (entry.bucket->empty())
+    {
+        if (entry.connected)
+        {
+            m_connected.erase(entry.key);
+        }
+        else
+        {
+            m_unconnected.erase(entry.key.localPort);
+        }
+    }
+}
+
+void
+Ipv6EndPointDemux::PeerChanged(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto it = m_index.find(endPoint);
+    NS_ASSERT_MSG(it != m_index.end(), "Endpoint not allocated by this demux");
+    UnindexByPeer(endPoint, it->second);
+    IndexByPeer(endPoint, it->second);
+}
+
+const Ipv6EndPointDemux::EndPoints*
+Ipv6EndPointDemux::FindByPeer(uint16_t localPort, Ipv6Address peerAddress, uint16_t peerPort) const
+{
+    if (peerAddress != Ipv6Address::GetAny() && peerPort != 0)
+    {
+        auto it = m_connected.find({localPort, peerAddress, peerPort});
+        return it != m_connected.end() ? &it->second : nullptr;
+    }
+    auto it = m_unconnected.find(localPort);
+    return it != m_unconnected.end() ? &it->second : nullptr;
+}
+
 uint16_t
 Ipv6EndPointDemux::AllocateEphemeralPort()
 {
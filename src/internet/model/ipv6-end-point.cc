@@ -35,6 +35,7 @@ Ipv6EndPoint::~Ipv6EndPoint()
     m_rxCallback.Nullify();
     m_icmpCallback.Nullify();
     m_destroyCallback.Nullify();
+    m_peerChangedCallback.Nullify();
 }
 
 Ipv6Address
@@ -90,6 +91,10 @@ Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
     m_peerAddr = addr;
     m_peerPort = port;
+    if (!m_peerChangedCallback.IsNull())
+    {
+        m_peerChangedCallback(this);
+    }
 }
 
 void
@@ -112,6 +117,13 @@ Ipv6EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv6EndPoint::SetPeerChangedCallback(Callback<void, Ipv6EndPoint*> callback)
+{
+    NS_LOG_FUNCTION(this << &callback);
+    m_peerChangedCallback = callback;
+}
+
 void
 Ipv6EndPoint::ForwardUp(Ptr<Packet> p,
                         Ipv6Header header,
@@ -140,6 +140,15 @@ class Ipv6EndPoint
      * \param callback callback function
      */
     void SetDestroyCallback(Callback<void> callback);
+    /**
+     * \brief Set the callback notified when the peer of the endpoint changes.
+     *
+     * It is used by the Ipv6EndPointDemux owning the endpoint to keep its
+     * index of the endpoints by peer up to date.
+     *
+     * \param callback callback function
+     */
+    void SetPeerChangedCallback(Callback<void, Ipv6EndPoint*> callback);
 
     /**
      * \brief Forward the packet to the upper level.
@@ -224,6 +233,11 @@ class Ipv6EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The peer changed callback.
+     */
+    Callback<void, Ipv6EndPoint*> m_peerChangedCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
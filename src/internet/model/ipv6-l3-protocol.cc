@@ -29,6 +29,8 @@
 #include "ns3/mac64-address.h"
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
+#include "ns3/queue-disc.h"
+#include "ns3/super-segment-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
@@ -1188,6 +1190,23 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
     NS_LOG_LOGIC("Send via NetDevice ifIndex " << dev->GetIfIndex() << " Ipv6InterfaceIndex "
                                                << interface);
 
+    SuperSegmentTag superSegmentTag;
+    bool superSegment = packet->PeekPacketTag(superSegmentTag);
+    Ptr<IpL4Protocol> protocol = GetProtocol(ipHeader.GetNextHeader());
+    if (superSegment && protocol && outInterface->IsUp() && !CanSendSuperSegment(dev))
+    {
+        // Send the segments of the super-segment instead
+        for (const auto& segment :
+             protocol->Segment(packet, ipHeader.GetSource(), ipHeader.GetDestination()))
+        {
+            Ipv6Header segmentHeader = ipHeader;
+            segmentHeader.SetPayloadLength(segment->GetSize());
+            NS_ASSERT(!segment->PeekPacketTag(superSegmentTag));
+            SendRealOut(route, segment, segmentHeader);
+        }
+        return;
+    }
+
     // Check packet size
     std::list<Ipv6ExtensionFragment::Ipv6PayloadHeaderPair> fragments;
 
@@ -1219,7 +1238,7 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
         targetMtu = dev->GetMtu();
     }
 
-    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
+    if (!superSegment && packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
     {
         // Router => drop
         if (!fromMe)
@@ -1300,6 +1319,19 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
     }
 }
 
+bool
+Ipv6L3Protocol::CanSendSuperSegment(Ptr<NetDevice> device) const
+{
+    NS_LOG_FUNCTION(this << device);
+    if (!device->SupportsSuperSegments())
+    {
+        return false;
+    }
+    Ptr<TrafficControlLayer> tc = m_node->GetObject<TrafficControlLayer>();
+    Ptr<QueueDisc> qdisc = tc ? tc->GetRootQueueDiscOnDevice(device) : nullptr;
+    return !qdisc || qdisc->GetNPackets() == 0;
+}
+
 void
 Ipv6L3Protocol::IpForward(Ptr<const NetDevice> idev,
                           Ptr<Ipv6Route> rtentry,
@@ -606,6 +606,18 @@ class Ipv6L3Protocol : public Ipv6
      */
     void SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6Header& ipHeader);
 
+    /**
+     * \brief Check if a super-segment can be sent as is on a device
+     *
+     * A super-segment is only sent as is on a device that supports
+     * super-segments, and whose root queue disc holds no packet, so that the
+     * packets waiting in a queue disc are single segments.
+     *
+     * \param device the output device
+     * \return true if the super-segment can be sent as is on the device
+     */
+    bool CanSendSuperSegment(Ptr<NetDevice> device) const;
+
     /**
      * \brief Forward a packet.
      * \param idev Pointer to ingress network device
@@ -171,7 +171,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(routePtr, metric);
     }
 }
 
@@ -198,7 +198,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(routePtr, metric);
     }
 }
 
@@ -215,7 +215,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        InsertNetworkRoute(routePtr, metric);
     }
 }
 
@@ -257,7 +257,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    InsertNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -352,20 +352,36 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-    {
-        Ipv6RoutingTableEntry* rtentry = j->first;
+    return m_networkIndex.AnyOf(
+        route.GetDestNetwork(),
+        route.GetDestNetworkPrefix(),
+        [&route, metric](const std::pair<Ipv6RoutingTableEntry*, uint32_t>& j) {
+            Ipv6RoutingTableEntry* rtentry = j.first;
+            return rtentry->GetDest() == route.GetDest() &&
+                   rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
+                   rtentry->GetGateway() == route.GetGateway() &&
+                   rtentry->GetInterface() == route.GetInterface() &&
+                   rtentry->GetPrefixToUse() == route.GetPrefixToUse() && j.second == metric;
+        });
+}
 
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() &&
-            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && j->second == metric)
-        {
-            return true;
-        }
-    }
-    return false;
+void
+Ipv6StaticRouting::InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkIndex.Insert(m_networkRoutes.back(),
+                          route->GetDestNetwork(),
+                          route->GetDestNetworkPrefix());
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    NS_LOG_FUNCTION(this << it->first);
+    m_networkIndex.Remove(*it, it->first->GetDestNetwork(), it->first->GetDestNetworkPrefix());
+    delete it->first;
+    return m_networkRoutes.erase(it);
 }
 
 Ptr<Ipv6Route>
@@ -391,70 +407,58 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
-
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
-
-        if (mask.IsMatch(dst, entry))
-        {
-            NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
-                                                       << ", metric " << metric);
-
+    // the routes with the longest matching prefix, among which the first host route or
+    // the last route with the shortest metric is selected
+    std::vector<std::pair<Ipv6RoutingTableEntry*, uint32_t>> routes;
+    m_networkIndex.GetLongestMatches(
+        dst,
+        [this, interface](const std::pair<Ipv6RoutingTableEntry*, uint32_t>& route) {
             /* if interface is given, check the route will output on this interface */
-            if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface()))
-            {
-                if (maskLen < longestMask)
-                {
-                    NS_LOG_LOGIC("Previous match longer, skipping");
-                    continue;
-                }
-
-                if (maskLen > longestMask)
-                {
-                    shortestMetric = 0xffffffff;
-                }
-
-                longestMask = maskLen;
-                if (metric > shortestMetric)
-                {
-                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                    continue;
-                }
-
-                shortestMetric = metric;
-                Ipv6RoutingTableEntry* route = j;
-                uint32_t interfaceIdx = route->GetInterface();
-                rtentry = Create<Ipv6Route>();
+            return !interface || interface == m_ipv6->GetNetDevice(route.first->GetInterface());
+        },
+        routes);
+
+    const std::pair<Ipv6RoutingTableEntry*, uint32_t>* selected = nullptr;
+    for (const auto& route : routes)
+    {
+        longestMask = route.first->GetDestNetworkPrefix().GetPrefixLength();
+        NS_LOG_LOGIC("Found global network route " << *route.first << ", mask length "
+                                                   << longestMask << ", metric "
+                                                   << route.second);
+        if (route.second > shortestMetric)
+        {
+            NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+            continue;
+        }
+        shortestMetric = route.second;
+        selected = &route;
+        if (longestMask == 128)
+        {
+            break;
+        }
+    }
 
-                if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
-                {
-                    rtentry->SetSource(
-                        m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                }
-                else
-                {
-                    // Default route
-                    rtentry->SetSource(m_ipv6->SourceAddressSelection(
-                        interfaceIdx,
-                        route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                }
+    if (selected)
+    {
+        Ipv6RoutingTableEntry* route = selected->first;
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv6Route>();
 
-                rtentry->SetDestination(route->GetDest());
-                rtentry->SetGateway(route->GetGateway());
-                rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                if (maskLen == 128)
-                {
-                    break;
-                }
-            }
+        if (route->GetGateway().IsAny() || !route->GetDest().IsAny())
+        {
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        }
+        else
+        {
+            // Default route
+            rtentry->SetSource(m_ipv6->SourceAddressSelection(
+                interfaceIdx,
+                route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
         }
+
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
     }
 
     if (rtentry)
@@ -475,6 +479,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkIndex.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -632,8 +637,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
         tmp++;
@@ -655,8 +659,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
     }
@@ -797,8 +800,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -835,8 +837,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -893,8 +894,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseNetworkRoute(j);
             }
             else
             {
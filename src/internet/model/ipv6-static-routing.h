@@ -12,6 +12,7 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "routing-table-index.h"
 
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
@@ -295,6 +296,10 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Index of the network routes by destination network
+    typedef RoutingTableIndex<Ipv6Address, Ipv6Prefix, std::pair<Ipv6RoutingTableEntry*, uint32_t>>
+        NetworkRoutesIndex;
+
     /**
      * \brief Checks if a route is already present in the forwarding table.
      * \param route route
@@ -303,6 +308,20 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a route at the end of the forwarding table for network.
+     * \param route the route, which is deleted when removed from the table
+     * \param metric metric of route
+     */
+    void InsertNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove a route from the forwarding table for network and delete it.
+     * \param it the iterator pointing to the route
+     * \return the iterator following the removed route
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -325,6 +344,11 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the index of the forwarding table for network.
+     */
+    NetworkRoutesIndex m_networkIndex;
+
     /**
      * \brief the forwarding table for multicast.
      */
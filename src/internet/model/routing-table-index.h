@@ -0,0 +1,343 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ROUTING_TABLE_INDEX_H
+#define ROUTING_TABLE_INDEX_H
+
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4Routing
+ * \ingroup ipv6Routing
+ *
+ * \brief An index of the routes of a routing table by destination network, to look
+ * up the routes matching a destination without walking the routing table.
+ *
+ * The routes are grouped by network mask (or prefix), from the longest to the
+ * shortest prefix length, and hashed by destination network within their group.
+ * Looking up a destination thus takes a hash table lookup per distinct mask of the
+ * routing table (a handful, in practice), whatever the number of routes. The routes
+ * to the same network with the same mask (e.g., equal cost multipath routes) share
+ * a bucket.
+ *
+ * The routes are returned in the order they were inserted, which is the order of
+ * the routing table as long as the routes are appended to it, so that a routing
+ * protocol selects the very same route as a walk of its routing table.
+ *
+ * \tparam Address \explicit the type of the addresses (Ipv4Address or Ipv6Address)
+ * \tparam Mask \explicit the type of the network masks (Ipv4Mask or Ipv6Prefix)
+ * \tparam Route \explicit the type of the routes stored in the routing table
+ */
+template <typename Address, typename Mask, typename Route>
+class RoutingTableIndex
+{
+  public:
+    /**
+     * Insert a route after the routes already in the index.
+     *
+     * \param route the route
+     * \param network the destination network of the route
+     * \param mask the network mask of the route
+     */
+    void Insert(const Route& route, Address network, Mask mask);
+
+    /**
+     * Remove a route from the index.
+     *
+     * \param route the route
+     * \param network the destination network of the route
+     * \param mask the network mask of the route
+     */
+    void Remove(const Route& route, Address network, Mask mask);
+
+    /**
+     * Remove all the routes from the index.
+     */
+    void Clear();
+
+    /**
+     * Check whether a route to the given network with the given mask (whatever its
+     * prefix length) satisfies the given predicate.
+     *
+     * \tparam F \deduced the type of the predicate
+     * \param network the destination network
+     * \param mask the network mask
+     * \param pred the predicate
+     * \return true if a route to the given network satisfies the predicate
+     */
+    template <typename F>
+    bool AnyOf(Address network, Mask mask, F pred) const;
+
+    /**
+     * Get the routes matching a destination that are accepted by a filter, in the
+     * order they were inserted.
+     *
+     * \tparam F \deduced the type of the filter
+     * \param dest the destination
+     * \param filter the filter, returning true for the routes that can be used
+     * \param[out] routes the routes matching the destination
+     */
+    template <typename F>
+    void GetMatches(Address dest, F filter, std::vector<Route>& routes) const;
+
+    /**
+     * Get the routes matching a destination that are accepted by a filter and have
+     * the longest prefix length among such routes, in the order they were inserted.
+     *
+     * \tparam F \deduced the type of the filter
+     * \param dest the destination
+     * \param filter the filter, returning true for the routes that can be used
+     * \param[out] routes the routes matching the destination with the longest prefix
+     */
+    template <typename F>
+    void GetLongestMatches(Address dest, F filter, std::vector<Route>& routes) const;
+
+  private:
+    /// A route along with its insertion order
+    using Entry = std::pair<uint64_t, Route>;
+
+    /// The hash function of the addresses
+    using Hash = std::conditional_t<std::is_same_v<Address, Ipv4Address>,
+                                    Ipv4AddressHash,
+                                    Ipv6AddressHash>;
+
+    /// The routes with the same network mask
+    struct Group
+    {
+        uint16_t prefixLength; //!< the prefix length of the mask
+        Mask mask;             //!< the network mask
+        std::unordered_map<Address, std::vector<Entry>, Hash> routes; //!< routes by network
+    };
+
+    /// Iterator over the groups
+    using GroupIt = typename std::vector<Group>::const_iterator;
+
+    /**
+     * \param address an address
+     * \param mask a network mask
+     * \return the network of the given address with the given mask
+     */
+    static Address Combine(Address address, Mask mask);
+
+    /**
+     * \param mask a network mask
+     * \return an iterator to the group of the given mask, or to the end of the groups
+     */
+    typename std::vector<Group>::iterator Find(Mask mask);
+
+    /**
+     * Get the routes of the given groups matching a destination that are accepted by
+     * a filter, in the order they were inserted.
+     *
+     * \tparam F \deduced the type of the filter
+     * \param dest the destination
+     * \param first the first group
+     * \param last the group past the last group
+     * \param filter the filter, returning true for the routes that can be used
+     * \param[out] routes the routes matching the destination
+     */
+    template <typename F>
+    void Collect(Address dest,
+                 GroupIt first,
+                 GroupIt last,
+                 F filter,
+                 std::vector<Route>& routes) const;
+
+    std::vector<Group> m_groups; //!< the groups, by decreasing prefix length
+    uint64_t m_nextSequence{0};  //!< the insertion order of the next route
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename Address, typename Mask, typename Route>
+Address
+RoutingTableIndex<Address, Mask, Route>::Combine(Address address, Mask mask)
+{
+    if constexpr (std::is_same_v<Address, Ipv4Address>)
+    {
+        return address.CombineMask(mask);
+    }
+    else
+    {
+        return address.CombinePrefix(mask);
+    }
+}
+
+template <typename Address, typename Mask, typename Route>
+typename std::vector<typename RoutingTableIndex<Address, Mask, Route>::Group>::iterator
+RoutingTableIndex<Address, Mask, Route>::Find(Mask mask)
+{
+    return std::find_if(m_groups.begin(), m_groups.end(), [&mask](const Group& group) {
+        return group.prefixLength == mask.GetPrefixLength() && group.mask == mask;
+    });
+}
+
+template <typename Address, typename Mask, typename Route>
+void
+RoutingTableIndex<Address, Mask, Route>::Insert(const Route& route, Address network, Mask mask)
+{
+    auto group = Find(mask);
+    if (group == m_groups.end())
+    {
+        group = std::find_if(m_groups.begin(), m_groups.end(), [&mask](const Group& group) {
+            return group.prefixLength < mask.GetPrefixLength();
+        });
+        group = m_groups.insert(group, Group{mask.GetPrefixLength(), mask, {}});
+    }
+    group->routes[Combine(network, mask)].emplace_back(m_nextSequence++, route);
+}
+
+template <typename Address, typename Mask, typename Route>
+void
+RoutingTableIndex<Address, Mask, Route>::Remove(const Route& route, Address network, Mask mask)
+{
+    auto group = Find(mask);
+    NS_ASSERT_MSG(group != m_groups.end(), "No route with mask " << mask);
+    auto bucket = group->routes.find(Combine(network, mask));
+    NS_ASSERT_MSG(bucket != group->routes.end(), "No route to " << network << " " << mask);
+    auto& entries = bucket->second;
+    auto entry = std::find_if(entries.begin(), entries.end(), [&route](const Entry& entry) {
+        return entry.second == route;
+    });
+    NS_ASSERT_MSG(entry != entries.end(), "Route to " << network << " " << mask << " not found");
+    entries.erase(entry);
+    if (entries.empty())
+    {
+        group->routes.erase(bucket);
+        if (group->routes.empty())
+        {
+            m_groups.erase(group);
+        }
+    }
+}
+
+template <typename Address, typename Mask, typename Route>
+void
+RoutingTableIndex<Address, Mask, Route>::Clear()
+{
+    m_groups.clear();
+}
+
+template <typename Address, typename Mask, typename Route>
+template <typename F>
+bool
+RoutingTableIndex<Address, Mask, Route>::AnyOf(Address network, Mask mask, F pred) const
+{
+    // masks are compared regardless of their prefix length, as the routes do
+    for (const auto& group : m_groups)
+    {
+        if (!(group.mask == mask))
+        {
+            continue;
+        }
+        auto bucket = group.routes.find(Combine(network, mask));
+        if (bucket != group.routes.end() &&
+            std::any_of(bucket->second.cbegin(),
+                        bucket->second.cend(),
+                        [&pred](const Entry& entry) { return pred(entry.second); }))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Address, typename Mask, typename Route>
+template <typename F>
+void
+RoutingTableIndex<Address, Mask, Route>::GetMatches(Address dest,
+                                                    F filter,
+                                                    std::vector<Route>& routes) const
+{
+    routes.clear();
+    Collect(dest, m_groups.cbegin(), m_groups.cend(), filter, routes);
+}
+
+template <typename Address, typename Mask, typename Route>
+template <typename F>
+void
+RoutingTableIndex<Address, Mask, Route>::GetLongestMatches(Address dest,
+                                                           F filter,
+                                                           std::vector<Route>& routes) const
+{
+    routes.clear();
+    for (auto first = m_groups.cbegin(); first != m_groups.cend() && routes.empty();)
+    {
+        // the groups with the same prefix length (the masks may differ beyond it)
+        auto last = std::find_if(first, m_groups.cend(), [first](const Group& group) {
+            return group.prefixLength != first->prefixLength;
+        });
+        Collect(dest, first, last, filter, routes);
+        first = last;
+    }
+}
+
+template <typename Address, typename Mask, typename Route>
+template <typename F>
+void
+RoutingTableIndex<Address, Mask, Route>::Collect(Address dest,
+                                                 GroupIt first,
+                                                 GroupIt last,
+                                                 F filter,
+                                                 std::vector<Route>& routes) const
+{
+    const std::vector<Entry>* bucket = nullptr;
+    std::vector<Entry> entries;
+    for (auto group = first; group != last; ++group)
+    {
+        auto it = group->routes.find(Combine(dest, group->mask));
+        if (it == group->routes.end())
+        {
+            continue;
+        }
+        if (!bucket)
+        {
+            bucket = &it->second;
+            continue;
+        }
+        // more than one group matches (e.g., a default route and a network route):
+        // merge their routes in insertion order
+        if (entries.empty())
+        {
+            entries = *bucket;
+        }
+        entries.insert(entries.end(), it->second.cbegin(), it->second.cend());
+    }
+    if (!entries.empty())
+    {
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.first < b.first;
+        });
+        bucket = &entries;
+    }
+    if (!bucket)
+    {
+        return;
+    }
+    for (const auto& [sequence, route] : *bucket)
+    {
+        if (filter(route))
+        {
+            routes.push_back(route);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* ROUTING_TABLE_INDEX_H */
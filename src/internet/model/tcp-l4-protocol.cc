@@ -34,6 +34,7 @@
 #include "ns3/object-map.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/super-segment-tag.h"
 
 #include <iomanip>
 #include <sstream>
@@ -572,6 +573,52 @@ TcpL4Protocol::Receive(Ptr<Packet> packet,
     return IpL4Protocol::RX_OK;
 }
 
+std::list<Ptr<Packet>>
+TcpL4Protocol::Segment(Ptr<Packet> p, const Address& source, const Address& destination)
+{
+    NS_LOG_FUNCTION(this << p << source << destination);
+
+    Ptr<Packet> packet = p->Copy();
+    SuperSegmentTag superSegment;
+    if (!packet->RemovePacketTag(superSegment) || superSegment.GetSegmentSize() == 0)
+    {
+        return {p};
+    }
+    TcpHeader header;
+    packet->RemoveHeader(header);
+
+    std::list<Ptr<Packet>> segments;
+    uint32_t payloadSize = packet->GetSize();
+    uint32_t segmentSize = superSegment.GetSegmentSize();
+    for (uint32_t offset = 0; offset < payloadSize; offset += segmentSize)
+    {
+        uint32_t size = std::min(segmentSize, payloadSize - offset);
+        Ptr<Packet> segment = packet->CreateFragment(offset, size);
+        TcpHeader segmentHeader = header;
+        segmentHeader.SetSequenceNumber(header.GetSequenceNumber() + SequenceNumber32(offset));
+        uint8_t flags = header.GetFlags();
+        if (offset > 0)
+        {
+            flags &= ~TcpHeader::CWR;
+        }
+        if (offset + size < payloadSize)
+        {
+            flags &= ~(TcpHeader::FIN | TcpHeader::PSH);
+        }
+        segmentHeader.SetFlags(flags);
+        if (Node::ChecksumEnabled())
+        {
+            segmentHeader.EnableChecksums();
+        }
+        segmentHeader.InitializeChecksum(source, destination, PROT_NUMBER);
+        segment->AddHeader(segmentHeader);
+        segments.push_back(segment);
+    }
+    NS_LOG_LOGIC("Split a super-segment of " << payloadSize << " bytes in " << segments.size()
+                                             << " segments");
+    return segments;
+}
+
 void
 TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
                             const TcpHeader& outgoing,
@@ -271,6 +271,22 @@ class TcpL4Protocol : public IpL4Protocol
                      Ipv6Address payloadDestination,
                      const uint8_t payload[8]) override;
 
+    /**
+     * \brief Split a super-segment in the segments it stands for
+     *
+     * Each segment carries the TCP header of the super-segment, with its own
+     * sequence number; the FIN and PSH flags are only set on the last
+     * segment, and the CWR flag on the first one.
+     *
+     * \param p the super-segment, without the network header
+     * \param source the source address of the super-segment
+     * \param destination the destination address of the super-segment
+     * \return the segments, without the network header
+     */
+    std::list<Ptr<Packet>> Segment(Ptr<Packet> p,
+                                   const Address& source,
+                                   const Address& destination) override;
+
     void SetDownTarget(IpL4Protocol::DownTargetCallback cb) override;
     void SetDownTarget6(IpL4Protocol::DownTargetCallback6 cb) override;
     int GetProtocolNumber() const override;
@@ -10,6 +10,7 @@
 
 #include "ns3/log.h"
 #include "ns3/packet.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -25,6 +26,12 @@ TcpRxBuffer::GetTypeId()
                             .SetParent<Object>()
                             .SetGroupName("Internet")
                             .AddConstructor<TcpRxBuffer>()
+                            .AddAttribute("MaxSpanSize",
+                                          "The maximum size of the spans in which contiguous "
+                                          "segments are coalesced (0 to disable coalescing)",
+                                          UintegerValue(65535),
+                                          MakeUintegerAccessor(&TcpRxBuffer::m_maxSpanSize),
+                                          MakeUintegerChecker<uint32_t>())
                             .AddTraceSource("NextRxSequence",
                                             "Next sequence number expected (RCV.NXT)",
                                             MakeTraceSourceAccessor(&TcpRxBuffer::m_nextRxSeq),
@@ -44,7 +51,8 @@ TcpRxBuffer::TcpRxBuffer(uint32_t n)
       m_gotFin(false),
       m_size(0),
       m_maxBuffer(32768),
-      m_availBytes(0)
+      m_availBytes(0),
+      m_maxSpanSize(65535)
 {
 }
 
@@ -160,8 +168,13 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    auto i = m_data.begin();
+    // Remove overlapped bytes from packet. The spans do not overlap, so only the
+    // span starting before headSeq may overlap the head of the packet
+    auto i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
+    {
+        --i;
+    }
     while (i != m_data.end() && i->first <= tailSeq)
     {
         SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
@@ -197,31 +210,50 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
         p = p->CreateFragment(start, length);
         NS_ASSERT(length == p->GetSize());
     }
-    // Insert packet into buffer
+    // The packet tags are not delivered to the application, as the data is
+    // extracted regardless of the segment boundaries
+    p->RemoveAllPacketTags();
+
+    // Insert packet into buffer, appending it to the span ending at headSeq, if any
     NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
-    m_data[headSeq] = p;
+    i = m_data.lower_bound(headSeq);
+    if (i != m_data.begin() &&
+        std::prev(i)->first + SequenceNumber32(std::prev(i)->second->GetSize()) == headSeq &&
+        std::prev(i)->second->GetSize() + p->GetSize() <= m_maxSpanSize)
+    {
+        --i;
+        i->second->AddAtEnd(p);
+    }
+    else
+    {
+        i = m_data.emplace_hint(i, headSeq, p);
+    }
+    // Coalesce the span starting at tailSeq, if any
+    auto next = std::next(i);
+    if (next != m_data.end() && next->first == tailSeq &&
+        i->second->GetSize() + next->second->GetSize() <= m_maxSpanSize)
+    {
+        i->second->AddAtEnd(next->second);
+        m_data.erase(next);
+    }
 
+    TcpOptionSack::SackBlock block = AddBlock(headSeq, tailSeq);
     if (headSeq > m_nextRxSeq)
     {
-        // Generate a new SACK block
-        UpdateSackList(headSeq, tailSeq);
+        // Generate a new SACK block, with the contiguous data holding the segment
+        UpdateSackList(block.first, block.second);
     }
 
-    NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
+    NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << tailSeq - headSeq);
     // Update variables
-    m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    m_size += static_cast<uint32_t>(tailSeq - headSeq); // Occupancy
+    // The data in sequence is the block holding m_nextRxSeq, which starts at
+    // the first byte still in the buffer
+    auto firstBlock = m_blocks.begin();
+    if (firstBlock->first <= m_nextRxSeq && m_nextRxSeq < firstBlock->second)
     {
-        if (i->first < m_nextRxSeq)
-        {
-            continue;
-        }
-        else if (i->first > m_nextRxSeq)
-        {
-            break;
-        };
-        m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
-        m_availBytes += i->second->GetSize();
+        m_availBytes += static_cast<uint32_t>(firstBlock->second - m_nextRxSeq);
+        m_nextRxSeq = firstBlock->second;
         ClearSackList(m_nextRxSeq);
     }
     NS_LOG_LOGIC("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -232,6 +264,28 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
     return true;
 }
 
+TcpOptionSack::SackBlock
+TcpRxBuffer::AddBlock(const SequenceNumber32& head, const SequenceNumber32& tail)
+{
+    NS_LOG_FUNCTION(this << head << tail);
+
+    TcpOptionSack::SackBlock block(head, tail);
+    auto it = m_blocks.upper_bound(head);
+    if (it != m_blocks.begin() && std::prev(it)->second >= head)
+    {
+        // Merge with the block ending at or after head
+        --it;
+        block.first = it->first;
+    }
+    while (it != m_blocks.end() && it->first <= tail)
+    {
+        block.second = std::max(block.second, it->second);
+        it = m_blocks.erase(it);
+    }
+    m_blocks.emplace_hint(it, block.first, block.second);
+    return block;
+}
+
 uint32_t
 TcpRxBuffer::GetSackListSize() const
 {
@@ -291,6 +345,13 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
     {
         current = *it;
 
+        // The block holds the current one, reported again in the first block
+        if (begin.first <= current.first && current.second <= begin.second)
+        {
+            it = m_sackList.erase(it);
+            continue;
+        }
+
         // This is a left merge:
         // [current_first; current_second] [beg_first; beg_second]
         if (begin.first == current.second)
@@ -331,10 +392,10 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
         m_sackList.pop_back();
     }
 
-    // Please note that, if a block b is discarded and then a block contiguous
-    // to b is received, only that new block (without the b part) is reported.
-    // This is perfectly fine for the RFC point (a), given that we do not report any
-    // overlapping blocks shortly after.
+    // Please note that the first block is the whole contiguous data holding
+    // the segment, so that, if a block b is discarded and then a block
+    // contiguous to b is received, the b part is reported again, as required
+    // by the RFC point (a).
 }
 
 void
@@ -376,33 +437,51 @@ TcpRxBuffer::Extract(uint32_t maxSize)
     {
         return nullptr; // No contiguous block to return
     }
-    NS_ASSERT(!m_data.empty());            // At least we have something to extract
-    Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
+    NS_ASSERT(!m_data.empty()); // At least we have something to extract
+    Ptr<Packet> outPkt;         // The packet that contains all the data to return
+    SequenceNumber32 headSeq = m_data.begin()->first;
+    uint32_t extracted = 0;
     BufIterator i;
     while (extractSize)
     { // Check the buffered data for delivery
         i = m_data.begin();
         NS_ASSERT(i->first <= m_nextRxSeq); // in-sequence data expected
-        // Check if we send the whole pkt or just a partial
+        // Check if we send the whole span or just a partial
         uint32_t pktSize = i->second->GetSize();
+        Ptr<Packet> data;
         if (pktSize <= extractSize)
-        { // Whole packet is extracted
-            outPkt->AddAtEnd(i->second);
+        { // Whole span is extracted
+            data = i->second;
             m_data.erase(i);
-            m_size -= pktSize;
-            m_availBytes -= pktSize;
-            extractSize -= pktSize;
         }
         else
         { // Partial is extracted and done
-            outPkt->AddAtEnd(i->second->CreateFragment(0, extractSize));
+            data = i->second->CreateFragment(0, extractSize);
             m_data[i->first + SequenceNumber32(extractSize)] =
                 i->second->CreateFragment(extractSize, pktSize - extractSize);
             m_data.erase(i);
-            m_size -= extractSize;
-            m_availBytes -= extractSize;
-            extractSize = 0;
         }
+        if (!outPkt)
+        { // The first span is handed over without being copied
+            outPkt = data;
+        }
+        else
+        {
+            outPkt->AddAtEnd(data);
+        }
+        m_size -= data->GetSize();
+        m_availBytes -= data->GetSize();
+        extractSize -= data->GetSize();
+        extracted += data->GetSize();
+    }
+    // The extracted data is at the head of the first block
+    auto firstBlock = m_blocks.begin();
+    NS_ASSERT(firstBlock->first == headSeq);
+    SequenceNumber32 blockEnd = firstBlock->second;
+    m_blocks.erase(firstBlock);
+    if (headSeq + SequenceNumber32(extracted) < blockEnd)
+    {
+        m_blocks.emplace_hint(m_blocks.begin(), headSeq + SequenceNumber32(extracted), blockEnd);
     }
     if (outPkt->GetSize() == 0)
     {
@@ -44,6 +44,17 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * Coalescing
+ * ----------
+ *
+ * Contiguous segments are coalesced in spans of data, up to the size set by
+ * the MaxSpanSize attribute, so that the number of packets held by this
+ * buffer does not grow with the window but with the number of holes. The
+ * buffered data is also tracked as a set of contiguous blocks, whose gaps
+ * are the holes in the sequence space: the block of the segment just
+ * received is the first SACK block, and the in-order data is found without
+ * walking the buffer.
+ *
  * SACK list
  * ---------
  *
@@ -209,6 +220,17 @@ class TcpRxBuffer : public Object
      */
     void ClearSackList(const SequenceNumber32& seq);
 
+    /**
+     * \brief Add a range of sequence numbers to the blocks of buffered data
+     *
+     * The range is merged with the blocks it overlaps or touches.
+     *
+     * \param head first sequence number of the range
+     * \param tail sequence number following the range
+     * \return the block that contains the range
+     */
+    TcpOptionSack::SackBlock AddBlock(const SequenceNumber32& head, const SequenceNumber32& tail);
+
     TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
     /// container for data stored in the buffer
@@ -220,7 +242,10 @@ class TcpRxBuffer : public Object
     uint32_t m_size;       //!< Number of total data bytes in the buffer, not necessarily contiguous
     uint32_t m_maxBuffer;  //!< Upper bound of the number of data bytes in buffer (RCV.WND)
     uint32_t m_availBytes; //!< Number of bytes available to read, i.e. contiguous block at head
-    std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Corresponding data (may be null)
+    uint32_t m_maxSpanSize; //!< Maximum size of a span of coalesced segments
+    std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Spans of data, by first sequence number
+    /// Blocks of contiguous buffered data (first sequence, sequence following the block)
+    std::map<SequenceNumber32, SequenceNumber32> m_blocks;
 };
 
 } // namespace ns3
@@ -48,6 +48,7 @@
 #include "ns3/pointer.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
+#include "ns3/super-segment-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
@@ -61,6 +62,9 @@ NS_LOG_COMPONENT_DEFINE("TcpSocketBase");
 
 NS_OBJECT_ENSURE_REGISTERED(TcpSocketBase);
 
+/// The largest payload of a super-segment, which fits in an IP packet with the largest TCP header
+static const uint32_t MAX_SUPER_SEGMENT_PAYLOAD = 65535 - 20 - 60;
+
 TypeId
 TcpSocketBase::GetTypeId()
 {
@@ -155,6 +159,12 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("SuperSegmentSize",
+                          "The maximum number of full segments of new data sent as a single "
+                          "super-segment, as with TSO/GSO (1 disables super-segments)",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_superSegmentSize),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -370,6 +380,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_superSegmentSize(sock.m_superSegmentSize),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -3132,6 +3143,11 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     bool isRetransmission = outItem->IsRetrans();
     Ptr<Packet> p = outItem->GetPacketCopy();
     uint32_t sz = p->GetSize(); // Size of packet
+    if (sz > m_tcb->m_segmentSize)
+    {
+        // A super-segment of new data, see SendPendingData
+        p->AddPacketTag(SuperSegmentTag(m_tcb->m_segmentSize, sz));
+    }
     uint8_t flags = withAck ? TcpHeader::ACK : 0;
     uint32_t remainingData = m_txBuffer->SizeFromSequence(seq + SequenceNumber32(sz));
 
@@ -3385,6 +3401,18 @@ TcpSocketBase::SendPendingData(bool withAck)
             auto maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            // New data is sent in super-segments of full segments, if enabled
+            if (m_superSegmentSize > 1 && next >= m_tcb->m_highTxMark.Get() &&
+                availableWindow >= 2 * m_tcb->m_segmentSize &&
+                availableData >= 2 * m_tcb->m_segmentSize)
+            {
+                s = std::min({availableWindow,
+                              availableData,
+                              m_superSegmentSize * m_tcb->m_segmentSize,
+                              MAX_SUPER_SEGMENT_PAYLOAD});
+                s = std::max(s - s % m_tcb->m_segmentSize, m_tcb->m_segmentSize);
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -3538,6 +3566,10 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
+    // A super-segment is acknowledged as the segments it stands for
+    SuperSegmentTag superSegment;
+    uint32_t segments = p->PeekPacketTag(superSegment) ? superSegment.GetSegments() : 1;
+
     // Put into Rx buffer
     SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence();
     if (!m_tcb->m_rxBuffer->Add(p, tcpHeader))
@@ -3594,7 +3626,8 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        m_delAckCount += segments;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -1378,6 +1378,7 @@ class TcpSocketBase : public TcpSocket
                                  //!< which was set for handling previous congestion event.
     uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
     bool m_limitedTx{true};      //!< perform limited transmit
+    uint32_t m_superSegmentSize{1}; //!< Maximum number of segments sent as one super-segment
 
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
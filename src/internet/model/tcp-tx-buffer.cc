@@ -50,7 +50,8 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostMarked(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -165,6 +166,7 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     NS_ASSERT(m_sentList.empty());
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostMarked = seq;
 }
 
 bool
@@ -285,7 +287,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    AddToIndex(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -299,37 +301,33 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    if (auto index = m_sentIndex.find(seq); index != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = index->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -339,6 +337,7 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     {
         m_retrans += item->m_packet->GetSize();
         item->m_retrans = true;
+        UpdateIndex(item);
     }
 
     return item;
@@ -386,12 +385,39 @@ TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
     NS_LOG_INFO("Split of size " << size << " result: t1 " << *t1 << " t2 " << *t2);
 }
 
+void
+TcpTxBuffer::SplitSentItem(const SequenceNumber32& seq)
+{
+    NS_LOG_FUNCTION(this << seq);
+
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return;
+    }
+    --index;
+    auto it = index->second;
+    TcpTxItem* item = *it;
+    uint32_t size = item->m_packet->GetSize();
+    if (index->first == seq || item->m_sacked || size <= m_segmentSize ||
+        index->first + size <= seq)
+    {
+        return;
+    }
+
+    auto firstPart = new TcpTxItem();
+    SplitItems(firstPart, item, seq - index->first);
+    auto firstIt = m_sentList.insert(it, firstPart);
+    m_sentIndex[firstPart->m_startSeq] = firstIt;
+    AddToIndex(it);
+}
+
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -427,6 +453,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     TcpTxItem* outItem = nullptr;
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    const bool indexed = (&list == &m_sentList);
+
+    if (indexed)
+    {
+        // Start from the item that contains seq
+        auto index = m_sentIndex.upper_bound(seq);
+        if (index != m_sentIndex.begin())
+        {
+            --index;
+            it = index->second;
+            beginOfCurrentPacket = index->first;
+        }
+    }
 
     while (it != list.end())
     {
@@ -461,7 +500,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstIt = list.insert(it, firstPart);
+                if (indexed)
+                {
+                    m_sentIndex[firstPart->m_startSeq] = firstIt;
+                    AddToIndex(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -527,7 +571,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstIt = list.insert(it, firstPart);
+                if (indexed)
+                {
+                    m_sentIndex[firstPart->m_startSeq] = firstIt;
+                    AddToIndex(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -555,8 +604,16 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
             TcpTxItem* next = (*it); // Please remember we have incremented it
                                      // in the previous if
 
+            if (indexed)
+            {
+                RemoveFromIndex(next);
+            }
             MergeItems(currentItem, next);
             list.erase(it);
+            if (indexed)
+            {
+                UpdateIndex(currentItem);
+            }
 
             delete next;
 
@@ -640,16 +697,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item that precedes ack can end at ack
+    auto index = m_sentIndex.lower_bound(ack);
+    if (index == m_sentIndex.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    const TcpTxItem* item = *(--index)->second;
+    return item->m_startSeq + item->m_packet->GetSize() == ack && !item->m_sacked &&
+           item->m_retrans;
 }
 
 void
@@ -696,6 +752,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             m_firstByteSeq += pktSize;
 
             RemoveFromCounts(item, pktSize);
+            RemoveFromIndex(item);
 
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
@@ -714,8 +771,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             pktSize -= offset;
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
+            RemoveFromIndex(item);
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
             item->m_startSeq += offset;
+            AddToIndex(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -745,9 +804,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // when adding Reno dupacks in the count.
             head->m_sacked = false;
             m_sackedOut -= head->m_packet->GetSize();
+            UpdateIndex(head);
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
-            AddRenoSack();
             MarkHeadAsLost();
+            AddRenoSack();
         }
 
         NS_ASSERT_MSG(head->m_startSeq == seq,
@@ -760,6 +820,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
         m_sackSeen = false;
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
+    if (m_lostMarked < m_firstByteSeq)
+    {
+        m_lostMarked = m_firstByteSeq;
+    }
 
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
@@ -779,17 +843,23 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
-        while (item_it != m_sentList.end())
+        // A super-segment may be reported in part
+        SplitSentItem((*option_it).first);
+        SplitSentItem((*option_it).second);
+
+        // The items before the block cannot be mapped over it, start from the
+        // first item that begins inside the block
+        for (auto index = m_sentIndex.lower_bound((*option_it).first); index != m_sentIndex.end();
+             ++index)
         {
+            auto item_it = index->second;
+            SequenceNumber32 beginOfCurrentPacket = index->first;
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
 
             // Check the boundary of this packet ... only mark as sacked if
@@ -818,6 +888,7 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                     (*item_it)->m_sacked = true;
                     m_sackedOut += (*item_it)->m_packet->GetSize();
                     bytesSacked += (*item_it)->m_packet->GetSize();
+                    UpdateIndex(*item_it);
 
                     if (m_highestSack.first == m_sentList.end() ||
                         m_highestSack.second <= beginOfCurrentPacket + pktSize)
@@ -844,9 +915,6 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                                                << *(*item_it) << "], not found, breaking loop");
                 break;
             }
-
-            beginOfCurrentPacket += pktSize;
-            ++item_it;
         }
     }
 
@@ -868,47 +936,51 @@ void
 TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
-    uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
-    if (m_highestSack.first == m_sentList.end())
+    NS_LOG_INFO("Status before the update: " << *this);
+
+    // Find the sacked item that holds the dupAckThresh-th sacked segment,
+    // counting down from the highest sacked item: the items before it, that
+    // are not sacked, are lost. A sacked item holds more than one segment if
+    // it is part of a super-segment. The head is never sacked, hence it is
+    // never counted.
+    SequenceNumber32 lostBefore = m_highestSack.second;
+    if (m_dupAckThresh > 0)
     {
-        NS_LOG_INFO("Status before the update: " << *this
-                                                 << ", will start from the latest sent item");
-    }
-    else
-    {
-        NS_LOG_INFO("Status before the update: " << *this << ", will start from item "
-                                                 << *(*m_highestSack.first));
-    }
-
-    for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
-    {
-        TcpTxItem* item = *it;
-        if (item->m_sacked)
+        auto sacked = m_sackedIndex.upper_bound(m_highestSack.second);
+        uint32_t count = 0;
+        while (count < m_dupAckThresh && sacked != m_sackedIndex.begin())
         {
-            sacked++;
+            --sacked;
+            const uint32_t size = (*m_sentIndex.at(*sacked))->m_packet->GetSize();
+            count += (m_segmentSize > 0 && size > m_segmentSize)
+                         ? (size + m_segmentSize - 1) / m_segmentSize
+                         : 1;
         }
-
-        if (sacked >= m_dupAckThresh)
+        if (count < m_dupAckThresh)
         {
-            if (!item->m_sacked && !item->m_lost)
-            {
-                item->m_lost = true;
-                m_lostOut += item->m_packet->GetSize();
-            }
+            NS_LOG_INFO("Less than " << m_dupAckThresh << " sacked items, nothing is lost");
+            return;
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
+        lostBefore = *sacked;
     }
 
-    if (sacked >= m_dupAckThresh)
+    // The items before m_lostMarked are already lost or sacked
+    for (auto index = m_sentIndex.lower_bound(m_lostMarked);
+         index != m_sentIndex.end() && index->first < lostBefore;
+         ++index)
     {
-        TcpTxItem* item = *m_sentList.begin();
-        if (!item->m_lost)
+        TcpTxItem* item = *index->second;
+        if (!item->m_sacked && !item->m_lost)
         {
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
+            UpdateIndex(item);
         }
     }
+    if (m_lostMarked < lostBefore)
+    {
+        m_lostMarked = lostBefore;
+    }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
 }
@@ -923,24 +995,25 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Search for the item that contains seq
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return false;
+    }
+    const TcpTxItem* item = *(--index)->second;
+    if (seq < item->m_startSeq + item->m_packet->GetSize())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if (item->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if (item->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -965,36 +1038,38 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
      *
      *     (1.c) IsLost (S2) returns true.
      */
-    TcpTxItem* item;
+    // Conditions 1.a and 1.b: the items neither retransmitted nor sacked, below
+    // the highest sacked sequence if a SACK was received
+    auto isCandidate = [this](const SequenceNumber32& s) {
+        return !m_sackSeen || s < m_highestSack.second;
+    };
+
+    // Condition 1.c: the first lost candidate
+    if (!m_lostIndex.empty() && isCandidate(*m_lostIndex.begin()))
+    {
+        *seq = *m_lostIndex.begin();
+        NS_LOG_INFO("IsLost, returning" << *seq);
+        *seqHigh = *seq + m_segmentSize;
+        return true;
+    }
+
+    // Since no candidate is lost, the first candidate is kept for rule 3 (or the
+    // second one, if the first one starts at sequence 0)
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
-    SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
-
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    if (isRecovery)
     {
-        item = *it;
-
-        // Condition 1.a , 1.b , and 1.c
-        if (!item->m_retrans && !item->m_sacked &&
-            ((m_sackSeen && item->m_startSeq < m_highestSack.second) || !m_sackSeen))
+        for (auto it = m_unsackedIndex.begin(); it != m_unsackedIndex.end() && isCandidate(*it);
+             ++it)
         {
-            if (item->m_lost)
-            {
-                NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-                *seq = beginOfCurrentPkt;
-                *seqHigh = *seq + m_segmentSize;
-                return true;
-            }
-            else if (seqPerRule3.GetValue() == 0 && isRecovery)
+            NS_LOG_INFO("Saving for rule 3 the seq " << *it);
+            isSeqPerRule3Valid = true;
+            seqPerRule3 = *it;
+            if (seqPerRule3.GetValue() != 0)
             {
-                NS_LOG_INFO("Saving for rule 3 the seq " << beginOfCurrentPkt);
-                isSeqPerRule3Valid = true;
-                seqPerRule3 = beginOfCurrentPkt;
+                break;
             }
         }
-
-        // Nothing found, iterate
-        beginOfCurrentPkt += item->m_packet->GetSize();
     }
 
     /* (2) If no sequence number 'S2' per rule (1) exists but there
@@ -1202,11 +1277,17 @@ TcpTxBuffer::ResetRenoSack()
     m_sackedOut = 0;
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
-        (*it)->m_sacked = false;
+        if ((*it)->m_sacked)
+        {
+            (*it)->m_sacked = false;
+            UpdateIndex(*it);
+        }
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     m_sackSeen = false;
+    // The items that were sacked are neither lost nor sacked anymore
+    m_lostMarked = m_firstByteSeq;
 }
 
 void
@@ -1237,6 +1318,11 @@ TcpTxBuffer::ResetSentList()
     m_sackedOut = 0;
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_sentIndex.clear();
+    m_sackedIndex.clear();
+    m_lostIndex.clear();
+    m_unsackedIndex.clear();
+    m_lostMarked = m_firstByteSeq;
 }
 
 void
@@ -1247,6 +1333,11 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        RemoveFromIndex(item);
+        if (item->m_startSeq < m_lostMarked)
+        {
+            m_lostMarked = item->m_startSeq;
+        }
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1299,7 +1390,9 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         }
 
         (*it)->m_retrans = false;
+        UpdateIndex(*it);
     }
+    m_lostMarked = m_firstByteSeq + m_sentSize;
 
     NS_LOG_INFO("Set sent list lost, status: " << *this);
     NS_ASSERT_MSG(m_sentSize >= m_sackedOut + m_lostOut, *this);
@@ -1333,6 +1426,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead()
     {
         m_sentList.front()->m_retrans = false;
         m_retrans -= m_sentList.front()->m_packet->GetSize();
+        UpdateIndex(m_sentList.front());
     }
     ConsistencyCheck();
 }
@@ -1362,6 +1456,7 @@ TcpTxBuffer::MarkHeadAsLost()
             m_sentList.front()->m_lost = true;
             m_lostOut += m_sentList.front()->m_packet->GetSize();
         }
+        UpdateIndex(m_sentList.front());
     }
     ConsistencyCheck();
 }
@@ -1396,6 +1491,7 @@ TcpTxBuffer::AddRenoSack()
     {
         (*it)->m_sacked = true;
         m_sackedOut += (*it)->m_packet->GetSize();
+        UpdateIndex(*it);
         m_sackSeen = true;
         m_highestSack = std::make_pair(it, (*it)->m_startSeq);
         NS_LOG_INFO("Added a Reno SACK, status: " << *this);
@@ -1444,6 +1540,67 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        const TcpTxItem* item = *it;
+        const auto& start = item->m_startSeq;
+        auto index = m_sentIndex.find(start);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << *item << " not indexed");
+        NS_ASSERT(m_sackedIndex.count(start) == (item->m_sacked ? 1 : 0));
+        NS_ASSERT(m_lostIndex.count(start) ==
+                  (item->m_lost && !item->m_sacked && !item->m_retrans ? 1 : 0));
+        NS_ASSERT(m_unsackedIndex.count(start) == (!item->m_sacked && !item->m_retrans ? 1 : 0));
+        NS_ASSERT(start >= m_lostMarked || item->m_lost || item->m_sacked);
+    }
+}
+
+void
+TcpTxBuffer::AddToIndex(PacketList::iterator it)
+{
+    m_sentIndex[(*it)->m_startSeq] = it;
+    UpdateIndex(*it);
+}
+
+void
+TcpTxBuffer::RemoveFromIndex(const TcpTxItem* item)
+{
+    m_sentIndex.erase(item->m_startSeq);
+    m_sackedIndex.erase(item->m_startSeq);
+    m_lostIndex.erase(item->m_startSeq);
+    m_unsackedIndex.erase(item->m_startSeq);
+}
+
+void
+TcpTxBuffer::UpdateIndex(const TcpTxItem* item)
+{
+    const auto& start = item->m_startSeq;
+    if (item->m_sacked)
+    {
+        m_sackedIndex.insert(start);
+        m_lostIndex.erase(start);
+        m_unsackedIndex.erase(start);
+        return;
+    }
+    m_sackedIndex.erase(start);
+    if (item->m_retrans)
+    {
+        m_lostIndex.erase(start);
+        m_unsackedIndex.erase(start);
+        return;
+    }
+    m_unsackedIndex.insert(start);
+    if (item->m_lost)
+    {
+        m_lostIndex.insert(start);
+    }
+    else
+    {
+        m_lostIndex.erase(start);
+    }
 }
 
 std::ostream&
@@ -17,6 +17,9 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <map>
+#include <set>
+
 namespace ns3
 {
 class Packet;
@@ -63,6 +66,15 @@ class Packet;
  * documentation) and maintaining the scoreboard is a matter of travelling the
  * list and set the SACK flag on the corresponding segment sent.
  *
+ * With large windows, travelling the list for each received ACK is too slow,
+ * hence the items of the sent list are also indexed by their first sequence
+ * number, and the sequence numbers of the sacked, lost and not retransmitted
+ * items are kept in ordered sets. Updating the scoreboard with a SACK block,
+ * finding the segment containing a sequence, counting the sacked segments
+ * above a sequence (\see UpdateLostCount) and choosing the next segment to
+ * transmit (\see NextSeg) then take a logarithmic time in the number of
+ * segments in flight.
+ *
  * Item properties
  * ---------------
  *
@@ -405,8 +417,8 @@ class TcpTxBuffer : public Object
     /**
      * \brief Update the lost count
      *
-     * Reset lost to 0, then walk the sent list looking for lost segments.
-     * We have two possible algorithms for detecting lost packets:
+     * Mark as lost the segments that are considered lost, starting from the
+     * highest sacked segment. We have two possible algorithms for detecting lost packets:
      *
      * - RFC 6675 algorithm, which says that if more than "Dupack thresh" (e.g., 3)
      * sacked segments above the sequence, then we can consider the sequence lost;
@@ -417,12 +429,33 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
-     *
+     * and updates the lost count. The sacked segments are counted through their
+     * index, and only the segments that follow the ones already marked as lost
+     * by a previous call are walked.
      */
     void UpdateLostCount();
 
+    /**
+     * \brief Add an item of the sent list to the indexes of the scoreboard
+     * \param it Iterator to the item in the sent list
+     */
+    void AddToIndex(PacketList::iterator it);
+
+    /**
+     * \brief Remove an item of the sent list from the indexes of the scoreboard
+     *
+     * The item is looked up by its first sequence number, which must not have
+     * changed since the item was added.
+     * \param item Item to remove
+     */
+    void RemoveFromIndex(const TcpTxItem* item);
+
+    /**
+     * \brief Update the indexes of the scoreboard after the flags of an item changed
+     * \param item Item whose flags changed
+     */
+    void UpdateIndex(const TcpTxItem* item);
+
     /**
      * \brief Remove the size specified from the lostOut, retrans, sacked count
      *
@@ -548,12 +581,16 @@ class TcpTxBuffer : public Object
      * \param requestedSeq Requested sequence
      * \param listEdited output parameter which indicates if the list has been edited
      * \return the item that contains the right packet
+     *
+     * When the list is the sent list, the walk starts from the item containing
+     * requestedSeq, found through the index of the sent list, and the index is
+     * updated with the fragments and merges.
      */
     TcpTxItem* GetPacketFromList(PacketList& list,
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * \brief Merge two TcpTxItem
@@ -579,6 +616,17 @@ class TcpTxBuffer : public Object
      */
     void SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const;
 
+    /**
+     * \brief Split the item of the sent list that contains a sequence number
+     *
+     * Only the items larger than a segment (the super-segments sent by
+     * TcpSocketBase) that are not sacked are split, so that the SACK blocks
+     * reporting a part of them can be mapped over items.
+     *
+     * \param seq the sequence number that begins the second part
+     */
+    void SplitSentItem(const SequenceNumber32& seq);
+
     /**
      * \brief Check if the values of sacked, lost, retrans, are in sync
      * with the sent list.
@@ -602,6 +650,15 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    std::map<SequenceNumber32, PacketList::iterator>
+        m_sentIndex; //!< Items of the sent list, indexed by their first sequence number
+    std::set<SequenceNumber32> m_sackedIndex; //!< First sequence number of the sacked items
+    std::set<SequenceNumber32>
+        m_lostIndex; //!< First sequence number of the lost items not sacked nor retransmitted
+    std::set<SequenceNumber32>
+        m_unsackedIndex; //!< First sequence number of the items not sacked nor retransmitted
+    SequenceNumber32 m_lostMarked{0}; //!< The items before this sequence are lost or sacked
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
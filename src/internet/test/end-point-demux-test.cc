@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/test.h"
+
+#include <array>
+#include <string>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief End point demux test: the endpoints are looked up among the endpoints
+ * indexed by local port and peer, with the same priorities as a scan of all the
+ * endpoints, and are indexed again when their peer changes.
+ *
+ * \tparam Demux \explicit the demux (Ipv4EndPointDemux or Ipv6EndPointDemux)
+ * \tparam Address \explicit the type of the addresses
+ * \tparam Interface \explicit the type of the interfaces
+ */
+template <typename Demux, typename Address, typename Interface>
+class EndPointDemuxTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param name the name of the test case
+     * \param local the local address
+     * \param peers three peer addresses
+     */
+    EndPointDemuxTestCase(const std::string& name,
+                          Address local,
+                          const std::array<Address, 3>& peers);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \param demux the demux
+     * \param peer the source address of the packet
+     * \param sport the source port of the packet
+     * \param dport the destination port of the packet
+     * \return the endpoint matching a packet received from the given peer, or a null
+     *         pointer if no endpoint or more than one endpoint match
+     */
+    auto Lookup(Demux& demux, Address peer, uint16_t sport, uint16_t dport = 80)
+    {
+        auto endPoints = demux.Lookup(m_local, dport, peer, sport, m_interface);
+        return endPoints.size() == 1 ? endPoints.front() : nullptr;
+    }
+
+    Address m_local;                //!< the local address
+    std::array<Address, 3> m_peers; //!< the peer addresses
+    Ptr<Interface> m_interface;     //!< the incoming interface
+};
+
+template <typename Demux, typename Address, typename Interface>
+EndPointDemuxTestCase<Demux, Address, Interface>::EndPointDemuxTestCase(
+    const std::string& name,
+    Address local,
+    const std::array<Address, 3>& peers)
+    : TestCase(name),
+      m_local(local),
+      m_peers(peers)
+{
+}
+
+template <typename Demux, typename Address, typename Interface>
+void
+EndPointDemuxTestCase<Demux, Address, Interface>::DoRun()
+{
+    m_interface = CreateObject<Interface>();
+    Demux demux;
+
+    // a listening endpoint and two connections to it from the same peer
+    auto listener = demux.Allocate(nullptr, Address::GetAny(), 80);
+    auto conn1 = demux.Allocate(nullptr, m_local, 80, m_peers[0], 1000);
+    auto conn2 = demux.Allocate(nullptr, m_local, 80, m_peers[0], 1001);
+    NS_TEST_ASSERT_MSG_NE(conn1, nullptr, "Connection not allocated");
+    NS_TEST_ASSERT_MSG_NE(conn2, nullptr, "Connection not allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, m_local, 80, m_peers[0], 1000),
+                          nullptr,
+                          "Duplicated connection allocated");
+
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1000), conn1, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1001), conn2, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1002), listener, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[1], 1000), listener, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1000, 81), nullptr, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(m_local, 80, m_peers[0], 1001),
+                          conn2,
+                          "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, m_local, 80),
+                          nullptr,
+                          "Endpoint allocated on the local address and port of a connection");
+
+    // an ephemeral endpoint is indexed by peer once connected, and again if the
+    // peer changes
+    auto client = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Ephemeral endpoint not allocated");
+    auto port = client->GetLocalPort();
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port), true, "Local port not found");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[2], 80, port), client, "Wrong endpoint");
+    client->SetPeer(m_peers[1], 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[1], 80, port), client, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[2], 80, port), nullptr, "Wrong endpoint");
+    client->SetPeer(m_peers[2], 80);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[1], 80, port), nullptr, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[2], 80, port), client, "Wrong endpoint");
+    client->SetRxEnabled(false);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[2], 80, port), nullptr, "Wrong endpoint");
+    demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port), false, "Local port still found");
+
+    // deallocated connections are no longer found
+    demux.DeAllocate(conn1);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1000), listener, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1001), conn2, "Wrong endpoint");
+    demux.DeAllocate(conn2);
+    demux.DeAllocate(listener);
+    NS_TEST_EXPECT_MSG_EQ(Lookup(demux, m_peers[0], 1001), nullptr, "Wrong endpoint");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), false, "Local port still found");
+
+    m_interface = nullptr;
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief End point demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new EndPointDemuxTestCase<Ipv4EndPointDemux, Ipv4Address, Ipv4Interface>(
+                        "IPv4 endpoint lookup",
+                        Ipv4Address("10.0.0.1"),
+                        {Ipv4Address("10.0.0.2"),
+                         Ipv4Address("10.0.0.3"),
+                         Ipv4Address("10.0.0.4")}),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new EndPointDemuxTestCase<Ipv6EndPointDemux, Ipv6Address, Ipv6Interface>(
+                        "IPv6 endpoint lookup",
+                        Ipv6Address("2001::1"),
+                        {Ipv6Address("2001::2"),
+                         Ipv6Address("2001::3"),
+                         Ipv6Address("2001::4")}),
+                    TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,300 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Test program for the fluid model of the background traffic.
+//
+//   n0 ---- 100 Mbps ----+
+//                        n2 ---- 100 Mbps ---- n3
+//   n1 ----  10 Mbps ----+
+//
+// The background flows are sent from n0 and n1 to n3, along the routes
+// computed by Ipv4GlobalRouting.
+
+#include "ns3/data-rate.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-fluid-flow-manager.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Base class of the Ipv4FluidFlowManager tests, which builds the topology.
+ */
+class Ipv4FluidFlowManagerTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param name the name of the test case
+     */
+    Ipv4FluidFlowManagerTestCase(std::string name);
+
+  protected:
+    /**
+     * \brief Build the topology and the fluid flow manager.
+     */
+    void Setup();
+
+    /**
+     * \param device the device transmitting on a link
+     * \return the data rate of the device, in Mbps
+     */
+    static double GetDataRate(Ptr<NetDevice> device);
+
+    NodeContainer m_nodes;               //!< The nodes
+    NetDeviceContainer m_n0n2;           //!< The devices of the link between n0 and n2
+    NetDeviceContainer m_n1n2;           //!< The devices of the link between n1 and n2
+    NetDeviceContainer m_n2n3;           //!< The devices of the link between n2 and n3
+    Ipv4Address m_n3Address;             //!< The address of n3
+    Ptr<Ipv4FluidFlowManager> m_manager; //!< The fluid flow manager
+};
+
+Ipv4FluidFlowManagerTestCase::Ipv4FluidFlowManagerTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+Ipv4FluidFlowManagerTestCase::Setup()
+{
+    m_nodes.Create(4);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    simpleHelper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Mbps")));
+    m_n0n2 = simpleHelper.Install(NodeContainer(m_nodes.Get(0), m_nodes.Get(2)),
+                                  CreateObject<SimpleChannel>());
+    m_n2n3 = simpleHelper.Install(NodeContainer(m_nodes.Get(2), m_nodes.Get(3)),
+                                  CreateObject<SimpleChannel>());
+    simpleHelper.SetDeviceAttribute("DataRate", DataRateValue(DataRate("10Mbps")));
+    m_n1n2 = simpleHelper.Install(NodeContainer(m_nodes.Get(1), m_nodes.Get(2)),
+                                  CreateObject<SimpleChannel>());
+
+    InternetStackHelper internet;
+    internet.Install(m_nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.0");
+    address.Assign(m_n0n2);
+    address.SetBase("10.0.1.0", "255.255.255.0");
+    address.Assign(m_n1n2);
+    address.SetBase("10.0.2.0", "255.255.255.0");
+    m_n3Address = address.Assign(m_n2n3).GetAddress(1);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    m_manager = CreateObject<Ipv4FluidFlowManager>();
+}
+
+double
+Ipv4FluidFlowManagerTestCase::GetDataRate(Ptr<NetDevice> device)
+{
+    DataRateValue rate;
+    device->GetAttribute("DataRate", rate);
+    return rate.Get().GetBitRate() / 1e6;
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the max-min allocation of the rates, and the capacity left to
+ * the packet-level traffic.
+ */
+class Ipv4FluidFlowManagerAllocationTestCase : public Ipv4FluidFlowManagerTestCase
+{
+  public:
+    Ipv4FluidFlowManagerAllocationTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4FluidFlowManagerAllocationTestCase::Ipv4FluidFlowManagerAllocationTestCase()
+    : Ipv4FluidFlowManagerTestCase("Check the max-min allocation of the background flows")
+{
+}
+
+void
+Ipv4FluidFlowManagerAllocationTestCase::DoRun()
+{
+    Setup();
+    const double tolerance = 1e-3;
+
+    // The flow from n1 is bottlenecked by the 10 Mbps link, which it shares
+    // with a foreground flow; the flow from n0 gets the fair share of what is
+    // left on the link to n3
+    uint32_t flow0 = m_manager->AddFlow(m_nodes.Get(0), m_n3Address, 0);
+    uint32_t flow1 = m_manager->AddFlow(m_nodes.Get(1), m_n3Address, 0);
+    NS_TEST_EXPECT_MSG_EQ(m_manager->GetNFlows(), 2, "Unexpected number of flows");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_manager->GetFlowRate(flow1).GetBitRate() / 1e6,
+                              5,
+                              tolerance,
+                              "Unexpected rate of the flow from n1");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_manager->GetFlowRate(flow0).GetBitRate() / 1e6,
+                              47.5,
+                              tolerance,
+                              "Unexpected rate of the flow from n0");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_manager->GetLoad(m_n2n3.Get(0)).GetBitRate() / 1e6,
+                              52.5,
+                              tolerance,
+                              "Unexpected load of the link to n3");
+
+    // The packet-level traffic gets the capacity left
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n2n3.Get(0)),
+                              47.5,
+                              tolerance,
+                              "Unexpected capacity left on the link to n3");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n0n2.Get(0)),
+                              52.5,
+                              tolerance,
+                              "Unexpected capacity left on the link from n0");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n1n2.Get(0)),
+                              5,
+                              tolerance,
+                              "Unexpected capacity left on the link from n1");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n2n3.Get(1)),
+                              100,
+                              tolerance,
+                              "The reverse direction of the link to n3 is loaded");
+
+    // The capacity is given back when the flows are removed
+    m_manager->RemoveFlow(flow0);
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n0n2.Get(0)),
+                              100,
+                              tolerance,
+                              "The capacity of the link from n0 is not restored");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n2n3.Get(0)),
+                              95,
+                              tolerance,
+                              "Unexpected capacity left on the link to n3");
+    m_manager->RemoveFlow(flow1);
+    m_manager->RemoveFlow(flow1);
+    NS_TEST_EXPECT_MSG_EQ(m_manager->GetNFlows(), 0, "Unexpected number of flows");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n2n3.Get(0)),
+                              100,
+                              tolerance,
+                              "The capacity of the link to n3 is not restored");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n1n2.Get(0)),
+                              10,
+                              tolerance,
+                              "The capacity of the link from n1 is not restored");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the rates are reallocated at the arrivals and the
+ * departures of the flows, and the completion time of the flows.
+ */
+class Ipv4FluidFlowManagerDepartureTestCase : public Ipv4FluidFlowManagerTestCase
+{
+  public:
+    Ipv4FluidFlowManagerDepartureTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record the completion of a flow.
+     *
+     * \param flowId the identifier of the flow
+     * \param duration the time the flow took to transfer its bytes
+     */
+    void FlowCompleted(uint32_t flowId, Time duration);
+
+    std::map<uint32_t, Time> m_completed; //!< The duration of the completed flows
+};
+
+Ipv4FluidFlowManagerDepartureTestCase::Ipv4FluidFlowManagerDepartureTestCase()
+    : Ipv4FluidFlowManagerTestCase("Check the arrivals and the departures of the background flows")
+{
+}
+
+void
+Ipv4FluidFlowManagerDepartureTestCase::FlowCompleted(uint32_t flowId, Time duration)
+{
+    m_completed[flowId] = duration;
+}
+
+void
+Ipv4FluidFlowManagerDepartureTestCase::DoRun()
+{
+    Setup();
+    m_manager->TraceConnectWithoutContext(
+        "FlowCompleted",
+        MakeCallback(&Ipv4FluidFlowManagerDepartureTestCase::FlowCompleted, this));
+    const double tolerance = 1e-3;
+
+    // 10 Mbit from n0, at 50 Mbps alone, then at 47.5 Mbps when the unlimited
+    // flow from n1 arrives: 5 Mbit in 100 ms, then 5 Mbit in 105.263 ms
+    uint32_t flow0 = m_manager->AddFlow(m_nodes.Get(0), m_n3Address, 1250000);
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_manager->GetFlowRate(flow0).GetBitRate() / 1e6,
+                              50,
+                              tolerance,
+                              "Unexpected rate of the flow from n0 alone");
+    uint32_t flow1 = 0;
+    Simulator::Schedule(MilliSeconds(100), [&]() {
+        flow1 = m_manager->AddFlow(m_nodes.Get(1), m_n3Address, 0);
+        NS_TEST_EXPECT_MSG_EQ_TOL(m_manager->GetFlowRate(flow0).GetBitRate() / 1e6,
+                                  47.5,
+                                  tolerance,
+                                  "Unexpected rate of the flow from n0 with the flow from n1");
+    });
+    Simulator::Schedule(MilliSeconds(300), [&]() {
+        NS_TEST_EXPECT_MSG_EQ(m_manager->GetNFlows(), 1, "The flow from n0 did not depart");
+        NS_TEST_EXPECT_MSG_EQ(m_manager->GetFlowRate(flow0), DataRate(0), "Departed flow rate");
+        NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n2n3.Get(0)),
+                                  95,
+                                  tolerance,
+                                  "Unexpected capacity left on the link to n3");
+        NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n0n2.Get(0)),
+                                  100,
+                                  tolerance,
+                                  "The capacity of the link from n0 is not restored");
+        m_manager->RemoveFlow(flow1);
+    });
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_completed.size(), 1, "Unexpected number of completed flows");
+    NS_TEST_EXPECT_MSG_EQ(m_completed.count(flow0), 1, "The flow from n0 did not complete");
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_completed[flow0],
+                              MilliSeconds(100) + Seconds(5 / 47.5),
+                              MicroSeconds(1),
+                              "Unexpected completion time of the flow from n0");
+    NS_TEST_EXPECT_MSG_EQ(m_manager->GetNFlows(), 0, "Unexpected number of flows");
+    NS_TEST_EXPECT_MSG_EQ_TOL(GetDataRate(m_n2n3.Get(0)),
+                              100,
+                              tolerance,
+                              "The capacity of the link to n3 is not restored");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Ipv4FluidFlowManager TestSuite
+ */
+class Ipv4FluidFlowManagerTestSuite : public TestSuite
+{
+  public:
+    Ipv4FluidFlowManagerTestSuite();
+};
+
+Ipv4FluidFlowManagerTestSuite::Ipv4FluidFlowManagerTestSuite()
+    : TestSuite("ipv4-fluid-flow-manager", Type::UNIT)
+{
+    AddTestCase(new Ipv4FluidFlowManagerAllocationTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4FluidFlowManagerDepartureTestCase(), TestCase::Duration::QUICK);
+}
+
+static Ipv4FluidFlowManagerTestSuite g_ipv4FluidFlowManagerTestSuite; //!< Static variable for test initialization
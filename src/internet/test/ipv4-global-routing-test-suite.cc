@@ -5,6 +5,9 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/global-route-manager-impl.h"
+#include "ns3/global-route-manager.h"
+#include "ns3/global-router-interface.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -12,6 +15,7 @@
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-packet-info-tag.h"
+#include "ns3/ipv4-route.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
@@ -23,6 +27,7 @@
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simple-net-device.h"
+#include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/string.h"
@@ -30,6 +35,10 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -1300,6 +1309,458 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the routes computed by GlobalRouteManagerImpl::InitializeRoutes,
+ * serially and with several threads, are the same, and are in the same order, as the
+ * routes computed by the SPFVertex based SPF calculation.
+ *
+ * The topology is a 4x4 grid of routers connected by point-to-point links (hence with
+ * equal cost paths), a router connected to two routers of the grid by point-to-point
+ * links with different metrics, a LAN attached to the corner of the grid opposite to
+ * them and two other routers, a host attached to the LAN and a host attached to a router
+ * of the grid by a point-to-point link. A router of the grid injects an AS external route.
+ */
+class Ipv4GlobalRoutingSpfTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingSpfTestCase();
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * \param name the name of the test case
+     */
+    Ipv4GlobalRoutingSpfTestCase(const std::string& name);
+
+    void DoSetup() override;
+
+    /**
+     * Create the topology, with the given nodes attached to the LAN.
+     *
+     * \param lanNodes the nodes attached to the LAN
+     */
+    void CreateTopology(const std::vector<uint32_t>& lanNodes);
+
+    /**
+     * \returns the routes of all the nodes, one string per node
+     */
+    std::vector<std::string> GetRoutes() const;
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4GlobalRoutingSpfTestCase::Ipv4GlobalRoutingSpfTestCase()
+    : Ipv4GlobalRoutingSpfTestCase("Global routing SPF calculation on the graph of the LSDB")
+{
+}
+
+Ipv4GlobalRoutingSpfTestCase::Ipv4GlobalRoutingSpfTestCase(const std::string& name)
+    : TestCase(name)
+{
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::DoSetup()
+{
+    CreateTopology({15, 17, 18, 19});
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::CreateTopology(const std::vector<uint32_t>& lanNodes)
+{
+    // nodes 0-15: grid, 16: extra router, 17-18: LAN routers, 19: LAN host, 20: p2p host
+    m_nodes.Create(21);
+
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    SimpleNetDeviceHelper p2pHelper;
+    p2pHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.0.0", "255.255.255.252");
+    auto connect = [&](uint32_t a, uint32_t b, uint16_t metric) {
+        NetDeviceContainer net = p2pHelper.Install(m_nodes.Get(a), CreateObject<SimpleChannel>());
+        net.Add(p2pHelper.Install(m_nodes.Get(b), DynamicCast<SimpleChannel>(
+                                                      net.Get(0)->GetChannel())));
+        Ipv4InterfaceContainer interfaces = ipv4.Assign(net);
+        interfaces.Get(0).first->SetMetric(interfaces.Get(0).second, metric);
+        interfaces.Get(1).first->SetMetric(interfaces.Get(1).second, metric);
+        ipv4.NewNetwork();
+    };
+    for (uint32_t row = 0; row < 4; row++)
+    {
+        for (uint32_t col = 0; col < 4; col++)
+        {
+            if (col < 3)
+            {
+                connect(row * 4 + col, row * 4 + col + 1, 1);
+            }
+            if (row < 3)
+            {
+                connect(row * 4 + col, (row + 1) * 4 + col, 1);
+            }
+        }
+    }
+    connect(0, 16, 3);
+    connect(16, 5, 1);
+    connect(6, 20, 1);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+    SimpleNetDeviceHelper lanHelper;
+    NetDeviceContainer lan;
+    for (uint32_t i : lanNodes)
+    {
+        lan.Add(lanHelper.Install(m_nodes.Get(i), channel));
+    }
+    ipv4.SetBase("10.2.0.0", "255.255.255.0");
+    ipv4.Assign(lan);
+
+    m_nodes.Get(9)->GetObject<GlobalRouter>()->InjectRoute("192.168.0.0", "255.255.0.0");
+}
+
+std::vector<std::string>
+Ipv4GlobalRoutingSpfTestCase::GetRoutes() const
+{
+    std::vector<std::string> routes;
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> gr =
+            m_nodes.Get(i)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        std::ostringstream oss;
+        for (uint32_t j = 0; j < gr->GetNRoutes(); j++)
+        {
+            oss << *gr->GetRoute(j) << std::endl;
+        }
+        routes.push_back(oss.str());
+    }
+    return routes;
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::DoRun()
+{
+    // Routes computed by the SPFVertex based SPF calculation
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    auto impl = SimulationSingleton<GlobalRouteManagerImpl>::Get();
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        impl->DebugSPFCalculate(m_nodes.Get(i)->GetObject<GlobalRouter>()->GetRouterId());
+    }
+    auto expected = GetRoutes();
+    NS_TEST_ASSERT_MSG_EQ(expected[15].empty(), false, "Expected routes on node 15");
+    NS_TEST_ASSERT_MSG_EQ(expected[17].empty(), false, "Expected routes on node 17");
+    NS_TEST_ASSERT_MSG_EQ(expected[20].empty(), false, "Expected a default route on node 20");
+
+    for (uint32_t nThreads : {1, 4})
+    {
+        Config::SetGlobal("GlobalRoutingThreads", UintegerValue(nThreads));
+        GlobalRouteManager::DeleteGlobalRoutes();
+        GlobalRouteManager::BuildGlobalRoutingDatabase();
+        GlobalRouteManager::InitializeRoutes();
+        auto routes = GetRoutes();
+        for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(routes[i],
+                                  expected[i],
+                                  "Unexpected routes on node " << i << " with " << nThreads
+                                                               << " threads");
+        }
+    }
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(1));
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the routes updated by GlobalRouteManager::UpdateGlobalRoutes after a
+ * change of the topology are the same, and are in the same order, as the routes computed
+ * from scratch, and that the SPF calculation is run again only for the routers whose
+ * shortest path tree is affected by the change.
+ *
+ * The topology is the one of Ipv4GlobalRoutingSpfTestCase, with the LAN detached from
+ * the grid, so that the changes of the LAN do not affect the routers of the grid. The
+ * changes bring point-to-point and LAN interfaces down and up, remove an address and
+ * inject an AS external route.
+ */
+class Ipv4GlobalRoutingUpdateTestCase : public Ipv4GlobalRoutingSpfTestCase
+{
+  public:
+    Ipv4GlobalRoutingUpdateTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+};
+
+Ipv4GlobalRoutingUpdateTestCase::Ipv4GlobalRoutingUpdateTestCase()
+    : Ipv4GlobalRoutingSpfTestCase("Global routing update after topology changes")
+{
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoSetup()
+{
+    CreateTopology({17, 18, 19});
+}
+
+void
+Ipv4GlobalRoutingUpdateTestCase::DoRun()
+{
+    /// A change of the topology
+    struct Change
+    {
+        std::string description;       //!< the description of the change
+        std::function<void()> apply;   //!< the function applying the change
+        std::set<uint32_t> calculated; //!< the nodes whose SPF calculation must be run again
+        std::set<uint32_t> unaffected; //!< the nodes whose routes must not be updated
+    };
+
+    auto ipv4 = [this](uint32_t node) { return m_nodes.Get(node)->GetObject<Ipv4>(); };
+    auto gr = [this](uint32_t node) {
+        return m_nodes.Get(node)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+    };
+    const std::vector<Change> changes{
+        {"p2p link between nodes 0 and 16 down",
+         [&]() {
+             ipv4(0)->SetDown(3);
+             ipv4(16)->SetDown(1);
+         },
+         {0, 16},
+         {17, 18, 19}},
+        {"p2p link between nodes 0 and 16 up",
+         [&]() {
+             ipv4(0)->SetUp(3);
+             ipv4(16)->SetUp(1);
+         },
+         {0, 16},
+         {17, 18, 19}},
+        {"p2p interface of node 5 down",
+         [&]() { ipv4(5)->SetDown(3); },
+         {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20},
+         {17, 18, 19}},
+        {"p2p interface of node 6 down", [&]() { ipv4(6)->SetDown(2); }, {6, 20}, {17, 18, 19}},
+        {"LAN interface of node 17 down",
+         [&]() { ipv4(17)->SetDown(1); },
+         {17, 18, 19},
+         {0, 5, 15, 20}},
+        {"AS external route injected by node 3",
+         [&]() {
+             m_nodes.Get(3)->GetObject<GlobalRouter>()->InjectRoute("172.16.0.0",
+                                                                    "255.255.0.0");
+         },
+         {},
+         {18, 19}},
+        {"p2p interfaces of nodes 5 and 6 up",
+         [&]() {
+             ipv4(5)->SetUp(3);
+             ipv4(6)->SetUp(2);
+         },
+         {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20},
+         {18, 19}},
+        {"p2p interface of node 20 down",
+         [&]() { ipv4(20)->SetDown(1); },
+         {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20},
+         {18, 19}},
+        {"LAN interface of node 17 and p2p interface of node 20 up",
+         [&]() {
+             ipv4(17)->SetUp(1);
+             ipv4(20)->SetUp(1);
+         },
+         {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20},
+         {}},
+        {"address of node 0 towards node 16 changed",
+         [&]() {
+             ipv4(0)->AddAddress(3, Ipv4InterfaceAddress("10.3.0.1", "255.255.255.252"));
+             ipv4(0)->RemoveAddress(3, 0);
+         },
+         {0, 16},
+         {17, 18, 19}},
+    };
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    for (const auto& change : changes)
+    {
+        // the routes of the unaffected nodes must be the same objects after the update
+        std::map<uint32_t, Ipv4RoutingTableEntry*> firstRoutes;
+        for (const auto i : change.unaffected)
+        {
+            NS_TEST_ASSERT_MSG_GT(gr(i)->GetNRoutes(), 0, "Expected routes on node " << i);
+            firstRoutes[i] = gr(i)->GetRoute(0);
+        }
+
+        change.apply();
+        GlobalRouteManager::UpdateGlobalRoutes();
+        auto routes = GetRoutes();
+        for (const auto& [i, route] : firstRoutes)
+        {
+            NS_TEST_EXPECT_MSG_EQ(gr(i)->GetRoute(0),
+                                  route,
+                                  "Routes of node " << i << " updated after: "
+                                                    << change.description);
+        }
+        const auto& calculated =
+            SimulationSingleton<GlobalRouteManagerImpl>::Get()->DebugGetCalculatedRouters();
+        for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(calculated.count(i),
+                                  change.calculated.count(i),
+                                  "Unexpected SPF calculation of node " << i << " after: "
+                                                                        << change.description);
+        }
+
+        GlobalRouteManager::DeleteGlobalRoutes();
+        GlobalRouteManager::BuildGlobalRoutingDatabase();
+        GlobalRouteManager::InitializeRoutes();
+        auto expected = GetRoutes();
+
+        for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(routes[i],
+                                  expected[i],
+                                  "Unexpected routes on node " << i
+                                                               << " after: " << change.description);
+        }
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check that the routes computed on demand (see the GlobalRoutingOnDemand global
+ * value) in the topology of Ipv4GlobalRoutingSpfTestCase select the same route as the
+ * routes computed in advance, with tree and route caches small enough to evict entries.
+ */
+class Ipv4GlobalRoutingOnDemandTestCase : public Ipv4GlobalRoutingSpfTestCase
+{
+  public:
+    Ipv4GlobalRoutingOnDemandTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \returns the route selected by each node towards each destination, without and
+     * with an output device, one string per node
+     */
+    std::vector<std::string> LookupRoutes() const;
+};
+
+Ipv4GlobalRoutingOnDemandTestCase::Ipv4GlobalRoutingOnDemandTestCase()
+    : Ipv4GlobalRoutingSpfTestCase("Global routes computed on demand")
+{
+}
+
+std::vector<std::string>
+Ipv4GlobalRoutingOnDemandTestCase::LookupRoutes() const
+{
+    // the addresses of all the interfaces, an AS external destination and an unknown one
+    std::vector<Ipv4Address> destinations{"192.168.1.1", "172.16.0.1"};
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4> ipv4 = m_nodes.Get(i)->GetObject<Ipv4>();
+        for (uint32_t j = 1; j < ipv4->GetNInterfaces(); j++)
+        {
+            destinations.push_back(ipv4->GetAddress(j, 0).GetLocal());
+        }
+    }
+
+    std::vector<std::string> routes;
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> gr =
+            m_nodes.Get(i)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        std::ostringstream oss;
+        for (const auto& dest : destinations)
+        {
+            for (Ptr<NetDevice> oif : {Ptr<NetDevice>(), m_nodes.Get(i)->GetDevice(1)})
+            {
+                Ipv4Header header;
+                header.SetDestination(dest);
+                Socket::SocketErrno sockerr;
+                Ptr<Ipv4Route> route = gr->RouteOutput(Create<Packet>(), header, oif, sockerr);
+                oss << dest << ": ";
+                if (route)
+                {
+                    oss << route->GetGateway() << " " << route->GetSource() << " "
+                        << route->GetOutputDevice()->GetIfIndex();
+                }
+                oss << std::endl;
+            }
+        }
+        routes.push_back(oss.str());
+    }
+    return routes;
+}
+
+void
+Ipv4GlobalRoutingOnDemandTestCase::DoRun()
+{
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    auto expected = LookupRoutes();
+
+    Config::SetGlobal("GlobalRoutingOnDemand", BooleanValue(true));
+    Config::SetGlobal("GlobalRoutingTreeCacheSize", UintegerValue(2));
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        m_nodes.Get(i)->GetObject<GlobalRouter>()->GetRoutingProtocol()->SetAttribute(
+            "RouteCacheSize",
+            UintegerValue(8));
+    }
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+
+    auto gr = [this](uint32_t node) {
+        return m_nodes.Get(node)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+    };
+    NS_TEST_ASSERT_MSG_EQ(gr(0)->GetNRoutes(), 0, "No route expected in the table of node 0");
+    NS_TEST_ASSERT_MSG_EQ(gr(20)->GetNRoutes(), 1, "Expected a default route on node 20");
+
+    // the second pass looks up the destinations whose routes have been evicted again
+    for (uint32_t pass = 0; pass < 2; pass++)
+    {
+        auto routes = LookupRoutes();
+        for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(routes[i],
+                                  expected[i],
+                                  "Unexpected routes on node " << i << " in pass " << pass);
+        }
+    }
+
+    // the routes are computed again on demand after a change of the topology
+    m_nodes.Get(5)->GetObject<Ipv4>()->SetDown(3);
+    GlobalRouteManager::UpdateGlobalRoutes();
+    auto routes = LookupRoutes();
+    Config::SetGlobal("GlobalRoutingOnDemand", BooleanValue(false));
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    expected = LookupRoutes();
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(routes[i],
+                              expected[i],
+                              "Unexpected routes on node " << i << " after the update");
+    }
+    Config::SetGlobal("GlobalRoutingTreeCacheSize", UintegerValue(16));
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -1322,6 +1783,9 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingSpfTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingUpdateTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingOnDemandTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
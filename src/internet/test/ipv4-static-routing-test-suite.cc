@@ -9,6 +9,8 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
@@ -196,6 +198,113 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 StaticRouting route selection Test
+ *
+ * Checks that the route selected for a destination is the route with the longest
+ * matching prefix and, among those, the first host route or the last network route
+ * with the lowest metric, also after routes are removed from the routing table.
+ */
+class Ipv4StaticRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the gateway of the route selected for a destination.
+     *
+     * \param dest the destination
+     * \param oif the output device requested, if any
+     * \param gateway the expected gateway
+     */
+    void CheckGateway(Ipv4Address dest, Ptr<NetDevice> oif, Ipv4Address gateway);
+
+    Ptr<Ipv4StaticRouting> m_routing; //!< the static routing protocol under test
+};
+
+Ipv4StaticRoutingLookupTestCase::Ipv4StaticRoutingLookupTestCase()
+    : TestCase("Selection of the static route to a destination")
+{
+}
+
+void
+Ipv4StaticRoutingLookupTestCase::CheckGateway(Ipv4Address dest,
+                                              Ptr<NetDevice> oif,
+                                              Ipv4Address gateway)
+{
+    Ipv4Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = m_routing->RouteOutput(nullptr, header, oif, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route to " << dest);
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(), gateway, "Unexpected route to " << dest);
+}
+
+void
+Ipv4StaticRoutingLookupTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    NodeContainer nodes(node, CreateObject<Node>());
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    NetDeviceContainer devices1 = devHelper.Install(nodes);
+    NetDeviceContainer devices2 = devHelper.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.1.0", "255.255.255.0");
+    ipv4.Assign(devices1);
+    ipv4.SetBase("10.0.2.0", "255.255.255.0");
+    ipv4.Assign(devices2);
+
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    m_routing = ipv4RoutingHelper.GetStaticRouting(node->GetObject<Ipv4>());
+    m_routing->SetDefaultRoute(Ipv4Address("10.0.1.10"), 1);
+    m_routing->AddNetworkRouteTo("192.168.0.0", "255.255.0.0", "10.0.1.20", 1, 5);
+    m_routing->AddNetworkRouteTo("192.168.0.0", "255.255.0.0", "10.0.2.20", 2, 5);
+    m_routing->AddNetworkRouteTo("192.168.1.0", "255.255.255.0", "10.0.1.30", 1, 10);
+    m_routing->AddNetworkRouteTo("192.168.1.0", "255.255.255.0", "10.0.2.30", 2, 1);
+    m_routing->AddHostRouteTo("192.168.2.1", "10.0.1.40", 1, 7);
+    m_routing->AddHostRouteTo("192.168.2.1", "10.0.2.40", 2, 1);
+
+    // a route already in the routing table is not added again
+    uint32_t nRoutes = m_routing->GetNRoutes();
+    m_routing->AddNetworkRouteTo("192.168.0.0", "255.255.0.0", "10.0.2.20", 2, 5);
+    NS_TEST_EXPECT_MSG_EQ(m_routing->GetNRoutes(), nRoutes, "Duplicate route added");
+
+    CheckGateway("172.16.0.1", nullptr, "10.0.1.10");
+    CheckGateway("192.168.3.1", nullptr, "10.0.2.20");
+    CheckGateway("192.168.1.1", nullptr, "10.0.2.30");
+    CheckGateway("192.168.1.1", devices1.Get(0), "10.0.1.30");
+    CheckGateway("192.168.2.1", nullptr, "10.0.1.40");
+    CheckGateway("192.168.2.1", devices2.Get(0), "10.0.2.40");
+    CheckGateway("10.0.2.1", nullptr, "0.0.0.0");
+
+    for (uint32_t i = m_routing->GetNRoutes(); i-- > 0;)
+    {
+        if (m_routing->GetRoute(i).GetGateway() == Ipv4Address("10.0.2.30") ||
+            m_routing->GetRoute(i).GetGateway() == Ipv4Address("10.0.1.40"))
+        {
+            m_routing->RemoveRoute(i);
+        }
+    }
+    CheckGateway("192.168.1.1", nullptr, "10.0.1.30");
+    CheckGateway("192.168.2.1", nullptr, "10.0.2.40");
+
+    // the routes through an interface are removed when the interface goes down
+    node->GetObject<Ipv4>()->SetDown(2);
+    CheckGateway("192.168.3.1", nullptr, "10.0.1.20");
+    CheckGateway("192.168.2.1", nullptr, "10.0.1.20");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  *
@@ -211,6 +320,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", Type::UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingLookupTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
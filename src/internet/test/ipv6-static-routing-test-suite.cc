@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Tests for Ipv6 static routing
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv6 StaticRouting route selection Test
+ *
+ * Checks that the route selected for a destination is the route with the longest
+ * matching prefix and, among those, the first host route or the last network route
+ * with the lowest metric, also after routes are removed from the routing table.
+ */
+class Ipv6StaticRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv6StaticRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the gateway of the route selected for a destination.
+     *
+     * \param dest the destination
+     * \param oif the output device requested, if any
+     * \param gateway the expected gateway
+     */
+    void CheckGateway(Ipv6Address dest, Ptr<NetDevice> oif, Ipv6Address gateway);
+
+    Ptr<Ipv6StaticRouting> m_routing; //!< the static routing protocol under test
+};
+
+Ipv6StaticRoutingLookupTestCase::Ipv6StaticRoutingLookupTestCase()
+    : TestCase("Selection of the static route to a destination")
+{
+}
+
+void
+Ipv6StaticRoutingLookupTestCase::CheckGateway(Ipv6Address dest,
+                                              Ptr<NetDevice> oif,
+                                              Ipv6Address gateway)
+{
+    Ipv6Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv6Route> route = m_routing->RouteOutput(nullptr, header, oif, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route to " << dest);
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(), gateway, "Unexpected route to " << dest);
+}
+
+void
+Ipv6StaticRoutingLookupTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    NodeContainer nodes(node, CreateObject<Node>());
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    NetDeviceContainer devices1 = devHelper.Install(nodes);
+    NetDeviceContainer devices2 = devHelper.Install(nodes);
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:1::"), Ipv6Prefix(64));
+    ipv6.Assign(devices1);
+    ipv6.SetBase(Ipv6Address("2001:2::"), Ipv6Prefix(64));
+    ipv6.Assign(devices2);
+
+    Ipv6StaticRoutingHelper ipv6RoutingHelper;
+    m_routing = ipv6RoutingHelper.GetStaticRouting(node->GetObject<Ipv6>());
+    m_routing->SetDefaultRoute("fe80::10", 1);
+    m_routing->AddNetworkRouteTo("2001:db8::", Ipv6Prefix(32), "fe80::20", 1, 5);
+    m_routing->AddNetworkRouteTo("2001:db8::", Ipv6Prefix(32), "fe80::21", 2, 5);
+    m_routing->AddNetworkRouteTo("2001:db8:1::", Ipv6Prefix(48), "fe80::30", 1, 10);
+    m_routing->AddNetworkRouteTo("2001:db8:1::", Ipv6Prefix(48), "fe80::31", 2, 1);
+    m_routing->AddHostRouteTo("2001:db8:2::1", "fe80::40", 1, Ipv6Address("::"), 7);
+    m_routing->AddHostRouteTo("2001:db8:2::1", "fe80::41", 2, Ipv6Address("::"), 1);
+
+    // a route already in the routing table is not added again
+    uint32_t nRoutes = m_routing->GetNRoutes();
+    m_routing->AddNetworkRouteTo("2001:db8::", Ipv6Prefix(32), "fe80::21", 2, 5);
+    NS_TEST_EXPECT_MSG_EQ(m_routing->GetNRoutes(), nRoutes, "Duplicate route added");
+
+    CheckGateway("2001:cafe::1", nullptr, "fe80::10");
+    CheckGateway("2001:db8:3::1", nullptr, "fe80::21");
+    CheckGateway("2001:db8:1::1", nullptr, "fe80::31");
+    CheckGateway("2001:db8:1::1", devices1.Get(0), "fe80::30");
+    CheckGateway("2001:db8:2::1", nullptr, "fe80::40");
+    CheckGateway("2001:db8:2::1", devices2.Get(0), "fe80::41");
+    CheckGateway("2001:2::1", nullptr, "::");
+
+    for (uint32_t i = m_routing->GetNRoutes(); i-- > 0;)
+    {
+        if (m_routing->GetRoute(i).GetGateway() == Ipv6Address("fe80::31") ||
+            m_routing->GetRoute(i).GetGateway() == Ipv6Address("fe80::40"))
+        {
+            m_routing->RemoveRoute(i);
+        }
+    }
+    CheckGateway("2001:db8:1::1", nullptr, "fe80::30");
+    CheckGateway("2001:db8:2::1", nullptr, "fe80::41");
+
+    // the routes through an interface are removed when the interface goes down
+    node->GetObject<Ipv6>()->SetDown(2);
+    CheckGateway("2001:db8:3::1", nullptr, "fe80::20");
+    CheckGateway("2001:db8:2::1", nullptr, "fe80::20");
+
+    m_routing = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv6 StaticRouting TestSuite
+ */
+class Ipv6StaticRoutingTestSuite : public TestSuite
+{
+  public:
+    Ipv6StaticRoutingTestSuite();
+};
+
+Ipv6StaticRoutingTestSuite::Ipv6StaticRoutingTestSuite()
+    : TestSuite("ipv6-static-routing", Type::UNIT)
+{
+    AddTestCase(new Ipv6StaticRoutingLookupTestCase, TestCase::Duration::QUICK);
+}
+
+static Ipv6StaticRoutingTestSuite
+    ipv6StaticRoutingTestSuite; //!< Static variable for test initialization
@@ -8,6 +8,8 @@
 #include "ns3/tcp-rx-buffer.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("TcpRxBufferTestSuite");
@@ -31,6 +33,11 @@ class TcpRxBufferTestCase : public TestCase
      * \brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * \brief Test the coalescing of the segments received out of order.
+     */
+    void TestCoalescing();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -42,6 +49,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestCoalescing();
 }
 
 void
@@ -277,6 +285,88 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestCoalescing()
+{
+    const uint32_t segmentSize = 100;
+    const uint32_t nSegments = 1000;
+    const SequenceNumber32 head(1);
+    std::vector<uint8_t> data(segmentSize * nSegments);
+    for (uint32_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i % 251);
+    }
+    TcpRxBuffer rxBuf;
+    rxBuf.SetMaxBufferSize(data.size());
+    rxBuf.SetNextRxSequence(head);
+    auto addBytes = [&](uint32_t offset, uint32_t size) {
+        TcpHeader h;
+        h.SetSequenceNumber(head + SequenceNumber32(offset));
+        return rxBuf.Add(Create<Packet>(data.data() + offset, size), h);
+    };
+
+    // The odd segments are received first
+    for (uint32_t i = 1; i < nSegments; i += 2)
+    {
+        addBytes(i * segmentSize, segmentSize);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), data.size() / 2, "Wrong buffer occupancy");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "No data should be available");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 4, "SACK list should contain four elements");
+    auto block = rxBuf.GetSackList().front();
+    NS_TEST_ASSERT_MSG_EQ(block.first,
+                          head + SequenceNumber32((nSegments - 1) * segmentSize),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(block.second,
+                          head + SequenceNumber32(nSegments * segmentSize),
+                          "SACK block different than expected");
+
+    // Bytes overlapping two received segments and the hole between them fill the hole
+    NS_TEST_ASSERT_MSG_EQ(addBytes(3 * segmentSize + 50, 2 * segmentSize),
+                          true,
+                          "The hole should be filled");
+    block = rxBuf.GetSackList().front();
+    NS_TEST_ASSERT_MSG_EQ(block.first,
+                          head + SequenceNumber32(3 * segmentSize),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(block.second,
+                          head + SequenceNumber32(6 * segmentSize),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(addBytes(3 * segmentSize, segmentSize),
+                          false,
+                          "Duplicate data should not be buffered");
+
+    // The even segments are received backwards, the first one last
+    for (uint32_t i = nSegments - 2; i > 0; i -= 2)
+    {
+        if (i != 4)
+        {
+            addBytes(i * segmentSize, segmentSize);
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "No data should be available");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 1, "SACK list should contain one element");
+    addBytes(0, segmentSize);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          head + SequenceNumber32(data.size()),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), data.size(), "All the data should be available");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "SACK list should contain no element");
+
+    // The data is extracted in order, in chunks unaligned with the segments
+    std::vector<uint8_t> extracted(data.size());
+    uint32_t offset = 0;
+    while (Ptr<Packet> p = rxBuf.Extract(3 * segmentSize + 7))
+    {
+        NS_TEST_ASSERT_MSG_EQ((p->GetSize() <= 3 * segmentSize + 7), true, "Too much data");
+        p->CopyData(extracted.data() + offset, p->GetSize());
+        offset += p->GetSize();
+    }
+    NS_TEST_ASSERT_MSG_EQ(offset, data.size(), "Wrong amount of data extracted");
+    NS_TEST_ASSERT_MSG_EQ((extracted == data), true, "Data extracted differs from the data sent");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "The buffer should be empty");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
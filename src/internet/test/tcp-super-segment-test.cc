@@ -0,0 +1,248 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ *
+ */
+
+#include "tcp-general-test.h"
+
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/super-segment-tag.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpSuperSegmentTest");
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the segments that TcpL4Protocol::Segment() creates out of a
+ * super-segment.
+ *
+ * Each segment must carry the payload that follows the payload of the
+ * previous one, a TCP header with the right sequence number and a valid
+ * checksum; the CWR flag must only be set on the first segment, and the FIN
+ * and PSH flags on the last one.
+ */
+class TcpSegmentTestCase : public TestCase
+{
+  public:
+    TcpSegmentTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TcpSegmentTestCase::TcpSegmentTestCase()
+    : TestCase("Check the segments of a super-segment")
+{
+}
+
+void
+TcpSegmentTestCase::DoRun()
+{
+    const uint32_t segmentSize = 1000;
+    const uint32_t payloadSize = 2500;
+    const Ipv4Address source("10.0.0.1");
+    const Ipv4Address destination("10.0.0.2");
+    const SequenceNumber32 seq(100);
+    Config::SetGlobal("ChecksumEnabled", BooleanValue(true));
+
+    Ptr<TcpL4Protocol> tcp = CreateObject<TcpL4Protocol>();
+
+    // a packet without the tag is returned as it is
+    Ptr<Packet> segment = Create<Packet>(segmentSize);
+    auto segments = tcp->Segment(segment, source, destination);
+    NS_TEST_ASSERT_MSG_EQ(segments.size(), 1, "A segment was split");
+    NS_TEST_ASSERT_MSG_EQ(segments.front(), segment, "A segment was modified");
+
+    std::vector<uint8_t> payload(payloadSize);
+    for (uint32_t i = 0; i < payloadSize; i++)
+    {
+        payload[i] = i % 256;
+    }
+    Ptr<Packet> superSegment = Create<Packet>(payload.data(), payloadSize);
+    TcpHeader header;
+    header.SetSourcePort(49153);
+    header.SetDestinationPort(50000);
+    header.SetSequenceNumber(seq);
+    header.SetAckNumber(SequenceNumber32(1));
+    header.SetFlags(TcpHeader::ACK | TcpHeader::PSH | TcpHeader::FIN | TcpHeader::CWR);
+    header.SetWindowSize(1000);
+    superSegment->AddHeader(header);
+    superSegment->AddPacketTag(SuperSegmentTag(segmentSize, payloadSize));
+
+    segments = tcp->Segment(superSegment, source, destination);
+    NS_TEST_ASSERT_MSG_EQ(segments.size(), 3, "Wrong number of segments");
+
+    uint32_t offset = 0;
+    for (const auto& p : segments)
+    {
+        SuperSegmentTag tag;
+        NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag), false, "A segment carries the tag");
+
+        TcpHeader segmentHeader;
+        segmentHeader.EnableChecksums();
+        segmentHeader.InitializeChecksum(source, destination, TcpL4Protocol::PROT_NUMBER);
+        p->RemoveHeader(segmentHeader);
+        NS_TEST_EXPECT_MSG_EQ(segmentHeader.IsChecksumOk(), true, "Wrong checksum");
+        NS_TEST_EXPECT_MSG_EQ(segmentHeader.GetSequenceNumber(),
+                              seq + offset,
+                              "Wrong sequence number");
+        NS_TEST_EXPECT_MSG_EQ(segmentHeader.GetSourcePort(), 49153, "Wrong source port");
+        NS_TEST_EXPECT_MSG_EQ(segmentHeader.GetDestinationPort(), 50000, "Wrong port");
+
+        const uint32_t size = std::min(segmentSize, payloadSize - offset);
+        NS_TEST_ASSERT_MSG_EQ(p->GetSize(), size, "Wrong segment size");
+        std::vector<uint8_t> buffer(size);
+        p->CopyData(buffer.data(), size);
+        NS_TEST_EXPECT_MSG_EQ((buffer == std::vector<uint8_t>(payload.begin() + offset,
+                                                               payload.begin() + offset + size)),
+                              true,
+                              "Wrong payload");
+
+        const uint8_t flags = segmentHeader.GetFlags();
+        const bool first = (offset == 0);
+        const bool last = (offset + size == payloadSize);
+        NS_TEST_EXPECT_MSG_EQ(((flags & TcpHeader::ACK) != 0), true, "ACK flag not set");
+        NS_TEST_EXPECT_MSG_EQ(((flags & TcpHeader::CWR) != 0), first, "Wrong CWR flag");
+        NS_TEST_EXPECT_MSG_EQ(((flags & TcpHeader::FIN) != 0), last, "Wrong FIN flag");
+        NS_TEST_EXPECT_MSG_EQ(((flags & TcpHeader::PSH) != 0), last, "Wrong PSH flag");
+        offset += size;
+    }
+
+    Config::SetGlobal("ChecksumEnabled", BooleanValue(false));
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check a transfer in super-segments over a device that does not
+ * support them.
+ *
+ * The sender socket sends super-segments, which the IP layer splits in the
+ * segments that the simple net device transmits. The receiver must get all
+ * the data, in segments no larger than the segment size, with valid checksums
+ * (otherwise TcpL4Protocol drops them).
+ */
+class TcpSuperSegmentTestCase : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param superSegmentSize the SuperSegmentSize attribute of the sender socket
+     */
+    TcpSuperSegmentTestCase(uint32_t superSegmentSize);
+
+  protected:
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint32_t m_superSegmentSize;    //!< The SuperSegmentSize attribute of the sender
+    uint32_t m_superSegmentsTx{0};  //!< The number of super-segments sent
+    uint32_t m_segmentsRx{0};       //!< The number of data segments received
+    uint32_t m_bytesRx{0};          //!< The number of bytes received
+    SequenceNumber32 m_nextRxSeq{}; //!< The sequence number of the next data segment
+};
+
+TcpSuperSegmentTestCase::TcpSuperSegmentTestCase(uint32_t superSegmentSize)
+    : TcpGeneralTest("Check a transfer in super-segments of " + std::to_string(superSegmentSize) +
+                     " segments over a simple net device"),
+      m_superSegmentSize(superSegmentSize)
+{
+}
+
+void
+TcpSuperSegmentTestCase::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktSize(5000);
+    SetAppPktCount(10);
+    Config::SetGlobal("ChecksumEnabled", BooleanValue(true));
+}
+
+void
+TcpSuperSegmentTestCase::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+    GetSenderSocket()->SetAttribute("SuperSegmentSize", UintegerValue(m_superSegmentSize));
+}
+
+void
+TcpSuperSegmentTestCase::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == SENDER && p->GetSize() > GetSegSize(SENDER))
+    {
+        m_superSegmentsTx++;
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(p->GetSize(),
+                                    m_superSegmentSize * GetSegSize(SENDER),
+                                    "The super-segment is too large");
+        NS_TEST_ASSERT_MSG_EQ(p->GetSize() % GetSegSize(SENDER),
+                              0,
+                              "The super-segment is not made of full segments");
+    }
+}
+
+void
+TcpSuperSegmentTestCase::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who != RECEIVER || p->GetSize() == 0)
+    {
+        return;
+    }
+    NS_TEST_ASSERT_MSG_LT_OR_EQ(p->GetSize(), GetSegSize(SENDER), "A super-segment was received");
+    if (m_segmentsRx > 0)
+    {
+        NS_TEST_ASSERT_MSG_EQ(h.GetSequenceNumber(), m_nextRxSeq, "Data received out of order");
+    }
+    m_segmentsRx++;
+    m_bytesRx += p->GetSize();
+    m_nextRxSeq = h.GetSequenceNumber() + p->GetSize();
+}
+
+void
+TcpSuperSegmentTestCase::FinalChecks()
+{
+    Config::SetGlobal("ChecksumEnabled", BooleanValue(false));
+    NS_TEST_ASSERT_MSG_EQ(m_bytesRx, GetPktSize() * GetPktCount(), "Data missing");
+    if (m_superSegmentSize > 1)
+    {
+        NS_TEST_ASSERT_MSG_GT(m_superSegmentsTx, 0, "No super-segment sent");
+        NS_TEST_ASSERT_MSG_GT(m_segmentsRx, m_superSegmentsTx, "Super-segments not split");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_superSegmentsTx, 0, "Super-segments sent while disabled");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TestSuite: TCP super-segments
+ */
+class TcpSuperSegmentTestSuite : public TestSuite
+{
+  public:
+    TcpSuperSegmentTestSuite()
+        : TestSuite("tcp-super-segment", Type::UNIT)
+    {
+        AddTestCase(new TcpSegmentTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new TcpSuperSegmentTestCase(1), TestCase::Duration::QUICK);
+        AddTestCase(new TcpSuperSegmentTestCase(4), TestCase::Duration::QUICK);
+        AddTestCase(new TcpSuperSegmentTestCase(16), TestCase::Duration::QUICK);
+    }
+};
+
+static TcpSuperSegmentTestSuite g_tcpSuperSegmentTestSuite; //!< Static variable for test init
@@ -42,6 +42,10 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard of a large window with many holes */
+    void TestLargeWindow();
+    /** \brief Test the split of super-segments reported in part by SACK blocks */
+    void TestSuperSegmentSack();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -89,6 +93,20 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for a large window:
+     *  -> one segment out of ten is lost, the others are sacked one by one
+     *  -> the lost segments are retransmitted in order, partially for the first one
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestLargeWindow, this);
+
+    /*
+     * Case for super-segments:
+     *  -> a SACK block reports the middle of a super-segment
+     *  -> a SACK block reports the beginning of another super-segment
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestSuperSegmentSack, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -409,6 +427,131 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestLargeWindow()
+{
+    const uint32_t segmentSize = 1000;
+    const uint32_t nSegments = 2000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetMaxBufferSize(nSegments * segmentSize);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    SequenceNumber32 head(1);
+    txBuf->SetHeadSequence(head);
+    auto segment = [&head, segmentSize](uint32_t i) { return head + i * segmentSize; };
+
+    txBuf->Add(Create<Packet>(nSegments * segmentSize));
+    for (uint32_t i = 0; i < nSegments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, segment(i));
+    }
+
+    // every tenth segment is lost, starting from the head; each received
+    // segment extends the SACK block of the segments received since the last hole
+    for (uint32_t i = 0; i < nSegments; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            continue;
+        }
+        TcpOptionSack::SackList sackList;
+        sackList.emplace_back(segment(i - i % 10 + 1), segment(i + 1));
+        NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sackList), segmentSize, "Segment not sacked");
+    }
+
+    const uint32_t nLost = nSegments / 10;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), (nSegments - nLost) * segmentSize, "Wrong sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), nLost * segmentSize, "Wrong lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 0, "Wrong bytes in flight");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(segment(nSegments - 10)), true, "Hole not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(segment(nSegments - 9)), false, "Sacked segment lost");
+
+    // retransmit the first half of the head, then all the holes in order
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No next segment");
+    NS_TEST_ASSERT_MSG_EQ(seq, head, "Wrong next segment");
+    txBuf->CopyFromSequence(segmentSize / 2, seq);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No next segment");
+    NS_TEST_ASSERT_MSG_EQ(seq, head + segmentSize / 2, "Wrong next segment");
+    txBuf->CopyFromSequence(segmentSize / 2, seq);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsRetransmittedDataAcked(segment(1)),
+                          true,
+                          "Retransmission not acked");
+    for (uint32_t i = 10; i < nSegments; i += 10)
+    {
+        NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No next segment");
+        NS_TEST_ASSERT_MSG_EQ(seq, segment(i), "Wrong next segment");
+        txBuf->CopyFromSequence(segmentSize, seq);
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), false, "Unexpected next segment");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(), nLost * segmentSize, "Wrong retransmits");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), nLost * segmentSize, "Wrong bytes in flight");
+
+    // the retransmissions are received
+    txBuf->DiscardUpTo(segment(nSegments));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 0, "Wrong sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 0, "Wrong lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(), 0, "Wrong retransmits");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 0, "Wrong bytes in flight");
+}
+
+void
+TcpTxBufferTestCase::TestSuperSegmentSack()
+{
+    const uint32_t segmentSize = 1000;
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    SequenceNumber32 head(1);
+    txBuf->SetHeadSequence(head);
+
+    // two super-segments of five segments each
+    txBuf->Add(Create<Packet>(10 * segmentSize));
+    txBuf->CopyFromSequence(5 * segmentSize, head);
+    txBuf->CopyFromSequence(5 * segmentSize, head + 5 * segmentSize);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 10 * segmentSize, "Wrong bytes in flight");
+
+    // the third and fourth segments of the first super-segment are sacked
+    TcpOptionSack::SackList sackList;
+    sackList.emplace_back(head + 2 * segmentSize, head + 4 * segmentSize);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sackList),
+                          2 * segmentSize,
+                          "Part of a super-segment not sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 2 * segmentSize, "Wrong sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head), false, "Head lost too early");
+
+    // the first three segments of the second super-segment are sacked
+    sackList.emplace_back(head + 5 * segmentSize, head + 8 * segmentSize);
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sackList),
+                          3 * segmentSize,
+                          "Part of a super-segment not sacked");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 5 * segmentSize, "Wrong sacked");
+
+    // the sacked segments are counted one by one, even if the second block is
+    // a single item of the sent list: the segments before the first block and
+    // the one between the blocks have three sacked segments above them, hence
+    // they are lost, the ones after the second block are not
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head), true, "Head not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + segmentSize), true, "Second segment not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + 4 * segmentSize),
+                          true,
+                          "Segment between the blocks not lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + 8 * segmentSize),
+                          false,
+                          "Segment after the blocks lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), 3 * segmentSize, "Wrong lost");
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(), 2 * segmentSize, "Wrong bytes in flight");
+
+    // the lost part of the first super-segment is retransmitted first
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    NS_TEST_ASSERT_MSG_EQ(txBuf->NextSeg(&seq, &seqHigh, true), true, "No next segment");
+    NS_TEST_ASSERT_MSG_EQ(seq, head, "Wrong next segment");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
@@ -199,6 +199,19 @@ AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode file
     return StreamWrapper;
 }
 
+Ptr<OutputStreamWrapper>
+AsciiTraceHelper::CreateBinaryFileStream(std::string filename, BinaryTraceFile::CaptureMode mode)
+{
+    NS_LOG_FUNCTION(filename << mode);
+
+    //
+    // The same ownership rules as for CreateFileStream apply: the binary trace
+    // file is flushed and closed when the last callback holding the wrapper is
+    // destroyed.
+    //
+    return Create<OutputStreamWrapper>(Create<BinaryTraceFile>(filename, mode));
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice(std::string prefix,
                                         Ptr<NetDevice> device,
@@ -303,6 +316,11 @@ AsciiTraceHelper::DefaultEnqueueSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::ENQUEUE, p);
+        return;
+    }
     *stream->GetStream() << "+ " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -312,6 +330,11 @@ AsciiTraceHelper::DefaultEnqueueSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::ENQUEUE, context, p);
+        return;
+    }
     *stream->GetStream() << "+ " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -333,6 +356,11 @@ AsciiTraceHelper::DefaultDropSinkWithoutContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::DROP, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -342,6 +370,11 @@ AsciiTraceHelper::DefaultDropSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                              Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::DROP, context, p);
+        return;
+    }
     *stream->GetStream() << "d " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -364,6 +397,11 @@ AsciiTraceHelper::DefaultDequeueSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::DEQUEUE, p);
+        return;
+    }
     *stream->GetStream() << "- " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -373,6 +411,11 @@ AsciiTraceHelper::DefaultDequeueSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::DEQUEUE, context, p);
+        return;
+    }
     *stream->GetStream() << "- " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
@@ -392,6 +435,11 @@ AsciiTraceHelper::DefaultReceiveSinkWithoutContext(Ptr<OutputStreamWrapper> stre
                                                    Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::RECEIVE, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << *p << std::endl;
 }
 
@@ -401,6 +449,11 @@ AsciiTraceHelper::DefaultReceiveSinkWithContext(Ptr<OutputStreamWrapper> stream,
                                                 Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(stream << p);
+    if (Ptr<BinaryTraceFile> file = stream->GetBinaryTraceFile())
+    {
+        file->Write(BinaryTraceFile::RECEIVE, context, p);
+        return;
+    }
     *stream->GetStream() << "r " << Simulator::Now().GetSeconds() << " " << context << " " << *p
                          << std::endl;
 }
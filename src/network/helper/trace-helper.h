@@ -11,6 +11,7 @@
 #include "node-container.h"
 
 #include "ns3/assert.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/pcap-file-wrapper.h"
 #include "ns3/simulator.h"
@@ -227,6 +228,30 @@ class AsciiTraceHelper
     Ptr<OutputStreamWrapper> CreateFileStream(std::string filename,
                                               std::ios::openmode filemode = std::ios::out);
 
+    /**
+     * @brief Create an output stream object which records the traced events
+     * in a compact binary trace file instead of printing them.
+     *
+     * The returned object can be passed wherever an output stream created by
+     * CreateFileStream is accepted by the default trace sinks, e.g., to
+     * AsciiTraceHelperForDevice::EnableAsciiAll.  Formatting a line of text
+     * (including the output of Packet::Print) for each event is by far the
+     * most expensive part of ASCII tracing; the binary trace file stores the
+     * time, node, device, event type, packet uid and size of each event in
+     * columns and, unless told otherwise, the serialized packet, so that the
+     * binary-trace-to-ascii program can reproduce the ASCII trace afterwards.
+     *
+     * The returned object has no std::ostream: it cannot be used by trace
+     * sinks other than the default ones.
+     *
+     * @param filename file name
+     * @param mode what is captured in addition to the fixed-size columns
+     * @returns a smart pointer to the output stream
+     */
+    Ptr<OutputStreamWrapper> CreateBinaryFileStream(
+        std::string filename,
+        BinaryTraceFile::CaptureMode mode = BinaryTraceFile::CAPTURE_PACKET);
+
     /**
      * @brief Hook a trace source to the default enqueue operation trace sink that
      * does not accept nor log a trace context.
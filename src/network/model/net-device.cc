@@ -29,4 +29,10 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+bool
+NetDevice::SupportsSuperSegments() const
+{
+    return false;
+}
+
 } // namespace ns3
@@ -356,6 +356,17 @@ class NetDevice : public Object
      * \return true if this interface supports a bridging mode, false otherwise.
      */
     virtual bool SupportsSendFrom() const = 0;
+
+    /**
+     * A super-segment (see SuperSegmentTag) stands for a number of segments
+     * sent back to back. The network layer hands the segments of a
+     * super-segment to the devices that do not support super-segments.
+     *
+     * \return true if this interface can send a super-segment as a single
+     *         packet, taking into account the headers of all its segments,
+     *         false otherwise.
+     */
+    virtual bool SupportsSuperSegments() const;
 };
 
 } // namespace ns3
@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/llc-snap-header.h"
+#include "ns3/log.h"
+#include "ns3/output-stream-wrapper.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/trace-helper.h"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceFileTestSuite");
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that events recorded by the default ASCII trace sinks in a
+ * binary trace file are read back unchanged and converted to the same text
+ * as the one produced by the ASCII trace sinks.
+ */
+class BinaryTraceFileTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param mode the capture mode
+     */
+    BinaryTraceFileTestCase(BinaryTraceFile::CaptureMode mode);
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Fire the default trace sinks for a packet, on both the text and the
+     * binary streams.
+     *
+     * \param size the payload size
+     */
+    void TraceEvents(uint32_t size);
+
+    BinaryTraceFile::CaptureMode m_mode; //!< capture mode
+    std::string m_filename;              //!< binary trace file name
+    std::ostringstream m_text;           //!< ASCII trace
+    Ptr<OutputStreamWrapper> m_ascii;    //!< ASCII stream
+    Ptr<OutputStreamWrapper> m_binary;   //!< binary stream
+    std::vector<Ptr<Packet>> m_packets;  //!< traced packets
+};
+
+BinaryTraceFileTestCase::BinaryTraceFileTestCase(BinaryTraceFile::CaptureMode mode)
+    : TestCase(std::string("Check binary trace files with capture mode ") +
+               (mode == BinaryTraceFile::CAPTURE_PACKET ? "CAPTURE_PACKET" : "CAPTURE_NONE")),
+      m_mode(mode)
+{
+}
+
+void
+BinaryTraceFileTestCase::DoSetup()
+{
+    m_filename = CreateTempDirFilename("binary-trace-file-test.btr");
+}
+
+void
+BinaryTraceFileTestCase::DoTeardown()
+{
+    if (std::remove(m_filename.c_str()))
+    {
+        NS_LOG_ERROR("Failed to delete file " << m_filename);
+    }
+}
+
+void
+BinaryTraceFileTestCase::TraceEvents(uint32_t size)
+{
+    Ptr<Packet> p = Create<Packet>(size);
+    LlcSnapHeader llc;
+    llc.SetType(0x0800);
+    p->AddHeader(llc);
+    m_packets.push_back(p);
+
+    std::string context = "/NodeList/" + std::to_string(size % 3) + "/DeviceList/" +
+                          std::to_string(size % 2) + "/TxQueue/Enqueue";
+
+    for (const auto& stream : {m_ascii, m_binary})
+    {
+        AsciiTraceHelper::DefaultEnqueueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDequeueSinkWithContext(stream, context, p);
+        AsciiTraceHelper::DefaultDropSinkWithoutContext(stream, p);
+        AsciiTraceHelper::DefaultReceiveSinkWithoutContext(stream, p);
+    }
+}
+
+void
+BinaryTraceFileTestCase::DoRun()
+{
+    Packet::EnablePrinting();
+
+    m_ascii = Create<OutputStreamWrapper>(&m_text);
+    Ptr<BinaryTraceFile> file = Create<BinaryTraceFile>(m_filename, m_mode, 3);
+    m_binary = Create<OutputStreamWrapper>(file);
+    NS_TEST_ASSERT_MSG_EQ(m_binary->GetBinaryTraceFile(), file, "Binary trace file not wrapped");
+
+    const uint32_t nPackets = 7;
+    for (uint32_t i = 0; i < nPackets; i++)
+    {
+        Simulator::Schedule(MilliSeconds(i * 7 + 1),
+                            &BinaryTraceFileTestCase::TraceEvents,
+                            this,
+                            100 + i);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(file->GetRecordCount(), 4 * nPackets, "Unexpected number of records");
+    file->Flush();
+
+    BinaryTraceFileReader reader(m_filename);
+    NS_TEST_ASSERT_MSG_EQ(reader.GetCaptureMode(), m_mode, "Unexpected capture mode");
+
+    std::ostringstream converted;
+    BinaryTraceFileReader::Record record;
+    uint32_t n = 0;
+    while (reader.Read(record))
+    {
+        const Ptr<Packet>& p = m_packets[n / 4];
+        NS_TEST_ASSERT_MSG_EQ(record.uid, p->GetUid(), "Unexpected packet uid");
+        NS_TEST_ASSERT_MSG_EQ(record.size, p->GetSize(), "Unexpected packet size");
+        NS_TEST_ASSERT_MSG_EQ(record.time, MilliSeconds((n / 4) * 7 + 1).GetSeconds(), "Time");
+        bool withContext = (n % 4) < 2;
+        if (withContext)
+        {
+            NS_TEST_ASSERT_MSG_EQ(record.node, (p->GetSize() - 8) % 3, "Unexpected node id");
+            NS_TEST_ASSERT_MSG_EQ(record.device, (p->GetSize() - 8) % 2, "Unexpected device id");
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(record.context,
+                                  BinaryTraceFile::NO_CONTEXT,
+                                  "Unexpected context");
+            NS_TEST_ASSERT_MSG_EQ(record.node, BinaryTraceFile::NO_ID, "Unexpected node id");
+        }
+        reader.PrintAscii(converted, record);
+        n++;
+    }
+    NS_TEST_ASSERT_MSG_EQ(n, 4 * nPackets, "Unexpected number of records read back");
+
+    if (m_mode == BinaryTraceFile::CAPTURE_PACKET)
+    {
+        NS_TEST_ASSERT_MSG_EQ(converted.str(),
+                              m_text.str(),
+                              "Converted trace differs from the ASCII trace");
+    }
+
+    m_ascii = nullptr;
+    m_binary = nullptr;
+    m_packets.clear();
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Binary trace file TestSuite
+ */
+class BinaryTraceFileTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceFileTestSuite();
+};
+
+BinaryTraceFileTestSuite::BinaryTraceFileTestSuite()
+    : TestSuite("binary-trace-file", Type::UNIT)
+{
+    AddTestCase(new BinaryTraceFileTestCase(BinaryTraceFile::CAPTURE_PACKET),
+                TestCase::Duration::QUICK);
+    AddTestCase(new BinaryTraceFileTestCase(BinaryTraceFile::CAPTURE_NONE),
+                TestCase::Duration::QUICK);
+}
+
+static BinaryTraceFileTestSuite g_binaryTraceTestSuite; //!< Static variable for test initialization
@@ -5,36 +5,63 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <list>
+
 using namespace ns3;
 
+namespace ns3
+{
+
+/// std::list container of packets, used to test a non-default DropTailQueue container
+using PacketList = std::list<Ptr<Packet>>;
+
+NS_OBJECT_TEMPLATE_CLASS_TWO_DEFINE(DropTailQueue, Packet, PacketList);
+
+} // namespace ns3
+
 /**
  * \ingroup network-test
  * \ingroup tests
  *
  * DropTailQueue unit tests.
+ *
+ * \tparam Container \explicit the container storing the queue items
  */
+template <typename Container>
 class DropTailQueueTestCase : public TestCase
 {
   public:
-    DropTailQueueTestCase();
+    /**
+     * Constructor
+     * \param name the name of the container
+     */
+    DropTailQueueTestCase(std::string name);
     void DoRun() override;
 };
 
-DropTailQueueTestCase::DropTailQueueTestCase()
-    : TestCase("Sanity check on the drop tail queue implementation")
+template <typename Container>
+DropTailQueueTestCase<Container>::DropTailQueueTestCase(std::string name)
+    : TestCase("Sanity check on the drop tail queue implementation using " + name)
 {
 }
 
+template <typename Container>
 void
-DropTailQueueTestCase::DoRun()
+DropTailQueueTestCase<Container>::DoRun()
 {
-    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    Ptr<DropTailQueue<Packet, Container>> queue =
+        CreateObject<DropTailQueue<Packet, Container>>();
     NS_TEST_EXPECT_MSG_EQ(queue->SetAttributeFailSafe("MaxSize", StringValue("3p")),
                           true,
                           "Verify that we can actually set the attribute");
+    NS_TEST_EXPECT_MSG_EQ(queue->GetInstanceTypeId().IsChildOf(Queue<Packet>::GetTypeId()),
+                          true,
+                          "A DropTailQueue<Packet> must be a Queue<Packet> whatever the container");
 
     Ptr<Packet> p1;
     Ptr<Packet> p2;
@@ -76,6 +103,84 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * RingBuffer unit tests: a random sequence of insertions and removals at
+ * both ends and in the middle is applied to a RingBuffer and to a std::list,
+ * whose contents are then compared.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Check that RingBuffer behaves like std::list")
+{
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    RingBuffer<Ptr<Packet>> ring(4);
+    std::list<Ptr<Packet>> list;
+    NS_TEST_EXPECT_MSG_EQ(ring.capacity(), 4, "Unexpected initial capacity");
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    for (uint32_t step = 0; step < 5000; step++)
+    {
+        std::size_t pos = rng->GetInteger(0, list.size());
+        switch (rng->GetInteger(0, 3))
+        {
+        case 0: {
+            Ptr<Packet> p = Create<Packet>(step);
+            auto it = ring.insert(ring.cbegin() + pos, p);
+            NS_TEST_EXPECT_MSG_EQ(*it, p, "Iterator returned by insert does not point to item");
+            list.insert(std::next(list.cbegin(), pos), p);
+            break;
+        }
+        case 1: {
+            Ptr<Packet> p = Create<Packet>(step);
+            ring.push_back(p);
+            list.push_back(p);
+            break;
+        }
+        case 2:
+            if (pos < list.size())
+            {
+                auto it = ring.erase(ring.cbegin() + pos);
+                auto listIt = list.erase(std::next(list.cbegin(), pos));
+                NS_TEST_EXPECT_MSG_EQ((it == ring.end()),
+                                      (listIt == list.end()),
+                                      "Unexpected iterator returned by erase");
+            }
+            break;
+        default:
+            if (!list.empty())
+            {
+                NS_TEST_EXPECT_MSG_EQ(ring.front(), list.front(), "Unexpected front item");
+                ring.pop_front();
+                list.pop_front();
+            }
+            break;
+        }
+
+        NS_TEST_ASSERT_MSG_EQ(ring.size(), list.size(), "Unexpected size");
+        NS_TEST_ASSERT_MSG_EQ(std::equal(ring.begin(), ring.end(), list.begin()),
+                              true,
+                              "Unexpected content at step " << step);
+    }
+
+    ring.clear();
+    NS_TEST_EXPECT_MSG_EQ(ring.empty(), true, "The ring buffer should be empty");
+    NS_TEST_EXPECT_MSG_EQ((ring.begin() == ring.end()), true, "begin() should equal end()");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -88,7 +193,11 @@ class DropTailQueueTestSuite : public TestSuite
     DropTailQueueTestSuite()
         : TestSuite("drop-tail-queue", Type::UNIT)
     {
-        AddTestCase(new DropTailQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new DropTailQueueTestCase<RingBuffer<Ptr<Packet>>>("RingBuffer"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new DropTailQueueTestCase<PacketList>("std::list"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new RingBufferTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -14,6 +14,7 @@
  */
 
 #include "ns3/address.h"
+#include "ns3/boolean.h"
 #include "ns3/callback.h"
 #include "ns3/double.h"
 #include "ns3/error-model.h"
@@ -29,6 +30,8 @@
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <cmath>
+
 using namespace ns3;
 
 static void
@@ -277,6 +280,158 @@ BurstErrorModelSimple::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_drops, 260, "Wrong number of drops.");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the SkipAhead mode of RateErrorModel and BurstErrorModel
+ * yields the same packet error statistics as drawing the decision variable
+ * for every packet.
+ */
+class SkipAheadErrorModelTestCase : public TestCase
+{
+  public:
+    SkipAheadErrorModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a RateErrorModel on packets of various sizes and check the fraction
+     * of corrupted packets against the expected packet error rate.
+     *
+     * \param unit the error unit
+     * \param rate the error rate
+     * \param skipAhead whether to enable the SkipAhead mode
+     */
+    void CheckRateErrorModel(RateErrorModel::ErrorUnit unit, double rate, bool skipAhead);
+
+    /**
+     * Run a BurstErrorModel on a number of packets.
+     *
+     * \param rate the burst error rate
+     * \param skipAhead whether to enable the SkipAhead mode
+     * \return the number of corrupted packets
+     */
+    uint32_t RunBurstErrorModel(double rate, bool skipAhead);
+
+    static constexpr uint32_t N_PACKETS = 20000; //!< the number of packets per run
+};
+
+SkipAheadErrorModelTestCase::SkipAheadErrorModelTestCase()
+    : TestCase("Check the SkipAhead mode of RateErrorModel and BurstErrorModel")
+{
+}
+
+void
+SkipAheadErrorModelTestCase::CheckRateErrorModel(RateErrorModel::ErrorUnit unit,
+                                                 double rate,
+                                                 bool skipAhead)
+{
+    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    em->SetUnit(unit);
+    em->SetRate(rate);
+    em->SetAttribute("SkipAhead", BooleanValue(skipAhead));
+    em->AssignStreams(20);
+
+    uint32_t corrupted = 0;
+    double expected = 0;
+    double variance = 0;
+    for (uint32_t i = 0; i < N_PACKETS; i++)
+    {
+        uint32_t size = 100 * (1 + i % 10);
+        Ptr<Packet> p = Create<Packet>(size);
+        if (em->IsCorrupt(p))
+        {
+            corrupted++;
+        }
+        double units = 1;
+        if (unit == RateErrorModel::ERROR_UNIT_BYTE)
+        {
+            units = size;
+        }
+        else if (unit == RateErrorModel::ERROR_UNIT_BIT)
+        {
+            units = 8.0 * size;
+        }
+        double per = 1 - std::pow(1 - rate, units);
+        expected += per;
+        variance += per * (1 - per);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(static_cast<double>(corrupted),
+                              expected,
+                              5 * std::sqrt(variance) + 1,
+                              "Unexpected number of corrupted packets with unit "
+                                  << unit << ", rate " << rate << ", skip ahead " << skipAhead);
+}
+
+uint32_t
+SkipAheadErrorModelTestCase::RunBurstErrorModel(double rate, bool skipAhead)
+{
+    Ptr<BurstErrorModel> em = CreateObject<BurstErrorModel>();
+    em->SetBurstRate(rate);
+    em->SetAttribute("SkipAhead", BooleanValue(skipAhead));
+    em->AssignStreams(30);
+
+    uint32_t corrupted = 0;
+    for (uint32_t i = 0; i < N_PACKETS; i++)
+    {
+        if (em->IsCorrupt(Create<Packet>(100)))
+        {
+            corrupted++;
+        }
+    }
+    return corrupted;
+}
+
+void
+SkipAheadErrorModelTestCase::DoRun()
+{
+    for (bool skipAhead : {false, true})
+    {
+        CheckRateErrorModel(RateErrorModel::ERROR_UNIT_PACKET, 0.05, skipAhead);
+        CheckRateErrorModel(RateErrorModel::ERROR_UNIT_BYTE, 1e-4, skipAhead);
+        CheckRateErrorModel(RateErrorModel::ERROR_UNIT_BIT, 1e-5, skipAhead);
+        CheckRateErrorModel(RateErrorModel::ERROR_UNIT_BIT, 0, skipAhead);
+        CheckRateErrorModel(RateErrorModel::ERROR_UNIT_BYTE, 1, skipAhead);
+    }
+
+    // Once a burst has started, packets are corrupted regardless of the
+    // decision variable, hence the expected number of corrupted packets is
+    // not that of independent trials; compare the two modes instead
+    uint32_t perPacket = RunBurstErrorModel(0.01, false);
+    uint32_t skipAhead = RunBurstErrorModel(0.01, true);
+    NS_TEST_EXPECT_MSG_EQ_TOL(static_cast<double>(skipAhead),
+                              static_cast<double>(perPacket),
+                              5 * std::sqrt(2 * 2.5 * perPacket),
+                              "Unexpected number of packets corrupted by BurstErrorModel");
+    NS_TEST_EXPECT_MSG_EQ(RunBurstErrorModel(0, true), 0, "No packet should be corrupted");
+
+    // The SkipAhead mode is not used if the decision variable is not Uniform(0,1):
+    // a constant decision variable larger than the error rate corrupts no packet
+    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    em->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    em->SetRate(0.5);
+    em->SetRandomVariable(CreateObjectWithAttributes<ConstantRandomVariable>("Constant",
+                                                                             DoubleValue(0.9)));
+    em->SetAttribute("SkipAhead", BooleanValue(true));
+    Ptr<BurstErrorModel> bem = CreateObject<BurstErrorModel>();
+    bem->SetBurstRate(0.5);
+    bem->SetRandomVariable(CreateObjectWithAttributes<ConstantRandomVariable>("Constant",
+                                                                              DoubleValue(0.9)));
+    bem->SetAttribute("SkipAhead", BooleanValue(true));
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(em->IsCorrupt(Create<Packet>(100)),
+                              false,
+                              "RateErrorModel should draw the decision variable for every packet");
+        NS_TEST_EXPECT_MSG_EQ(bem->IsCorrupt(Create<Packet>(100)),
+                              false,
+                              "BurstErrorModel should draw the decision variable for every packet");
+    }
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -298,6 +453,7 @@ ErrorModelTestSuite::ErrorModelTestSuite()
 {
     AddTestCase(new ErrorModelSimple, TestCase::Duration::QUICK);
     AddTestCase(new BurstErrorModelSimple, TestCase::Duration::QUICK);
+    AddTestCase(new SkipAheadErrorModelTestCase, TestCase::Duration::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
@@ -0,0 +1,419 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "binary-trace-file.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceFile");
+
+namespace
+{
+
+/// Tag of a chunk defining an entry of the context table
+const uint8_t CONTEXT_CHUNK = 'C';
+/// Tag of a chunk holding a block of records
+const uint8_t BLOCK_CHUNK = 'B';
+
+/**
+ * Parse the value following a given path element of a trace context,
+ * e.g., the node id in "/NodeList/3/DeviceList/1/...".
+ *
+ * \param context the trace context
+ * \param element the path element, including the surrounding slashes
+ * \returns the value, or BinaryTraceFile::NO_ID if not found
+ */
+uint32_t
+ParseContextId(const std::string& context, const std::string& element)
+{
+    std::size_t pos = context.find(element);
+    if (pos == std::string::npos)
+    {
+        return BinaryTraceFile::NO_ID;
+    }
+    pos += element.size();
+    std::size_t end = pos;
+    while (end < context.size() && context[end] >= '0' && context[end] <= '9')
+    {
+        end++;
+    }
+    if (end == pos)
+    {
+        return BinaryTraceFile::NO_ID;
+    }
+    return static_cast<uint32_t>(std::stoul(context.substr(pos, end - pos)));
+}
+
+/**
+ * Write the content of a column to a file.
+ *
+ * \param file the output file
+ * \param column the column
+ */
+template <typename T>
+void
+WriteColumn(std::ofstream& file, const std::vector<T>& column)
+{
+    file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+}
+
+/**
+ * Read a value from a file.
+ *
+ * \param file the input file
+ * \param value the value to read
+ * \returns true if the value could be read
+ */
+template <typename T>
+bool
+ReadValue(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<std::size_t>(file.gcount()) == sizeof(T);
+}
+
+/**
+ * Read a column of a block from a file.
+ *
+ * \param file the input file
+ * \param count the number of values in the column
+ * \returns the column
+ */
+template <typename T>
+std::vector<T>
+ReadColumn(std::ifstream& file, uint32_t count)
+{
+    std::vector<T> column(count);
+    file.read(reinterpret_cast<char*>(column.data()), count * sizeof(T));
+    NS_ABORT_MSG_UNLESS(static_cast<std::size_t>(file.gcount()) == count * sizeof(T),
+                        "BinaryTraceFileReader: truncated block");
+    return column;
+}
+
+} // namespace
+
+BinaryTraceFile::BinaryTraceFile(std::string filename, CaptureMode mode, uint32_t blockSize)
+    : m_mode(mode),
+      m_blockSize(blockSize),
+      m_records(0)
+{
+    NS_LOG_FUNCTION(this << filename << mode << blockSize);
+    NS_ABORT_MSG_IF(blockSize == 0, "BinaryTraceFile: the block size must be positive");
+    m_file.open(filename, std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(),
+                        "BinaryTraceFile::BinaryTraceFile(): Unable to Open " << filename);
+    FatalImpl::RegisterStream(&m_file);
+
+    m_file.write(GetMagic(), 8);
+    uint32_t version = VERSION;
+    uint32_t capture = m_mode;
+    m_file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    m_file.write(reinterpret_cast<const char*>(&capture), sizeof(capture));
+
+    m_time.reserve(m_blockSize);
+    m_node.reserve(m_blockSize);
+    m_device.reserve(m_blockSize);
+    m_event.reserve(m_blockSize);
+    m_context.reserve(m_blockSize);
+    m_uid.reserve(m_blockSize);
+    m_size.reserve(m_blockSize);
+    if (m_mode == CAPTURE_PACKET)
+    {
+        m_packetSize.reserve(m_blockSize);
+    }
+}
+
+BinaryTraceFile::~BinaryTraceFile()
+{
+    NS_LOG_FUNCTION(this);
+    Flush();
+    FatalImpl::UnregisterStream(&m_file);
+    m_file.close();
+}
+
+const char*
+BinaryTraceFile::GetMagic()
+{
+    return "NS3BTRC";
+}
+
+BinaryTraceFile::CaptureMode
+BinaryTraceFile::GetCaptureMode() const
+{
+    return m_mode;
+}
+
+uint64_t
+BinaryTraceFile::GetRecordCount() const
+{
+    return m_records;
+}
+
+void
+BinaryTraceFile::Write(EventType type, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << type << p);
+    DoWrite(type, NO_CONTEXT, NO_ID, NO_ID, p);
+}
+
+void
+BinaryTraceFile::Write(EventType type, const std::string& context, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << type << context << p);
+    const ContextInfo& info = LookupContext(context);
+    DoWrite(type, info.id, info.node, info.device, p);
+}
+
+const BinaryTraceFile::ContextInfo&
+BinaryTraceFile::LookupContext(const std::string& context)
+{
+    auto it = m_contexts.find(context);
+    if (it != m_contexts.end())
+    {
+        return it->second;
+    }
+
+    ContextInfo info;
+    info.id = static_cast<uint32_t>(m_contexts.size());
+    info.node = ParseContextId(context, "/NodeList/");
+    info.device = ParseContextId(context, "/DeviceList/");
+    it = m_contexts.emplace(context, info).first;
+
+    // Context definitions are written as soon as they are created; they
+    // therefore always precede the first block referring to them.
+    uint32_t length = context.size();
+    m_file.put(CONTEXT_CHUNK);
+    m_file.write(reinterpret_cast<const char*>(&info.id), sizeof(info.id));
+    m_file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    m_file.write(context.data(), length);
+    return it->second;
+}
+
+void
+BinaryTraceFile::DoWrite(EventType type,
+                         uint32_t contextId,
+                         uint32_t node,
+                         uint32_t device,
+                         Ptr<const Packet> p)
+{
+    m_time.push_back(Simulator::Now().GetSeconds());
+    m_node.push_back(node);
+    m_device.push_back(device);
+    m_event.push_back(type);
+    m_context.push_back(contextId);
+    m_uid.push_back(p->GetUid());
+    m_size.push_back(p->GetSize());
+
+    if (m_mode == CAPTURE_PACKET)
+    {
+        uint32_t size = p->GetSerializedSize();
+        m_scratch.resize((size + 3) / 4);
+        uint32_t ok = p->Serialize(reinterpret_cast<uint8_t*>(m_scratch.data()), size);
+        NS_ASSERT_MSG(ok, "BinaryTraceFile: unable to serialize packet " << p->GetUid());
+        m_packetSize.push_back(size);
+        auto data = reinterpret_cast<const uint8_t*>(m_scratch.data());
+        m_packetData.insert(m_packetData.end(), data, data + size);
+    }
+
+    m_records++;
+    if (m_time.size() >= m_blockSize)
+    {
+        WriteBlock();
+    }
+}
+
+void
+BinaryTraceFile::WriteBlock()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_time.empty())
+    {
+        return;
+    }
+    uint32_t count = m_time.size();
+    m_file.put(BLOCK_CHUNK);
+    m_file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    WriteColumn(m_file, m_time);
+    WriteColumn(m_file, m_node);
+    WriteColumn(m_file, m_device);
+    WriteColumn(m_file, m_event);
+    WriteColumn(m_file, m_context);
+    WriteColumn(m_file, m_uid);
+    WriteColumn(m_file, m_size);
+    if (m_mode == CAPTURE_PACKET)
+    {
+        WriteColumn(m_file, m_packetSize);
+        WriteColumn(m_file, m_packetData);
+    }
+
+    m_time.clear();
+    m_node.clear();
+    m_device.clear();
+    m_event.clear();
+    m_context.clear();
+    m_uid.clear();
+    m_size.clear();
+    m_packetSize.clear();
+    m_packetData.clear();
+}
+
+void
+BinaryTraceFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    WriteBlock();
+    m_file.flush();
+}
+
+BinaryTraceFileReader::BinaryTraceFileReader(std::string filename)
+    : m_next(0)
+{
+    NS_LOG_FUNCTION(this << filename);
+    m_file.open(filename, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(),
+                        "BinaryTraceFileReader::BinaryTraceFileReader(): Unable to Open "
+                            << filename);
+
+    char magic[8];
+    m_file.read(magic, 8);
+    NS_ABORT_MSG_UNLESS(m_file.gcount() == 8 &&
+                            std::memcmp(magic, BinaryTraceFile::GetMagic(), 8) == 0,
+                        "BinaryTraceFileReader: " << filename << " is not a binary trace file");
+    uint32_t version;
+    uint32_t capture;
+    NS_ABORT_MSG_UNLESS(ReadValue(m_file, version) && ReadValue(m_file, capture),
+                        "BinaryTraceFileReader: truncated header in " << filename);
+    NS_ABORT_MSG_UNLESS(version == BinaryTraceFile::VERSION,
+                        "BinaryTraceFileReader: unsupported version " << version);
+    m_mode = static_cast<BinaryTraceFile::CaptureMode>(capture);
+}
+
+BinaryTraceFile::CaptureMode
+BinaryTraceFileReader::GetCaptureMode() const
+{
+    return m_mode;
+}
+
+const std::string&
+BinaryTraceFileReader::GetContext(uint32_t id) const
+{
+    NS_ABORT_MSG_UNLESS(id < m_contexts.size(), "BinaryTraceFileReader: unknown context " << id);
+    return m_contexts[id];
+}
+
+bool
+BinaryTraceFileReader::ReadBlock()
+{
+    NS_LOG_FUNCTION(this);
+    uint8_t tag;
+    while (ReadValue(m_file, tag))
+    {
+        if (tag == CONTEXT_CHUNK)
+        {
+            uint32_t id;
+            uint32_t length;
+            NS_ABORT_MSG_UNLESS(ReadValue(m_file, id) && ReadValue(m_file, length),
+                                "BinaryTraceFileReader: truncated context");
+            std::string context(length, '\0');
+            m_file.read(context.data(), length);
+            NS_ABORT_MSG_UNLESS(id == m_contexts.size(),
+                                "BinaryTraceFileReader: unexpected context id " << id);
+            m_contexts.push_back(context);
+            continue;
+        }
+
+        NS_ABORT_MSG_UNLESS(tag == BLOCK_CHUNK, "BinaryTraceFileReader: unknown chunk " << tag);
+        uint32_t count;
+        NS_ABORT_MSG_UNLESS(ReadValue(m_file, count), "BinaryTraceFileReader: truncated block");
+        auto time = ReadColumn<double>(m_file, count);
+        auto node = ReadColumn<uint32_t>(m_file, count);
+        auto device = ReadColumn<uint32_t>(m_file, count);
+        auto event = ReadColumn<uint8_t>(m_file, count);
+        auto context = ReadColumn<uint32_t>(m_file, count);
+        auto uid = ReadColumn<uint64_t>(m_file, count);
+        auto size = ReadColumn<uint32_t>(m_file, count);
+
+        m_block.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            Record& record = m_block[i];
+            record.time = time[i];
+            record.node = node[i];
+            record.device = device[i];
+            record.event = static_cast<BinaryTraceFile::EventType>(event[i]);
+            record.context = context[i];
+            record.uid = uid[i];
+            record.size = size[i];
+            record.packet.clear();
+        }
+        if (m_mode == BinaryTraceFile::CAPTURE_PACKET)
+        {
+            auto packetSize = ReadColumn<uint32_t>(m_file, count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                m_block[i].packet = ReadColumn<uint8_t>(m_file, packetSize[i]);
+            }
+        }
+        m_next = 0;
+        return true;
+    }
+    return false;
+}
+
+bool
+BinaryTraceFileReader::Read(Record& record)
+{
+    if (m_next == m_block.size() && !ReadBlock())
+    {
+        return false;
+    }
+    record = m_block[m_next++];
+    return true;
+}
+
+Ptr<Packet>
+BinaryTraceFileReader::GetPacket(const Record& record)
+{
+    if (record.packet.empty())
+    {
+        return nullptr;
+    }
+    // Packet deserialization reads the buffer as a sequence of uint32_t
+    std::vector<uint32_t> aligned((record.packet.size() + 3) / 4);
+    std::memcpy(aligned.data(), record.packet.data(), record.packet.size());
+    return Create<Packet>(reinterpret_cast<const uint8_t*>(aligned.data()),
+                          record.packet.size(),
+                          true);
+}
+
+void
+BinaryTraceFileReader::PrintAscii(std::ostream& os, const Record& record) const
+{
+    os << static_cast<char>(record.event) << " " << record.time << " ";
+    if (record.context != BinaryTraceFile::NO_CONTEXT)
+    {
+        os << GetContext(record.context) << " ";
+    }
+    Ptr<Packet> p = GetPacket(record);
+    if (p)
+    {
+        os << *p;
+    }
+    else
+    {
+        os << "uid=" << record.uid << " size=" << record.size;
+    }
+    os << std::endl;
+}
+
+} // namespace ns3
@@ -0,0 +1,270 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief A compact, columnar replacement for ASCII device traces.
+ *
+ * The ASCII trace sinks of AsciiTraceHelper format every enqueue, dequeue,
+ * drop and receive event as a line of text which includes the output of
+ * Packet::Print.  On large simulations formatting dominates the cost of
+ * tracing.  This class records the same events in binary form instead:
+ * events are accumulated in memory, one vector per column, and written to
+ * the file one block of records at a time.
+ *
+ * Each record holds the following columns:
+ *
+ * - the simulation time of the event, in seconds
+ * - the node id and the device id, parsed from the trace context
+ *   (NO_ID if the event was traced without context)
+ * - the event type ('+', '-', 'd' or 'r')
+ * - the index of the trace context in the context table
+ * - the packet uid and the packet size
+ * - optionally, the packet serialized with Packet::Serialize, which keeps
+ *   its headers and metadata so that the original ASCII line can be rebuilt
+ *
+ * A file starts with an 8 byte magic string, followed by the format version
+ * and the capture mode (two uint32_t).  It then contains a sequence of
+ * chunks, each starting with a one byte tag: 'C' chunks define an entry of
+ * the context table, 'B' chunks hold a block of records stored column by
+ * column.  All values are written in host byte order.
+ *
+ * BinaryTraceFileReader reads the records back, and the binary-trace-to-ascii
+ * program in the utils directory converts a binary trace to the text that the
+ * ASCII trace sinks would have produced.
+ *
+ * This class uses a basic ns-3 reference counting base class but is not
+ * an ns3::Object with attributes, TypeId, or aggregation.
+ */
+class BinaryTraceFile : public SimpleRefCount<BinaryTraceFile>
+{
+  public:
+    /**
+     * The traced events, encoded with the character used in ASCII traces
+     */
+    enum EventType : uint8_t
+    {
+        ENQUEUE = '+',
+        DEQUEUE = '-',
+        DROP = 'd',
+        RECEIVE = 'r'
+    };
+
+    /**
+     * What is captured in addition to the packet uid and size
+     */
+    enum CaptureMode : uint32_t
+    {
+        CAPTURE_NONE = 0,  //!< only the fixed-size columns are recorded
+        CAPTURE_PACKET = 1 //!< the serialized packet is recorded as well
+    };
+
+    /// Value of the node id and device id columns when they are not known
+    static constexpr uint32_t NO_ID = 0xffffffff;
+    /// Value of the context column for events traced without context
+    static constexpr uint32_t NO_CONTEXT = 0xffffffff;
+    /// Current version of the file format
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * Constructor
+     * \param filename file name
+     * \param mode the capture mode
+     * \param blockSize number of records buffered before a block is written
+     */
+    BinaryTraceFile(std::string filename,
+                    CaptureMode mode = CAPTURE_PACKET,
+                    uint32_t blockSize = 4096);
+    ~BinaryTraceFile();
+
+    /**
+     * Record an event traced without context.
+     *
+     * \param type the event type
+     * \param p the traced packet
+     */
+    void Write(EventType type, Ptr<const Packet> p);
+
+    /**
+     * Record an event traced with context.
+     *
+     * \param type the event type
+     * \param context the trace context
+     * \param p the traced packet
+     */
+    void Write(EventType type, const std::string& context, Ptr<const Packet> p);
+
+    /**
+     * Write the records buffered so far and flush the underlying file.
+     */
+    void Flush();
+
+    /**
+     * \returns the capture mode of this file
+     */
+    CaptureMode GetCaptureMode() const;
+
+    /**
+     * \returns the number of records written so far, including buffered ones
+     */
+    uint64_t GetRecordCount() const;
+
+    /**
+     * \returns the 8 byte magic string found at the start of each file
+     */
+    static const char* GetMagic();
+
+  private:
+    /**
+     * Append a record to the column buffers.
+     *
+     * \param type the event type
+     * \param contextId the index of the context, or NO_CONTEXT
+     * \param node the node id, or NO_ID
+     * \param device the device id, or NO_ID
+     * \param p the traced packet
+     */
+    void DoWrite(EventType type,
+                 uint32_t contextId,
+                 uint32_t node,
+                 uint32_t device,
+                 Ptr<const Packet> p);
+
+    /**
+     * Write the buffered records as a block and clear the column buffers.
+     */
+    void WriteBlock();
+
+    /// Information about a context of the context table
+    struct ContextInfo
+    {
+        uint32_t id;     //!< index in the context table
+        uint32_t node;   //!< node id parsed from the context
+        uint32_t device; //!< device id parsed from the context
+    };
+
+    /**
+     * Look up a context in the context table, adding it (and writing its
+     * definition to the file) if it is not there yet.
+     *
+     * \param context the trace context
+     * \returns the information about the context
+     */
+    const ContextInfo& LookupContext(const std::string& context);
+
+    std::ofstream m_file;                                    //!< the output file
+    CaptureMode m_mode;                                      //!< capture mode
+    uint32_t m_blockSize;                                    //!< records per block
+    uint64_t m_records;                                      //!< records written so far
+    std::unordered_map<std::string, ContextInfo> m_contexts; //!< the context table
+    std::vector<double> m_time;                              //!< time column
+    std::vector<uint32_t> m_node;                            //!< node id column
+    std::vector<uint32_t> m_device;                          //!< device id column
+    std::vector<uint8_t> m_event;                            //!< event type column
+    std::vector<uint32_t> m_context;                         //!< context index column
+    std::vector<uint64_t> m_uid;                             //!< packet uid column
+    std::vector<uint32_t> m_size;                            //!< packet size column
+    std::vector<uint32_t> m_packetSize;                      //!< serialized packet sizes
+    std::vector<uint8_t> m_packetData;                       //!< serialized packets
+    std::vector<uint32_t> m_scratch;                         //!< aligned serialization buffer
+};
+
+/**
+ * \brief Read back the records of a file written by BinaryTraceFile.
+ */
+class BinaryTraceFileReader
+{
+  public:
+    /**
+     * A single record of a binary trace file
+     */
+    struct Record
+    {
+        double time;                      //!< time of the event, in seconds
+        uint32_t node;                    //!< node id, or BinaryTraceFile::NO_ID
+        uint32_t device;                  //!< device id, or BinaryTraceFile::NO_ID
+        BinaryTraceFile::EventType event; //!< event type
+        uint32_t context;                 //!< context index, or BinaryTraceFile::NO_CONTEXT
+        uint64_t uid;                     //!< packet uid
+        uint32_t size;                    //!< packet size
+        std::vector<uint8_t> packet;      //!< serialized packet, empty if not captured
+    };
+
+    /**
+     * Constructor.  Aborts if the file cannot be opened or if it is not a
+     * binary trace file.
+     *
+     * \param filename file name
+     */
+    BinaryTraceFileReader(std::string filename);
+
+    /**
+     * Read the next record.
+     *
+     * \param record the record to fill
+     * \returns false at the end of the file, true otherwise
+     */
+    bool Read(Record& record);
+
+    /**
+     * \param id the index of a context
+     * \returns the context string; must have been seen in a record already
+     */
+    const std::string& GetContext(uint32_t id) const;
+
+    /**
+     * \returns the capture mode of the file
+     */
+    BinaryTraceFile::CaptureMode GetCaptureMode() const;
+
+    /**
+     * Rebuild a packet from the serialized form stored in a record.
+     *
+     * \param record the record
+     * \returns the packet, or 0 if the packet was not captured
+     */
+    static Ptr<Packet> GetPacket(const Record& record);
+
+    /**
+     * Print a record the way the default ASCII trace sinks of
+     * AsciiTraceHelper print the corresponding event.  If the packet was not
+     * captured, its uid and size are printed instead of Packet::Print output.
+     *
+     * \param os the output stream
+     * \param record the record
+     */
+    void PrintAscii(std::ostream& os, const Record& record) const;
+
+  private:
+    /**
+     * Read chunks until a block of records is loaded.
+     *
+     * \returns false at the end of the file
+     */
+    bool ReadBlock();
+
+    std::ifstream m_file;                //!< the input file
+    BinaryTraceFile::CaptureMode m_mode; //!< capture mode
+    std::vector<std::string> m_contexts; //!< the context table
+    std::vector<Record> m_block;         //!< records of the current block
+    std::size_t m_next;                  //!< next record of the current block
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
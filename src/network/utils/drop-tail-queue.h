@@ -8,6 +8,7 @@
 #define DROPTAIL_H
 
 #include "queue.h"
+#include "ring-buffer.h"
 
 namespace ns3
 {
@@ -16,8 +17,17 @@ namespace ns3
  * \ingroup queue
  *
  * \brief A FIFO packet queue that drops tail-end packets on overflow
+ *
+ * The items are stored in a RingBuffer by default.  A different container,
+ * e.g. std::list, can be selected by means of the second template parameter;
+ * the corresponding instance of the DropTailQueue class must then be
+ * registered with the NS_OBJECT_TEMPLATE_CLASS_TWO_DEFINE macro.  Whatever
+ * the container, a DropTailQueue<Item> is a Queue<Item>.
+ *
+ * \tparam Item \explicit Type of the objects stored within the queue
+ * \tparam Container \explicit Type of the container that stores queue items
  */
-template <typename Item>
+template <typename Item, typename Container = RingBuffer<Ptr<Item>>>
 class DropTailQueue : public Queue<Item>
 {
   public:
@@ -40,13 +50,16 @@ class DropTailQueue : public Queue<Item>
     Ptr<Item> Remove() override;
     Ptr<const Item> Peek() const override;
 
+  protected:
+    void DoDispose() override;
+
   private:
-    using Queue<Item>::GetContainer;
     using Queue<Item>::DoEnqueue;
     using Queue<Item>::DoDequeue;
     using Queue<Item>::DoRemove;
     using Queue<Item>::DoPeek;
 
+    Container m_items;       //!< the items in the queue
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
 
@@ -54,15 +67,15 @@ class DropTailQueue : public Queue<Item>
  * Implementation of the templates declared above.
  */
 
-template <typename Item>
+template <typename Item, typename Container>
 TypeId
-DropTailQueue<Item>::GetTypeId()
+DropTailQueue<Item, Container>::GetTypeId()
 {
     static TypeId tid =
-        TypeId(GetTemplateClassName<DropTailQueue<Item>>())
+        TypeId(GetTemplateClassName<DropTailQueue<Item, Container>>())
             .SetParent<Queue<Item>>()
             .SetGroupName("Network")
-            .template AddConstructor<DropTailQueue<Item>>()
+            .template AddConstructor<DropTailQueue<Item, Container>>()
             .AddAttribute("MaxSize",
                           "The max queue size",
                           QueueSizeValue(QueueSize("100p")),
@@ -71,62 +84,72 @@ DropTailQueue<Item>::GetTypeId()
     return tid;
 }
 
-template <typename Item>
-DropTailQueue<Item>::DropTailQueue()
+template <typename Item, typename Container>
+DropTailQueue<Item, Container>::DropTailQueue()
     : Queue<Item>(),
       NS_LOG_TEMPLATE_DEFINE("DropTailQueue")
 {
     NS_LOG_FUNCTION(this);
 }
 
-template <typename Item>
-DropTailQueue<Item>::~DropTailQueue()
+template <typename Item, typename Container>
+DropTailQueue<Item, Container>::~DropTailQueue()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+template <typename Item, typename Container>
+void
+DropTailQueue<Item, Container>::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_items.clear();
+    Queue<Item>::DoDispose();
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 bool
-DropTailQueue<Item>::Enqueue(Ptr<Item> item)
+DropTailQueue<Item, Container>::Enqueue(Ptr<Item> item)
 {
     NS_LOG_FUNCTION(this << item);
 
-    return DoEnqueue(GetContainer().end(), item);
+    typename Container::iterator ret;
+    return DoEnqueue(m_items, m_items.cend(), item, ret);
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<Item>
-DropTailQueue<Item>::Dequeue()
+DropTailQueue<Item, Container>::Dequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<Item> item = DoDequeue(GetContainer().begin());
+    Ptr<Item> item = DoDequeue(m_items, m_items.cbegin());
 
     NS_LOG_LOGIC("Popped " << item);
 
     return item;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<Item>
-DropTailQueue<Item>::Remove()
+DropTailQueue<Item, Container>::Remove()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<Item> item = DoRemove(GetContainer().begin());
+    Ptr<Item> item = DoRemove(m_items, m_items.cbegin());
 
     NS_LOG_LOGIC("Removed " << item);
 
     return item;
 }
 
-template <typename Item>
+template <typename Item, typename Container>
 Ptr<const Item>
-DropTailQueue<Item>::Peek() const
+DropTailQueue<Item, Container>::Peek() const
 {
     NS_LOG_FUNCTION(this);
 
-    return DoPeek(GetContainer().begin());
+    return DoPeek(m_items, m_items.cbegin());
 }
 
 // The following explicit template instantiation declarations prevent all the
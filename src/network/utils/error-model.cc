@@ -60,6 +60,7 @@
 #include "ns3/string.h"
 
 #include <cmath>
+#include <limits>
 
 namespace ns3
 {
@@ -132,6 +133,49 @@ ErrorModel::IsEnabled() const
     return m_enable;
 }
 
+/**
+ * Draw the number of error-free units preceding the next errored unit, when
+ * each unit is independently errored with the given probability, i.e., a
+ * geometrically distributed random variable.
+ *
+ * \param ranvar a Uniform(0,1) random variable
+ * \param rate the probability that a unit is errored
+ * \returns the number of error-free units before the next error
+ */
+static uint64_t
+DrawErrorGap(Ptr<RandomVariableStream> ranvar, double rate)
+{
+    if (rate <= 0)
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    if (rate >= 1)
+    {
+        return 0;
+    }
+    // inversion of the geometric distribution: P(gap >= k) = (1 - rate)^k
+    double gap = std::floor(std::log(1 - ranvar->GetValue()) / std::log1p(-rate));
+    if (!(gap < static_cast<double>(std::numeric_limits<uint64_t>::max())))
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return static_cast<uint64_t>(gap);
+}
+
+/**
+ * The geometric inversion of DrawErrorGap() only yields the statistics of the
+ * per-packet decision if the decision variable is Uniform(0,1).
+ *
+ * \param ranvar the decision variable
+ * \returns whether the decision variable is a UniformRandomVariable on [0,1)
+ */
+static bool
+IsStandardUniform(Ptr<RandomVariableStream> ranvar)
+{
+    Ptr<UniformRandomVariable> uniform = DynamicCast<UniformRandomVariable>(ranvar);
+    return uniform && uniform->GetMin() == 0 && uniform->GetMax() == 1;
+}
+
 //
 // RateErrorModel
 //
@@ -165,11 +209,24 @@ RateErrorModel::GetTypeId()
                           "The decision variable attached to this error model.",
                           StringValue("ns3::UniformRandomVariable[Min=0.0|Max=1.0]"),
                           MakePointerAccessor(&RateErrorModel::m_ranvar),
-                          MakePointerChecker<RandomVariableStream>());
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("SkipAhead",
+                          "Whether to draw the number of error-free units preceding the next "
+                          "error from a geometric distribution, instead of drawing the decision "
+                          "variable for every packet. Only effective if RanVar is a "
+                          "UniformRandomVariable on [0,1); otherwise, the decision variable is "
+                          "drawn for every packet.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RateErrorModel::m_skipAhead),
+                          MakeBooleanChecker());
     return tid;
 }
 
 RateErrorModel::RateErrorModel()
+    : m_gapDrawn(false),
+      m_gapRate(0),
+      m_gapUnit(ERROR_UNIT_BYTE),
+      m_unitsToError(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -230,6 +287,10 @@ RateErrorModel::DoCorrupt(Ptr<Packet> p)
     {
         return false;
     }
+    if (m_skipAhead && IsStandardUniform(m_ranvar))
+    {
+        return DoCorruptSkipAhead(p);
+    }
     switch (m_unit)
     {
     case ERROR_UNIT_PACKET:
@@ -270,11 +331,47 @@ RateErrorModel::DoCorruptBit(Ptr<Packet> p)
     return (m_ranvar->GetValue() < per);
 }
 
+bool
+RateErrorModel::DoCorruptSkipAhead(Ptr<Packet> p)
+{
+    NS_LOG_FUNCTION(this << p);
+    uint64_t units = 1;
+    if (m_unit == ERROR_UNIT_BYTE)
+    {
+        units = p->GetSize();
+    }
+    else if (m_unit == ERROR_UNIT_BIT)
+    {
+        units = 8 * static_cast<uint64_t>(p->GetSize());
+    }
+    if (units == 0)
+    {
+        return false;
+    }
+    if (!m_gapDrawn || m_gapRate != m_rate || m_gapUnit != m_unit)
+    {
+        m_unitsToError = DrawErrorGap(m_ranvar, m_rate);
+        m_gapDrawn = true;
+        m_gapRate = m_rate;
+        m_gapUnit = m_unit;
+    }
+    if (m_unitsToError >= units)
+    {
+        m_unitsToError -= units;
+        return false;
+    }
+    // the next error falls within this packet. Errors in the remaining units
+    // do not matter and, the distribution being memoryless, the gap to the
+    // following error is drawn from the end of this packet
+    m_gapDrawn = false;
+    return true;
+}
+
 void
 RateErrorModel::DoReset()
 {
     NS_LOG_FUNCTION(this);
-    /* re-initialize any state; no-op for now */
+    m_gapDrawn = false;
 }
 
 //
@@ -305,13 +402,25 @@ BurstErrorModel::GetTypeId()
                           "The number of packets being corrupted at one drop.",
                           StringValue("ns3::UniformRandomVariable[Min=1|Max=4]"),
                           MakePointerAccessor(&BurstErrorModel::m_burstSize),
-                          MakePointerChecker<RandomVariableStream>());
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("SkipAhead",
+                          "Whether to draw the number of packets preceding the next error event "
+                          "from a geometric distribution, instead of drawing the decision "
+                          "variable for every packet. Only effective if BurstStart is a "
+                          "UniformRandomVariable on [0,1); otherwise, the decision variable is "
+                          "drawn for every packet.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&BurstErrorModel::m_skipAhead),
+                          MakeBooleanChecker());
     return tid;
 }
 
 BurstErrorModel::BurstErrorModel()
     : m_counter(0),
-      m_currentBurstSz(0)
+      m_currentBurstSz(0),
+      m_gapDrawn(false),
+      m_gapRate(0),
+      m_packetsToBurst(0)
 {
 }
 
@@ -365,9 +474,31 @@ BurstErrorModel::DoCorrupt(Ptr<Packet> p)
     {
         return false;
     }
-    double ranVar = m_burstStart->GetValue();
+    bool burstStart;
+    if (m_skipAhead && IsStandardUniform(m_burstStart))
+    {
+        if (!m_gapDrawn || m_gapRate != m_burstRate)
+        {
+            m_packetsToBurst = DrawErrorGap(m_burstStart, m_burstRate);
+            m_gapDrawn = true;
+            m_gapRate = m_burstRate;
+        }
+        burstStart = (m_packetsToBurst == 0);
+        if (burstStart)
+        {
+            m_gapDrawn = false;
+        }
+        else
+        {
+            m_packetsToBurst--;
+        }
+    }
+    else
+    {
+        burstStart = (m_burstStart->GetValue() < m_burstRate);
+    }
 
-    if (ranVar < m_burstRate)
+    if (burstStart)
     {
         // get a new burst size for the new error event
         m_currentBurstSz = m_burstSize->GetInteger();
@@ -406,6 +537,7 @@ BurstErrorModel::DoReset()
     NS_LOG_FUNCTION(this);
     m_counter = 0;
     m_currentBurstSz = 0;
+    m_gapDrawn = false;
 }
 
 //
@@ -164,8 +164,20 @@ class ErrorModel : public Object
  * unit (which may be per-bit, per-byte, and per-packet).
  * Users can optionally provide a RandomVariableStream object; the default
  * is to use a Uniform(0,1) distribution.
-
- * Reset() on this model will do nothing
+ *
+ * By default, a random variate is drawn for every packet and compared with
+ * the probability that at least one unit of the packet is errored.  If the
+ * SkipAhead attribute is set to true, the model instead draws the number of
+ * error-free units preceding the next error from a geometric distribution and
+ * counts it down as packets go by, so that random variates are only drawn for
+ * corrupted packets.  Owing to the memorylessness of the geometric
+ * distribution, both modes yield the same packet error statistics, provided
+ * that the decision variable is Uniform(0,1): the SkipAhead mode is only used
+ * if the decision variable is a UniformRandomVariable on [0,1), and the
+ * variable is drawn for every packet otherwise.  In SkipAhead mode, the
+ * DoCorruptPkt, DoCorruptByte and DoCorruptBit methods are not used.
+ *
+ * Reset() on this model discards the countdown of the SkipAhead mode
  *
  * IsCorrupt() will not modify the packet data buffer
  */
@@ -244,12 +256,25 @@ class RateErrorModel : public ErrorModel
      * \returns true if the packet is corrupted
      */
     virtual bool DoCorruptBit(Ptr<Packet> p);
+    /**
+     * Corrupt a packet by counting down the number of units preceding the
+     * next error (SkipAhead mode).
+     * \param p the packet to corrupt
+     * \returns true if the packet is corrupted
+     */
+    bool DoCorruptSkipAhead(Ptr<Packet> p);
     void DoReset() override;
 
     ErrorUnit m_unit; //!< Error rate unit
     double m_rate;    //!< Error rate
 
     Ptr<RandomVariableStream> m_ranvar; //!< rng stream
+
+    bool m_skipAhead;        //!< whether error gaps are drawn from a geometric distribution
+    bool m_gapDrawn;         //!< whether m_unitsToError holds a valid countdown
+    double m_gapRate;        //!< the error rate used to draw the current countdown
+    ErrorUnit m_gapUnit;     //!< the error unit of the current countdown
+    uint64_t m_unitsToError; //!< number of error-free units before the next error
 };
 
 /**
@@ -282,6 +307,13 @@ class RateErrorModel : public ErrorModel
  * total number of packets that has been dropped does not exceed the
  * burst size.
  *
+ * If the SkipAhead attribute is set to true, the decision variable is not
+ * drawn for every packet: instead, the number of packets preceding the next
+ * error event is drawn from a geometric distribution and counted down, which
+ * yields the same statistics provided that the decision variable is
+ * Uniform(0,1). Hence, the SkipAhead mode is only used if the decision
+ * variable is a UniformRandomVariable on [0,1).
+ *
  * IsCorrupt() will not modify the packet data buffer
  */
 class BurstErrorModel : public ErrorModel
@@ -339,6 +371,11 @@ class BurstErrorModel : public ErrorModel
      */
     uint32_t m_counter;
     uint32_t m_currentBurstSz; //!< the current burst size
+
+    bool m_skipAhead;          //!< whether error event gaps are drawn from a geometric distribution
+    bool m_gapDrawn;           //!< whether m_packetsToBurst holds a valid countdown
+    double m_gapRate;          //!< the burst rate used to draw the current countdown
+    uint64_t m_packetsToBurst; //!< number of packets before the next error event
 };
 
 /**
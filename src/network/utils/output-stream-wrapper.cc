@@ -39,10 +39,22 @@ OutputStreamWrapper::OutputStreamWrapper(std::ostream* os)
     NS_ABORT_MSG_UNLESS(m_ostream->good(), "Output stream is not valid for writing.");
 }
 
+OutputStreamWrapper::OutputStreamWrapper(Ptr<BinaryTraceFile> file)
+    : m_ostream(nullptr),
+      m_destroyable(false),
+      m_binaryFile(file)
+{
+    NS_LOG_FUNCTION(this << file);
+    NS_ABORT_MSG_UNLESS(m_binaryFile, "Binary trace file is not valid for writing.");
+}
+
 OutputStreamWrapper::~OutputStreamWrapper()
 {
     NS_LOG_FUNCTION(this);
-    FatalImpl::UnregisterStream(m_ostream);
+    if (m_ostream)
+    {
+        FatalImpl::UnregisterStream(m_ostream);
+    }
     if (m_destroyable)
     {
         delete m_ostream;
@@ -54,7 +66,16 @@ std::ostream*
 OutputStreamWrapper::GetStream()
 {
     NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_binaryFile,
+                    "OutputStreamWrapper::GetStream(): a binary trace file has no output stream; "
+                    "only the default trace sinks of AsciiTraceHelper support binary trace files");
     return m_ostream;
 }
 
+Ptr<BinaryTraceFile>
+OutputStreamWrapper::GetBinaryTraceFile() const
+{
+    return m_binaryFile;
+}
+
 } // namespace ns3
@@ -7,6 +7,8 @@
 #ifndef OUTPUT_STREAM_WRAPPER_H
 #define OUTPUT_STREAM_WRAPPER_H
 
+#include "binary-trace-file.h"
+
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
@@ -71,6 +73,17 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      * \param os output stream
      */
     OutputStreamWrapper(std::ostream* os);
+    /**
+     * Constructor for a wrapper around a binary trace file.
+     *
+     * The default trace sinks of AsciiTraceHelper record their events in the
+     * binary trace file instead of printing them when they are given such a
+     * wrapper.  Such a wrapper has no std::ostream: GetStream aborts, hence
+     * the helpers with their own ASCII trace sinks do not accept it.
+     *
+     * \param file the binary trace file
+     */
+    OutputStreamWrapper(Ptr<BinaryTraceFile> file);
     ~OutputStreamWrapper();
 
     /**
@@ -78,13 +91,22 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      *
      * \see SetStream
      *
+     * The simulation is aborted if this wrapper encapsulates a binary trace file.
+     *
      * \returns a pointer to the encapsulated std::ostream
      */
     std::ostream* GetStream();
 
+    /**
+     * \returns the encapsulated binary trace file, or a null pointer if this
+     * wrapper encapsulates a std::ostream
+     */
+    Ptr<BinaryTraceFile> GetBinaryTraceFile() const;
+
   private:
-    std::ostream* m_ostream; //!< The output stream
-    bool m_destroyable;      //!< Can be destroyed
+    std::ostream* m_ostream;           //!< The output stream
+    bool m_destroyable;                //!< Can be destroyed
+    Ptr<BinaryTraceFile> m_binaryFile; //!< The binary trace file
 };
 
 } // namespace ns3
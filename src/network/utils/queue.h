@@ -235,7 +235,10 @@ class QueueBase : public Object
  * container used internally to store queue items. The container type must provide
  * the methods insert(), erase() and clear() and define the iterator and const_iterator
  * types, following the usual syntax of C++ containers. The default container type
- * is std::list (as defined in queue-fwd.h). In case the container is such that
+ * is std::list (as defined in queue-fwd.h). Subclasses may also store the items
+ * in a container of their own, which is passed to the DoEnqueue, DoDequeue,
+ * DoRemove and DoPeek methods (e.g., DropTailQueue stores the items in a
+ * RingBuffer by default). In case the container is such that
  * an object stored within the queue is obtained from a container element through
  * an operation other than dereferencing an iterator pointing to the container
  * element, the container has to provide a public method named GetItem that
@@ -354,6 +357,51 @@ class Queue : public QueueBase
      */
     Ptr<const Item> DoPeek(ConstIterator pos) const;
 
+    /**
+     * Push an item in the given container of queue items
+     * \tparam C \deduced the type of the container
+     * \param container the container
+     * \param pos the position before which the item will be inserted
+     * \param item the item to enqueue
+     * \param[out] ret an iterator pointing to the inserted value
+     * \return true if success, false if the packet has been dropped.
+     */
+    template <typename C>
+    bool DoEnqueue(C& container,
+                   typename C::const_iterator pos,
+                   Ptr<Item> item,
+                   typename C::iterator& ret);
+
+    /**
+     * Pull the item to dequeue from the given container of queue items
+     * \tparam C \deduced the type of the container
+     * \param container the container
+     * \param pos the position of the item to dequeue
+     * \return the item.
+     */
+    template <typename C>
+    Ptr<Item> DoDequeue(C& container, typename C::const_iterator pos);
+
+    /**
+     * Pull the item to drop from the given container of queue items
+     * \tparam C \deduced the type of the container
+     * \param container the container
+     * \param pos the position of the item to remove
+     * \return the item.
+     */
+    template <typename C>
+    Ptr<Item> DoRemove(C& container, typename C::const_iterator pos);
+
+    /**
+     * Peek an item in the given container of queue items
+     * \tparam C \deduced the type of the container
+     * \param container the container
+     * \param pos the position of the item to peek
+     * \return the item.
+     */
+    template <typename C>
+    Ptr<const Item> DoPeek(const C& container, typename C::const_iterator pos) const;
+
     /**
      * \brief Drop a packet before enqueue
      * \param item item that was dropped
@@ -385,14 +433,14 @@ class Queue : public QueueBase
      * assumes that an object stored in the queue can be obtained by dereferencing the
      * iterator pointing to the container element that includes such an object.
      */
-    template <class, class = void>
+    template <class T, class = void>
     struct MakeGetItem
     {
         /**
          * \param it the given const iterator
          * \return the item included in the element pointed to by the given iterator
          */
-        static Ptr<Item> GetItem(const Container&, const ConstIterator it)
+        static Ptr<Item> GetItem(const T&, const typename T::const_iterator it)
         {
             return *it;
         }
@@ -405,16 +453,16 @@ class Queue : public QueueBase
      * wrapper to invoke such a method.
      */
     template <class T>
-    struct MakeGetItem<
-        T,
-        std::void_t<decltype(std::declval<T>().GetItem(std::declval<ConstIterator>()))>>
+    struct MakeGetItem<T,
+                       std::void_t<decltype(std::declval<T>().GetItem(
+                           std::declval<typename T::const_iterator>()))>>
     {
         /**
          * \param container the container
          * \param it the given const iterator
          * \return the item included in the element pointed to by the given iterator
          */
-        static Ptr<Item> GetItem(const Container& container, const ConstIterator it)
+        static Ptr<Item> GetItem(const T& container, const typename T::const_iterator it)
         {
             return container.GetItem(it);
         }
@@ -506,6 +554,17 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item)
 template <typename Item, typename Container>
 bool
 Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& ret)
+{
+    return DoEnqueue(m_packets, pos, item, ret);
+}
+
+template <typename Item, typename Container>
+template <typename C>
+bool
+Queue<Item, Container>::DoEnqueue(C& container,
+                                  typename C::const_iterator pos,
+                                  Ptr<Item> item,
+                                  typename C::iterator& ret)
 {
     NS_LOG_FUNCTION(this << item);
 
@@ -516,7 +575,7 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
         return false;
     }
 
-    ret = m_packets.insert(pos, item);
+    ret = container.insert(pos, item);
 
     uint32_t size = item->GetSize();
     m_nBytes += size;
@@ -534,6 +593,14 @@ Queue<Item, Container>::DoEnqueue(ConstIterator pos, Ptr<Item> item, Iterator& r
 template <typename Item, typename Container>
 Ptr<Item>
 Queue<Item, Container>::DoDequeue(ConstIterator pos)
+{
+    return DoDequeue(m_packets, pos);
+}
+
+template <typename Item, typename Container>
+template <typename C>
+Ptr<Item>
+Queue<Item, Container>::DoDequeue(C& container, typename C::const_iterator pos)
 {
     NS_LOG_FUNCTION(this);
 
@@ -543,11 +610,11 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
         return nullptr;
     }
 
-    Ptr<Item> item = MakeGetItem<Container>::GetItem(m_packets, pos);
+    Ptr<Item> item = MakeGetItem<C>::GetItem(container, pos);
 
     if (item)
     {
-        m_packets.erase(pos);
+        container.erase(pos);
         NS_ASSERT(m_nBytes.Get() >= item->GetSize());
         NS_ASSERT(m_nPackets.Get() > 0);
 
@@ -563,6 +630,14 @@ Queue<Item, Container>::DoDequeue(ConstIterator pos)
 template <typename Item, typename Container>
 Ptr<Item>
 Queue<Item, Container>::DoRemove(ConstIterator pos)
+{
+    return DoRemove(m_packets, pos);
+}
+
+template <typename Item, typename Container>
+template <typename C>
+Ptr<Item>
+Queue<Item, Container>::DoRemove(C& container, typename C::const_iterator pos)
 {
     NS_LOG_FUNCTION(this);
 
@@ -572,11 +647,11 @@ Queue<Item, Container>::DoRemove(ConstIterator pos)
         return nullptr;
     }
 
-    Ptr<Item> item = MakeGetItem<Container>::GetItem(m_packets, pos);
+    Ptr<Item> item = MakeGetItem<C>::GetItem(container, pos);
 
     if (item)
     {
-        m_packets.erase(pos);
+        container.erase(pos);
         NS_ASSERT(m_nBytes.Get() >= item->GetSize());
         NS_ASSERT(m_nPackets.Get() > 0);
 
@@ -615,6 +690,14 @@ Queue<Item, Container>::DoDispose()
 template <typename Item, typename Container>
 Ptr<const Item>
 Queue<Item, Container>::DoPeek(ConstIterator pos) const
+{
+    return DoPeek(m_packets, pos);
+}
+
+template <typename Item, typename Container>
+template <typename C>
+Ptr<const Item>
+Queue<Item, Container>::DoPeek(const C& container, typename C::const_iterator pos) const
 {
     NS_LOG_FUNCTION(this);
 
@@ -624,7 +707,7 @@ Queue<Item, Container>::DoPeek(ConstIterator pos) const
         return nullptr;
     }
 
-    return MakeGetItem<Container>::GetItem(m_packets, pos);
+    return MakeGetItem<C>::GetItem(container, pos);
 }
 
 template <typename Item, typename Container>
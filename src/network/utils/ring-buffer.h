@@ -0,0 +1,673 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup queue
+ * ns3::RingBuffer declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup queue
+ *
+ * \brief A sequence container storing its elements in a growable circular array.
+ *
+ * RingBuffer provides the subset of the std::list interface which is used by
+ * the Queue class (insert(), erase(), clear(), begin(), end() and the
+ * iterator and const_iterator types), plus the usual push and pop operations
+ * at both ends.  Inserting or erasing at either end takes constant time and
+ * does not allocate memory unless the capacity has to grow, in which case
+ * the capacity is doubled.  Inserting or erasing in the middle moves the
+ * elements between the position and the nearest end.
+ *
+ * Unlike std::list, inserting or erasing an element invalidates the
+ * iterators pointing to the other elements.  Containers whose users keep
+ * iterators to the queued elements (such as the WifiMacQueueContainer) must
+ * keep using a node-based container.
+ *
+ * Slots left free by erased elements are reset to a default-constructed
+ * value, so that, e.g., smart pointers stored in the buffer are released as
+ * soon as they are removed.
+ *
+ * \tparam T \explicit the type of the elements, which must be default constructible
+ */
+template <typename T>
+class RingBuffer
+{
+  public:
+    /// Type of the elements
+    using value_type = T;
+    /// Type of the sizes
+    using size_type = std::size_t;
+    /// Type of the iterator differences
+    using difference_type = std::ptrdiff_t;
+    /// Reference to an element
+    using reference = T&;
+    /// Const reference to an element
+    using const_reference = const T&;
+
+    /**
+     * Random access iterator over the elements of a RingBuffer. An iterator
+     * stores the position of the element relative to the first element.
+     *
+     * \tparam IsConst whether this is a const iterator
+     */
+    template <bool IsConst>
+    class IteratorImpl
+    {
+      public:
+        /// The iterator category
+        using iterator_category = std::random_access_iterator_tag;
+        /// Type of the elements
+        using value_type = T;
+        /// Type of the iterator differences
+        using difference_type = std::ptrdiff_t;
+        /// Pointer to an element
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        /// Reference to an element
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        /// Pointer to the ring buffer
+        using RingPtr = std::conditional_t<IsConst, const RingBuffer*, RingBuffer*>;
+
+        /// Default constructor, needed by Queue
+        IteratorImpl()
+            : m_ring(nullptr),
+              m_index(0)
+        {
+        }
+
+        /**
+         * Constructor
+         * \param ring the ring buffer
+         * \param index the position relative to the first element
+         */
+        IteratorImpl(RingPtr ring, size_type index)
+            : m_ring(ring),
+              m_index(index)
+        {
+        }
+
+        /**
+         * Conversion from iterator to const iterator
+         * \param other the iterator to convert
+         */
+        template <bool WasConst, typename = std::enable_if_t<IsConst && !WasConst>>
+        IteratorImpl(const IteratorImpl<WasConst>& other)
+            : m_ring(other.m_ring),
+              m_index(other.m_index)
+        {
+        }
+
+        /// \return a reference to the element
+        reference operator*() const
+        {
+            return m_ring->Slot(m_index);
+        }
+
+        /// \return a pointer to the element
+        pointer operator->() const
+        {
+            return &m_ring->Slot(m_index);
+        }
+
+        /**
+         * \param n the offset
+         * \return a reference to the element at the given offset
+         */
+        reference operator[](difference_type n) const
+        {
+            return m_ring->Slot(m_index + n);
+        }
+
+        /// \return the incremented iterator
+        IteratorImpl& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        /// \return the iterator before the increment
+        IteratorImpl operator++(int)
+        {
+            IteratorImpl tmp = *this;
+            ++m_index;
+            return tmp;
+        }
+
+        /// \return the decremented iterator
+        IteratorImpl& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        /// \return the iterator before the decrement
+        IteratorImpl operator--(int)
+        {
+            IteratorImpl tmp = *this;
+            --m_index;
+            return tmp;
+        }
+
+        /**
+         * \param n the offset
+         * \return this iterator, advanced by the given offset
+         */
+        IteratorImpl& operator+=(difference_type n)
+        {
+            m_index += n;
+            return *this;
+        }
+
+        /**
+         * \param n the offset
+         * \return this iterator, moved back by the given offset
+         */
+        IteratorImpl& operator-=(difference_type n)
+        {
+            m_index -= n;
+            return *this;
+        }
+
+        /**
+         * \param n the offset
+         * \return an iterator advanced by the given offset
+         */
+        IteratorImpl operator+(difference_type n) const
+        {
+            return IteratorImpl(m_ring, m_index + n);
+        }
+
+        /**
+         * \param n the offset
+         * \return an iterator moved back by the given offset
+         */
+        IteratorImpl operator-(difference_type n) const
+        {
+            return IteratorImpl(m_ring, m_index - n);
+        }
+
+        /**
+         * \param other another iterator on the same ring buffer
+         * \return the distance between the two iterators
+         */
+        template <bool OtherConst>
+        difference_type operator-(const IteratorImpl<OtherConst>& other) const
+        {
+            return static_cast<difference_type>(m_index) -
+                   static_cast<difference_type>(other.m_index);
+        }
+
+        /**
+         * \param other another iterator
+         * \return true if the two iterators point to the same element
+         */
+        template <bool OtherConst>
+        bool operator==(const IteratorImpl<OtherConst>& other) const
+        {
+            return m_ring == other.m_ring && m_index == other.m_index;
+        }
+
+        /**
+         * \param other another iterator
+         * \return true if the two iterators point to different elements
+         */
+        template <bool OtherConst>
+        bool operator!=(const IteratorImpl<OtherConst>& other) const
+        {
+            return !(*this == other);
+        }
+
+        /**
+         * \param other another iterator on the same ring buffer
+         * \return true if this iterator precedes the other one
+         */
+        template <bool OtherConst>
+        bool operator<(const IteratorImpl<OtherConst>& other) const
+        {
+            return m_index < other.m_index;
+        }
+
+      private:
+        friend class RingBuffer;
+        friend class IteratorImpl<!IsConst>;
+
+        RingPtr m_ring;    //!< the ring buffer
+        size_type m_index; //!< the position relative to the first element
+    };
+
+    /// Iterator
+    using iterator = IteratorImpl<false>;
+    /// Const iterator
+    using const_iterator = IteratorImpl<true>;
+
+    RingBuffer();
+
+    /**
+     * Construct a ring buffer with the given initial capacity.
+     *
+     * \param capacity the initial capacity, rounded up to a power of two
+     */
+    explicit RingBuffer(size_type capacity);
+
+    /// \return an iterator to the first element
+    iterator begin();
+    /// \return an iterator past the last element
+    iterator end();
+    /// \return a const iterator to the first element
+    const_iterator begin() const;
+    /// \return a const iterator past the last element
+    const_iterator end() const;
+    /// \return a const iterator to the first element
+    const_iterator cbegin() const;
+    /// \return a const iterator past the last element
+    const_iterator cend() const;
+
+    /// \return the number of elements
+    size_type size() const;
+    /// \return true if there are no elements
+    bool empty() const;
+    /// \return the number of elements that can be stored without growing
+    size_type capacity() const;
+
+    /**
+     * Make sure that the given number of elements can be stored without growing.
+     *
+     * \param capacity the requested capacity, rounded up to a power of two
+     */
+    void reserve(size_type capacity);
+
+    /**
+     * \param n the position of the element
+     * \return a reference to the element at the given position
+     */
+    reference operator[](size_type n);
+    /**
+     * \param n the position of the element
+     * \return a const reference to the element at the given position
+     */
+    const_reference operator[](size_type n) const;
+
+    /// \return a reference to the first element
+    reference front();
+    /// \return a const reference to the first element
+    const_reference front() const;
+    /// \return a reference to the last element
+    reference back();
+    /// \return a const reference to the last element
+    const_reference back() const;
+
+    /**
+     * Add an element after the last element.
+     * \param value the element to add
+     */
+    void push_back(T value);
+    /**
+     * Add an element before the first element.
+     * \param value the element to add
+     */
+    void push_front(T value);
+    /// Remove the last element
+    void pop_back();
+    /// Remove the first element
+    void pop_front();
+
+    /**
+     * Insert an element before the given position.
+     *
+     * \param pos iterator before which the element is inserted
+     * \param value the element to insert
+     * \return an iterator pointing to the inserted element
+     */
+    iterator insert(const_iterator pos, T value);
+
+    /**
+     * Remove the element at the given position.
+     *
+     * \param pos iterator pointing to the element to remove
+     * \return an iterator pointing to the element following the removed one
+     */
+    iterator erase(const_iterator pos);
+
+    /// Remove all the elements
+    void clear();
+
+  private:
+    /**
+     * \param index the position relative to the first element
+     * \return a reference to the slot storing the element at the given position
+     */
+    T& Slot(size_type index);
+    /**
+     * \param index the position relative to the first element
+     * \return a const reference to the slot storing the element at the given position
+     */
+    const T& Slot(size_type index) const;
+
+    /**
+     * Grow the storage to the given capacity, placing the first element at
+     * the beginning of the new storage.
+     *
+     * \param capacity the new capacity, a power of two
+     */
+    void Grow(size_type capacity);
+
+    /**
+     * \param n a number
+     * \return the smallest power of two that is not less than the given number
+     */
+    static size_type RoundUp(size_type n);
+
+    std::vector<T> m_slots; //!< the storage, whose size is a power of two
+    size_type m_head;       //!< index of the slot storing the first element
+    size_type m_size;       //!< number of elements
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T>
+RingBuffer<T>::RingBuffer()
+    : m_head(0),
+      m_size(0)
+{
+}
+
+template <typename T>
+RingBuffer<T>::RingBuffer(size_type capacity)
+    : m_slots(RoundUp(capacity)),
+      m_head(0),
+      m_size(0)
+{
+}
+
+template <typename T>
+typename RingBuffer<T>::size_type
+RingBuffer<T>::RoundUp(size_type n)
+{
+    size_type capacity = 1;
+    while (capacity < n)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+template <typename T>
+T&
+RingBuffer<T>::Slot(size_type index)
+{
+    return m_slots[(m_head + index) & (m_slots.size() - 1)];
+}
+
+template <typename T>
+const T&
+RingBuffer<T>::Slot(size_type index) const
+{
+    return m_slots[(m_head + index) & (m_slots.size() - 1)];
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::begin()
+{
+    return iterator(this, 0);
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::end()
+{
+    return iterator(this, m_size);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::end() const
+{
+    return const_iterator(this, m_size);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::cbegin() const
+{
+    return begin();
+}
+
+template <typename T>
+typename RingBuffer<T>::const_iterator
+RingBuffer<T>::cend() const
+{
+    return end();
+}
+
+template <typename T>
+typename RingBuffer<T>::size_type
+RingBuffer<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+bool
+RingBuffer<T>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T>
+typename RingBuffer<T>::size_type
+RingBuffer<T>::capacity() const
+{
+    return m_slots.size();
+}
+
+template <typename T>
+void
+RingBuffer<T>::reserve(size_type capacity)
+{
+    if (capacity > m_slots.size())
+    {
+        Grow(RoundUp(capacity));
+    }
+}
+
+template <typename T>
+void
+RingBuffer<T>::Grow(size_type capacity)
+{
+    std::vector<T> slots(capacity);
+    for (size_type i = 0; i < m_size; i++)
+    {
+        slots[i] = std::move(Slot(i));
+    }
+    m_slots.swap(slots);
+    m_head = 0;
+}
+
+template <typename T>
+typename RingBuffer<T>::reference
+RingBuffer<T>::operator[](size_type n)
+{
+    NS_ASSERT(n < m_size);
+    return Slot(n);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_reference
+RingBuffer<T>::operator[](size_type n) const
+{
+    NS_ASSERT(n < m_size);
+    return Slot(n);
+}
+
+template <typename T>
+typename RingBuffer<T>::reference
+RingBuffer<T>::front()
+{
+    NS_ASSERT(m_size > 0);
+    return Slot(0);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_reference
+RingBuffer<T>::front() const
+{
+    NS_ASSERT(m_size > 0);
+    return Slot(0);
+}
+
+template <typename T>
+typename RingBuffer<T>::reference
+RingBuffer<T>::back()
+{
+    NS_ASSERT(m_size > 0);
+    return Slot(m_size - 1);
+}
+
+template <typename T>
+typename RingBuffer<T>::const_reference
+RingBuffer<T>::back() const
+{
+    NS_ASSERT(m_size > 0);
+    return Slot(m_size - 1);
+}
+
+template <typename T>
+void
+RingBuffer<T>::push_back(T value)
+{
+    if (m_size == m_slots.size())
+    {
+        Grow(m_slots.empty() ? 16 : 2 * m_slots.size());
+    }
+    Slot(m_size) = std::move(value);
+    m_size++;
+}
+
+template <typename T>
+void
+RingBuffer<T>::push_front(T value)
+{
+    if (m_size == m_slots.size())
+    {
+        Grow(m_slots.empty() ? 16 : 2 * m_slots.size());
+    }
+    m_head = (m_head + m_slots.size() - 1) & (m_slots.size() - 1);
+    Slot(0) = std::move(value);
+    m_size++;
+}
+
+template <typename T>
+void
+RingBuffer<T>::pop_back()
+{
+    NS_ASSERT(m_size > 0);
+    Slot(m_size - 1) = T();
+    m_size--;
+}
+
+template <typename T>
+void
+RingBuffer<T>::pop_front()
+{
+    NS_ASSERT(m_size > 0);
+    Slot(0) = T();
+    m_head = (m_head + 1) & (m_slots.size() - 1);
+    m_size--;
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::insert(const_iterator pos, T value)
+{
+    NS_ASSERT(pos.m_ring == this && pos.m_index <= m_size);
+    size_type index = pos.m_index;
+
+    if (index < m_size / 2)
+    {
+        // move the elements before the position one slot backward
+        push_front(std::move(value));
+        for (size_type i = 0; i < index; i++)
+        {
+            std::swap(Slot(i), Slot(i + 1));
+        }
+    }
+    else
+    {
+        // move the elements from the position on one slot forward
+        push_back(std::move(value));
+        for (size_type i = m_size - 1; i > index; i--)
+        {
+            std::swap(Slot(i), Slot(i - 1));
+        }
+    }
+    return iterator(this, index);
+}
+
+template <typename T>
+typename RingBuffer<T>::iterator
+RingBuffer<T>::erase(const_iterator pos)
+{
+    NS_ASSERT(pos.m_ring == this && pos.m_index < m_size);
+    size_type index = pos.m_index;
+
+    if (index < m_size / 2)
+    {
+        // move the elements before the position one slot forward
+        for (size_type i = index; i > 0; i--)
+        {
+            std::swap(Slot(i), Slot(i - 1));
+        }
+        pop_front();
+    }
+    else
+    {
+        // move the elements after the position one slot backward
+        for (size_type i = index; i + 1 < m_size; i++)
+        {
+            std::swap(Slot(i), Slot(i + 1));
+        }
+        pop_back();
+    }
+    return iterator(this, index);
+}
+
+template <typename T>
+void
+RingBuffer<T>::clear()
+{
+    while (!empty())
+    {
+        pop_back();
+    }
+    m_head = 0;
+}
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
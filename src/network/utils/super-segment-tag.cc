@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#include "super-segment-tag.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SuperSegmentTag");
+
+NS_OBJECT_ENSURE_REGISTERED(SuperSegmentTag);
+
+TypeId
+SuperSegmentTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::SuperSegmentTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<SuperSegmentTag>();
+    return tid;
+}
+
+TypeId
+SuperSegmentTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+SuperSegmentTag::GetSerializedSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return 8;
+}
+
+void
+SuperSegmentTag::Serialize(TagBuffer buf) const
+{
+    NS_LOG_FUNCTION(this << &buf);
+    buf.WriteU32(m_segmentSize);
+    buf.WriteU32(m_payloadSize);
+}
+
+void
+SuperSegmentTag::Deserialize(TagBuffer buf)
+{
+    NS_LOG_FUNCTION(this << &buf);
+    m_segmentSize = buf.ReadU32();
+    m_payloadSize = buf.ReadU32();
+}
+
+void
+SuperSegmentTag::Print(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this << &os);
+    os << "SegmentSize=" << m_segmentSize << " PayloadSize=" << m_payloadSize;
+}
+
+SuperSegmentTag::SuperSegmentTag()
+    : Tag(),
+      m_segmentSize(0),
+      m_payloadSize(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SuperSegmentTag::SuperSegmentTag(uint32_t segmentSize, uint32_t payloadSize)
+    : Tag(),
+      m_segmentSize(segmentSize),
+      m_payloadSize(payloadSize)
+{
+    NS_LOG_FUNCTION(this << segmentSize << payloadSize);
+}
+
+uint32_t
+SuperSegmentTag::GetSegmentSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_segmentSize;
+}
+
+uint32_t
+SuperSegmentTag::GetPayloadSize() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_payloadSize;
+}
+
+uint32_t
+SuperSegmentTag::GetSegments() const
+{
+    NS_LOG_FUNCTION(this);
+    if (m_segmentSize == 0)
+    {
+        return 1;
+    }
+    return std::max<uint32_t>((m_payloadSize + m_segmentSize - 1) / m_segmentSize, 1);
+}
+
+uint32_t
+SuperSegmentTag::GetSegmentsSize(uint32_t packetSize) const
+{
+    NS_LOG_FUNCTION(this << packetSize);
+    NS_ASSERT(packetSize >= m_payloadSize);
+    return packetSize + (GetSegments() - 1) * (packetSize - m_payloadSize);
+}
+
+} // namespace ns3
@@ -0,0 +1,80 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef SUPER_SEGMENT_TAG_H
+#define SUPER_SEGMENT_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Packet tag marking a super-segment
+ *
+ * A super-segment is a packet standing for a number of segments sent back to
+ * back, as the segments of a TSO/GSO send in Linux: its payload is the
+ * payload of all the segments, and its headers are the headers that each
+ * segment carries. Devices that support super-segments (see
+ * NetDevice::SupportsSuperSegments) send them as a single packet, in the
+ * time taken by all the segments; the other devices are handed the
+ * segments by the network layer.
+ */
+class SuperSegmentTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+    SuperSegmentTag();
+
+    /**
+     * Constructs a SuperSegmentTag
+     *
+     * \param segmentSize the size of the payload of a segment
+     * \param payloadSize the size of the payload of the super-segment
+     */
+    SuperSegmentTag(uint32_t segmentSize, uint32_t payloadSize);
+
+    /**
+     * \return the size of the payload of a segment, except the last one
+     */
+    uint32_t GetSegmentSize() const;
+
+    /**
+     * \return the size of the payload of the super-segment
+     */
+    uint32_t GetPayloadSize() const;
+
+    /**
+     * \return the number of segments of the super-segment
+     */
+    uint32_t GetSegments() const;
+
+    /**
+     * \brief Get the size of the segments of a super-segment
+     *
+     * The headers of the super-segment are repeated in every segment.
+     *
+     * \param packetSize the size of the super-segment, headers included
+     * \return the total size of its segments, headers included
+     */
+    uint32_t GetSegmentsSize(uint32_t packetSize) const;
+
+  private:
+    uint32_t m_segmentSize; //!< Size of the payload of a segment
+    uint32_t m_payloadSize; //!< Size of the payload of the super-segment
+};
+
+} // namespace ns3
+
+#endif /* SUPER_SEGMENT_TAG_H */
@@ -87,6 +87,23 @@ NixVectorHelper<T>::PrintRoute(Ptr<Node> source,
     rp->PrintRoutingPath(source, dest, stream, unit);
 }
 
+template <typename T>
+void
+NixVectorHelper<T>::PrecomputeNixVectors(const std::vector<std::pair<Ptr<Node>, IpAddress>>& flows,
+                                         uint32_t nThreads)
+{
+    std::vector<std::pair<Ptr<NixVectorRouting<IpRoutingProtocol>>, IpAddress>> routes;
+    for (const auto& [source, dest] : flows)
+    {
+        Ptr<NixVectorRouting<IpRoutingProtocol>> rp =
+            T::template GetRouting<NixVectorRouting<IpRoutingProtocol>>(
+                source->template GetObject<Ip>()->GetRoutingProtocol());
+        NS_ASSERT(rp);
+        routes.emplace_back(rp, dest);
+    }
+    NixVectorRouting<IpRoutingProtocol>::PrecomputeNixVectors(routes, nThreads);
+}
+
 template class NixVectorHelper<Ipv4RoutingHelper>;
 template class NixVectorHelper<Ipv6RoutingHelper>;
 
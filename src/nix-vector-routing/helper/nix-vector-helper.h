@@ -18,6 +18,9 @@
 #include "ns3/ipv6-routing-helper.h"
 #include "ns3/object-factory.h"
 
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -104,6 +107,18 @@ class NixVectorHelper : public std::enable_if_t<std::is_same_v<Ipv4RoutingHelper
                             Ptr<OutputStreamWrapper> stream,
                             Time::Unit unit = Time::S);
 
+    /**
+     * \brief builds the nix-vectors of the given flows before the simulation is run,
+     * across the given number of threads.
+     * \param flows the source node and the IP destination address of each flow
+     * \param nThreads the number of threads (0 to use one thread per CPU core)
+     *
+     * This method calls the PrecomputeNixVectors() method of the
+     * NixVectorRouting with the routing protocol of the source nodes.
+     */
+    static void PrecomputeNixVectors(const std::vector<std::pair<Ptr<Node>, IpAddress>>& flows,
+                                     uint32_t nThreads = 0);
+
   private:
     ObjectFactory m_agentFactory; //!< Object factory
 
@@ -14,13 +14,18 @@
 #include "nix-vector-routing.h"
 
 #include "ns3/abort.h"
+#include "ns3/global-value.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
 #include "ns3/loopback-net-device.h"
 #include "ns3/names.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <queue>
+#include <thread>
 
 namespace ns3
 {
@@ -30,6 +35,18 @@ NS_LOG_COMPONENT_DEFINE("NixVectorRouting");
 NS_OBJECT_TEMPLATE_CLASS_DEFINE(NixVectorRouting, Ipv4RoutingProtocol);
 NS_OBJECT_TEMPLATE_CLASS_DEFINE(NixVectorRouting, Ipv6RoutingProtocol);
 
+/**
+ * \relates NixVectorRouting
+ * \anchor GlobalValueNixVectorBfsCacheSize
+ * \brief The number of reverse BFS kept by Nix-vector routing.
+ */
+static GlobalValue g_nixVectorBfsCacheSize =
+    GlobalValue("NixVectorBfsCacheSize",
+                "The maximum number of destination nodes whose reverse BFS is kept, and shared "
+                "by all the nodes, to build the nix-vectors towards them",
+                UintegerValue(256),
+                MakeUintegerChecker<uint32_t>(1));
+
 template <typename T>
 bool NixVectorRouting<T>::g_isCacheDirty = false;
 
@@ -44,6 +61,16 @@ template <typename T>
 typename NixVectorRouting<T>::NetDeviceToIpInterfaceMap
     NixVectorRouting<T>::g_netdeviceToIpInterfaceMap;
 
+template <typename T>
+typename NixVectorRouting<T>::BfsGraph NixVectorRouting<T>::g_bfsGraph;
+
+template <typename T>
+typename NixVectorRouting<T>::BfsDistances NixVectorRouting<T>::g_bfsDistances;
+
+template <typename T>
+std::unordered_map<uint32_t, typename NixVectorRouting<T>::BfsDistances::iterator>
+    NixVectorRouting<T>::g_bfsDistancesIndex;
+
 template <typename T>
 TypeId
 NixVectorRouting<T>::GetTypeId()
@@ -157,6 +184,11 @@ NixVectorRouting<T>::FlushGlobalNixRoutingCache() const
     // IP address to node mapping is potentially invalid so clear it.
     // Will be repopulated in lazy evaluation when mapping is needed.
     g_ipAddressToNodeMap.clear();
+
+    // Same for the topology explored by the BFS and the reverse BFS run on it.
+    g_bfsGraph = BfsGraph();
+    g_bfsDistances.clear();
+    g_bfsDistancesIndex.clear();
 }
 
 template <typename T>
@@ -206,6 +238,20 @@ NixVectorRouting<T>::GetNixVector(Ptr<Node> source, IpAddress dest, Ptr<NetDevic
     {
         // otherwise proceed as normal
         // and build the nix vector
+        if (!oif)
+        {
+            // the reverse BFS from the destination is shared by all the sources
+            if (BuildNixVector(GetBfsGraph(),
+                               GetBfsDistances(destNode->GetId()),
+                               source->GetId(),
+                               nixVector))
+            {
+                return nixVector;
+            }
+            NS_LOG_ERROR("No routing path exists");
+            return nullptr;
+        }
+
         std::vector<Ptr<Node>> parentVector;
 
         if (BFS(NodeList::GetNNodes(), source, destNode, parentVector, oif))
@@ -289,18 +335,93 @@ NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
 
     Ptr<Node> parentNode = parentVector.at(dest);
 
-    uint32_t numberOfDevices = parentNode->GetNDevices();
+    // If we find the node that matches "dest" among the neighbors
+    // then we can add the index to the nix vector.
+    // the index corresponds to the neighbor index
+    std::vector<uint32_t> neighbors;
+    GetNixNeighbors(parentNode, neighbors);
     uint32_t destId = 0;
-    uint32_t totalNeighbors = 0;
+    uint32_t totalNeighbors = neighbors.size();
+    for (uint32_t i = 0; i < totalNeighbors; i++)
+    {
+        if (neighbors[i] == dest)
+        {
+            destId = i;
+        }
+    }
+    NS_LOG_LOGIC("Adding Nix: " << destId << " with " << nixVector->BitCount(totalNeighbors)
+                                << " bits, for node " << parentNode->GetId());
+    nixVector->AddNeighborIndex(destId, nixVector->BitCount(totalNeighbors));
 
-    // scan through the net devices on the T node
+    // recurse through T vector, grabbing the path
+    // and building the nix vector
+    BuildNixVector(parentVector, source, (parentVector.at(dest))->GetId(), nixVector);
+    return true;
+}
+
+template <typename T>
+bool
+NixVectorRouting<T>::BuildNixVector(const BfsGraph& graph,
+                                    const std::vector<uint32_t>& distances,
+                                    uint32_t source,
+                                    Ptr<NixVector> nixVector)
+{
+    NS_LOG_FUNCTION(source << nixVector);
+
+    if (distances.at(source) == NO_PATH)
+    {
+        return false;
+    }
+
+    // walk the path from the source, going at each hop through the first
+    // neighbor visited by the BFS that is one hop closer to the destination
+    std::vector<uint32_t> path{source};
+    for (uint32_t curr = source; distances[curr] > 0;)
+    {
+        const auto& neighbors = graph.neighbors[curr];
+        auto next = std::find_if(neighbors.cbegin(), neighbors.cend(), [&](uint32_t n) {
+            return distances[n] == distances[curr] - 1;
+        });
+        NS_ASSERT_MSG(next != neighbors.cend(), "No neighbor closer to the destination");
+        curr = *next;
+        path.push_back(curr);
+    }
+
+    // the neighbor-indices are added from the last hop, as the recursion
+    // of BuildNixVector does
+    for (std::size_t i = path.size() - 1; i > 0; i--)
+    {
+        const auto& neighbors = graph.nixNeighbors[path[i - 1]];
+        uint32_t destId = 0;
+        for (uint32_t j = 0; j < neighbors.size(); j++)
+        {
+            if (neighbors[j] == path[i])
+            {
+                destId = j;
+            }
+        }
+        nixVector->AddNeighborIndex(destId, nixVector->BitCount(neighbors.size()));
+    }
+    return true;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::GetNixNeighbors(Ptr<Node> node, std::vector<uint32_t>& neighbors) const
+{
+    NS_LOG_FUNCTION(this << node);
+
+    neighbors.clear();
+    uint32_t numberOfDevices = node->GetNDevices();
+
+    // scan through the net devices on the node
     // and then look at the nodes adjacent to them
     for (uint32_t i = 0; i < numberOfDevices; i++)
     {
         // Get a net device from the node
         // as well as the channel, and figure
         // out the adjacent net devices
-        Ptr<NetDevice> localNetDevice = parentNode->GetDevice(i);
+        Ptr<NetDevice> localNetDevice = node->GetDevice(i);
         if (localNetDevice->IsBridge())
         {
             continue;
@@ -316,33 +437,279 @@ NixVectorRouting<T>::BuildNixVector(const std::vector<Ptr<Node>>& parentVector,
         NetDeviceContainer netDeviceContainer;
         GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
 
+        for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End(); iter++)
+        {
+            neighbors.push_back((*iter)->GetNode()->GetId());
+        }
+    }
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::GetBfsNeighbors(Ptr<Node> node, std::vector<Ptr<Node>>& neighbors) const
+{
+    NS_LOG_FUNCTION(this << node);
+
+    neighbors.clear();
+    Ptr<IpL3Protocol> ip = node->GetObject<IpL3Protocol>();
+
+    // Iterate over the node's adjacent vertices
+    for (uint32_t i = 0; i < (node->GetNDevices()); i++)
+    {
+        // Get a net device from the node
+        // as well as the channel, and figure
+        // out the adjacent net device
+        Ptr<NetDevice> localNetDevice = node->GetDevice(i);
+
+        // make sure that we can go this way
+        if (ip)
+        {
+            uint32_t interfaceIndex = (ip)->GetInterfaceForDevice(node->GetDevice(i));
+            if (!(ip->IsUp(interfaceIndex)))
+            {
+                NS_LOG_LOGIC("IpInterface is down");
+                continue;
+            }
+        }
+        if (!(localNetDevice->IsLinkUp()))
+        {
+            NS_LOG_LOGIC("Link is down.");
+            continue;
+        }
+        Ptr<Channel> channel = localNetDevice->GetChannel();
+        if (!channel)
+        {
+            continue;
+        }
+
+        // this function takes in the local net dev, and channel, and
+        // writes to the netDeviceContainer the adjacent net devs
+        NetDeviceContainer netDeviceContainer;
+        GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
+
         // Finally we can get the adjacent nodes
-        // and scan through them.  If we find the
-        // node that matches "dest" then we can add
-        // the index  to the nix vector.
-        // the index corresponds to the neighbor index
-        uint32_t offset = 0;
         for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End(); iter++)
         {
-            Ptr<Node> remoteNode = (*iter)->GetNode();
+            Ptr<IpInterface> remoteIpInterface = GetInterfaceByNetDevice(*iter);
+            if (!remoteIpInterface || !(remoteIpInterface->IsUp()))
+            {
+                NS_LOG_LOGIC("IpInterface either doesn't exist or is down");
+                continue;
+            }
+            neighbors.push_back((*iter)->GetNode());
+        }
+    }
+}
+
+template <typename T>
+const typename NixVectorRouting<T>::BfsGraph&
+NixVectorRouting<T>::GetBfsGraph() const
+{
+    NS_LOG_FUNCTION(this);
+
+    const uint32_t numberOfNodes = NodeList::GetNNodes();
+    if (g_bfsGraph.neighbors.size() == numberOfNodes)
+    {
+        return g_bfsGraph;
+    }
+
+    // nodes have been added since the topology was read
+    NS_LOG_LOGIC("Reading the topology of " << numberOfNodes << " nodes");
+    g_bfsDistances.clear();
+    g_bfsDistancesIndex.clear();
+    g_bfsGraph.neighbors.assign(numberOfNodes, {});
+    g_bfsGraph.predecessors.assign(numberOfNodes, {});
+    g_bfsGraph.nixNeighbors.assign(numberOfNodes, {});
+
+    std::vector<Ptr<Node>> neighbors;
+    for (uint32_t i = 0; i < numberOfNodes; i++)
+    {
+        Ptr<Node> node = NodeList::GetNode(i);
+        GetBfsNeighbors(node, neighbors);
+        for (const auto& neighbor : neighbors)
+        {
+            // only the first time a node is visited matters to the BFS
+            const auto id = neighbor->GetId();
+            auto& ids = g_bfsGraph.neighbors[i];
+            if (std::find(ids.cbegin(), ids.cend(), id) == ids.cend())
+            {
+                ids.push_back(id);
+                g_bfsGraph.predecessors[id].push_back(i);
+            }
+        }
+        GetNixNeighbors(node, g_bfsGraph.nixNeighbors[i]);
+    }
+    return g_bfsGraph;
+}
 
-            if (remoteNode->GetId() == dest)
+template <typename T>
+void
+NixVectorRouting<T>::ReverseBFS(const BfsGraph& graph,
+                                uint32_t dest,
+                                std::vector<uint32_t>& distances)
+{
+    NS_LOG_FUNCTION(dest);
+
+    distances.assign(graph.predecessors.size(), NO_PATH);
+    std::queue<uint32_t> greyNodeList; // discovered nodes with unexplored predecessors
+    distances.at(dest) = 0;
+    greyNodeList.push(dest);
+    while (!greyNodeList.empty())
+    {
+        const auto currNode = greyNodeList.front();
+        greyNodeList.pop();
+        for (const auto pred : graph.predecessors[currNode])
+        {
+            if (distances[pred] == NO_PATH)
             {
-                destId = totalNeighbors + offset;
+                distances[pred] = distances[currNode] + 1;
+                greyNodeList.push(pred);
             }
-            offset += 1;
         }
+    }
+}
 
-        totalNeighbors += netDeviceContainer.GetN();
+template <typename T>
+const std::vector<uint32_t>&
+NixVectorRouting<T>::GetBfsDistances(uint32_t dest) const
+{
+    NS_LOG_FUNCTION(this << dest);
+
+    const auto& graph = GetBfsGraph();
+    if (auto it = g_bfsDistancesIndex.find(dest); it != g_bfsDistancesIndex.end())
+    {
+        g_bfsDistances.splice(g_bfsDistances.begin(), g_bfsDistances, it->second);
+        return it->second->second;
     }
-    NS_LOG_LOGIC("Adding Nix: " << destId << " with " << nixVector->BitCount(totalNeighbors)
-                                << " bits, for node " << parentNode->GetId());
-    nixVector->AddNeighborIndex(destId, nixVector->BitCount(totalNeighbors));
 
-    // recurse through T vector, grabbing the path
-    // and building the nix vector
-    BuildNixVector(parentVector, source, (parentVector.at(dest))->GetId(), nixVector);
-    return true;
+    UintegerValue cacheSize;
+    g_nixVectorBfsCacheSize.GetValue(cacheSize);
+    if (g_bfsDistances.size() >= cacheSize.Get())
+    {
+        // evict the least recently used destination, reusing its entry
+        while (g_bfsDistances.size() > cacheSize.Get())
+        {
+            g_bfsDistancesIndex.erase(g_bfsDistances.back().first);
+            g_bfsDistances.pop_back();
+        }
+        g_bfsDistancesIndex.erase(g_bfsDistances.back().first);
+        g_bfsDistances.splice(g_bfsDistances.begin(),
+                              g_bfsDistances,
+                              std::prev(g_bfsDistances.end()));
+        g_bfsDistances.front().first = dest;
+    }
+    else
+    {
+        g_bfsDistances.emplace_front(dest, std::vector<uint32_t>());
+    }
+    g_bfsDistancesIndex.emplace(dest, g_bfsDistances.begin());
+
+    auto& distances = g_bfsDistances.front().second;
+    ReverseBFS(graph, dest, distances);
+    return distances;
+}
+
+template <typename T>
+void
+NixVectorRouting<T>::PrecomputeNixVectors(
+    const std::vector<std::pair<Ptr<NixVectorRouting<T>>, IpAddress>>& flows,
+    uint32_t nThreads)
+{
+    NS_LOG_FUNCTION(flows.size() << nThreads);
+
+    if (flows.empty())
+    {
+        return;
+    }
+
+    /// A flow whose nix-vector is to be built
+    struct Flow
+    {
+        uint32_t source;              //!< the source node ID
+        uint32_t dest;                //!< the destination node ID
+        Ptr<NixVectorRouting<T>> rp;  //!< the routing protocol of the source node
+        IpAddress address;            //!< the destination address
+        Ptr<NixVector> nixVector;     //!< the nix-vector of the flow
+    };
+
+    //
+    // Read the topology and find the flows whose nix-vector is not cached,
+    // as the BFS only reads plain arrays which can be shared by threads
+    //
+    flows.front().first->CheckCacheStateAndFlush();
+    const auto& graph = flows.front().first->GetBfsGraph();
+
+    std::vector<Flow> pending;
+    for (const auto& [rp, address] : flows)
+    {
+        NS_ASSERT(rp);
+        Ptr<Node> destNode = rp->GetNodeByIp(address);
+        if (!destNode || destNode == rp->m_node || rp->m_nixCache.count(address))
+        {
+            continue;
+        }
+        pending.push_back({rp->m_node->GetId(), destNode->GetId(), rp, address, nullptr});
+    }
+    std::stable_sort(pending.begin(), pending.end(), [](const Flow& a, const Flow& b) {
+        return a.dest < b.dest;
+    });
+
+    // the flows towards the same destination node are handled by the same thread
+    std::vector<std::size_t> firstFlows;
+    for (std::size_t i = 0; i < pending.size(); i++)
+    {
+        if (i == 0 || pending[i].dest != pending[i - 1].dest)
+        {
+            firstFlows.push_back(i);
+        }
+    }
+    firstFlows.push_back(pending.size());
+
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    nThreads = std::max<std::size_t>(std::min<std::size_t>(nThreads, firstFlows.size() - 1), 1);
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        std::vector<uint32_t> distances;
+        for (std::size_t d; (d = next++) + 1 < firstFlows.size();)
+        {
+            ReverseBFS(graph, pending[firstFlows[d]].dest, distances);
+            for (auto i = firstFlows[d]; i < firstFlows[d + 1]; i++)
+            {
+                auto nixVector = Create<NixVector>();
+                if (BuildNixVector(graph, distances, pending[i].source, nixVector))
+                {
+                    pending[i].nixVector = nixVector;
+                }
+            }
+        }
+    };
+
+    NS_LOG_INFO("Building the nix-vectors of " << pending.size() << " flows towards "
+                                               << firstFlows.size() - 1 << " nodes using "
+                                               << nThreads << " threads");
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < nThreads; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto& flow : pending)
+    {
+        if (flow.nixVector)
+        {
+            flow.nixVector->SetEpoch(g_epoch);
+            flow.rp->m_nixCache.insert(typename NixMap_t::value_type(flow.address, flow.nixVector));
+        }
+    }
 }
 
 template <typename T>
@@ -1199,64 +1566,20 @@ NixVectorRouting<T>::BFS(uint32_t numberOfNodes,
         else
         {
             // Iterate over the current node's adjacent vertices
-            // and push them into the queue
-            for (uint32_t i = 0; i < (currNode->GetNDevices()); i++)
+            // and push them into the queue, if they aren't
+            // already there.
+            std::vector<Ptr<Node>> neighbors;
+            GetBfsNeighbors(currNode, neighbors);
+            for (const auto& remoteNode : neighbors)
             {
-                // Get a net device from the node
-                // as well as the channel, and figure
-                // out the adjacent net device
-                Ptr<NetDevice> localNetDevice = currNode->GetDevice(i);
-
-                // make sure that we can go this way
-                if (ip)
-                {
-                    uint32_t interfaceIndex = (ip)->GetInterfaceForDevice(currNode->GetDevice(i));
-                    if (!(ip->IsUp(interfaceIndex)))
-                    {
-                        NS_LOG_LOGIC("IpInterface is down");
-                        continue;
-                    }
-                }
-                if (!(localNetDevice->IsLinkUp()))
-                {
-                    NS_LOG_LOGIC("Link is down.");
-                    continue;
-                }
-                Ptr<Channel> channel = localNetDevice->GetChannel();
-                if (!channel)
-                {
-                    continue;
-                }
-
-                // this function takes in the local net dev, and channel, and
-                // writes to the netDeviceContainer the adjacent net devs
-                NetDeviceContainer netDeviceContainer;
-                GetAdjacentNetDevices(localNetDevice, channel, netDeviceContainer);
-
-                // Finally we can get the adjacent nodes
-                // and scan through them.  We push them
-                // to the greyNode queue, if they aren't
-                // already there.
-                for (auto iter = netDeviceContainer.Begin(); iter != netDeviceContainer.End();
-                     iter++)
+                // check to see if this node has been pushed before
+                // by checking to see if it has a parent
+                // if it doesn't (null or 0), then set its parent and
+                // push to the queue
+                if (!parentVector.at(remoteNode->GetId()))
                 {
-                    Ptr<Node> remoteNode = (*iter)->GetNode();
-                    Ptr<IpInterface> remoteIpInterface = GetInterfaceByNetDevice(*iter);
-                    if (!remoteIpInterface || !(remoteIpInterface->IsUp()))
-                    {
-                        NS_LOG_LOGIC("IpInterface either doesn't exist or is down");
-                        continue;
-                    }
-
-                    // check to see if this node has been pushed before
-                    // by checking to see if it has a parent
-                    // if it doesn't (null or 0), then set its parent and
-                    // push to the queue
-                    if (!parentVector.at(remoteNode->GetId()))
-                    {
-                        parentVector.at(remoteNode->GetId()) = currNode;
-                        greyNodeList.push(remoteNode);
-                    }
+                    parentVector.at(remoteNode->GetId()) = currNode;
+                    greyNodeList.push(remoteNode);
                 }
             }
         }
@@ -1432,5 +1755,11 @@ template void NixVectorRouting<Ipv6RoutingProtocol>::PrintRoutingPath(
     IpAddress dest,
     Ptr<OutputStreamWrapper> stream,
     Time::Unit unit) const;
+template void NixVectorRouting<Ipv4RoutingProtocol>::PrecomputeNixVectors(
+    const std::vector<std::pair<Ptr<NixVectorRouting<Ipv4RoutingProtocol>>, IpAddress>>& flows,
+    uint32_t nThreads);
+template void NixVectorRouting<Ipv6RoutingProtocol>::PrecomputeNixVectors(
+    const std::vector<std::pair<Ptr<NixVectorRouting<Ipv6RoutingProtocol>>, IpAddress>>& flows,
+    uint32_t nThreads);
 
 } // namespace ns3
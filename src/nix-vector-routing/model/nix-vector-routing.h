@@ -30,8 +30,12 @@
 #include "ns3/node-list.h"
 #include "ns3/nstime.h"
 
+#include <limits>
+#include <list>
 #include <map>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 // NOLINTBEGIN(modernize-use-override)
 
@@ -131,7 +135,45 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                           Ptr<OutputStreamWrapper> stream,
                           Time::Unit unit) const;
 
+    /**
+     * @brief Build the nix-vectors of the given flows and store them in the
+     * nix-vector cache of their source node, spreading the BFS across threads
+     *
+     * This method is meant to be called before the simulation is run, so that
+     * the first packets of the flows do not trigger the computation of their
+     * nix-vector. The topology is read once, then the flows are grouped by
+     * destination node and a single BFS is run for each destination node, by
+     * worker threads which only access a snapshot of the topology.
+     *
+     * \param flows the Nix-vector routing protocol of the source node and the
+     *              destination address of each flow
+     * \param nThreads the number of threads (0 to use one thread per CPU core)
+     *
+     * \note IpAddress is alias for either Ipv4Address or Ipv6Address
+     *       depending on on whether the network is IPv4 or IPv6 respectively.
+     */
+    static void PrecomputeNixVectors(
+        const std::vector<std::pair<Ptr<NixVectorRouting<T>>, IpAddress>>& flows,
+        uint32_t nThreads);
+
   private:
+    /// Distance of the nodes from which a destination cannot be reached
+    static constexpr uint32_t NO_PATH = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * The topology explored by the BFS, indexed by node ID and shared by the
+     * routing protocols of all the nodes.
+     */
+    struct BfsGraph
+    {
+        /// the nodes adjacent to each node, in the order the BFS visits them
+        std::vector<std::vector<uint32_t>> neighbors;
+        /// the nodes to which each node is adjacent
+        std::vector<std::vector<uint32_t>> predecessors;
+        /// the neighbors of each node, indexed by the neighbor-index of the nix-vector
+        std::vector<std::vector<uint32_t>> nixNeighbors;
+    };
+
     /**
      * Flushes the cache which stores nix-vector based on
      * destination IP
@@ -218,6 +260,63 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
                         uint32_t dest,
                         Ptr<NixVector> nixVector) const;
 
+    /**
+     * Builds the nix-vector of the path from a source node to the destination
+     * node of a reverse BFS. At each hop, the path goes through the first node
+     * closer to the destination in the order the BFS visits the neighbors,
+     * which is the path found by a BFS run from the source node.
+     *
+     * \param [in] graph the topology
+     * \param [in] distances the distance of every node from the destination
+     * \param [in] source Source Node index
+     * \param [out] nixVector the NixVector to be used for routing
+     * \returns true on success, false if the destination cannot be reached.
+     */
+    static bool BuildNixVector(const BfsGraph& graph,
+                               const std::vector<uint32_t>& distances,
+                               uint32_t source,
+                               Ptr<NixVector> nixVector);
+
+    /**
+     * Gets the nodes adjacent to a node, in the order the BFS visits them
+     * (a node may appear more than once)
+     * \param [in] node the node
+     * \param [out] neighbors the adjacent nodes
+     */
+    void GetBfsNeighbors(Ptr<Node> node, std::vector<Ptr<Node>>& neighbors) const;
+
+    /**
+     * Gets the neighbors of a node in the order of their neighbor-index
+     * \param [in] node the node
+     * \param [out] neighbors the IDs of the neighbors
+     */
+    void GetNixNeighbors(Ptr<Node> node, std::vector<uint32_t>& neighbors) const;
+
+    /**
+     * Gets the topology explored by the BFS, reading it from the nodes if
+     * it has been flushed
+     * \returns the topology
+     */
+    const BfsGraph& GetBfsGraph() const;
+
+    /**
+     * \brief Reverse breadth first search algorithm, computing the distance
+     * of every node from a destination
+     * \param [in] graph the topology
+     * \param [in] dest Destination Node index
+     * \param [out] distances the distance of every node (NO_PATH if the
+     *              destination cannot be reached)
+     */
+    static void ReverseBFS(const BfsGraph& graph, uint32_t dest, std::vector<uint32_t>& distances);
+
+    /**
+     * Gets the distance of every node from a destination from the cache of
+     * reverse BFS shared by all the nodes, running the reverse BFS if needed
+     * \param dest Destination Node index
+     * \returns the distance of every node from the destination
+     */
+    const std::vector<uint32_t>& GetBfsDistances(uint32_t dest) const;
+
     /**
      * Simply iterates through the nodes net-devices and determines
      * how many neighbors the node has.
@@ -506,6 +605,14 @@ class NixVectorRouting : public std::enable_if_t<std::is_same_v<Ipv4RoutingProto
     typedef std::unordered_map<Ptr<NetDevice>, Ptr<IpInterface>> NetDeviceToIpInterfaceMap;
     static NetDeviceToIpInterfaceMap
         g_netdeviceToIpInterfaceMap; //!< NetDevice pointer to IpInterface pointer map
+
+    static BfsGraph g_bfsGraph; //!< Topology explored by the BFS
+
+    /// Distances from the destination nodes, most recently used first
+    typedef std::list<std::pair<uint32_t, std::vector<uint32_t>>> BfsDistances;
+    static BfsDistances g_bfsDistances; //!< Cache of the reverse BFS
+    /// Entries of the cache of the reverse BFS, by destination node ID
+    static std::unordered_map<uint32_t, typename BfsDistances::iterator> g_bfsDistancesIndex;
 };
 
 /**
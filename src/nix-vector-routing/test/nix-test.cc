@@ -14,6 +14,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/nix-vector-helper.h"
+#include "ns3/nix-vector-routing.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
@@ -382,6 +383,150 @@ NixVectorRoutingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup nix-vector-routing-test
+ * \ingroup tests
+ *
+ * The topology is of the form:
+ * \verbatim
+     n0 -- n1
+     |      |
+     n2 -- n3
+   \endverbatim
+ *
+ * Following are the tests in this test case:
+ * - Test that the path from n0 to n3 goes through n1, the first neighbor of n0
+ *   found by the BFS.
+ * - Test that the nix-vectors precomputed across threads for all the flows are
+ *   the nix-vectors computed on demand.
+ *
+ * \brief IPv4 Nix-Vector Routing Precomputation Test
+ */
+class NixVectorPrecomputeTest : public TestCase
+{
+  public:
+    NixVectorPrecomputeTest();
+
+  private:
+    /**
+     * \brief Look up the route of the given flows and print the nix-vector caches.
+     * \param flows the source node and the destination address of each flow
+     * \param nodes the nodes whose caches are printed
+     * \return the nix-vector caches of the nodes
+     */
+    std::string LookupRoutes(const std::vector<std::pair<Ptr<Node>, Ipv4Address>>& flows,
+                             const NodeContainer& nodes);
+
+    /**
+     * \param node a node
+     * \return the Nix-vector routing protocol of the node
+     */
+    static Ptr<Ipv4NixVectorRouting> GetRouting(Ptr<Node> node);
+
+    void DoRun() override;
+};
+
+NixVectorPrecomputeTest::NixVectorPrecomputeTest()
+    : TestCase("four nodes, precomputed nix-vector test")
+{
+}
+
+Ptr<Ipv4NixVectorRouting>
+NixVectorPrecomputeTest::GetRouting(Ptr<Node> node)
+{
+    return DynamicCast<Ipv4NixVectorRouting>(node->GetObject<Ipv4>()->GetRoutingProtocol());
+}
+
+std::string
+NixVectorPrecomputeTest::LookupRoutes(const std::vector<std::pair<Ptr<Node>, Ipv4Address>>& flows,
+                                      const NodeContainer& nodes)
+{
+    for (const auto& [source, dest] : flows)
+    {
+        Ipv4Header header;
+        header.SetDestination(dest);
+        Socket::SocketErrno sockerr;
+        Ptr<Ipv4Route> route =
+            source->GetObject<Ipv4>()->GetRoutingProtocol()->RouteOutput(Create<Packet>(),
+                                                                         header,
+                                                                         nullptr,
+                                                                         sockerr);
+        NS_TEST_EXPECT_MSG_NE(route, nullptr, "No route from node " << source->GetId());
+    }
+
+    std::ostringstream stringStream;
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(&stringStream);
+    for (auto it = nodes.Begin(); it != nodes.End(); it++)
+    {
+        (*it)->GetObject<Ipv4>()->GetRoutingProtocol()->PrintRoutingTable(stream);
+    }
+    return stringStream.str();
+}
+
+void
+NixVectorPrecomputeTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(4);
+
+    Ipv4NixVectorHelper ipv4NixRouting;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(ipv4NixRouting);
+    stack.SetIpv6StackInstall(false);
+    stack.Install(nodes);
+
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.255.0");
+    std::vector<std::pair<uint32_t, Ipv4Address>> addresses;
+    const std::vector<std::pair<uint32_t, uint32_t>> links{{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+    for (const auto& [a, b] : links)
+    {
+        Ipv4InterfaceContainer interfaces =
+            address.Assign(devHelper.Install(NodeContainer(nodes.Get(a), nodes.Get(b))));
+        addresses.emplace_back(a, interfaces.GetAddress(0));
+        addresses.emplace_back(b, interfaces.GetAddress(1));
+        address.NewNetwork();
+    }
+
+    // there is no route from a node to its own addresses
+    std::vector<std::pair<Ptr<Node>, Ipv4Address>> flows;
+    for (auto it = nodes.Begin(); it != nodes.End(); it++)
+    {
+        for (const auto& [owner, dest] : addresses)
+        {
+            if (owner != (*it)->GetId())
+            {
+                flows.emplace_back(*it, dest);
+            }
+        }
+    }
+
+    // n3 is reached through n1 rather than n2
+    std::ostringstream pathStream;
+    Ptr<OutputStreamWrapper> routingStream = Create<OutputStreamWrapper>(&pathStream);
+    GetRouting(nodes.Get(0))
+        ->PrintRoutingPath(nodes.Get(0), Ipv4Address("10.1.3.2"), routingStream, Time::S);
+    const std::string path =
+        "Time: +0s, Nix Routing\n"
+        "Route path from Node 0 to Node 3, Nix Vector: 01 (2 bits left)\n"
+        "10.1.0.1                 (Node 0)  ---->   10.1.0.2                 (Node 1)\n"
+        "10.1.2.1                 (Node 1)  ---->   10.1.3.2                 (Node 3)\n\n";
+    NS_TEST_EXPECT_MSG_EQ(pathStream.str(), path, "Routing Path is incorrect.");
+
+    Ipv4NixVectorHelper::PrecomputeNixVectors(flows, 2);
+    std::string precomputed = LookupRoutes(flows, nodes);
+
+    GetRouting(nodes.Get(0))->FlushGlobalNixRoutingCache();
+    std::string onDemand = LookupRoutes(flows, nodes);
+    NS_TEST_EXPECT_MSG_EQ(precomputed,
+                          onDemand,
+                          "The precomputed nix-vectors differ from the on-demand nix-vectors");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup nix-vector-routing-test
  * \ingroup tests
@@ -395,6 +540,7 @@ class NixVectorRoutingTestSuite : public TestSuite
         : TestSuite("nix-vector-routing", Type::UNIT)
     {
         AddTestCase(new NixVectorRoutingTest(), TestCase::Duration::QUICK);
+        AddTestCase(new NixVectorPrecomputeTest(), TestCase::Duration::QUICK);
     }
 };
 
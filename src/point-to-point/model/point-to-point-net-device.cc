@@ -16,6 +16,7 @@
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
+#include "ns3/super-segment-tag.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
@@ -240,6 +241,13 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
     Time txCompleteTime = txTime + m_tInterframeGap;
+    SuperSegmentTag superSegment;
+    if (p->PeekPacketTag(superSegment))
+    {
+        // The segments of a super-segment are sent back to back, each with its headers
+        txTime = m_bps.CalculateBytesTxTime(superSegment.GetSegmentsSize(p->GetSize()));
+        txCompleteTime = txTime + m_tInterframeGap * superSegment.GetSegments();
+    }
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
     Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
@@ -597,6 +605,13 @@ PointToPointNetDevice::SupportsSendFrom() const
     return false;
 }
 
+bool
+PointToPointNetDevice::SupportsSuperSegments() const
+{
+    NS_LOG_FUNCTION(this);
+    return true;
+}
+
 void
 PointToPointNetDevice::DoMpiReceive(Ptr<Packet> p)
 {
@@ -186,6 +186,7 @@ class PointToPointNetDevice : public NetDevice
 
     void SetPromiscReceiveCallback(PromiscReceiveCallback cb) override;
     bool SupportsSendFrom() const override;
+    bool SupportsSuperSegments() const override;
 
   protected:
     /**
@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "distance-spectrum-transmit-filter.h"
+
+#include "spectrum-phy.h"
+#include "spectrum-signal-parameters.h"
+
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/mobility-model.h>
+
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("DistanceSpectrumTransmitFilter");
+
+NS_OBJECT_ENSURE_REGISTERED(DistanceSpectrumTransmitFilter);
+
+TypeId
+DistanceSpectrumTransmitFilter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::DistanceSpectrumTransmitFilter")
+            .SetParent<SpectrumTransmitFilter>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<DistanceSpectrumTransmitFilter>()
+            .AddAttribute("MaxRange",
+                          "The distance (in meters) beyond which signals are discarded.",
+                          DoubleValue(std::numeric_limits<double>::max()),
+                          MakeDoubleAccessor(&DistanceSpectrumTransmitFilter::m_maxRange),
+                          MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+DistanceSpectrumTransmitFilter::DistanceSpectrumTransmitFilter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+DistanceSpectrumTransmitFilter::DoFilter(Ptr<const SpectrumSignalParameters> params,
+                                         Ptr<const SpectrumPhy> receiverPhy)
+{
+    NS_LOG_FUNCTION(this << params << receiverPhy);
+
+    auto txMobility = params->txPhy->GetMobility();
+    auto rxMobility = receiverPhy->GetMobility();
+    if (!txMobility || !rxMobility)
+    {
+        return false;
+    }
+
+    if (auto distance = txMobility->GetDistanceFrom(rxMobility); distance > m_maxRange)
+    {
+        NS_LOG_DEBUG("Receiver at distance " << distance << "m out of range: filter");
+        return true;
+    }
+    return false;
+}
+
+int64_t
+DistanceSpectrumTransmitFilter::DoAssignStreams(int64_t stream)
+{
+    return 0;
+}
+
+} // namespace ns3
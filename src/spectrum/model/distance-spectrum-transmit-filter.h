@@ -0,0 +1,51 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef DISTANCE_SPECTRUM_TRANSMIT_FILTER_H
+#define DISTANCE_SPECTRUM_TRANSMIT_FILTER_H
+
+#include "spectrum-transmit-filter.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief transmit filter discarding the receivers that are too far from the transmitter
+ *
+ * This filter discards the signals whose receiver is farther than the MaxRange
+ * attribute from the transmitter, before any antenna gain, propagation loss or
+ * propagation delay is computed for the receiver.  It is meant to complement the
+ * MaxLossDb attribute of SpectrumChannel, which only discards the signals after
+ * the propagation loss has been computed.  The user is responsible for setting a
+ * conservative range, beyond which the received power is certainly negligible
+ * given the transmit power and the propagation loss model in use.
+ *
+ * Signals are not filtered if the transmitter or the receiver has no mobility model.
+ */
+class DistanceSpectrumTransmitFilter : public SpectrumTransmitFilter
+{
+  public:
+    DistanceSpectrumTransmitFilter();
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+  protected:
+    int64_t DoAssignStreams(int64_t stream) override;
+
+  private:
+    bool DoFilter(Ptr<const SpectrumSignalParameters> params,
+                  Ptr<const SpectrumPhy> receiverPhy) override;
+
+    double m_maxRange; //!< the distance (m) beyond which signals are discarded
+};
+
+} // namespace ns3
+
+#endif /* DISTANCE_SPECTRUM_TRANSMIT_FILTER_H */
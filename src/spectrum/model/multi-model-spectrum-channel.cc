@@ -226,6 +226,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     m_txSigParamsTrace(txParamsTrace);
 
     auto txMobility = txParams->txPhy->GetMobility();
+    auto txNetDevice = txParams->txPhy->GetDevice();
     auto txSpectrumModelUid = txParams->psd->GetSpectrumModelUid();
     NS_LOG_LOGIC("txSpectrumModelUid " << txSpectrumModelUid);
 
@@ -247,7 +248,6 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             if ((*rxPhyIterator) != txParams->txPhy)
             {
                 auto rxNetDevice = (*rxPhyIterator)->GetDevice();
-                auto txNetDevice = txParams->txPhy->GetDevice();
 
                 if (rxNetDevice && txNetDevice)
                 {
@@ -266,10 +266,8 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     continue;
                 }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                auto rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(txParams->psd);
                 Time delay{0};
+                auto pathGainLinear{1.0};
 
                 auto receiverMobility = (*rxPhyIterator)->GetMobility();
 
@@ -279,10 +277,10 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     auto rxAntennaGain{0.0};
                     auto propagationGainDb{0.0};
                     auto pathLossDb{0.0};
-                    if (rxParams->txAntenna)
+                    if (txParams->txAntenna)
                     {
                         Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                        txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
                         NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
                         pathLossDb -= txAntennaGain;
                     }
@@ -323,8 +321,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                         // beyond range
                         continue;
                     }
-                    auto pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                    *(rxParams->psd) *= pathGainLinear;
+                    pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
 
                     if (m_propagationDelay)
                     {
@@ -332,6 +329,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
+                // copy the signal parameters (including the PSD) only for the
+                // receivers that are in range
+                NS_LOG_LOGIC("copying signal parameters " << txParams);
+                auto rxParams = txParams->Copy();
+                if (txMobility && receiverMobility)
+                {
+                    *(rxParams->psd) *= pathGainLinear;
+                }
+
                 if (rxNetDevice)
                 {
                     // the receiver has a NetDevice, so we expect that it is attached to a Node
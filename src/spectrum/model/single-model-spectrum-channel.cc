@@ -112,11 +112,11 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     }
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
     for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
     {
         Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
-        Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
         if (rxNetDevice && txNetDevice)
         {
@@ -139,8 +139,7 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             Time delay = MicroSeconds(0);
 
             Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-            NS_LOG_LOGIC("copying signal parameters " << txParams);
-            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+            double pathGainLinear = 1;
 
             if (senderMobility && receiverMobility)
             {
@@ -148,10 +147,10 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 double rxAntennaGain = 0;
                 double propagationGainDb = 0;
                 double pathLossDb = 0;
-                if (rxParams->txAntenna)
+                if (txParams->txAntenna)
                 {
                     Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
-                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                    txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
                     NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
                     pathLossDb -= txAntennaGain;
                 }
@@ -186,8 +185,7 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     // beyond range
                     continue;
                 }
-                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                *(rxParams->psd) *= pathGainLinear;
+                pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
 
                 if (m_propagationDelay)
                 {
@@ -195,6 +193,15 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 }
             }
 
+            // copy the signal parameters (including the PSD) only for the
+            // receivers that are in range
+            NS_LOG_LOGIC("copying signal parameters " << txParams);
+            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+            if (senderMobility && receiverMobility)
+            {
+                *(rxParams->psd) *= pathGainLinear;
+            }
+
             if (rxNetDevice)
             {
                 // the receiver has a NetDevice, so we expect that it is attached to a Node
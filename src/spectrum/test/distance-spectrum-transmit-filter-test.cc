@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/distance-spectrum-transmit-filter.h>
+#include <ns3/double.h>
+#include <ns3/half-duplex-ideal-phy.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/spectrum-model-ism2400MHz-res1MHz.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/test.h>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the DistanceSpectrumTransmitFilter discards the receivers
+ * beyond its range, before the path loss is computed by the channel.
+ */
+class DistanceSpectrumTransmitFilterTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param channelType the TypeId name of the channel
+     */
+    DistanceSpectrumTransmitFilterTestCase(std::string channelType);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when the channel computes the path loss towards a receiver
+     * \param txPhy the transmitting PHY
+     * \param rxPhy the receiving PHY
+     * \param lossDb the path loss in dB
+     */
+    void PathLoss(Ptr<const SpectrumPhy> txPhy, Ptr<const SpectrumPhy> rxPhy, double lossDb);
+
+    std::string m_channelType; //!< the TypeId name of the channel
+    uint32_t m_receivers;      //!< the number of receivers processed by the channel
+};
+
+DistanceSpectrumTransmitFilterTestCase::DistanceSpectrumTransmitFilterTestCase(
+    std::string channelType)
+    : TestCase("Check the DistanceSpectrumTransmitFilter with " + channelType),
+      m_channelType(channelType),
+      m_receivers(0)
+{
+}
+
+void
+DistanceSpectrumTransmitFilterTestCase::PathLoss(Ptr<const SpectrumPhy> txPhy,
+                                                 Ptr<const SpectrumPhy> rxPhy,
+                                                 double lossDb)
+{
+    m_receivers++;
+}
+
+void
+DistanceSpectrumTransmitFilterTestCase::DoRun()
+{
+    ObjectFactory factory(m_channelType);
+    Ptr<SpectrumChannel> channel = factory.Create<SpectrumChannel>();
+    channel->TraceConnectWithoutContext(
+        "PathLoss",
+        MakeCallback(&DistanceSpectrumTransmitFilterTestCase::PathLoss, this));
+
+    auto psd = Create<SpectrumValue>(SpectrumModelIsm2400MhzRes1Mhz);
+    *psd = 1e-6;
+
+    std::vector<Ptr<HalfDuplexIdealPhy>> phys;
+    for (double x : {0.0, 10.0, 99.0, 101.0, 1000.0})
+    {
+        auto mobility = CreateObject<ConstantPositionMobilityModel>();
+        mobility->SetPosition(Vector(x, 0, 0));
+        auto phy = CreateObject<HalfDuplexIdealPhy>();
+        phy->SetMobility(mobility);
+        phy->SetTxPowerSpectralDensity(psd);
+        channel->AddRx(phy);
+        phys.push_back(phy);
+    }
+
+    auto params = Create<SpectrumSignalParameters>();
+    params->txPhy = phys.front();
+    params->psd = psd;
+    params->duration = MilliSeconds(1);
+
+    channel->StartTx(params);
+    NS_TEST_EXPECT_MSG_EQ(m_receivers, 4, "All the receivers should be processed without filter");
+
+    auto filter = CreateObject<DistanceSpectrumTransmitFilter>();
+    filter->SetAttribute("MaxRange", DoubleValue(100));
+    channel->AddSpectrumTransmitFilter(filter);
+
+    m_receivers = 0;
+    channel->StartTx(params);
+    NS_TEST_EXPECT_MSG_EQ(m_receivers, 2, "Receivers beyond 100 m should be filtered");
+
+    // the scheduled receptions are not of interest here
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief DistanceSpectrumTransmitFilter TestSuite
+ */
+class DistanceSpectrumTransmitFilterTestSuite : public TestSuite
+{
+  public:
+    DistanceSpectrumTransmitFilterTestSuite();
+};
+
+DistanceSpectrumTransmitFilterTestSuite::DistanceSpectrumTransmitFilterTestSuite()
+    : TestSuite("distance-spectrum-transmit-filter", Type::UNIT)
+{
+    AddTestCase(new DistanceSpectrumTransmitFilterTestCase("ns3::SingleModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+    AddTestCase(new DistanceSpectrumTransmitFilterTestCase("ns3::MultiModelSpectrumChannel"),
+                TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static DistanceSpectrumTransmitFilterTestSuite g_distanceSpectrumTransmitFilterTestSuite;
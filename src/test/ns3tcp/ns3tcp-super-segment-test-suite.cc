@@ -0,0 +1,227 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/bulk-send-helper.h"
+#include "ns3/config.h"
+#include "ns3/csma-helper.h"
+#include "ns3/error-model.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/pointer.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/super-segment-tag.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("Ns3TcpSuperSegmentTest");
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * \brief Check that a bulk transfer sent in super-segments delivers the same
+ * data as a transfer sent in segments, in about the same time.
+ *
+ * On point-to-point links, which support super-segments, the sender device
+ * transmits fewer, larger packets; on CSMA links the IP layer splits the
+ * super-segments and the device transmits as many packets as without them.
+ */
+class Ns3TcpSuperSegmentTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param csma whether the nodes are connected by a CSMA link, instead of a
+     *             point-to-point one
+     * \param errorRate the packet error rate of the receiver device
+     */
+    Ns3TcpSuperSegmentTestCase(bool csma, double errorRate);
+
+  private:
+    void DoRun() override;
+
+    /// The outcome of a transfer
+    struct Transfer
+    {
+        uint64_t received{0};  //!< The bytes received by the sink
+        uint32_t txPackets{0};     //!< The packets transmitted by the sender device
+        uint32_t superSegments{0}; //!< The packets of more than one segment among them
+        uint32_t acks{0};          //!< The packets transmitted by the receiver device
+        Time completion;       //!< The time the last byte was received
+    };
+
+    /**
+     * Run a bulk transfer.
+     *
+     * \param superSegmentSize the SuperSegmentSize attribute of the sender socket
+     * \return the outcome of the transfer
+     */
+    Transfer RunTransfer(uint32_t superSegmentSize);
+
+    bool m_csma;        //!< Whether the nodes are connected by a CSMA link
+    double m_errorRate; //!< The packet error rate of the receiver device
+};
+
+Ns3TcpSuperSegmentTestCase::Ns3TcpSuperSegmentTestCase(bool csma, double errorRate)
+    : TestCase(std::string("Check a bulk transfer in TCP super-segments over ") +
+               (csma ? "CSMA" : "point-to-point") + ", error rate " + std::to_string(errorRate)),
+      m_csma(csma),
+      m_errorRate(errorRate)
+{
+}
+
+Ns3TcpSuperSegmentTestCase::Transfer
+Ns3TcpSuperSegmentTestCase::RunTransfer(uint32_t superSegmentSize)
+{
+    const uint64_t maxBytes = 2000000;
+    const uint16_t port = 50000;
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1 << 20));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1 << 20));
+    Config::SetDefault("ns3::TcpSocketBase::SuperSegmentSize", UintegerValue(superSegmentSize));
+
+    NodeContainer nodes(2);
+    NetDeviceContainer devices;
+    if (m_csma)
+    {
+        CsmaHelper csma;
+        csma.SetChannelAttribute("DataRate", StringValue("100Mbps"));
+        csma.SetChannelAttribute("Delay", StringValue("1ms"));
+        devices = csma.Install(nodes);
+    }
+    else
+    {
+        PointToPointHelper pointToPoint;
+        pointToPoint.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+        pointToPoint.SetChannelAttribute("Delay", StringValue("1ms"));
+        devices = pointToPoint.Install(nodes);
+    }
+    if (m_errorRate > 0)
+    {
+        Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+        errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+        errorModel->SetRate(m_errorRate);
+        errorModel->AssignStreams(0);
+        devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+    }
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices);
+
+    BulkSendHelper source("ns3::TcpSocketFactory",
+                          InetSocketAddress(interfaces.GetAddress(1), port));
+    source.SetAttribute("MaxBytes", UintegerValue(maxBytes));
+    source.SetAttribute("SendSize", UintegerValue(65536));
+    ApplicationContainer sourceApps = source.Install(nodes.Get(0));
+    sourceApps.Start(Seconds(0.1));
+
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sink.Install(nodes.Get(1));
+    sinkApps.Start(Seconds(0));
+
+    Transfer transfer;
+    auto countTx = [&transfer](Ptr<const Packet> p) {
+        transfer.txPackets++;
+        SuperSegmentTag tag;
+        if (p->PeekPacketTag(tag) && tag.GetSegments() > 1)
+        {
+            transfer.superSegments++;
+        }
+    };
+    devices.Get(0)->TraceConnectWithoutContext("PhyTxBegin",
+                                               Callback<void, Ptr<const Packet>>(countTx));
+    auto countAck = [&transfer](Ptr<const Packet>) { transfer.acks++; };
+    devices.Get(1)->TraceConnectWithoutContext("PhyTxBegin",
+                                               Callback<void, Ptr<const Packet>>(countAck));
+    auto sinkRx = [&transfer](Ptr<const Packet>, const Address&) {
+        transfer.completion = Simulator::Now();
+    };
+    sinkApps.Get(0)->TraceConnectWithoutContext(
+        "Rx",
+        Callback<void, Ptr<const Packet>, const Address&>(sinkRx));
+
+    Simulator::Stop(Seconds(20));
+    Simulator::Run();
+    transfer.received = DynamicCast<PacketSink>(sinkApps.Get(0))->GetTotalRx();
+    Simulator::Destroy();
+    Config::Reset();
+
+    NS_TEST_EXPECT_MSG_EQ(transfer.received, maxBytes, "Data missing at the sink");
+    return transfer;
+}
+
+void
+Ns3TcpSuperSegmentTestCase::DoRun()
+{
+    Transfer segments = RunTransfer(1);
+    Transfer superSegments = RunTransfer(16);
+
+    if (m_csma)
+    {
+        // The super-segments are split before the device
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(superSegments.txPackets,
+                                    segments.txPackets * 9 / 10,
+                                    "The CSMA device transmitted super-segments");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_LT(superSegments.txPackets,
+                              segments.txPackets / 2,
+                              "The point-to-point device did not transmit super-segments");
+        // The receiver counts the segments of a super-segment for delayed
+        // ACKs, hence it acknowledges every super-segment right away
+        NS_TEST_EXPECT_MSG_GT(superSegments.superSegments, 0, "No super-segment transmitted");
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(superSegments.acks,
+                                    superSegments.superSegments,
+                                    "Super-segments not acknowledged one by one");
+    }
+    if (m_errorRate == 0)
+    {
+        NS_TEST_EXPECT_MSG_LT(superSegments.completion,
+                              segments.completion * 1.2,
+                              "The transfer in super-segments is too slow");
+        NS_TEST_EXPECT_MSG_GT(superSegments.completion,
+                              segments.completion * 0.8,
+                              "The transfer in super-segments is too fast");
+    }
+}
+
+/**
+ * \ingroup system-tests-tcp
+ *
+ * TCP super-segments TestSuite.
+ */
+class Ns3TcpSuperSegmentTestSuite : public TestSuite
+{
+  public:
+    Ns3TcpSuperSegmentTestSuite();
+};
+
+Ns3TcpSuperSegmentTestSuite::Ns3TcpSuperSegmentTestSuite()
+    : TestSuite("ns3-tcp-super-segment", Type::SYSTEM)
+{
+    AddTestCase(new Ns3TcpSuperSegmentTestCase(false, 0), TestCase::Duration::QUICK);
+    AddTestCase(new Ns3TcpSuperSegmentTestCase(false, 0.01), TestCase::Duration::QUICK);
+    AddTestCase(new Ns3TcpSuperSegmentTestCase(true, 0), TestCase::Duration::QUICK);
+}
+
+/// Do not forget to allocate an instance of this TestSuite.
+static Ns3TcpSuperSegmentTestSuite g_ns3TcpSuperSegmentTestSuite;
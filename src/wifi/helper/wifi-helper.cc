@@ -696,6 +696,9 @@ WifiPhyHelper::EnableAsciiInternal(Ptr<OutputStreamWrapper> stream,
     // want, and use the AsciiTraceHelper Hook*WithContext functions, but for
     // compatibility and simplicity, we just use Config::Connect and let it deal
     // with coming up with a context.
+    NS_ABORT_MSG_IF(stream->GetBinaryTraceFile(),
+                    "WifiPhyHelper::EnableAsciiInternal(): binary trace files are not supported, "
+                    "use an ASCII stream");
     oss.str("");
     oss << "/NodeList/" << nodeid << "/DeviceList/" << deviceid
         << "/$ns3::WifiNetDevice/Phy/State/RxOk";
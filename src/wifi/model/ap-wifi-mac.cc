@@ -19,12 +19,14 @@
 #include "msdu-aggregator.h"
 #include "qos-txop.h"
 #include "reduced-neighbor-report.h"
+#include "sta-wifi-mac.h"
 #include "wifi-mac-queue-scheduler.h"
 #include "wifi-mac-queue.h"
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
 
 #include "ns3/ap-emlsr-manager.h"
+#include "ns3/channel.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/eht-frame-exchange-manager.h"
 #include "ns3/he-configuration.h"
@@ -36,6 +38,7 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -94,6 +97,30 @@ ApWifiMac::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&ApWifiMac::m_sendUnsolProbeResp),
                           MakeBooleanChecker())
+            .AddAttribute("BeaconAbstraction",
+                          "If true, Beacon frames whose content did not change since the last "
+                          "Beacon frame transmitted through the PHY are not transmitted through "
+                          "the PHY: the medium is kept busy for the duration of the Beacon frame "
+                          "at the AP and at the associated stations and the Beacon frame is "
+                          "delivered to the associated stations at the end of such duration. "
+                          "Abstracted Beacon frames are never lost and only reach the stations "
+                          "that associated while Beacon abstraction was enabled. Other devices in "
+                          "range of the AP (e.g., stations and APs of overlapping BSSs) do not "
+                          "sense the medium busy during abstracted Beacon frames, hence the "
+                          "contention for the medium among multiple BSSs is affected.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApWifiMac::m_beaconAbstraction),
+                          MakeBooleanChecker())
+            .AddAttribute("BeaconAbstractionPhyPeriod",
+                          "If Beacon abstraction is enabled, one out of this number of Beacon "
+                          "frames is transmitted through the PHY even if its content did not "
+                          "change, so that stations that are not associated can discover the AP "
+                          "by passive scanning and the loss of Beacon frames is modeled for such "
+                          "Beacon frames. A value of zero means that Beacon frames are only "
+                          "transmitted through the PHY when their content changes.",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&ApWifiMac::m_beaconAbstractionPhyPeriod),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("EnableNonErpProtection",
                           "Whether or not protection mechanism should be used when non-ERP STAs "
                           "are present within the BSS."
@@ -1300,6 +1327,10 @@ ApWifiMac::SetAid(MgtAssocResponseHeader& assoc, const LinkIdStaAddrMap& linkIdS
             // the STA on this link had no AID assigned
             m_assocLogger(aid, staAddr);
             link.stationManager->SetAssociationId(staAddr, aid);
+            if (m_beaconAbstraction)
+            {
+                AddBeaconReceiver(staAddr, id);
+            }
 
             if (link.stationManager->GetDsssSupported(staAddr) &&
                 !link.stationManager->GetErpOfdmSupported(staAddr))
@@ -1489,8 +1520,12 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     packet->AddHeader(beacon);
 
     NS_LOG_INFO("Generating beacon from " << link.feManager->GetAddress() << " linkID " << +linkId);
-    // The beacon has it's own special queue, so we load it in there
-    m_beaconTxop->Queue(Create<WifiMpdu>(packet, hdr));
+    auto mpdu = Create<WifiMpdu>(packet, hdr);
+    if (!m_beaconAbstraction || !AbstractBeacon(mpdu, linkId))
+    {
+        // The beacon has it's own special queue, so we load it in there
+        m_beaconTxop->Queue(mpdu);
+    }
     link.beaconEvent =
         Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
 
@@ -1514,6 +1549,87 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     }
 }
 
+bool
+ApWifiMac::AbstractBeacon(Ptr<const WifiMpdu> beacon, uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << *beacon << +linkId);
+    auto& link = GetLink(linkId);
+
+    // the frame body of the Beacon frame starts with the Timestamp field (8 octets), which
+    // changes for every Beacon frame
+    auto packet = beacon->GetPacket();
+    NS_ASSERT(packet->GetSize() >= 8);
+    std::vector<uint8_t> content(packet->GetSize());
+    packet->CopyData(content.data(), content.size());
+    content.erase(content.begin(), content.begin() + 8);
+
+    if (content != link.lastPhyBeacon ||
+        (m_beaconAbstractionPhyPeriod > 0 &&
+         link.nAbstractedBeacons + 1 >= m_beaconAbstractionPhyPeriod))
+    {
+        NS_LOG_DEBUG("Beacon frame has to be transmitted through the PHY");
+        link.lastPhyBeacon = std::move(content);
+        link.nAbstractedBeacons = 0;
+        return false;
+    }
+    link.nAbstractedBeacons++;
+
+    const auto txVector =
+        GetWifiRemoteStationManager(linkId)->GetDataTxVector(beacon->GetHeader(),
+                                                             link.phy->GetChannelWidth());
+    const auto txDuration =
+        WifiPhy::CalculateTxDuration(beacon->GetSize(), txVector, link.phy->GetPhyBand());
+    NS_LOG_DEBUG("Abstracting Beacon frame (duration=" << txDuration.As(Time::US) << ")");
+    GetChannelAccessManager(linkId)->NotifyAbstractedBusyStartNow(txDuration);
+
+    // deliver the Beacon frame to the stations associated with us on this link that are
+    // still associated and awake
+    std::vector<std::pair<Ptr<StaWifiMac>, uint8_t>> receivers;
+    for (const auto& [staAddr, receiver] : link.beaconReceivers)
+    {
+        const auto& [sta, staLinkId] = receiver;
+        if (!sta->IsAssociated() || sta->GetSetupLinkIds().count(staLinkId) == 0 ||
+            sta->GetBssid(staLinkId) != link.feManager->GetAddress())
+        {
+            continue;
+        }
+        auto staPhy = sta->GetWifiPhy(staLinkId);
+        if (!staPhy || staPhy->IsStateSleep() || staPhy->IsStateOff())
+        {
+            continue;
+        }
+        sta->GetChannelAccessManager(staLinkId)->NotifyAbstractedBusyStartNow(txDuration);
+        receivers.emplace_back(sta, staLinkId);
+    }
+
+    Simulator::Schedule(txDuration, [receivers, beaconInterval = GetBeaconInterval()]() {
+        for (const auto& [sta, staLinkId] : receivers)
+        {
+            sta->NotifyAbstractedBeacon(staLinkId, beaconInterval);
+        }
+    });
+    return true;
+}
+
+void
+ApWifiMac::AddBeaconReceiver(const Mac48Address& staAddr, uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << staAddr << +linkId);
+    auto& link = GetLink(linkId);
+    auto channel = link.phy->GetChannel();
+    for (std::size_t i = 0; i < channel->GetNDevices(); ++i)
+    {
+        auto device = DynamicCast<WifiNetDevice>(channel->GetDevice(i));
+        auto sta = device ? DynamicCast<StaWifiMac>(device->GetMac()) : nullptr;
+        if (const auto staLinkId = sta ? sta->GetLinkIdByAddress(staAddr) : std::nullopt)
+        {
+            link.beaconReceivers[staAddr] = {sta, *staLinkId};
+            return;
+        }
+    }
+    NS_LOG_DEBUG("Station " << staAddr << " not found on the channel of link " << +linkId);
+}
+
 Ptr<WifiMpdu>
 ApWifiMac::GetFilsDiscovery(uint8_t linkId) const
 {
@@ -1930,8 +2046,9 @@ ApWifiMac::Receive(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
                 {
                     if (it->second == from)
                     {
-                        staList.erase(it);
+                        GetLink(linkId).beaconReceivers.erase(from);
                         m_deAssocLogger(it->first, it->second);
+                        staList.erase(it);
                         if (GetWifiRemoteStationManager(linkId)->GetDsssSupported(from) &&
                             !GetWifiRemoteStationManager(linkId)->GetErpOfdmSupported(from))
                         {
@@ -43,6 +43,7 @@ class MgtReassocRequestHeader;
 class MgtAssocResponseHeader;
 class MgtEmlOmn;
 class ApEmlsrManager;
+class StaWifiMac;
 
 /// variant holding a  reference to a (Re)Association Request
 using AssocReqRefVariant = std::variant<std::reference_wrapper<MgtAssocRequestHeader>,
@@ -247,6 +248,13 @@ class ApWifiMac : public WifiMac
         bool shortSlotTimeEnabled{
             false}; //!< Flag whether short slot time is enabled within the BSS
         bool shortPreambleEnabled{false}; //!< Flag whether short preamble is enabled in the BSS
+        std::vector<uint8_t> lastPhyBeacon; //!< frame body (without the Timestamp field) of the
+                                            //!< last Beacon frame transmitted through the PHY
+        uint32_t nAbstractedBeacons{0};     //!< number of Beacon frames that were not transmitted
+                                            //!< through the PHY since the last one that was
+        std::map<Mac48Address, std::pair<Ptr<StaWifiMac>, uint8_t>>
+            beaconReceivers; //!< MAC and link ID of the stations associated on this link, by
+                             //!< link address, to which abstracted Beacon frames are delivered
     };
 
     /**
@@ -395,6 +403,29 @@ class ApWifiMac : public WifiMac
      */
     void SendOneBeacon(uint8_t linkId);
 
+    /**
+     * If the given Beacon frame can be abstracted (i.e., its content did not change since the
+     * last Beacon frame transmitted through the PHY on the given link and it is not the turn
+     * of a Beacon frame to be transmitted through the PHY), keep the medium busy for the
+     * duration of the Beacon frame and deliver it to the associated stations without
+     * transmitting it through the PHY.
+     *
+     * \param beacon the given Beacon frame
+     * \param linkId the ID of the given link
+     * \return whether the given Beacon frame has been abstracted
+     */
+    bool AbstractBeacon(Ptr<const WifiMpdu> beacon, uint8_t linkId);
+
+    /**
+     * Look for the station that associated with us on the given link among the devices
+     * attached to the channel of the link, and add it to the stations to which abstracted
+     * Beacon frames are delivered.
+     *
+     * \param staAddr the MAC address of the station on the given link
+     * \param linkId the ID of the given link
+     */
+    void AddBeaconReceiver(const Mac48Address& staAddr, uint8_t linkId);
+
     /**
      * Get the FILS Discovery frame to send on the given link.
      *
@@ -594,6 +625,9 @@ class ApWifiMac : public WifiMac
     Time m_fdBeaconIntervalNon6GHz; //!< Time elapsing between a beacon and FILS Discovery (FD)
                                     //!< frame or between two FD frames on 2.4GHz and 5GHz links
     bool m_sendUnsolProbeResp;      //!< send unsolicited Probe Response instead of FILS Discovery
+    bool m_beaconAbstraction;       //!< whether steady-state Beacon frames are abstracted
+    uint32_t m_beaconAbstractionPhyPeriod; //!< one out of this number of Beacon frames is
+                                           //!< transmitted through the PHY (if abstraction is on)
 
     /// store value and timestamp for each Buffer Status Report
     struct BsrType
@@ -11,6 +11,7 @@
 
 #include "block-ack-type.h"
 #include "originator-block-ack-agreement.h"
+#include "qos-utils.h"
 #include "recipient-block-ack-agreement.h"
 #include "wifi-mac-header.h"
 #include "wifi-mpdu.h"
@@ -22,6 +23,7 @@
 
 #include <map>
 #include <optional>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -449,14 +451,17 @@ class BlockAckManager : public Object
      */
     typedef std::list<Ptr<WifiMpdu>>::iterator PacketQueueI;
 
-    /// AgreementKey-indexed map of originator block ack agreements
+    /// AgreementKey-indexed hash table of originator block ack agreements
     using OriginatorAgreements =
-        std::map<AgreementKey, std::pair<OriginatorBlockAckAgreement, PacketQueue>>;
+        std::unordered_map<AgreementKey,
+                           std::pair<OriginatorBlockAckAgreement, PacketQueue>,
+                           WifiAddressTidHash>;
     /// typedef for an iterator for Agreements
     using OriginatorAgreementsI = OriginatorAgreements::iterator;
 
-    /// AgreementKey-indexed map of recipient block ack agreements
-    using RecipientAgreements = std::map<AgreementKey, RecipientBlockAckAgreement>;
+    /// AgreementKey-indexed hash table of recipient block ack agreements
+    using RecipientAgreements =
+        std::unordered_map<AgreementKey, RecipientBlockAckAgreement, WifiAddressTidHash>;
 
     /**
      * Handle the given in flight MPDU based on its given status. If the status is
@@ -12,13 +12,48 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("BlockAckWindow");
 
+BlockAckWindow::Reference::Reference(uint64_t& word, uint64_t mask)
+    : m_word(word),
+      m_mask(mask)
+{
+}
+
+BlockAckWindow::Reference&
+BlockAckWindow::Reference::operator=(bool value)
+{
+    if (value)
+    {
+        m_word |= m_mask;
+    }
+    else
+    {
+        m_word &= ~m_mask;
+    }
+    return *this;
+}
+
+BlockAckWindow::Reference&
+BlockAckWindow::Reference::operator=(const Reference& other)
+{
+    return *this = static_cast<bool>(other);
+}
+
+BlockAckWindow::Reference::operator bool() const
+{
+    return (m_word & m_mask) != 0;
+}
+
 BlockAckWindow::BlockAckWindow()
     : m_winStart(0),
+      m_winSize(0),
       m_head(0)
 {
 }
@@ -28,14 +63,15 @@ BlockAckWindow::Init(uint16_t winStart, uint16_t winSize)
 {
     NS_LOG_FUNCTION(this << winStart << winSize);
     m_winStart = winStart;
-    m_window.assign(winSize, false);
+    m_winSize = winSize;
+    m_window.assign((winSize + 63) / 64, 0);
     m_head = 0;
 }
 
 void
 BlockAckWindow::Reset(uint16_t winStart)
 {
-    Init(winStart, m_window.size());
+    Init(winStart, m_winSize);
 }
 
 uint16_t
@@ -47,29 +83,72 @@ BlockAckWindow::GetWinStart() const
 uint16_t
 BlockAckWindow::GetWinEnd() const
 {
-    return (m_winStart + m_window.size() - 1) % SEQNO_SPACE_SIZE;
+    return (m_winStart + m_winSize - 1) % SEQNO_SPACE_SIZE;
 }
 
 std::size_t
 BlockAckWindow::GetWinSize() const
 {
-    return m_window.size();
+    return m_winSize;
 }
 
-std::vector<bool>::reference
+BlockAckWindow::Reference
 BlockAckWindow::At(std::size_t distance)
 {
-    NS_ASSERT(distance < m_window.size());
+    NS_ASSERT(distance < m_winSize);
 
-    return m_window.at((m_head + distance) % m_window.size());
+    const auto pos = (m_head + distance) % (m_window.size() * 64);
+    return Reference(m_window[pos / 64], uint64_t{1} << (pos % 64));
 }
 
-std::vector<bool>::const_reference
+bool
 BlockAckWindow::At(std::size_t distance) const
 {
-    NS_ASSERT(distance < m_window.size());
+    NS_ASSERT(distance < m_winSize);
 
-    return m_window.at((m_head + distance) % m_window.size());
+    const auto pos = (m_head + distance) % (m_window.size() * 64);
+    return (m_window[pos / 64] >> (pos % 64)) & 1;
+}
+
+uint64_t
+BlockAckWindow::GetWord(std::size_t distance) const
+{
+    if (distance >= m_winSize)
+    {
+        return 0;
+    }
+
+    const auto pos = (m_head + distance) % (m_window.size() * 64);
+    const auto offset = pos % 64;
+    auto word = m_window[pos / 64] >> offset;
+    if (offset > 0)
+    {
+        word |= m_window[(pos / 64 + 1) % m_window.size()] << (64 - offset);
+    }
+    // the bits that are not part of the window are always cleared, but the first
+    // elements of the window are read again if we went past the end of the window
+    if (const auto left = m_winSize - distance; left < 64)
+    {
+        word &= (uint64_t{1} << left) - 1;
+    }
+    return word;
+}
+
+std::size_t
+BlockAckWindow::GetNLeadingSet() const
+{
+    std::size_t count = 0;
+    while (count < m_winSize)
+    {
+        const auto word = GetWord(count);
+        const auto nSet = static_cast<std::size_t>(std::countr_one(word));
+        count += nSet;
+        if (nSet < 64)
+        {
+            break;
+        }
+    }
+    return std::min(count, m_winSize);
 }
 
 void
@@ -77,16 +156,22 @@ BlockAckWindow::Advance(std::size_t count)
 {
     NS_LOG_FUNCTION(this << count);
 
-    if (count >= m_window.size())
+    if (count >= m_winSize)
     {
         Reset((m_winStart + count) % SEQNO_SPACE_SIZE);
         return;
     }
 
-    for (std::size_t i = 0; i < count; i++)
+    // clear the elements that leave the window, a word at a time
+    const auto nBits = m_window.size() * 64;
+    for (std::size_t left = count; left > 0;)
     {
-        m_window[m_head] = false;
-        m_head = (m_head + 1) % m_window.size();
+        const auto offset = m_head % 64;
+        const auto n = std::min(left, 64 - offset);
+        const auto mask = (n == 64) ? ~uint64_t{0} : ((uint64_t{1} << n) - 1) << offset;
+        m_window[m_head / 64] &= ~mask;
+        m_head = (m_head + n) % nBits;
+        left -= n;
     }
     m_winStart = (m_winStart + count) % SEQNO_SPACE_SIZE;
 }
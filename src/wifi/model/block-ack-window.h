@@ -24,10 +24,14 @@ namespace ns3
  * a given number of positions. This class can be used to implement both
  * an originator's window and a recipient's window.
  *
- * The window is implemented as a vector of bool and managed as a circular
- * queue. The window is moved forward by advancing the head of the queue and
- * clearing the elements that become part of the tail of the queue. Hence,
- * no element is required to be shifted when the window moves forward.
+ * The window is implemented as a vector of 64-bit words (each bit being an
+ * element of the window) and managed as a circular queue. The window is moved
+ * forward by advancing the head of the queue and clearing the elements that
+ * become part of the tail of the queue. Hence, no element is required to be
+ * shifted when the window moves forward. The elements of the vector that are
+ * not part of the window (the size of the vector is the window size rounded up
+ * to a multiple of 64) are always cleared, which allows to clear, scan and
+ * extract the elements of the window 64 at a time.
  *
  * Example:
  *
@@ -46,6 +50,43 @@ namespace ns3
 class BlockAckWindow
 {
   public:
+    /**
+     * Proxy class to access an element of the window, as std::vector<bool>::reference does.
+     */
+    class Reference
+    {
+      public:
+        /**
+         * Constructor
+         *
+         * \param word the word containing the element
+         * \param mask the mask identifying the element within the word
+         */
+        Reference(uint64_t& word, uint64_t mask);
+        /**
+         * Set or clear the element.
+         *
+         * \param value the value of the element
+         * \return a reference to this object
+         */
+        Reference& operator=(bool value);
+        /**
+         * Set or clear the element based on the value of another element.
+         *
+         * \param other the other element
+         * \return a reference to this object
+         */
+        Reference& operator=(const Reference& other);
+        /**
+         * \return the value of the element
+         */
+        operator bool() const;
+
+      private:
+        uint64_t& m_word; ///< the word containing the element
+        uint64_t m_mask;  ///< the mask identifying the element within the word
+    };
+
     /**
      * Constructor
      */
@@ -91,17 +132,32 @@ class BlockAckWindow
      * \return a reference to the element in the window having the given distance
      *         from the current winStart
      */
-    std::vector<bool>::reference At(std::size_t distance);
+    Reference At(std::size_t distance);
     /**
-     * Get a const reference to the element in the window having the given distance from
+     * Get the value of the element in the window having the given distance from
      * the current winStart. Note that the given distance must be less than the
      * window size.
      *
      * \param distance the given distance
-     * \return a const reference to the element in the window having the given distance
+     * \return the value of the element in the window having the given distance
      *         from the current winStart
      */
-    std::vector<bool>::const_reference At(std::size_t distance) const;
+    bool At(std::size_t distance) const;
+    /**
+     * Get the 64 elements of the window starting at the given distance from the
+     * current winStart. Bit i of the returned word is the element having distance
+     * <i>distance</i> + i from the current winStart; bits corresponding to positions
+     * beyond the end of the window are cleared.
+     *
+     * \param distance the given distance
+     * \return the 64 elements starting at the given distance from the current winStart
+     */
+    uint64_t GetWord(std::size_t distance) const;
+    /**
+     * \return the number of consecutive elements that are set, starting at the
+     *         current winStart
+     */
+    std::size_t GetNLeadingSet() const;
     /**
      * Advance the current winStart by the given number of positions.
      *
@@ -110,9 +166,10 @@ class BlockAckWindow
     void Advance(std::size_t count);
 
   private:
-    uint16_t m_winStart;        ///< window start (sequence number)
-    std::vector<bool> m_window; ///< window
-    std::size_t m_head;         ///< index of winStart in the vector
+    uint16_t m_winStart;            ///< window start (sequence number)
+    std::size_t m_winSize;          ///< window size
+    std::vector<uint64_t> m_window; ///< window
+    std::size_t m_head;             ///< index of the bit storing winStart in the vector
 };
 
 } // namespace ns3
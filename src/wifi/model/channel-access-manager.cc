@@ -905,18 +905,44 @@ ChannelAccessManager::NotifyCcaBusyStartNow(Time duration,
         }
     }
 
-    if (m_proactiveBackoff)
+    GenerateProactiveBackoff();
+}
+
+void
+ChannelAccessManager::NotifyAbstractedBusyStartNow(Time duration)
+{
+    NS_LOG_FUNCTION(this << duration);
+    UpdateBackoff();
+    UpdateLastIdlePeriod();
+    const auto end = Simulator::Now() + duration;
+    for (auto& [channelType, busyEnd] : m_lastBusyEnd)
+    {
+        busyEnd = std::max(busyEnd, end);
+    }
+    for (auto& busyEnd : m_lastPer20MHzBusyEnd)
+    {
+        busyEnd = std::max(busyEnd, end);
+    }
+    GenerateProactiveBackoff();
+}
+
+void
+ChannelAccessManager::GenerateProactiveBackoff()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_proactiveBackoff)
     {
-        // have all EDCAFs that are not carrying out a TXOP and have the backoff counter set to
-        // zero proactively generate a new backoff value
-        for (auto txop : m_txops)
+        return;
+    }
+    // have all EDCAFs that are not carrying out a TXOP and have the backoff counter set to
+    // zero proactively generate a new backoff value
+    for (auto txop : m_txops)
+    {
+        if (txop->GetAccessStatus(m_linkId) != Txop::GRANTED &&
+            txop->GetBackoffSlots(m_linkId) == 0)
         {
-            if (txop->GetAccessStatus(m_linkId) != Txop::GRANTED &&
-                txop->GetBackoffSlots(m_linkId) == 0)
-            {
-                NS_LOG_DEBUG("Generate backoff for " << txop->GetWifiMacQueue()->GetAc());
-                txop->GenerateBackoff(m_linkId);
-            }
+            NS_LOG_DEBUG("Generate backoff for " << txop->GetWifiMacQueue()->GetAc());
+            txop->GenerateBackoff(m_linkId);
         }
     }
 }
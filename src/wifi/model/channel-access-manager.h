@@ -250,6 +250,14 @@ class ChannelAccessManager : public Object
     void NotifyCcaBusyStartNow(Time duration,
                                WifiChannelListType channelType,
                                const std::vector<Time>& per20MhzDurations);
+    /**
+     * \param duration expected duration of the busy period
+     *
+     * Notify the Txop that the medium is busy for the given duration because of a frame
+     * that is not transmitted through the PHY (e.g., a Beacon frame sent by an AP operating
+     * in the Beacon abstraction mode). All the channels are considered busy.
+     */
+    void NotifyAbstractedBusyStartNow(Time duration);
     /**
      * \param phyListener the PHY listener that sent this notification
      * \param duration expected duration of channel switching period
@@ -370,6 +378,13 @@ class ChannelAccessManager : public Object
      */
     void UpdateBackoff();
 
+    /**
+     * If proactive backoff is enabled, have all the EDCAFs that are not carrying out a TXOP
+     * and have the backoff counter set to zero generate a new backoff value, as the medium
+     * has just become busy.
+     */
+    void GenerateProactiveBackoff();
+
     /**
      * This overload is provided to enable caching the value returned by GetAccessGrantStart(),
      * which is independent of the given Txop object.
@@ -931,6 +931,39 @@ CtrlBAckResponseHeader::SetReceivedPacket(uint16_t seq, std::size_t index)
     }
 }
 
+void
+CtrlBAckResponseHeader::SetReceivedPackets(uint16_t seq, uint64_t bits, std::size_t index)
+{
+    NS_ASSERT_MSG(m_baType.m_variant == BlockAckType::MULTI_STA || index == 0,
+                  "index can only be non null for Multi-STA Block Ack");
+    NS_ASSERT(index < m_baInfo.size());
+
+    auto& bitmap = m_baInfo[index].m_bitmap;
+    const std::size_t pos =
+        (seq - m_baInfo[index].m_startingSeq + SEQNO_SPACE_SIZE) % SEQNO_SPACE_SIZE;
+
+    if ((m_baType.m_variant == BlockAckType::COMPRESSED ||
+         m_baType.m_variant == BlockAckType::EXTENDED_COMPRESSED ||
+         m_baType.m_variant == BlockAckType::MULTI_STA) &&
+        pos % 8 == 0 && pos / 8 < bitmap.size())
+    {
+        for (std::size_t i = pos / 8; bits != 0 && i < bitmap.size(); i++)
+        {
+            bitmap[i] |= static_cast<uint8_t>(bits & 0xff);
+            bits >>= 8;
+        }
+        return;
+    }
+
+    for (uint16_t i = 0; bits != 0; i++, bits >>= 1)
+    {
+        if (bits & 1)
+        {
+            SetReceivedPacket((seq + i) % SEQNO_SPACE_SIZE, index);
+        }
+    }
+}
+
 void
 CtrlBAckResponseHeader::SetReceivedFragment(uint16_t seq, uint8_t frag)
 {
@@ -381,6 +381,20 @@ class CtrlBAckResponseHeader : public Header
      * \param index the index of the Per AID TID Info subfield (Multi-STA Block Ack only)
      */
     void SetReceivedPacket(uint16_t seq, std::size_t index = 0);
+    /**
+     * Record in the bitmap that the packets whose sequence number is the given one
+     * plus the position of a bit set in the given word were received, i.e., bit i
+     * of the given word refers to the packet with sequence number <i>seq</i> + i.
+     * For Multi-STA Block Acks, <i>index</i> identifies the Per AID TID Info
+     * subfield whose bitmap has to be updated. If the distance between the given
+     * sequence number and the starting sequence number is a multiple of 8, the
+     * bitmap is updated a byte at a time.
+     *
+     * \param seq the sequence number of the packet corresponding to the first bit
+     * \param bits a bit set for each received packet
+     * \param index the index of the Per AID TID Info subfield (Multi-STA Block Ack only)
+     */
+    void SetReceivedPackets(uint16_t seq, uint64_t bits, std::size_t index = 0);
     /**
      * Set the bitmap that the packet with the given sequence
      * number and fragment number was received.
@@ -982,27 +982,14 @@ HePhy::GetRuBandForTx(const WifiTxVector& txVector, uint16_t staId) const
     HeRu::RuSpec ru = txVector.GetRu(staId);
     const auto channelWidth = txVector.GetChannelWidth();
     NS_ASSERT(channelWidth <= m_wifiPhy->GetChannelWidth());
-    HeRu::SubcarrierGroup group = HeRu::GetSubcarrierGroup(
-        channelWidth,
-        ru.GetRuType(),
-        ru.GetPhyIndex(channelWidth, m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)));
     // for a TX spectrum, the guard bandwidth is a function of the transmission channel width
     // and the spectrum width equals the transmission channel width (hence bandIndex equals 0)
-    const auto indices = ConvertHeRuSubcarriers(channelWidth,
-                                                GetGuardBandwidth(channelWidth),
-                                                m_wifiPhy->GetOperatingChannel().GetFrequencies(),
-                                                m_wifiPhy->GetChannelWidth(),
-                                                m_wifiPhy->GetSubcarrierSpacing(),
-                                                {group.front().first, group.back().second},
-                                                0);
-    WifiSpectrumBandInfo ruBandForTx{};
-    for (const auto& indicesPerSegment : indices)
-    {
-        ruBandForTx.indices.emplace_back(indicesPerSegment);
-        ruBandForTx.frequencies.emplace_back(
-            m_wifiPhy->ConvertIndicesToFrequencies(indicesPerSegment));
-    }
-    return ruBandForTx;
+    return GetRuBand(
+        channelWidth,
+        GetGuardBandwidth(channelWidth),
+        ru.GetRuType(),
+        ru.GetPhyIndex(channelWidth, m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)),
+        0);
 }
 
 WifiSpectrumBandInfo
@@ -1012,28 +999,51 @@ HePhy::GetRuBandForRx(const WifiTxVector& txVector, uint16_t staId) const
     HeRu::RuSpec ru = txVector.GetRu(staId);
     const auto channelWidth = txVector.GetChannelWidth();
     NS_ASSERT(channelWidth <= m_wifiPhy->GetChannelWidth());
-    HeRu::SubcarrierGroup group = HeRu::GetSubcarrierGroup(
-        channelWidth,
-        ru.GetRuType(),
-        ru.GetPhyIndex(channelWidth, m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)));
     // for an RX spectrum, the guard bandwidth is a function of the operating channel width
     // and the spectrum width equals the operating channel width
-    const auto indices = ConvertHeRuSubcarriers(
+    return GetRuBand(
         channelWidth,
         GetGuardBandwidth(m_wifiPhy->GetChannelWidth()),
-        m_wifiPhy->GetOperatingChannel().GetFrequencies(),
-        m_wifiPhy->GetChannelWidth(),
-        m_wifiPhy->GetSubcarrierSpacing(),
-        {group.front().first, group.back().second},
+        ru.GetRuType(),
+        ru.GetPhyIndex(channelWidth, m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)),
         m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(channelWidth));
-    WifiSpectrumBandInfo ruBandForRx{};
-    for (const auto& indicesPerSegment : indices)
+}
+
+const WifiSpectrumBandInfo&
+HePhy::GetRuBand(MHz_u channelWidth,
+                 MHz_u guardBandwidth,
+                 HeRu::RuType ruType,
+                 std::size_t phyIndex,
+                 uint8_t bandIndex) const
+{
+    const auto& channel = m_wifiPhy->GetOperatingChannel();
+    if (!m_ruBandsChannel || *m_ruBandsChannel != channel)
+    {
+        // the operating channel has changed, the cached bands are no longer valid
+        m_ruBands.clear();
+        m_ruBandsChannel = channel;
+    }
+
+    auto [it, inserted] =
+        m_ruBands.try_emplace({channelWidth, guardBandwidth, ruType, phyIndex, bandIndex});
+    if (inserted)
     {
-        ruBandForRx.indices.emplace_back(indicesPerSegment);
-        ruBandForRx.frequencies.emplace_back(
-            m_wifiPhy->ConvertIndicesToFrequencies(indicesPerSegment));
+        const auto& group = HeRu::GetSubcarrierGroup(channelWidth, ruType, phyIndex);
+        const auto indices = ConvertHeRuSubcarriers(channelWidth,
+                                                    guardBandwidth,
+                                                    channel.GetFrequencies(),
+                                                    m_wifiPhy->GetChannelWidth(),
+                                                    m_wifiPhy->GetSubcarrierSpacing(),
+                                                    {group.front().first, group.back().second},
+                                                    bandIndex);
+        for (const auto& indicesPerSegment : indices)
+        {
+            it->second.indices.emplace_back(indicesPerSegment);
+            it->second.frequencies.emplace_back(
+                m_wifiPhy->ConvertIndicesToFrequencies(indicesPerSegment));
+        }
     }
-    return ruBandForRx;
+    return it->second;
 }
 
 WifiSpectrumBandInfo
@@ -1050,27 +1060,13 @@ HePhy::GetNonOfdmaBand(const WifiTxVector& txVector, uint16_t staId) const
     HeRu::RuSpec nonOfdmaRu =
         HeRu::FindOverlappingRu(channelWidth, ru, HeRu::GetRuType(nonOfdmaWidth));
 
-    HeRu::SubcarrierGroup groupPreamble = HeRu::GetSubcarrierGroup(
+    return GetRuBand(
         channelWidth,
+        GetGuardBandwidth(m_wifiPhy->GetChannelWidth()),
         nonOfdmaRu.GetRuType(),
         nonOfdmaRu.GetPhyIndex(channelWidth,
-                               m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)));
-    const auto indices = ConvertHeRuSubcarriers(
-        channelWidth,
-        GetGuardBandwidth(m_wifiPhy->GetChannelWidth()),
-        m_wifiPhy->GetOperatingChannel().GetFrequencies(),
-        m_wifiPhy->GetChannelWidth(),
-        m_wifiPhy->GetSubcarrierSpacing(),
-        {groupPreamble.front().first, groupPreamble.back().second},
+                               m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(20)),
         m_wifiPhy->GetOperatingChannel().GetPrimaryChannelIndex(channelWidth));
-    WifiSpectrumBandInfo nonOfdmaBand{};
-    for (const auto& indicesPerSegment : indices)
-    {
-        nonOfdmaBand.indices.emplace_back(indicesPerSegment);
-        nonOfdmaBand.frequencies.emplace_back(
-            m_wifiPhy->ConvertIndicesToFrequencies(indicesPerSegment));
-    }
-    return nonOfdmaBand;
 }
 
 MHz_u
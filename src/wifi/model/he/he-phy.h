@@ -16,9 +16,12 @@
 #include "ns3/callback.h"
 #include "ns3/vht-phy.h"
 #include "ns3/wifi-phy-band.h"
+#include "ns3/wifi-phy-operating-channel.h"
 #include "ns3/wifi-types.h"
 
+#include <map>
 #include <optional>
+#include <tuple>
 
 /**
  * \file
@@ -630,11 +633,37 @@ class HePhy : public VhtPhy
                                      const WifiTxVector& txVector,
                                      WifiPhyBand band);
 
+    /**
+     * Get the band in the spectrum covering the subcarrier range of the RU of the given type
+     * and PHY index in a PPDU of the given width. The bands are computed by
+     * ConvertHeRuSubcarriers the first time they are requested and are then cached until
+     * the operating channel changes.
+     *
+     * \param channelWidth the width of the PPDU
+     * \param guardBandwidth width of the guard band
+     * \param ruType the RU type
+     * \param phyIndex the PHY index of the RU
+     * \param bandIndex the index (starting at 0) of the band within the operating channel
+     * \return the band covering the subcarrier range of the RU
+     */
+    const WifiSpectrumBandInfo& GetRuBand(MHz_u channelWidth,
+                                          MHz_u guardBandwidth,
+                                          HeRu::RuType ruType,
+                                          std::size_t phyIndex,
+                                          uint8_t bandIndex) const;
+
+    /// (PPDU width, guard bandwidth, RU type, RU PHY index, band index) tuple
+    using RuBandKey = std::tuple<MHz_u, MHz_u, HeRu::RuType, std::size_t, uint8_t>;
+
     static const PpduFormats m_hePpduFormats; //!< HE PPDU formats
 
     std::size_t m_rxHeTbPpdus;                 //!< Number of successfully received HE TB PPDUS
     Ptr<ObssPdAlgorithm> m_obssPdAlgorithm;    //!< OBSS-PD algorithm
     std::vector<Time> m_lastPer20MHzDurations; //!< Hold the last per-20 MHz CCA durations vector
+
+    mutable std::map<RuBandKey, WifiSpectrumBandInfo> m_ruBands; //!< cached RU bands
+    /// the operating channel the cached RU bands refer to
+    mutable std::optional<WifiPhyOperatingChannel> m_ruBandsChannel;
 };                                             // class HePhy
 
 } // namespace ns3
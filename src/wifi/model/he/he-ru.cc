@@ -11,6 +11,7 @@
 #include "ns3/abort.h"
 #include "ns3/assert.h"
 
+#include <array>
 #include <optional>
 #include <tuple>
 
@@ -480,59 +481,59 @@ HeRu::RuSpec::GetPhyIndex(MHz_u bw, uint8_t p20Index) const
     }
 }
 
-std::size_t
-HeRu::GetNRus(MHz_u bw, RuType ruType)
+HeRu::RuTable
+HeRu::ComputeRuTable(MHz_u bw, RuType ruType)
 {
-    if (bw == 160 && ruType == RU_2x996_TONE)
-    {
-        return 1;
-    }
-
-    // if the bandwidth is 160MHz, search for the number of RUs available
-    // in 80MHz and double the result.
-    auto it = m_heRuSubcarrierGroups.find({(bw == 160 ? 80 : bw), ruType});
+    RuTable table;
 
-    if (it == m_heRuSubcarrierGroups.end())
-    {
-        return 0;
-    }
-
-    return (bw == 160 ? 2 : 1) * it->second.size();
-}
-
-std::vector<HeRu::RuSpec>
-HeRu::GetRusOfType(MHz_u bw, HeRu::RuType ruType)
-{
     if (ruType == HeRu::RU_2x996_TONE)
     {
-        NS_ASSERT(bw >= 160);
-        return {{ruType, 1, true}};
+        // a 2x996-tone RU covers a 160 MHz channel
+        if (bw == 160)
+        {
+            table.rus.emplace_back(ruType, 1, true);
+            table.groups.push_back({{-1012, -3}, {3, 1012}});
+        }
+        return table;
     }
 
-    std::vector<HeRu::RuSpec> ret;
-    std::vector<bool> primary80MHzSet{true};
+    // m_heRuSubcarrierGroups contains indices for the lower 80 MHz subchannel (i.e. from -500
+    // to 500). The RUs in a 160 MHz channel are obtained by shifting the indices by -512 (lower
+    // 80 MHz subchannel) and by 512 (upper 80 MHz subchannel)
+    auto it = m_heRuSubcarrierGroups.find({(bw == 160 ? 80 : bw), ruType});
 
-    if (bw == 160)
+    if (it != m_heRuSubcarrierGroups.end())
     {
-        primary80MHzSet.push_back(false);
-        bw = 80;
-    }
+        std::vector<bool> primary80MHzSet{true};
+        std::vector<int16_t> shifts{0};
 
-    for (auto primary80MHz : primary80MHzSet)
-    {
-        for (std::size_t ruIndex = 1;
-             ruIndex <= HeRu::m_heRuSubcarrierGroups.at({bw, ruType}).size();
-             ruIndex++)
+        if (bw == 160)
         {
-            ret.emplace_back(ruType, ruIndex, primary80MHz);
+            primary80MHzSet.push_back(false);
+            shifts = {-512, 512};
+        }
+
+        for (auto primary80MHz : primary80MHzSet)
+        {
+            for (std::size_t ruIndex = 1; ruIndex <= it->second.size(); ruIndex++)
+            {
+                table.rus.emplace_back(ruType, ruIndex, primary80MHz);
+            }
+        }
+        for (auto shift : shifts)
+        {
+            for (auto group : it->second)
+            {
+                for (auto& range : group)
+                {
+                    range.first += shift;
+                    range.second += shift;
+                }
+                table.groups.push_back(std::move(group));
+            }
         }
     }
-    return ret;
-}
 
-std::vector<HeRu::RuSpec>
-HeRu::GetCentral26TonesRus(MHz_u bw, HeRu::RuType ruType)
-{
     std::vector<std::size_t> indices;
 
     if (ruType == HeRu::RU_52_TONE || ruType == HeRu::RU_106_TONE)
@@ -558,7 +559,6 @@ HeRu::GetCentral26TonesRus(MHz_u bw, HeRu::RuType ruType)
         }
     }
 
-    std::vector<HeRu::RuSpec> ret;
     std::vector<bool> primary80MHzSet{true};
 
     if (bw == 160)
@@ -570,49 +570,99 @@ HeRu::GetCentral26TonesRus(MHz_u bw, HeRu::RuType ruType)
     {
         for (const auto& index : indices)
         {
-            ret.emplace_back(HeRu::RU_26_TONE, index, primary80MHz);
+            table.central26TonesRus.emplace_back(HeRu::RU_26_TONE, index, primary80MHz);
         }
     }
-    return ret;
+    return table;
 }
 
-HeRu::SubcarrierGroup
-HeRu::GetSubcarrierGroup(MHz_u bw, RuType ruType, std::size_t phyIndex)
+const HeRu::RuTable*
+HeRu::GetRuTable(MHz_u bw, RuType ruType)
 {
-    if (ruType == HeRu::RU_2x996_TONE) // handle special case of RU covering 160 MHz channel
+    // tables indexed by bandwidth (20, 40, 80 and 160 MHz) and RU type
+    using RuTables = std::array<std::array<RuTable, HeRu::RU_2x996_TONE + 1>, 4>;
+
+    static const RuTables tables = [] {
+        RuTables tables;
+        for (std::size_t bwIndex = 0; bwIndex < tables.size(); bwIndex++)
+        {
+            for (std::size_t type = 0; type < tables[bwIndex].size(); type++)
+            {
+                tables[bwIndex][type] =
+                    ComputeRuTable(MHz_u{20.0 * (1 << bwIndex)}, static_cast<RuType>(type));
+            }
+        }
+        return tables;
+    }();
+
+    std::size_t bwIndex;
+    switch (static_cast<uint16_t>(bw))
     {
-        NS_ABORT_MSG_IF(bw != 160, "2x996 tone RU can only be used on 160 MHz band");
-        return {{-1012, -3}, {3, 1012}};
+    case 20:
+        bwIndex = 0;
+        break;
+    case 40:
+        bwIndex = 1;
+        break;
+    case 80:
+        bwIndex = 2;
+        break;
+    case 160:
+        bwIndex = 3;
+        break;
+    default:
+        return nullptr;
     }
+    return &tables[bwIndex][ruType];
+}
 
-    // Determine the shift to apply to tone indices for 160 MHz channel (i.e. -1012 to 1012), since
-    // m_heRuSubcarrierGroups contains indices for lower 80 MHz subchannel (i.e. from -500 to 500).
-    // The phyIndex is used to that aim.
-    std::size_t indexInLower80MHz = phyIndex;
-    std::size_t numRus = GetNRus(bw, ruType);
-    int16_t shift = (bw == 160) ? -512 : 0;
-    if (bw == 160 && phyIndex > (numRus / 2))
+std::size_t
+HeRu::GetNRus(MHz_u bw, RuType ruType)
+{
+    const auto table = GetRuTable(bw, ruType);
+    return table ? table->groups.size() : 0;
+}
+
+const std::vector<HeRu::RuSpec>&
+HeRu::GetRusOfType(MHz_u bw, HeRu::RuType ruType)
+{
+    if (ruType == HeRu::RU_2x996_TONE)
     {
-        // The provided index is that of the upper 80 MHz subchannel
-        indexInLower80MHz = phyIndex - (numRus / 2);
-        shift = 512;
+        NS_ASSERT(bw >= 160);
+        bw = 160;
     }
 
-    auto it = m_heRuSubcarrierGroups.find({(bw == 160 ? 80 : bw), ruType});
+    const auto table = GetRuTable(bw, ruType);
+    NS_ABORT_MSG_IF(!table || table->rus.empty(),
+                    "No RU of type " << ruType << " in a " << bw << " MHz channel");
+    return table->rus;
+}
 
-    NS_ABORT_MSG_IF(it == m_heRuSubcarrierGroups.end(), "RU not found");
-    NS_ABORT_MSG_IF(indexInLower80MHz > it->second.size(), "RU index not available");
+const std::vector<HeRu::RuSpec>&
+HeRu::GetCentral26TonesRus(MHz_u bw, HeRu::RuType ruType)
+{
+    const auto table = GetRuTable(bw, ruType);
+    NS_ABORT_MSG_IF(!table, "Unsupported bandwidth " << bw << " MHz");
+    return table->central26TonesRus;
+}
 
-    SubcarrierGroup group = it->second.at(indexInLower80MHz - 1);
-    if (bw == 160)
+const HeRu::SubcarrierGroup&
+HeRu::GetSubcarrierGroup(MHz_u bw, RuType ruType, std::size_t phyIndex)
+{
+    if (ruType == HeRu::RU_2x996_TONE) // handle special case of RU covering 160 MHz channel
     {
-        for (auto& range : group)
-        {
-            range.first += shift;
-            range.second += shift;
-        }
+        NS_ABORT_MSG_IF(bw != 160, "2x996 tone RU can only be used on 160 MHz band");
+        return GetRuTable(bw, ruType)->groups.front();
     }
-    return group;
+
+    // Note that for a 160 MHz channel, the PHY index distinguishes between lower and
+    // higher 80 MHz subchannels
+    const auto table = GetRuTable(bw, ruType);
+
+    NS_ABORT_MSG_IF(!table || table->groups.empty(), "RU not found");
+    NS_ABORT_MSG_IF(phyIndex == 0 || phyIndex > table->groups.size(), "RU index not available");
+
+    return table->groups[phyIndex - 1];
 }
 
 bool
@@ -628,7 +678,7 @@ HeRu::DoesOverlap(MHz_u bw, RuSpec ru, const std::vector<RuSpec>& v)
     // not been set yet. Hence, we pass the "MAC" index to GetSubcarrierGroup instead
     // of the PHY index. This is fine because we compare the primary 80 MHz bands of
     // the two RUs below.
-    SubcarrierGroup rangesRu = GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetIndex());
+    const auto& rangesRu = GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetIndex());
     for (auto& p : v)
     {
         if (ru.GetPrimary80MHz() != p.GetPrimary80MHz())
@@ -638,7 +688,7 @@ HeRu::DoesOverlap(MHz_u bw, RuSpec ru, const std::vector<RuSpec>& v)
         }
         for (const auto& rangeRu : rangesRu)
         {
-            SubcarrierGroup rangesP = GetSubcarrierGroup(bw, p.GetRuType(), p.GetIndex());
+            const auto& rangesP = GetSubcarrierGroup(bw, p.GetRuType(), p.GetIndex());
             for (auto& rangeP : rangesP)
             {
                 if (rangeP.second >= rangeRu.first && rangeRu.second >= rangeP.first)
@@ -661,7 +711,7 @@ HeRu::DoesOverlap(MHz_u bw, RuSpec ru, const SubcarrierGroup& toneRanges, uint8_
             return true;
         }
 
-        SubcarrierGroup rangesRu =
+        const auto& rangesRu =
             GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetPhyIndex(bw, p20Index));
         for (auto& r : rangesRu)
         {
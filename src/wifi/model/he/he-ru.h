@@ -171,7 +171,7 @@ class HeRu
      * \param ruType the RU type (number of tones)
      * \return the set of distinct RUs available
      */
-    static std::vector<HeRu::RuSpec> GetRusOfType(MHz_u bw, HeRu::RuType ruType);
+    static const std::vector<HeRu::RuSpec>& GetRusOfType(MHz_u bw, HeRu::RuType ruType);
 
     /**
      * Get the set of 26-tone RUs that can be additionally allocated if the given
@@ -181,7 +181,7 @@ class HeRu
      * \param ruType the RU type (number of tones)
      * \return the set of 26-tone RUs that can be additionally allocated
      */
-    static std::vector<HeRu::RuSpec> GetCentral26TonesRus(MHz_u bw, HeRu::RuType ruType);
+    static const std::vector<HeRu::RuSpec>& GetCentral26TonesRus(MHz_u bw, HeRu::RuType ruType);
 
     /**
      * Get the subcarrier group of the RU having the given PHY index among all the
@@ -197,7 +197,9 @@ class HeRu
      * \param phyIndex the PHY index (starting at 1) of the RU
      * \return the subcarrier range of the specified RU
      */
-    static SubcarrierGroup GetSubcarrierGroup(MHz_u bw, RuType ruType, std::size_t phyIndex);
+    static const SubcarrierGroup& GetSubcarrierGroup(MHz_u bw,
+                                                     RuType ruType,
+                                                     std::size_t phyIndex);
 
     /**
      * Check whether the given RU overlaps with the given set of RUs.
@@ -300,6 +302,37 @@ class HeRu
 
     /// Empty 242-tone RU identifier
     static constexpr uint8_t EMPTY_242_TONE_RU = 113;
+
+  private:
+    /// The RUs and the subcarrier groups of a given type in a HE PPDU of a given bandwidth
+    struct RuTable
+    {
+        std::vector<RuSpec> rus;               ///< the RUs returned by GetRusOfType
+        std::vector<RuSpec> central26TonesRus; ///< the RUs returned by GetCentral26TonesRus
+        std::vector<SubcarrierGroup> groups;   ///< the subcarrier groups indexed by PHY index - 1
+    };
+
+    /**
+     * Compute the RUs and the subcarrier groups of the given type in a HE PPDU of the
+     * given bandwidth from the subcarrier groups of the RUs in the primary 80 MHz.
+     *
+     * \param bw the bandwidth of the HE PPDU (20, 40, 80, 160)
+     * \param ruType the RU type (number of tones)
+     * \return the RUs and the subcarrier groups of the given type
+     */
+    static RuTable ComputeRuTable(MHz_u bw, RuType ruType);
+
+    /**
+     * Get the RUs and the subcarrier groups of the given type in a HE PPDU of the given
+     * bandwidth. The tables for all the supported bandwidths and RU types are computed
+     * the first time this function is called and are then indexed by bandwidth and RU type.
+     *
+     * \param bw the bandwidth of the HE PPDU
+     * \param ruType the RU type (number of tones)
+     * \return the RUs and the subcarrier groups of the given type, or a null pointer if
+     *         the given bandwidth is not 20, 40, 80 or 160 MHz
+     */
+    static const RuTable* GetRuTable(MHz_u bw, RuType ruType);
 };
 
 /**
@@ -844,9 +844,9 @@ RrMultiUserScheduler::FinalizeTxVector(WifiTxVector& txVector)
     std::swap(heMuUserInfoMap, txVector.GetHeMuUserInfoMap());
 
     auto candidateIt = m_candidates.begin(); // iterator over the list of candidate receivers
-    auto ruSet = HeRu::GetRusOfType(m_allowedWidth, ruType);
+    const auto& ruSet = HeRu::GetRusOfType(m_allowedWidth, ruType);
     auto ruSetIt = ruSet.begin();
-    auto central26TonesRus = HeRu::GetCentral26TonesRus(m_allowedWidth, ruType);
+    const auto& central26TonesRus = HeRu::GetCentral26TonesRus(m_allowedWidth, ruType);
     auto central26TonesRusIt = central26TonesRus.begin();
 
     for (std::size_t i = 0; i < nRusAssigned + nCentral26TonesRus; i++)
@@ -19,6 +19,7 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
 #include <numeric>
@@ -163,7 +164,13 @@ InterferenceHelper::NiChange::GetEvent() const
 
 InterferenceHelper::InterferenceHelper()
     : m_errorRateModel(nullptr),
-      m_numRxAntennas(1)
+      m_numRxAntennas(1),
+      m_chunkCacheSize(0),
+      m_useChunkCache(false),
+      m_nChunkCacheHits(0),
+      m_nChunkCacheMisses(0),
+      m_nPerComputations(0),
+      m_nInterferenceFreePerComputations(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -176,10 +183,22 @@ InterferenceHelper::~InterferenceHelper()
 TypeId
 InterferenceHelper::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::InterferenceHelper")
-                            .SetParent<ns3::Object>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<InterferenceHelper>();
+    static TypeId tid =
+        TypeId("ns3::InterferenceHelper")
+            .SetParent<ns3::Object>()
+            .SetGroupName("Wifi")
+            .AddConstructor<InterferenceHelper>()
+            .AddAttribute("ChunkSuccessRateCacheSize",
+                          "The maximum number of chunk success rates of SU PPDUs kept in a cache, "
+                          "which is flushed when it is full. Only the PPDUs that are not "
+                          "overlapped by any other signal use the cache, and the rates are cached "
+                          "for the exact SNR, hence the cache is mostly hit on static links. The "
+                          "cache is flushed when the error rate model or the number of receive "
+                          "antennas is set, but not when the attributes of the error rate model "
+                          "are changed afterwards. A value of 0 disables the cache.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&InterferenceHelper::m_chunkCacheSize),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -193,6 +212,7 @@ InterferenceHelper::DoDispose()
     }
     m_niChanges.clear();
     m_firstPowers.clear();
+    m_chunkSuccessRates.clear();
     m_errorRateModel = nullptr;
 }
 
@@ -309,6 +329,7 @@ void
 InterferenceHelper::SetErrorRateModel(const Ptr<ErrorRateModel> rate)
 {
     m_errorRateModel = rate;
+    m_chunkSuccessRates.clear();
 }
 
 Ptr<ErrorRateModel>
@@ -321,6 +342,31 @@ void
 InterferenceHelper::SetNumberOfReceiveAntennas(uint8_t rx)
 {
     m_numRxAntennas = rx;
+    m_chunkSuccessRates.clear();
+}
+
+uint64_t
+InterferenceHelper::GetNPerComputations() const
+{
+    return m_nPerComputations;
+}
+
+uint64_t
+InterferenceHelper::GetNInterferenceFreePerComputations() const
+{
+    return m_nInterferenceFreePerComputations;
+}
+
+uint64_t
+InterferenceHelper::GetNChunkSuccessRateCacheHits() const
+{
+    return m_nChunkCacheHits;
+}
+
+uint64_t
+InterferenceHelper::GetNChunkSuccessRateCacheMisses() const
+{
+    return m_nChunkCacheMisses;
 }
 
 Time
@@ -372,12 +418,13 @@ InterferenceHelper::AppendEvent(Ptr<Event> event,
             // HE TB PPDU transmission and the start of HE TB payload.
             m_firstPowers.find(band)->second = previousPowerStart;
         }
-        auto first =
+        const auto first =
             AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
-        auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
+        const auto last =
+            AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
         for (auto i = first; i != last; ++i)
         {
-            i->second.AddPower(power);
+            niIt->second[i].second.AddPower(power);
         }
     }
 }
@@ -445,7 +492,14 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
     auto niIt = m_niChanges.find(band);
     NS_ABORT_IF(niIt == m_niChanges.end());
     const auto now = Simulator::Now();
-    auto it = niIt->second.find(event->GetStartTime());
+    const auto findStart = [&niIt, start = event->GetStartTime()]() {
+        // first NiChange occurring at the start of the event
+        return std::lower_bound(niIt->second.begin(),
+                                niIt->second.end(),
+                                start,
+                                [](const auto& niChange, Time t) { return niChange.first < t; });
+    };
+    auto it = findStart();
     const auto muMimoPower = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                                  ? CalculateMuMimoPowerW(event, band)
                                  : 0.0;
@@ -465,20 +519,20 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterference = 0.0;
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
+    it = findStart();
+    NS_ABORT_IF(it == niIt->second.end() || it->first != event->GetStartTime());
     for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
     {
         ;
     }
-    NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
+    auto& ni = nis[band];
+    ni.clear();
+    ni.emplace_back(event->GetStartTime(), NiChange(0, event));
     while (++it != niIt->second.end() && it->second.GetEvent() != event)
     {
-        ni.insert(*it);
+        ni.push_back(*it);
     }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis.insert({band, ni});
+    ni.emplace_back(event->GetEndTime(), NiChange(0, event));
     NS_ASSERT_MSG(noiseInterference >= 0.0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterference);
     return noiseInterference;
@@ -534,8 +588,7 @@ InterferenceHelper::CalculateChunkSuccessRate(double snir,
     }
     const auto rate = mode.GetDataRate(txVector.GetChannelWidth());
     auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
-    const auto csr =
-        m_errorRateModel->GetChunkSuccessRate(mode, txVector, snir, nbits, m_numRxAntennas, field);
+    const auto csr = GetChunkSuccessRate(mode, txVector, snir, nbits, field);
     return csr;
 }
 
@@ -554,16 +607,62 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
     auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
     nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
                                      // error rate as SISO for AWGN
-    double csr = m_errorRateModel->GetChunkSuccessRate(mode,
-                                                       txVector,
-                                                       snir,
-                                                       nbits,
-                                                       m_numRxAntennas,
-                                                       WIFI_PPDU_FIELD_DATA,
-                                                       staId);
+    double csr = GetChunkSuccessRate(mode, txVector, snir, nbits, WIFI_PPDU_FIELD_DATA, staId);
     return csr;
 }
 
+double
+InterferenceHelper::GetChunkSuccessRate(WifiMode mode,
+                                        const WifiTxVector& txVector,
+                                        double snr,
+                                        uint64_t nbits,
+                                        WifiPpduField field,
+                                        uint16_t staId) const
+{
+    if (!m_useChunkCache || m_chunkCacheSize == 0 || txVector.IsMu())
+    {
+        return m_errorRateModel
+            ->GetChunkSuccessRate(mode, txVector, snr, nbits, m_numRxAntennas, field, staId);
+    }
+    // For SU PPDUs, the success rate only depends on the parameters of the TXVECTOR in the key
+    // (besides the number of RX antennas and the error rate model, upon whose change the cache
+    // is cleared). Static links yield the same SNR for each PPDU not overlapped by any other
+    // signal, hence the cache is mostly hit for such receptions.
+    const ChunkKey key{mode.GetUid(),
+                       txVector.GetChannelWidth(),
+                       txVector.GetGuardInterval().GetNanoSeconds(),
+                       txVector.GetNss(),
+                       txVector.IsLdpc(),
+                       field,
+                       snr,
+                       nbits};
+    if (auto it = m_chunkSuccessRates.find(key); it != m_chunkSuccessRates.end())
+    {
+        m_nChunkCacheHits++;
+        return it->second;
+    }
+    m_nChunkCacheMisses++;
+    const auto csr =
+        m_errorRateModel->GetChunkSuccessRate(mode, txVector, snr, nbits, m_numRxAntennas, field);
+    if (m_chunkSuccessRates.size() >= m_chunkCacheSize)
+    {
+        m_chunkSuccessRates.clear();
+    }
+    m_chunkSuccessRates.emplace(key, csr);
+    return csr;
+}
+
+std::size_t
+InterferenceHelper::ChunkKeyHash::operator()(const ChunkKey& key) const
+{
+    std::size_t hash = std::hash<double>()(key.snr);
+    hash ^= (key.nbits + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+    hash ^= ((std::size_t(key.modeUid) << 32 | std::size_t(key.guardInterval) << 16 |
+              std::size_t(key.field) << 10 | std::size_t(key.nss) << 1 | key.ldpc) *
+             0x9e3779b97f4a7c15ULL);
+    return hash ^ std::hash<double>()(key.channelWidth);
+}
+
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         MHz_u channelWidth,
@@ -655,8 +754,8 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    const auto& niIt = nis->find(band)->second;
+    auto j = niIt.cbegin();
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection = Seconds(0);
@@ -669,7 +768,7 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
     NS_ABORT_IF(!m_firstPowers.contains(band));
     auto noiseInterference = m_firstPowers.at(band);
     const auto power = event->GetRxPowerW(band);
-    while (++j != niIt.end())
+    while (++j != niIt.cend())
     {
         auto current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -717,7 +816,7 @@ InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
+    const auto& niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
@@ -754,12 +853,14 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
                                   noiseInterference,
                                   channelWidth,
                                   event->GetPpdu()->GetTxVector().GetNss(staId));
+    CountPerComputation(ni.at(band));
 
     /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
      * all SNIR changes in the SNIR vector.
      */
     const auto per =
         CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    m_useChunkCache = false;
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -785,19 +886,38 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
     NiChangesPerBand ni;
     const auto noiseInterference = CalculateNoiseInterferenceW(event, ni, band);
     const auto snr = CalculateSnr(event->GetRxPowerW(band), noiseInterference, channelWidth, 1);
+    CountPerComputation(ni.at(band));
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
     const auto per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    m_useChunkCache = false;
 
     return PhyEntity::SnrPer(snr, per);
 }
 
+void
+InterferenceHelper::CountPerComputation(const NiChanges& ni) const
+{
+    m_nPerComputations++;
+    // the changes only include the start and the end of the event if no other signal overlaps
+    m_useChunkCache = (ni.size() == 2);
+    if (m_useChunkCache)
+    {
+        m_nInterferenceFreePerComputations++;
+    }
+    NS_LOG_DEBUG("Interference-free PER computations: " << m_nInterferenceFreePerComputations
+                                                        << "/" << m_nPerComputations);
+}
+
 InterferenceHelper::NiChanges::iterator
 InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(niIt->second.begin(),
+                            niIt->second.end(),
+                            moment,
+                            [](Time t, const auto& niChange) { return t < niChange.first; });
 }
 
 InterferenceHelper::NiChanges::iterator
@@ -810,10 +930,11 @@ InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator
     return it;
 }
 
-InterferenceHelper::NiChanges::iterator
+std::size_t
 InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
 {
-    return niIt->second.insert(GetNextPosition(moment, niIt), {moment, change});
+    auto it = niIt->second.emplace(GetNextPosition(moment, niIt), moment, change);
+    return std::distance(niIt->second.begin(), it);
 }
 
 void
@@ -13,6 +13,8 @@
 
 #include "ns3/object.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 
@@ -276,6 +278,25 @@ class InterferenceHelper : public Object
                                                const WifiSpectrumBandInfo& band,
                                                WifiPpduField header) const;
 
+    /**
+     * \return the number of PER computations (PHY header or payload) performed so far
+     */
+    uint64_t GetNPerComputations() const;
+    /**
+     * \return the number of PER computations (PHY header or payload) performed so far for
+     *         receptions that no other signal overlaps, i.e., with a single SNR
+     */
+    uint64_t GetNInterferenceFreePerComputations() const;
+    /**
+     * \return the number of chunk success rates of SU PPDUs found in the cache so far
+     */
+    uint64_t GetNChunkSuccessRateCacheHits() const;
+    /**
+     * \return the number of chunk success rates of SU PPDUs computed by the error rate model
+     *         so far, because they were not in the cache (or the cache is disabled)
+     */
+    uint64_t GetNChunkSuccessRateCacheMisses() const;
+
     /**
      * Notify that RX has started.
      * \param freqRange the frequency range in which the received signal event is detected
@@ -391,9 +412,13 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * Time-ordered sequence of NiChange, each one holding the total noise and
+     * interference power from its time on. NiChanges occurring at the same time
+     * are kept in insertion order. A contiguous container is used because
+     * changes are mostly appended and scanned, and the changes preceding the
+     * reception being processed are dropped when a new reception starts.
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
 
     /**
      * Map of NiChanges per band
@@ -515,11 +540,77 @@ class InterferenceHelper : public Object
                                         const WifiSpectrumBandInfo& band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
 
+    /**
+     * Get the success rate of a chunk from the error rate model, or from the cache of the
+     * success rates previously returned for SU PPDUs if the PER being computed is that of a
+     * PPDU not overlapped by any other signal.
+     *
+     * \param mode the WifiMode used for the transmission
+     * \param txVector the TXVECTOR used for the transmission
+     * \param snr the SINR of the chunk
+     * \param nbits the number of bits in the chunk
+     * \param field the PPDU field to which the chunk belongs to
+     * \param staId the station ID for MU
+     * \return the success rate
+     */
+    double GetChunkSuccessRate(WifiMode mode,
+                               const WifiTxVector& txVector,
+                               double snr,
+                               uint64_t nbits,
+                               WifiPpduField field,
+                               uint16_t staId = SU_STA_ID) const;
+
+    /**
+     * Update the counters of PER computations and enable the cache of chunk success rates
+     * for the PER computation that follows if the event is not overlapped by any other signal.
+     *
+     * \param ni the NiChanges over the duration of the event whose PER is computed
+     */
+    void CountPerComputation(const NiChanges& ni) const;
+
+    /// Key of the cache of chunk success rates
+    struct ChunkKey
+    {
+        uint32_t modeUid;      //!< the UID of the WifiMode
+        MHz_u channelWidth;    //!< the channel width
+        int64_t guardInterval; //!< the guard interval in nanoseconds
+        uint8_t nss;           //!< the number of spatial streams
+        bool ldpc;             //!< whether LDPC is used
+        WifiPpduField field;   //!< the PPDU field to which the chunk belongs to
+        double snr;            //!< the SNR of the chunk
+        uint64_t nbits;        //!< the number of bits in the chunk
+
+        /**
+         * \param other another key
+         * \return true if the keys are equal
+         */
+        bool operator==(const ChunkKey& other) const = default;
+    };
+
+    /// Hash function of the keys of the cache of chunk success rates
+    struct ChunkKeyHash
+    {
+        /**
+         * \param key a key of the cache of chunk success rates
+         * \return the hash of the key
+         */
+        std::size_t operator()(const ChunkKey& key) const;
+    };
+
     double m_noiseFigure;                 //!< noise figure (linear)
     Ptr<ErrorRateModel> m_errorRateModel; //!< error rate model
     uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
     FirstPowerPerBand m_firstPowers; //!< first power of each band
 
+    mutable std::unordered_map<ChunkKey, double, ChunkKeyHash>
+        m_chunkSuccessRates;              //!< chunk success rates cache
+    uint32_t m_chunkCacheSize;            //!< maximum number of entries of the cache
+    mutable bool m_useChunkCache;         //!< whether the PER being computed may use the cache
+    mutable uint64_t m_nChunkCacheHits;   //!< number of chunk success rates found in the cache
+    mutable uint64_t m_nChunkCacheMisses; //!< number of chunk success rates not in the cache
+    mutable uint64_t m_nPerComputations;  //!< number of PER computations
+    mutable uint64_t m_nInterferenceFreePerComputations; //!< number of single SNR PERs
+
     /**
      * Returns an iterator to the first NiChange that is later than moment
      *
@@ -539,16 +630,15 @@ class InterferenceHelper : public Object
 
     /**
      * Add NiChange to the list at the appropriate position and
-     * return the iterator of the new event.
+     * return the index of the new event. Note that adding a NiChange
+     * invalidates the iterators to the list.
      *
      * \param moment time to check from
      * \param change the NiChange to add
      * \param niIt iterator of the band to check
-     * \returns the iterator of the new event
+     * \returns the index of the new event in the list
      */
-    NiChanges::iterator AddNiChangeEvent(Time moment,
-                                         NiChange change,
-                                         NiChangesPerBand::iterator niIt);
+    std::size_t AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt);
 
     /**
      * Return whether another event is a MU-MIMO event that belongs to the same transmission and to
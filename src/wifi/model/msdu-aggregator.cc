@@ -113,7 +113,7 @@ MsduAggregator::GetNextAmsdu(Ptr<WifiMpdu> peekedItem,
     }
 
     Ptr<WifiMpdu> amsdu = queue->GetOriginal(peekedItem);
-    uint8_t nMsdu = 1;
+    std::list<Ptr<const WifiMpdu>> msdus; // the MSDUs to aggregate to the first one
     peekedItem = queue->PeekByTidAndAddress(tid, recipient, peekedItem->GetOriginal());
 
     // stop aggregation if we find an A-MSDU in the queue. This likely happens when an A-MSDU is
@@ -126,23 +126,28 @@ MsduAggregator::GetNextAmsdu(Ptr<WifiMpdu> peekedItem,
         NS_ASSERT_MSG(!peekedItem->HasSeqNoAssigned(),
                       "Found item with sequence number assignment after one without: perhaps "
                       "sequence numbers were not released correctly?");
-        // find the next MPDU before dequeuing the current one
-        Ptr<const WifiMpdu> msdu = peekedItem->GetOriginal();
-        peekedItem = queue->PeekByTidAndAddress(tid, recipient, msdu);
-        queue->DequeueIfQueued({amsdu});
-        // perform A-MSDU aggregation
-        amsdu->Aggregate(msdu);
-        queue->Replace(msdu, amsdu);
-
-        nMsdu++;
+        msdus.push_back(peekedItem->GetOriginal());
+        peekedItem = queue->PeekByTidAndAddress(tid, recipient, msdus.back());
     }
 
-    if (nMsdu == 1)
+    if (msdus.empty())
     {
         NS_LOG_DEBUG("Aggregation failed (could not aggregate at least two MSDUs)");
         return nullptr;
     }
 
+    // dequeue the first MSDU and all the aggregated MSDUs but the last one at once, perform
+    // A-MSDU aggregation and replace the last aggregated MSDU with the A-MSDU, which hence
+    // takes the position and the expiry time of the last aggregated MSDU
+    std::list<Ptr<const WifiMpdu>> dequeued{amsdu};
+    dequeued.insert(dequeued.end(), msdus.cbegin(), std::prev(msdus.cend()));
+    queue->DequeueIfQueued(dequeued);
+    for (const auto& msdu : msdus)
+    {
+        amsdu->Aggregate(msdu);
+    }
+    queue->Replace(msdus.back(), amsdu);
+
     // Aggregation succeeded
     return m_htFem->CreateAliasIfNeeded(amsdu);
 }
@@ -10,11 +10,16 @@
 #include "nist-error-rate-model.h"
 
 #include "wifi-tx-vector.h"
+#include "wifi-utils.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 
 #include <bitset>
 #include <cmath>
+#include <limits>
+#include <map>
+#include <tuple>
 
 namespace ns3
 {
@@ -26,14 +31,23 @@ NS_OBJECT_ENSURE_REGISTERED(NistErrorRateModel);
 TypeId
 NistErrorRateModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::NistErrorRateModel")
-                            .SetParent<ErrorRateModel>()
-                            .SetGroupName("Wifi")
-                            .AddConstructor<NistErrorRateModel>();
+    static TypeId tid =
+        TypeId("ns3::NistErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<NistErrorRateModel>()
+            .AddAttribute("LookupTableStep",
+                          "The SNR step (dB) of the tables from which the coded BER is "
+                          "interpolated. The smaller the step, the more accurate the "
+                          "interpolation. If zero, the coded BER is computed for every chunk.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&NistErrorRateModel::m_lookupTableStep),
+                          MakeDoubleChecker<dB_u>(0));
     return tid;
 }
 
 NistErrorRateModel::NistErrorRateModel()
+    : m_lookupTableStep(0)
 {
 }
 
@@ -169,6 +183,89 @@ NistErrorRateModel::GetFecQamBer(uint16_t constellationSize,
     return pms;
 }
 
+double
+NistErrorRateModel::GetCodedBer(uint16_t constellationSize, double snr, uint8_t bValue) const
+{
+    double ber;
+    if (constellationSize == 2)
+    {
+        ber = GetBpskBer(snr);
+    }
+    else if (constellationSize == 4)
+    {
+        ber = GetQpskBer(snr);
+    }
+    else
+    {
+        ber = GetQamBer(constellationSize, snr);
+    }
+    if (ber == 0.0)
+    {
+        return 0.0;
+    }
+    return std::min(CalculatePe(ber, bValue), 1.0);
+}
+
+const std::vector<double>&
+NistErrorRateModel::GetLookupTable(uint16_t constellationSize, uint8_t bValue) const
+{
+    // tables are shared by all the instances and built on first use
+    static std::map<std::tuple<uint16_t, uint8_t, dB_u>, std::vector<double>> tables;
+    auto [it, inserted] = tables.try_emplace({constellationSize, bValue, m_lookupTableStep});
+    if (inserted)
+    {
+        NS_LOG_DEBUG("Build lookup table for " << constellationSize << "-QAM, bValue=" << +bValue
+                                               << ", step=" << m_lookupTableStep << " dB");
+        const auto nPoints = static_cast<std::size_t>(
+            std::ceil((LOOKUP_TABLE_MAX_SNR - LOOKUP_TABLE_MIN_SNR) / m_lookupTableStep));
+        it->second.reserve(nPoints + 1);
+        for (std::size_t i = 0; i <= nPoints; ++i)
+        {
+            const auto snr = DbToRatio(LOOKUP_TABLE_MIN_SNR + i * m_lookupTableStep);
+            // a null BER is stored as -infinity
+            it->second.push_back(std::log(GetCodedBer(constellationSize, snr, bValue)));
+        }
+    }
+    return it->second;
+}
+
+double
+NistErrorRateModel::GetLookupChunkSuccessRate(uint16_t constellationSize,
+                                              double snr,
+                                              uint64_t nbits,
+                                              uint8_t bValue) const
+{
+    NS_LOG_FUNCTION(this << constellationSize << snr << nbits << +bValue);
+    const auto& table = GetLookupTable(constellationSize, bValue);
+    const auto position = (RatioToDb(snr) - LOOKUP_TABLE_MIN_SNR) / m_lookupTableStep;
+    double pe;
+    if (position >= 0 && position < table.size() - 1)
+    {
+        const auto index = static_cast<std::size_t>(position);
+        const auto lower = table[index];
+        const auto upper = table[index + 1];
+        if (std::isinf(lower) || std::isinf(upper))
+        {
+            // the logarithm of a null BER cannot be interpolated
+            pe = GetCodedBer(constellationSize, snr, bValue);
+        }
+        else
+        {
+            // the logarithm of the BER is interpolated, as the BER spans many orders of magnitude
+            pe = std::exp(lower + (position - index) * (upper - lower));
+        }
+    }
+    else
+    {
+        pe = GetCodedBer(constellationSize, snr, bValue);
+    }
+    if (pe == 0.0)
+    {
+        return 1.0;
+    }
+    return std::pow(1 - std::min(pe, 1.0), nbits);
+}
+
 uint8_t
 NistErrorRateModel::GetBValue(WifiCodeRate codeRate) const
 {
@@ -202,6 +299,13 @@ NistErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
     if (mode.GetModulationClass() >= WIFI_MOD_CLASS_ERP_OFDM)
     {
+        if (m_lookupTableStep > 0)
+        {
+            return GetLookupChunkSuccessRate(mode.GetConstellationSize(),
+                                             snr,
+                                             nbits,
+                                             GetBValue(mode.GetCodeRate()));
+        }
         if (mode.GetConstellationSize() == 2)
         {
             return GetFecBpskBer(snr, nbits, GetBValue(mode.GetCodeRate()));
@@ -12,6 +12,8 @@
 #include "error-rate-model.h"
 #include "wifi-mode.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -22,6 +24,11 @@ namespace ns3
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * If the LookupTableStep attribute is set, the coded bit error probability is
+ * not computed for every chunk but interpolated from a table sampled every
+ * LookupTableStep dB. Tables are built on first use and shared by all the
+ * instances using the same step.
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -34,6 +41,11 @@ class NistErrorRateModel : public ErrorRateModel
 
     NistErrorRateModel();
 
+    /// Lowest SNR covered by the lookup tables
+    static constexpr dB_u LOOKUP_TABLE_MIN_SNR{-10.0};
+    /// Highest SNR covered by the lookup tables
+    static constexpr dB_u LOOKUP_TABLE_MAX_SNR{60.0};
+
   private:
     double DoGetChunkSuccessRate(WifiMode mode,
                                  const WifiTxVector& txVector,
@@ -117,6 +129,45 @@ class NistErrorRateModel : public ErrorRateModel
                         double snr,
                         uint64_t nbits,
                         uint8_t bValue) const;
+    /**
+     * Return the coded BER for the given constellation size at the given SNR.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param snr SNR ratio (in linear scale)
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * \return the coded BER, capped to 1
+     */
+    double GetCodedBer(uint16_t constellationSize, double snr, uint8_t bValue) const;
+    /**
+     * Return the lookup table of the coded BER for the given constellation size and bValue,
+     * which holds the natural logarithm of the coded BER for the SNRs (in dB) ranging from
+     * LOOKUP_TABLE_MIN_SNR to LOOKUP_TABLE_MAX_SNR with a step of m_lookupTableStep.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * \return the lookup table
+     */
+    const std::vector<double>& GetLookupTable(uint16_t constellationSize, uint8_t bValue) const;
+    /**
+     * Return the chunk success rate for the given constellation size at the given SNR,
+     * obtained by interpolating the coded BER in the lookup table. The coded BER is
+     * computed if the SNR is not covered by the table.
+     *
+     * \param constellationSize the constellation size (M)
+     * \param snr SNR ratio (in linear scale)
+     * \param nbits the number of bits in the chunk
+     * \param bValue the bValue such that coding rate = bValue / (bValue + 1)
+     *
+     * \return the chunk success rate
+     */
+    double GetLookupChunkSuccessRate(uint16_t constellationSize,
+                                     double snr,
+                                     uint64_t nbits,
+                                     uint8_t bValue) const;
+
+    dB_u m_lookupTableStep; //!< SNR step of the lookup tables (0 to compute the BER for each chunk)
 };
 
 } // namespace ns3
@@ -14,6 +14,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -97,15 +99,19 @@ OriginatorBlockAckAgreement::AllAckedMpdusInTxWindow(const std::set<uint16_t>& s
         distances.insert(GetDistance(seqN));
     }
 
-    for (std::size_t i = 0; i < m_txWindow.GetWinSize(); ++i)
+    // check the window 64 positions at a time
+    for (std::size_t i = 0; i < m_txWindow.GetWinSize(); i += 64)
     {
-        if (distances.contains(i))
+        const auto n = std::min<std::size_t>(64, m_txWindow.GetWinSize() - i);
+        auto word = m_txWindow.GetWord(i);
+        // mark the positions to ignore as acknowledged
+        for (auto it = distances.lower_bound(i); it != distances.end() && *it < i + n; ++it)
         {
-            continue; // this is one of the positions to ignore
+            word |= uint64_t{1} << (*it - i);
         }
-        if (!m_txWindow.At(i))
+        if (word != ((n == 64) ? ~uint64_t{0} : (uint64_t{1} << n) - 1))
         {
-            return false; // this position is available or contains an unacknowledged MPDU
+            return false; // a position is available or contains an unacknowledged MPDU
         }
     }
     NS_LOG_INFO("TX window is blocked");
@@ -115,9 +121,9 @@ OriginatorBlockAckAgreement::AllAckedMpdusInTxWindow(const std::set<uint16_t>& s
 void
 OriginatorBlockAckAgreement::AdvanceTxWindow()
 {
-    while (m_txWindow.At(0))
+    if (const auto count = m_txWindow.GetNLeadingSet(); count > 0)
     {
-        m_txWindow.Advance(1); // reset the current head -- ensures loop termination
+        m_txWindow.Advance(count);
     }
 }
 
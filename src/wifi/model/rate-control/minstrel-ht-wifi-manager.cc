@@ -34,6 +34,7 @@
 #include "ns3/wifi-phy.h"
 
 #include <iomanip>
+#include <tuple>
 
 #define Min(a, b) ((a < b) ? a : b)
 #define Max(a, b) ((a > b) ? a : b)
@@ -63,6 +64,40 @@ struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
     std::ofstream m_statsFile; //!< File where statistics table is written.
 };
 
+McsGroupData::McsGroupData(std::size_t numGroups)
+    : m_positions(numGroups, UNSUPPORTED)
+{
+}
+
+GroupInfo&
+McsGroupData::AddSupportedGroup(std::size_t groupId)
+{
+    NS_ASSERT(groupId < m_positions.size() && m_positions[groupId] == UNSUPPORTED);
+    NS_ASSERT(m_groups.size() < UNSUPPORTED);
+    m_positions[groupId] = m_groups.size();
+    auto& group = m_groups.emplace_back();
+    group.m_supported = true;
+    return group;
+}
+
+GroupInfo&
+McsGroupData::operator[](std::size_t groupId)
+{
+    NS_ASSERT(groupId < m_positions.size());
+    if (m_positions[groupId] == UNSUPPORTED)
+    {
+        NS_ASSERT(!m_unsupported.m_supported);
+        return m_unsupported;
+    }
+    return m_groups[m_positions[groupId]];
+}
+
+std::size_t
+McsGroupData::GetNSupportedGroups() const
+{
+    return m_groups.size();
+}
+
 NS_OBJECT_ENSURE_REGISTERED(MinstrelHtWifiManager);
 
 TypeId
@@ -137,11 +172,6 @@ MinstrelHtWifiManager::MinstrelHtWifiManager()
 MinstrelHtWifiManager::~MinstrelHtWifiManager()
 {
     NS_LOG_FUNCTION(this);
-    for (uint8_t i = 0; i < m_numGroups; i++)
-    {
-        m_minstrelGroups[i].ratesFirstMpduTxTimeTable.clear();
-        m_minstrelGroups[i].ratesTxTimeTable.clear();
-    }
 }
 
 int64_t
@@ -241,6 +271,16 @@ MinstrelHtWifiManager::DoInitialize()
                             streams)) /// Are streams supported by the transmitter?
                     {
                         m_minstrelGroups[groupId].isSupported = true;
+                        NS_LOG_DEBUG("Initialized group " << +groupId << ": (" << +streams << ","
+                                                          << guardInterval << "," << chWidth
+                                                          << ")");
+
+                        if (!BindGroupTxTimes(groupId))
+                        {
+                            // a manager using the same PHY band and frame length already
+                            // calculated the TX times of the rates of this group
+                            continue;
+                        }
 
                         // Calculate TX time for all rates of the group
                         WifiModeList htMcsList = GetHtDeviceMcsList();
@@ -265,9 +305,6 @@ MinstrelHtWifiManager::DoInitialize()
                                                                   mode,
                                                                   MIDDLE_MPDU_IN_AGGREGATE));
                         }
-                        NS_LOG_DEBUG("Initialized group " << +groupId << ": (" << +streams << ","
-                                                          << guardInterval << "," << chWidth
-                                                          << ")");
                     }
                 }
                 gi /= 2;
@@ -302,6 +339,15 @@ MinstrelHtWifiManager::DoInitialize()
                             streams)) /// Are streams supported by the transmitter?
                     {
                         m_minstrelGroups[groupId].isSupported = true;
+                        NS_LOG_DEBUG("Initialized group " << +groupId << ": (" << +streams << ","
+                                                          << gi << "," << chWidth << ")");
+
+                        if (!BindGroupTxTimes(groupId))
+                        {
+                            // a manager using the same PHY band and frame length already
+                            // calculated the TX times of the rates of this group
+                            continue;
+                        }
 
                         // Calculate TX time for all rates of the group
                         WifiModeList vhtMcsList = GetVhtDeviceMcsList();
@@ -330,8 +376,6 @@ MinstrelHtWifiManager::DoInitialize()
                                                                       MIDDLE_MPDU_IN_AGGREGATE));
                             }
                         }
-                        NS_LOG_DEBUG("Initialized group " << +groupId << ": (" << +streams << ","
-                                                          << gi << "," << chWidth << ")");
                     }
                 }
                 gi /= 2;
@@ -366,6 +410,15 @@ MinstrelHtWifiManager::DoInitialize()
                             streams)) /// Are streams supported by the transmitter?
                     {
                         m_minstrelGroups[groupId].isSupported = true;
+                        NS_LOG_DEBUG("Initialized group " << +groupId << ": (" << +streams << ","
+                                                          << gi << "," << chWidth << ")");
+
+                        if (!BindGroupTxTimes(groupId))
+                        {
+                            // a manager using the same PHY band and frame length already
+                            // calculated the TX times of the rates of this group
+                            continue;
+                        }
 
                         // Calculate tx time for all rates of the group
                         WifiModeList heMcsList = GetHeDeviceMcsList();
@@ -394,8 +447,6 @@ MinstrelHtWifiManager::DoInitialize()
                                                                       MIDDLE_MPDU_IN_AGGREGATE));
                             }
                         }
-                        NS_LOG_DEBUG("Initialized group " << +groupId << ": (" << +streams << ","
-                                                          << gi << "," << chWidth << ")");
                     }
                 }
                 gi /= 2;
@@ -440,32 +491,81 @@ Time
 MinstrelHtWifiManager::GetFirstMpduTxTime(uint8_t groupId, WifiMode mode) const
 {
     NS_LOG_FUNCTION(this << +groupId << mode);
-    auto it = m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.find(mode);
-    NS_ASSERT(it != m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.end());
-    return it->second;
+    NS_ASSERT(m_minstrelGroups[groupId].txTimes);
+    const auto& table = m_minstrelGroups[groupId].txTimes->ratesFirstMpduTxTimeTable;
+    const auto rateId = GetModeRateId(mode);
+    NS_ASSERT(rateId < table.size() && table[rateId].IsStrictlyPositive());
+    return table[rateId];
 }
 
 void
 MinstrelHtWifiManager::AddFirstMpduTxTime(uint8_t groupId, WifiMode mode, Time t)
 {
     NS_LOG_FUNCTION(this << +groupId << mode << t);
-    m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.insert(std::make_pair(mode, t));
+    NS_ASSERT(m_minstrelGroups[groupId].txTimes);
+    auto& table = m_minstrelGroups[groupId].txTimes->ratesFirstMpduTxTimeTable;
+    const auto rateId = GetModeRateId(mode);
+    if (rateId >= table.size())
+    {
+        table.resize(rateId + 1);
+    }
+    table[rateId] = t;
 }
 
 Time
 MinstrelHtWifiManager::GetMpduTxTime(uint8_t groupId, WifiMode mode) const
 {
     NS_LOG_FUNCTION(this << +groupId << mode);
-    auto it = m_minstrelGroups[groupId].ratesTxTimeTable.find(mode);
-    NS_ASSERT(it != m_minstrelGroups[groupId].ratesTxTimeTable.end());
-    return it->second;
+    NS_ASSERT(m_minstrelGroups[groupId].txTimes);
+    const auto& table = m_minstrelGroups[groupId].txTimes->ratesTxTimeTable;
+    const auto rateId = GetModeRateId(mode);
+    NS_ASSERT(rateId < table.size() && table[rateId].IsStrictlyPositive());
+    return table[rateId];
 }
 
 void
 MinstrelHtWifiManager::AddMpduTxTime(uint8_t groupId, WifiMode mode, Time t)
 {
     NS_LOG_FUNCTION(this << +groupId << mode << t);
-    m_minstrelGroups[groupId].ratesTxTimeTable.insert(std::make_pair(mode, t));
+    NS_ASSERT(m_minstrelGroups[groupId].txTimes);
+    auto& table = m_minstrelGroups[groupId].txTimes->ratesTxTimeTable;
+    const auto rateId = GetModeRateId(mode);
+    if (rateId >= table.size())
+    {
+        table.resize(rateId + 1);
+    }
+    table[rateId] = t;
+}
+
+bool
+MinstrelHtWifiManager::BindGroupTxTimes(uint8_t groupId)
+{
+    NS_LOG_FUNCTION(this << +groupId);
+    // the transmission times only depend on the PHY band, the frame length and the
+    // definition of the group, hence they are stored once for all the managers
+    using Key = std::tuple<WifiPhyBand, uint32_t, McsGroupType, uint8_t, int64_t, MHz_u>;
+    static std::map<Key, McsGroupTxTimes> txTimes;
+
+    auto& group = m_minstrelGroups[groupId];
+    auto [it, inserted] = txTimes.try_emplace({GetPhy()->GetPhyBand(),
+                                               m_frameLength,
+                                               group.type,
+                                               group.streams,
+                                               group.gi.GetNanoSeconds(),
+                                               group.chWidth});
+    group.txTimes = &it->second;
+    return inserted;
+}
+
+uint8_t
+MinstrelHtWifiManager::GetModeRateId(WifiMode mode)
+{
+    // HT MCS indices account for the number of spatial streams
+    if (mode.GetModulationClass() == WIFI_MOD_CLASS_HT)
+    {
+        return mode.GetMcsValue() % MAX_HT_GROUP_RATES;
+    }
+    return mode.GetMcsValue();
 }
 
 WifiRemoteStation*
@@ -1702,8 +1802,6 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
     {
         if (m_minstrelGroups[groupId].isSupported)
         {
-            station->m_groupsTable[groupId].m_supported = false;
-
             if ((m_minstrelGroups[groupId].type == WIFI_MINSTREL_GROUP_HE) &&
                 !GetHeSupported(station))
             {
@@ -1762,7 +1860,7 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
                                    << " width: " << m_minstrelGroups[groupId].chWidth);
 
             noSupportedGroupFound = false;
-            station->m_groupsTable[groupId].m_supported = true;
+            station->m_groupsTable.AddSupportedGroup(groupId);
             station->m_groupsTable[groupId].m_col = 0;
             station->m_groupsTable[groupId].m_index = 0;
 
@@ -19,13 +19,18 @@
 #include "ns3/wifi-remote-station-manager.h"
 #include "ns3/wifi-types.h"
 
+#include <limits>
+
+class MinstrelHtTxTimesTest;
+
 namespace ns3
 {
 
 /**
- * Data structure to save transmission time calculations per rate.
+ * Data structure to save transmission time calculations per rate, indexed by the
+ * ID of the rate within its group. Invalid rates have a null transmission time.
  */
-typedef std::map<WifiMode, Time> TxTime;
+typedef std::vector<Time> TxTime;
 
 /**
  * \enum McsGroupType
@@ -62,24 +67,34 @@ operator<<(std::ostream& os, McsGroupType type)
 }
 
 /**
- * Data structure to contain the information that defines a group.
- * It also contains the transmission times for all the MCS in the group.
- * A group is a collection of MCS defined by the number of spatial streams,
- * if it uses or not Short Guard Interval, and the channel width used.
+ * Data structure to contain the transmission times for all the MCS in a group.
+ * These only depend on the definition of the group, the PHY band and the frame
+ * length, hence they are shared by all the managers for which these are the same.
  */
-struct McsGroup
+struct McsGroupTxTimes
 {
-    uint8_t streams;   ///< number of spatial streams
-    Time gi;           ///< guard interval duration
-    MHz_u chWidth;     ///< channel width
-    McsGroupType type; ///< identifies the group, \see McsGroupType
-    bool isSupported;  ///< flag whether group is  supported
     // To accurately account for TX times, we separate the TX time of the first
     // MPDU in an A-MPDU from the rest of the MPDUs.
     TxTime ratesTxTimeTable;          ///< rates transmit time table
     TxTime ratesFirstMpduTxTimeTable; ///< rates MPDU transmit time table
 };
 
+/**
+ * Data structure to contain the information that defines a group.
+ * It also points to the transmission times for all the MCS in the group.
+ * A group is a collection of MCS defined by the number of spatial streams,
+ * if it uses or not Short Guard Interval, and the channel width used.
+ */
+struct McsGroup
+{
+    uint8_t streams;                   ///< number of spatial streams
+    Time gi;                           ///< guard interval duration
+    MHz_u chWidth;                     ///< channel width
+    McsGroupType type;                 ///< identifies the group, \see McsGroupType
+    bool isSupported;                  ///< flag whether group is  supported
+    McsGroupTxTimes* txTimes{nullptr}; ///< transmission times (null if group is not supported)
+};
+
 /**
  * Data structure for a table of group definitions.
  * A vector of McsGroups.
@@ -147,10 +162,50 @@ struct GroupInfo
 };
 
 /**
- * Data structure for a table of groups. Each group is of type GroupInfo.
- * A vector of a GroupInfo.
+ * Data structure for the table of groups of a station, accessed through the group ID.
+ * Only the GroupInfo of the groups supported by the station are stored, in a compact
+ * vector, since the station usually supports a small subset of the groups.
  */
-typedef std::vector<GroupInfo> McsGroupData;
+class McsGroupData
+{
+  public:
+    McsGroupData() = default;
+
+    /**
+     * Constructor.
+     *
+     * \param numGroups the number of groups, none of which is supported by the station yet
+     */
+    explicit McsGroupData(std::size_t numGroups);
+
+    /**
+     * Add a group supported by the station.
+     *
+     * \param groupId the group ID
+     * \return the information of the group, which is flagged as supported
+     */
+    GroupInfo& AddSupportedGroup(std::size_t groupId);
+
+    /**
+     * \param groupId the group ID
+     * \return the information of the group. The information returned for all the groups
+     *         not supported by the station is the same entry, which must not be modified.
+     */
+    GroupInfo& operator[](std::size_t groupId);
+
+    /**
+     * \return the number of groups supported by the station
+     */
+    std::size_t GetNSupportedGroups() const;
+
+  private:
+    /// position in the vector of supported groups of the groups not supported by the station
+    static constexpr uint8_t UNSUPPORTED = std::numeric_limits<uint8_t>::max();
+
+    std::vector<uint8_t> m_positions; //!< position of each group in the vector of supported groups
+    std::vector<GroupInfo> m_groups;  //!< the groups supported by the station
+    GroupInfo m_unsupported{};        //!< the information of the groups not supported
+};
 
 /**
  * Constants for maximum values.
@@ -225,6 +280,9 @@ static const MHz_u MAX_HE_WIDTH = 160;         //!< Maximal channel width.
 class MinstrelHtWifiManager : public WifiRemoteStationManager
 {
   public:
+    /// allow MinstrelHtTxTimesTest class access
+    friend class ::MinstrelHtTxTimesTest;
+
     /**
      * \brief Get the type ID.
      * \return the object TypeId
@@ -342,6 +400,24 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
      */
     void AddFirstMpduTxTime(uint8_t groupId, WifiMode mode, Time t);
 
+    /**
+     * Make the given group point to the transmission times of the group with the same
+     * definition for the PHY band and frame length of this manager, which are created
+     * if no other manager needed them before.
+     *
+     * \param groupId the group ID
+     * \returns true if the transmission times have yet to be calculated
+     */
+    bool BindGroupTxTimes(uint8_t groupId);
+
+    /**
+     * Get the ID of the given mode within the group it belongs to.
+     *
+     * \param mode the wifi mode
+     * \returns the rate ID of the mode
+     */
+    static uint8_t GetModeRateId(WifiMode mode);
+
     /**
      * Update the number of retries and reset accordingly.
      * \param station the wifi remote station
@@ -242,11 +242,14 @@ RecipientBlockAckAgreement::FillBlockAckBitmap(CtrlBAckResponseHeader* blockAckH
         blockAckHeader->SetStartingSequence(ssn, index);
         blockAckHeader->ResetBitmap(index);
 
-        for (std::size_t i = 0; i < m_scoreboard.GetWinSize(); i++)
+        // copy the scoreboard into the bitmap 64 bits at a time
+        const auto nBits =
+            std::min(m_scoreboard.GetWinSize(), blockAckHeader->GetBitmap(index).size() * 8);
+        for (std::size_t i = 0; i < nBits; i += 64)
         {
-            if (m_scoreboard.At(i))
+            if (const auto word = m_scoreboard.GetWord(i); word != 0)
             {
-                blockAckHeader->SetReceivedPacket((ssn + i) % SEQNO_SPACE_SIZE, index);
+                blockAckHeader->SetReceivedPackets((ssn + i) % SEQNO_SPACE_SIZE, word, index);
             }
         }
     }
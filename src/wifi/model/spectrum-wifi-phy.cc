@@ -157,7 +157,7 @@ SpectrumWifiPhy::GetHeRuBands(Ptr<WifiSpectrumPhyInterface> spectrumPhyInterface
                 std::size_t nRus = HeRu::GetNRus(bw, ruType);
                 for (std::size_t phyIndex = 1; phyIndex <= nRus; phyIndex++)
                 {
-                    HeRu::SubcarrierGroup group = HeRu::GetSubcarrierGroup(bw, ruType, phyIndex);
+                    const auto& group = HeRu::GetSubcarrierGroup(bw, ruType, phyIndex);
                     HeRu::SubcarrierRange subcarrierRange =
                         std::make_pair(group.front().first, group.back().second);
                     const auto bandIndices =
@@ -1225,6 +1225,20 @@ StaWifiMac::ReceiveBeacon(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
     }
 }
 
+void
+StaWifiMac::NotifyAbstractedBeacon(uint8_t linkId, Time beaconInterval)
+{
+    NS_LOG_FUNCTION(this << +linkId << beaconInterval);
+
+    if (m_state != ASSOCIATED)
+    {
+        return;
+    }
+    NS_LOG_DEBUG("Abstracted Beacon received on link " << +linkId);
+    m_beaconArrival(Simulator::Now());
+    RestartBeaconWatchdog(beaconInterval * m_maxMissedBeacons);
+}
+
 void
 StaWifiMac::ReceiveProbeResp(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
 {
@@ -219,6 +219,18 @@ class StaWifiMac : public WifiMac
      */
     void ScanningTimeout(const std::optional<ApInfo>& bestAp);
 
+    /**
+     * Notify that the AP we are associated with on the given link has delivered a Beacon
+     * frame without transmitting it through the PHY, because the AP operates in the Beacon
+     * abstraction mode and the content of the Beacon frame did not change since the last
+     * Beacon frame that we received through the PHY. Hence, the Beacon frame only resets
+     * the beacon watchdog.
+     *
+     * \param linkId the ID of the link on which the Beacon frame was delivered
+     * \param beaconInterval the beacon interval advertised by the AP
+     */
+    void NotifyAbstractedBeacon(uint8_t linkId, Time beaconInterval);
+
     /**
      * Return whether we are associated with an AP.
      *
@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 
 namespace ns3
 {
@@ -178,50 +179,33 @@ TableBasedErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
     auto errorTable = (ldpc ? AwgnErrorTableLdpc1458
                             : (size < m_threshold ? AwgnErrorTableBcc32 : AwgnErrorTableBcc1458));
     const auto& itVector = errorTable[mcs];
-    auto itTable =
-        std::find_if(itVector.cbegin(), itVector.cend(), [&roundedSnr](const auto& element) {
-            return element.first == roundedSnr;
-        });
-    const auto minSnr = itVector.cbegin()->first;
-    const auto maxSnr = (--itVector.cend())->first;
+    // the tables are sorted by increasing SNR
+    auto itTable = std::lower_bound(itVector.cbegin(),
+                                    itVector.cend(),
+                                    roundedSnr,
+                                    [](const auto& element, dB_u value) {
+                                        return element.first < value;
+                                    });
     double per;
     if (itTable == itVector.cend())
     {
-        if (roundedSnr < minSnr)
-        {
-            per = 1.0;
-        }
-        else if (roundedSnr > maxSnr)
-        {
-            per = 0.0;
-        }
-        else
-        {
-            double a = 0.0;
-            double b = 0.0;
-            dB_u previousSnr{0.0};
-            dB_u nextSnr{0.0};
-            for (auto i = itVector.cbegin(); i != itVector.cend(); ++i)
-            {
-                if (i->first < roundedSnr)
-                {
-                    previousSnr = i->first;
-                    a = i->second;
-                }
-                else
-                {
-                    nextSnr = i->first;
-                    b = i->second;
-                    break;
-                }
-            }
-            per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
-        }
+        per = 0.0;
     }
-    else
+    else if (itTable->first == roundedSnr)
     {
         per = itTable->second;
     }
+    else if (itTable == itVector.cbegin())
+    {
+        per = 1.0;
+    }
+    else
+    {
+        const auto itPrevious = std::prev(itTable);
+        const auto a = itPrevious->second;
+        const auto b = itTable->second;
+        per = a + (roundedSnr - itPrevious->first) * (b - a) / (itTable->first - itPrevious->first);
+    }
 
     uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE
                                : (size < m_threshold ? ERROR_TABLE_BCC_SMALL_FRAME_SIZE
@@ -14,6 +14,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace ns3
@@ -25,6 +26,7 @@ WifiMacQueueContainer::clear()
     m_queues.clear();
     m_expiredQueue.clear();
     m_nBytesPerQueue.clear();
+    m_expiryIndex.clear();
 }
 
 WifiMacQueueContainer::iterator
@@ -39,7 +41,9 @@ WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
     auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
     it->second += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    auto elemIt = m_queues[queueId].emplace(pos, item);
+    AddExpiryTime(queueId, elemIt->GetExpiryTime());
+    return elemIt;
 }
 
 WifiMacQueueContainer::iterator
@@ -55,10 +59,87 @@ WifiMacQueueContainer::erase(const_iterator pos)
     NS_ASSERT(it != m_nBytesPerQueue.end());
     NS_ASSERT(it->second >= pos->mpdu->GetSize());
     it->second -= pos->mpdu->GetSize();
+    RemoveExpiryTime(queueId, pos->GetExpiryTime());
 
     return m_queues[queueId].erase(pos);
 }
 
+void
+WifiMacQueueContainer::SetExpiryTime(iterator it, Time expiryTime) const
+{
+    NS_ASSERT(!it->expired);
+    WifiContainerQueueId queueId = GetQueueId(it->mpdu);
+    RemoveExpiryTime(queueId, it->GetExpiryTime());
+    it->m_expiryTime = expiryTime;
+    AddExpiryTime(queueId, expiryTime);
+}
+
+void
+WifiMacQueueContainer::AddExpiryTime(const WifiContainerQueueId& queueId, Time expiryTime) const
+{
+    auto& index = m_expiryIndex[queueId];
+
+    if (index.empty() || index.back().first < expiryTime)
+    {
+        // the common case: MPDUs are enqueued in increasing order of expiry time
+        index.emplace_back(expiryTime, 1);
+        return;
+    }
+    if (index.back().first == expiryTime)
+    {
+        index.back().second++;
+        return;
+    }
+    if (expiryTime < index.front().first)
+    {
+        index.emplace_front(expiryTime, 1);
+        return;
+    }
+    auto it = std::lower_bound(index.begin(),
+                               index.end(),
+                               expiryTime,
+                               [](const auto& entry, Time t) { return entry.first < t; });
+    if (it->first == expiryTime)
+    {
+        it->second++;
+        return;
+    }
+    index.emplace(it, expiryTime, 1);
+}
+
+void
+WifiMacQueueContainer::RemoveExpiryTime(const WifiContainerQueueId& queueId, Time expiryTime) const
+{
+    auto indexIt = m_expiryIndex.find(queueId);
+    NS_ASSERT(indexIt != m_expiryIndex.end() && !indexIt->second.empty());
+    auto& index = indexIt->second;
+
+    auto it = index.begin();
+    if (it->first != expiryTime)
+    {
+        it = std::prev(index.end());
+        if (it->first != expiryTime)
+        {
+            it = std::lower_bound(index.begin(),
+                                  index.end(),
+                                  expiryTime,
+                                  [](const auto& entry, Time t) { return entry.first < t; });
+        }
+    }
+    NS_ASSERT(it != index.end() && it->first == expiryTime && it->second > 0);
+    it->second--;
+
+    // entries with no MPDU are only removed when they are at the front or at the back
+    while (!index.empty() && index.front().second == 0)
+    {
+        index.pop_front();
+    }
+    while (!index.empty() && index.back().second == 0)
+    {
+        index.pop_back();
+    }
+}
+
 Ptr<WifiMpdu>
 WifiMacQueueContainer::GetItem(const const_iterator it) const
 {
@@ -107,16 +188,27 @@ WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(queueId, m_queues[queueId]);
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(const WifiContainerQueueId& queueId,
+                                             ContainerQueue& queue) const
 {
+    Time now = Simulator::Now();
+
+    // the earliest expiry time of the MPDUs in the container queue tells us, in constant
+    // time, whether the container queue includes any MPDU with expired lifetime
+    if (auto indexIt = m_expiryIndex.find(queueId);
+        indexIt == m_expiryIndex.end() || indexIt->second.empty() ||
+        indexIt->second.front().first > now)
+    {
+        return {m_expiredQueue.end(), m_expiredQueue.end()};
+    }
+
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
-    Time now = Simulator::Now();
 
     do
     {
@@ -134,7 +226,7 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
         }
 
         // advance lastExpiredIt as we encounter MPDUs with expired lifetime that are not inflight
-        while (lastExpiredIt != queue.end() && lastExpiredIt->expiryTime <= now &&
+        while (lastExpiredIt != queue.end() && lastExpiredIt->GetExpiryTime() <= now &&
                lastExpiredIt->inflights.empty())
         {
             lastExpiredIt->expired = true;
@@ -142,11 +234,11 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
             auto it = m_nBytesPerQueue.find(queueId);
             NS_ASSERT(it != m_nBytesPerQueue.end());
             NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
             it->second -= lastExpiredIt->mpdu->GetSize();
+            RemoveExpiryTime(queueId, lastExpiredIt->GetExpiryTime());
 
             ++lastExpiredIt;
         }
@@ -170,7 +262,7 @@ WifiMacQueueContainer::ExtractAllExpiredMpdus() const
 
     for (auto& queue : m_queues)
     {
-        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.second);
+        auto [firstIt, lastIt] = DoExtractExpiredMpdus(queue.first, queue.second);
 
         if (firstIt != lastIt && !firstExpiredIt)
         {
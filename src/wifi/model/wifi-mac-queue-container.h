@@ -13,6 +13,7 @@
 
 #include "ns3/mac48-address.h"
 
+#include <deque>
 #include <list>
 #include <optional>
 #include <tuple>
@@ -131,6 +132,16 @@ class WifiMacQueueContainer
      */
     iterator erase(const_iterator pos);
 
+    /**
+     * Set the expiry time of the MPDU included in the element pointed to by the given
+     * iterator. The expiry time of the MPDUs stored in the container must only be set
+     * through this method, so that the index of the expiry times is kept up to date.
+     *
+     * \param it iterator pointing to an element that is not expired
+     * \param expiryTime the expiry time of the MPDU
+     */
+    void SetExpiryTime(iterator it, Time expiryTime) const;
+
     /**
      * Return the WifiMpdu included in the element pointed to by the given iterator.
      *
@@ -198,17 +209,47 @@ class WifiMacQueueContainer
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
+     * \param queueId the QueueId identifying the given container queue
      * \param queue the given container queue
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(const WifiContainerQueueId& queueId,
+                                                        ContainerQueue& queue) const;
+
+    /**
+     * The expiry times of the MPDUs stored in a container queue, sorted in increasing
+     * order, each paired with the number of MPDUs having that expiry time. Given that
+     * the expiry time of an MPDU is set when the MPDU is enqueued, new expiry times are
+     * normally added at the back, while expiry times are normally removed from the front,
+     * as MPDUs leave the container queue. Entries for which the number of MPDUs drops to
+     * zero are kept until they reach the front or the back of the index.
+     */
+    using ExpiryIndex = std::deque<std::pair<Time, uint32_t>>;
+
+    /**
+     * Add the given expiry time to the index of the given container queue.
+     *
+     * \param queueId the QueueId identifying the container queue
+     * \param expiryTime the expiry time to add
+     */
+    void AddExpiryTime(const WifiContainerQueueId& queueId, Time expiryTime) const;
+
+    /**
+     * Remove the given expiry time from the index of the given container queue.
+     *
+     * \param queueId the QueueId identifying the container queue
+     * \param expiryTime the expiry time to remove
+     */
+    void RemoveExpiryTime(const WifiContainerQueueId& queueId, Time expiryTime) const;
 
     mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
     mutable std::unordered_map<WifiContainerQueueId, uint32_t>
         m_nBytesPerQueue; //!< size in bytes of the container queues
+    mutable std::unordered_map<WifiContainerQueueId, ExpiryIndex>
+        m_expiryIndex; //!< expiry times of the MPDUs in the container queues
 };
 
 } // namespace ns3
@@ -15,7 +15,6 @@ namespace ns3
 
 WifiMacQueueElem::WifiMacQueueElem(Ptr<WifiMpdu> item)
     : mpdu(item),
-      expiryTime(0),
       ac(AC_UNDEF),
       expired(false)
 {
@@ -27,4 +26,10 @@ WifiMacQueueElem::~WifiMacQueueElem()
     inflights.clear();
 }
 
+Time
+WifiMacQueueElem::GetExpiryTime() const
+{
+    return m_expiryTime;
+}
+
 } // namespace ns3
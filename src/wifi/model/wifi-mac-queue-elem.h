@@ -39,7 +39,6 @@ class WifiMpdu;
 struct WifiMacQueueElem
 {
     Ptr<WifiMpdu> mpdu;                         ///< MPDU stored by this element
-    Time expiryTime{0};                         ///< expiry time of the MPDU (set by WifiMacQueue)
     AcIndex ac{AC_UNDEF};                       ///< the Access Category associated with the queue
                                                 ///< storing this element (set by WifiMacQueue)
     bool expired{false};                        ///< whether this MPDU has been marked as expired
@@ -53,6 +52,17 @@ struct WifiMacQueueElem
     WifiMacQueueElem(Ptr<WifiMpdu> item);
 
     ~WifiMacQueueElem();
+
+    /**
+     * \return the expiry time of the MPDU
+     */
+    Time GetExpiryTime() const;
+
+  private:
+    /// the expiry time is indexed by the container, which is the only one allowed to set it
+    friend class WifiMacQueueContainer;
+
+    Time m_expiryTime{0}; ///< expiry time of the MPDU (set by WifiMacQueueContainer)
 };
 
 } // namespace ns3
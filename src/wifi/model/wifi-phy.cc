@@ -56,6 +56,9 @@ NS_LOG_COMPONENT_DEFINE("WifiPhy");
 
 NS_OBJECT_ENSURE_REGISTERED(WifiPhy);
 
+/// Maximum number of entries of the cache of TX durations
+static const std::size_t MAX_TX_DURATION_CACHE_SIZE = 65536;
+
 TypeId
 WifiPhy::GetTypeId()
 {
@@ -462,6 +465,25 @@ WifiPhy::GetStaticPhyEntities()
     return g_staticPhyEntities;
 }
 
+WifiPhy::TxDurationCache&
+WifiPhy::GetTxDurationCache()
+{
+    static TxDurationCache g_txDurationCache;
+    return g_txDurationCache;
+}
+
+uint64_t
+WifiPhy::GetNTxDurationCacheHits()
+{
+    return GetTxDurationCache().nHits;
+}
+
+uint64_t
+WifiPhy::GetNTxDurationCacheMisses()
+{
+    return GetTxDurationCache().nMisses;
+}
+
 Ptr<WifiPhyStateHelper>
 WifiPhy::GetState() const
 {
@@ -793,6 +815,8 @@ WifiPhy::AddStaticPhyEntity(WifiModulationClass modulation, Ptr<PhyEntity> phyEn
                   "The PHY entity has already been added. The setting should only be done once per "
                   "modulation class");
     GetStaticPhyEntities()[modulation] = phyEntity;
+    // cached TX durations may have been computed by a previous PHY entity
+    GetTxDurationCache().durations.clear();
 }
 
 void
@@ -1567,12 +1591,57 @@ WifiPhy::CalculateTxDuration(uint32_t size,
                              WifiPhyBand band,
                              uint16_t staId)
 {
+    if (txVector.IsMu())
+    {
+        Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
+                        GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
+        NS_ASSERT(duration.IsStrictlyPositive());
+        return duration;
+    }
+
+    auto& cache = GetTxDurationCache();
+    const TxDurationKey key{size,
+                            band,
+                            staId,
+                            txVector.GetMode().GetUid(),
+                            txVector.GetPreambleType(),
+                            txVector.GetChannelWidth(),
+                            txVector.GetGuardInterval().GetNanoSeconds(),
+                            txVector.GetNss(),
+                            txVector.GetNess(),
+                            txVector.IsStbc(),
+                            txVector.IsLdpc()};
+    if (auto it = cache.durations.find(key); it != cache.durations.end())
+    {
+        cache.nHits++;
+        return it->second;
+    }
+    cache.nMisses++;
     Time duration = CalculatePhyPreambleAndHeaderDuration(txVector) +
                     GetPayloadDuration(size, txVector, band, NORMAL_MPDU, staId);
     NS_ASSERT(duration.IsStrictlyPositive());
+    if (cache.durations.size() >= MAX_TX_DURATION_CACHE_SIZE)
+    {
+        // evict a single entry, so that the cost of a miss does not depend on the cache size
+        cache.durations.erase(cache.durations.begin());
+    }
+    cache.durations.emplace(key, duration);
     return duration;
 }
 
+std::size_t
+WifiPhy::TxDurationKeyHash::operator()(const TxDurationKey& key) const
+{
+    std::size_t hash = (std::size_t(key.size) << 32 | std::size_t(key.modeUid) << 16 |
+                        std::size_t(key.staId)) *
+                       0x9e3779b97f4a7c15ULL;
+    hash ^= (std::size_t(key.guardInterval) << 24 | std::size_t(key.band) << 20 |
+             std::size_t(key.preamble) << 12 | std::size_t(key.nss) << 6 |
+             std::size_t(key.ness) << 2 | std::size_t(key.stbc) << 1 | key.ldpc) +
+            0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash ^ std::hash<double>()(key.channelWidth);
+}
+
 Time
 WifiPhy::CalculateTxDuration(Ptr<const WifiPsdu> psdu,
                              const WifiTxVector& txVector,
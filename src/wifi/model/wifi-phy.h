@@ -18,6 +18,7 @@
 #include "ns3/error-model.h"
 
 #include <limits>
+#include <unordered_map>
 
 #define WIFI_PHY_NS_LOG_APPEND_CONTEXT(phy)                                                        \
     {                                                                                              \
@@ -270,6 +271,18 @@ class WifiPhy : public Object
                                     const WifiTxVector& txVector,
                                     WifiPhyBand band);
 
+    /**
+     * The TX durations of SU PPDUs computed by CalculateTxDuration are stored in a cache
+     * shared by all the PHY instances.
+     *
+     * \return the number of TX durations of SU PPDUs found in the cache
+     */
+    static uint64_t GetNTxDurationCacheHits();
+    /**
+     * \return the number of TX durations of SU PPDUs not found in the cache
+     */
+    static uint64_t GetNTxDurationCacheMisses();
+
     /**
      * \param txVector the transmission parameters used for this packet
      *
@@ -1580,6 +1593,55 @@ class WifiPhy : public Object
      */
     static std::map<WifiModulationClass, Ptr<PhyEntity>>& GetStaticPhyEntities();
 
+    /// Key of the cache of TX durations
+    struct TxDurationKey
+    {
+        uint32_t size;         //!< the PSDU size
+        WifiPhyBand band;      //!< the band
+        uint16_t staId;        //!< the STA-ID
+        uint32_t modeUid;      //!< the UID of the mode
+        WifiPreamble preamble; //!< the preamble
+        MHz_u channelWidth;    //!< the channel width
+        int64_t guardInterval; //!< the guard interval in nanoseconds
+        uint8_t nss;           //!< the number of spatial streams
+        uint8_t ness;          //!< the number of extension spatial streams
+        bool stbc;             //!< whether STBC is used
+        bool ldpc;             //!< whether LDPC is used
+
+        /**
+         * \param other another key
+         * \return true if the keys are equal
+         */
+        bool operator==(const TxDurationKey& other) const = default;
+    };
+
+    /// Hash function of the keys of the cache of TX durations
+    struct TxDurationKeyHash
+    {
+        /**
+         * \param key a key of the cache of TX durations
+         * \return the hash of the key
+         */
+        std::size_t operator()(const TxDurationKey& key) const;
+    };
+
+    /**
+     * Cache of the TX durations of SU PPDUs. The key holds all the TXVECTOR parameters that
+     * the TX duration of a SU PPDU depends on.
+     */
+    struct TxDurationCache
+    {
+        std::unordered_map<TxDurationKey, Time, TxDurationKeyHash>
+            durations;       //!< cached TX durations
+        uint64_t nHits{0};   //!< number of cache hits
+        uint64_t nMisses{0}; //!< number of cache misses
+    };
+
+    /**
+     * \return the cache of TX durations shared by all the PHY instances
+     */
+    static TxDurationCache& GetTxDurationCache();
+
     WifiStandard m_standard;                    //!< WifiStandard
     WifiModulationClass m_maxModClassSupported; //!< max modulation class supported
     WifiPhyBand m_band;                         //!< WifiPhyBand
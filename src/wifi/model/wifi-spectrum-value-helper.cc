@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iterator>
 #include <map>
 #include <numeric>
@@ -155,6 +156,94 @@ WifiSpectrumValueHelper::GetSpectrumModel(const std::vector<MHz_u>& centerFreque
     return ret;
 }
 
+///< Wifi transmit PSD structure, identifying a transmit PSD normalized to 1 W
+struct WifiTxPsdId
+{
+    /// the function building the transmit PSD
+    enum Type : uint8_t
+    {
+        OFDM = 0,
+        DUPLICATED_20MHZ,
+        HT_OFDM,
+        HE_OFDM,
+        HE_MU_OFDM
+    } type;
+    std::vector<MHz_u> centerFrequencies;        ///< center frequency per segment
+    MHz_u channelWidth;                          ///< channel width
+    MHz_u guardBandwidth;                        ///< guard band width
+    dBr_u minInnerBand;                          ///< minimum relative power in the inner band
+    dBr_u minOuterBand;                          ///< minimum relative power in the outer band
+    dBr_u lowestPoint;                           ///< maximum relative power of the outermost band
+    std::vector<bool> puncturedSubchannels;      ///< punctured 20 MHz subchannels
+    std::vector<WifiSpectrumBandIndices> ruBand; ///< RU band used by the STA
+};
+
+/**
+ * Less than operator
+ * \param lhs the left hand side wifi transmit PSD to compare
+ * \param rhs the right hand side wifi transmit PSD to compare
+ * \returns true if the left hand side transmit PSD is less than the right hand side one
+ */
+bool
+operator<(const WifiTxPsdId& lhs, const WifiTxPsdId& rhs)
+{
+    return std::tie(lhs.type,
+                    lhs.centerFrequencies,
+                    lhs.channelWidth,
+                    lhs.guardBandwidth,
+                    lhs.minInnerBand,
+                    lhs.minOuterBand,
+                    lhs.lowestPoint,
+                    lhs.puncturedSubchannels,
+                    lhs.ruBand) < std::tie(rhs.type,
+                                           rhs.centerFrequencies,
+                                           rhs.channelWidth,
+                                           rhs.guardBandwidth,
+                                           rhs.minInnerBand,
+                                           rhs.minOuterBand,
+                                           rhs.lowestPoint,
+                                           rhs.puncturedSubchannels,
+                                           rhs.ruBand);
+}
+
+static std::map<WifiTxPsdId, Ptr<const SpectrumValue>>
+    g_wifiTxPsdMap; ///< transmit PSDs normalized to 1 W
+
+/// Maximum number of transmit PSDs normalized to 1 W kept in the cache
+static const std::size_t MAX_TX_PSD_CACHE_SIZE = 1024;
+
+/**
+ * Return a transmit PSD carrying the given power, obtained by scaling the transmit PSD
+ * normalized to 1 W that is identified by the given key. If the latter is not found in
+ * the cache, it is built using the given function and stored in the cache, from which an
+ * entry is evicted first if the cache is full (e.g., because HE TB PPDUs are sent on many
+ * distinct RUs).
+ *
+ * \param key the identifier of the transmit PSD normalized to 1 W
+ * \param txPower the transmit power
+ * \param create the function building the transmit PSD normalized to 1 W
+ * \return a pointer to a newly allocated SpectrumValue representing the transmit PSD
+ */
+static Ptr<SpectrumValue>
+GetTxPowerSpectralDensity(const WifiTxPsdId& key,
+                          Watt_u txPower,
+                          const std::function<Ptr<SpectrumValue>()>& create)
+{
+    auto it = g_wifiTxPsdMap.find(key);
+    if (it == g_wifiTxPsdMap.end())
+    {
+        NS_LOG_DEBUG("Build transmit PSD normalized to 1 W");
+        if (g_wifiTxPsdMap.size() >= MAX_TX_PSD_CACHE_SIZE)
+        {
+            g_wifiTxPsdMap.erase(g_wifiTxPsdMap.begin());
+        }
+        it = g_wifiTxPsdMap.emplace(key, create()).first;
+    }
+    auto c = it->second->Copy();
+    *c *= txPower;
+    return c;
+}
+
 // Power allocated to 71 center subbands out of 135 total subbands in the band
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity(MHz_u centerFrequency,
@@ -192,6 +281,35 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
                                                           dBr_u minInnerBand,
                                                           dBr_u minOuterBand,
                                                           dBr_u lowestPoint)
+{
+    const WifiTxPsdId key{WifiTxPsdId::OFDM,
+                          {centerFrequency},
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          {},
+                          {}};
+    return GetTxPowerSpectralDensity(key, txPower, [&]() {
+        return DoCreateOfdmTxPowerSpectralDensity(centerFrequency,
+                                                  channelWidth,
+                                                  1,
+                                                  guardBandwidth,
+                                                  minInnerBand,
+                                                  minOuterBand,
+                                                  lowestPoint);
+    });
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::DoCreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
+                                                            MHz_u channelWidth,
+                                                            Watt_u txPower,
+                                                            MHz_u guardBandwidth,
+                                                            dBr_u minInnerBand,
+                                                            dBr_u minOuterBand,
+                                                            dBr_u lowestPoint)
 {
     NS_LOG_FUNCTION(centerFrequency << channelWidth << txPower << guardBandwidth << minInnerBand
                                     << minOuterBand << lowestPoint);
@@ -265,6 +383,38 @@ WifiSpectrumValueHelper::CreateDuplicated20MhzTxPowerSpectralDensity(
     dBr_u minOuterBand,
     dBr_u lowestPoint,
     const std::vector<bool>& puncturedSubchannels)
+{
+    const WifiTxPsdId key{WifiTxPsdId::DUPLICATED_20MHZ,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          puncturedSubchannels,
+                          {}};
+    return GetTxPowerSpectralDensity(key, txPower, [&]() {
+        return DoCreateDuplicated20MhzTxPowerSpectralDensity(centerFrequencies,
+                                                             channelWidth,
+                                                             1,
+                                                             guardBandwidth,
+                                                             minInnerBand,
+                                                             minOuterBand,
+                                                             lowestPoint,
+                                                             puncturedSubchannels);
+    });
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::DoCreateDuplicated20MhzTxPowerSpectralDensity(
+    const std::vector<MHz_u>& centerFrequencies,
+    MHz_u channelWidth,
+    Watt_u txPower,
+    MHz_u guardBandwidth,
+    dBr_u minInnerBand,
+    dBr_u minOuterBand,
+    dBr_u lowestPoint,
+    const std::vector<bool>& puncturedSubchannels)
 {
     NS_ASSERT_MSG(centerFrequencies.size() == 1 ||
                       (channelWidth == 160 && centerFrequencies.size() <= 2),
@@ -369,6 +519,36 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity(
     dBr_u minInnerBand,
     dBr_u minOuterBand,
     dBr_u lowestPoint)
+{
+    const WifiTxPsdId key{WifiTxPsdId::HT_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          {},
+                          {}};
+    return GetTxPowerSpectralDensity(key, txPower, [&]() {
+        return DoCreateHtOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                    channelWidth,
+                                                    1,
+                                                    guardBandwidth,
+                                                    minInnerBand,
+                                                    minOuterBand,
+                                                    lowestPoint);
+    });
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::DoCreateHtOfdmTxPowerSpectralDensity(
+    const std::vector<MHz_u>& centerFrequencies,
+    MHz_u channelWidth,
+    Watt_u txPower,
+    MHz_u guardBandwidth,
+    dBr_u minInnerBand,
+    dBr_u minOuterBand,
+    dBr_u lowestPoint)
 {
     NS_ASSERT_MSG(centerFrequencies.size() == 1 ||
                       (channelWidth == 160 && centerFrequencies.size() <= 2),
@@ -480,6 +660,38 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(
     dBr_u minOuterBand,
     dBr_u lowestPoint,
     const std::vector<bool>& puncturedSubchannels)
+{
+    const WifiTxPsdId key{WifiTxPsdId::HE_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          minInnerBand,
+                          minOuterBand,
+                          lowestPoint,
+                          puncturedSubchannels,
+                          {}};
+    return GetTxPowerSpectralDensity(key, txPower, [&]() {
+        return DoCreateHeOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                    channelWidth,
+                                                    1,
+                                                    guardBandwidth,
+                                                    minInnerBand,
+                                                    minOuterBand,
+                                                    lowestPoint,
+                                                    puncturedSubchannels);
+    });
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::DoCreateHeOfdmTxPowerSpectralDensity(
+    const std::vector<MHz_u>& centerFrequencies,
+    MHz_u channelWidth,
+    Watt_u txPower,
+    MHz_u guardBandwidth,
+    dBr_u minInnerBand,
+    dBr_u minOuterBand,
+    dBr_u lowestPoint,
+    const std::vector<bool>& puncturedSubchannels)
 {
     NS_ASSERT_MSG(
         centerFrequencies.size() == 1 || channelWidth == 160,
@@ -646,6 +858,32 @@ WifiSpectrumValueHelper::CreateHeMuOfdmTxPowerSpectralDensity(
     Watt_u txPower,
     MHz_u guardBandwidth,
     const std::vector<WifiSpectrumBandIndices>& ru)
+{
+    const WifiTxPsdId key{WifiTxPsdId::HE_MU_OFDM,
+                          centerFrequencies,
+                          channelWidth,
+                          guardBandwidth,
+                          0,
+                          0,
+                          0,
+                          {},
+                          ru};
+    return GetTxPowerSpectralDensity(key, txPower, [&]() {
+        return DoCreateHeMuOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                      channelWidth,
+                                                      1,
+                                                      guardBandwidth,
+                                                      ru);
+    });
+}
+
+Ptr<SpectrumValue>
+WifiSpectrumValueHelper::DoCreateHeMuOfdmTxPowerSpectralDensity(
+    const std::vector<MHz_u>& centerFrequencies,
+    MHz_u channelWidth,
+    Watt_u txPower,
+    MHz_u guardBandwidth,
+    const std::vector<WifiSpectrumBandIndices>& ru)
 {
     auto printRuIndices = [](const std::vector<WifiSpectrumBandIndices>& v) {
         std::stringstream ss;
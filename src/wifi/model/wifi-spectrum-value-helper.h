@@ -31,6 +31,10 @@ using WifiSpectrumBandIndices = std::pair<uint32_t, uint32_t>;
  *  This class defines all functions to create a spectrum model for
  *  Wi-Fi based on a a spectral model aligned with an OFDM subcarrier
  *  spacing of 312.5 KHz (model also reused for DSSS modulations)
+ *
+ *  The OFDM transmit power spectral densities are only built once for a
+ *  transmit power of 1 W and a given set of parameters, and then scaled by
+ *  the requested transmit power.
  */
 class WifiSpectrumValueHelper
 {
@@ -299,6 +303,92 @@ class WifiSpectrumValueHelper
      */
     static Watt_u GetBandPowerW(Ptr<SpectrumValue> psd,
                                 const std::vector<WifiSpectrumBandIndices>& segments);
+
+  private:
+    /**
+     * Build the transmit power spectral density returned by CreateOfdmTxPowerSpectralDensity,
+     * which only scales the one built for a transmit power of 1 W.
+     *
+     * \copydetails CreateOfdmTxPowerSpectralDensity
+     */
+    static Ptr<SpectrumValue> DoCreateOfdmTxPowerSpectralDensity(MHz_u centerFrequency,
+                                                                 MHz_u channelWidth,
+                                                                 Watt_u txPower,
+                                                                 MHz_u guardBandwidth,
+                                                                 dBr_u minInnerBand,
+                                                                 dBr_u minOuterband,
+                                                                 dBr_u lowestPoint);
+
+    /**
+     * Build the transmit power spectral density returned by
+     * CreateDuplicated20MhzTxPowerSpectralDensity, which only scales the one built for a
+     * transmit power of 1 W.
+     *
+     * \copydetails CreateDuplicated20MhzTxPowerSpectralDensity
+     */
+    static Ptr<SpectrumValue> DoCreateDuplicated20MhzTxPowerSpectralDensity(
+        const std::vector<MHz_u>& centerFrequencies,
+        MHz_u channelWidth,
+        Watt_u txPower,
+        MHz_u guardBandwidth,
+        dBr_u minInnerBand,
+        dBr_u minOuterband,
+        dBr_u lowestPoint,
+        const std::vector<bool>& puncturedSubchannels);
+
+    /**
+     * Build the transmit power spectral density returned by CreateHtOfdmTxPowerSpectralDensity,
+     * which only scales the one built for a transmit power of 1 W.
+     *
+     * \copydetails CreateHtOfdmTxPowerSpectralDensity
+     */
+    static Ptr<SpectrumValue> DoCreateHtOfdmTxPowerSpectralDensity(
+        const std::vector<MHz_u>& centerFrequencies,
+        MHz_u channelWidth,
+        Watt_u txPower,
+        MHz_u guardBandwidth,
+        dBr_u minInnerBand,
+        dBr_u minOuterband,
+        dBr_u lowestPoint);
+
+    /**
+     * Build the transmit power spectral density returned by CreateHeOfdmTxPowerSpectralDensity,
+     * which only scales the one built for a transmit power of 1 W.
+     *
+     * \param centerFrequencies center frequency per segment
+     * \param channelWidth total allocated channel width over all segments
+     * \param txPower transmit power to allocate
+     * \param guardBandwidth width of the guard band
+     * \param minInnerBand the minimum relative power in the inner band
+     * \param minOuterband the minimum relative power in the outer band
+     * \param lowestPoint maximum relative power of the outermost subcarriers of the guard band
+     * \param puncturedSubchannels bitmap indicating whether a 20 MHz subchannel is punctured or not
+     * \return a pointer to a newly allocated SpectrumValue representing the HE OFDM Transmit Power
+     * Spectral Density in W/Hz for each Band
+     */
+    static Ptr<SpectrumValue> DoCreateHeOfdmTxPowerSpectralDensity(
+        const std::vector<MHz_u>& centerFrequencies,
+        MHz_u channelWidth,
+        Watt_u txPower,
+        MHz_u guardBandwidth,
+        dBr_u minInnerBand,
+        dBr_u minOuterband,
+        dBr_u lowestPoint,
+        const std::vector<bool>& puncturedSubchannels);
+
+    /**
+     * Build the transmit power spectral density returned by
+     * CreateHeMuOfdmTxPowerSpectralDensity, which only scales the one built for a transmit
+     * power of 1 W.
+     *
+     * \copydetails CreateHeMuOfdmTxPowerSpectralDensity
+     */
+    static Ptr<SpectrumValue> DoCreateHeMuOfdmTxPowerSpectralDensity(
+        const std::vector<MHz_u>& centerFrequencies,
+        MHz_u channelWidth,
+        Watt_u txPower,
+        MHz_u guardBandwidth,
+        const std::vector<WifiSpectrumBandIndices>& ru);
 };
 
 /**
@@ -795,7 +795,7 @@ WifiTxVector::DeriveRuAllocation(uint8_t p20Index) const
         const auto ruType = ru.GetRuType();
         const auto ruBw = HeRu::GetBandwidth(ruType);
         const auto isPrimary80MHz = ru.GetPrimary80MHz();
-        const auto rusPerSubchannel = HeRu::GetRusOfType(ruBw > 20 ? ruBw : 20, ruType);
+        const auto& rusPerSubchannel = HeRu::GetRusOfType(ruBw > 20 ? ruBw : 20, ruType);
         auto ruIndex = ru.GetIndex();
         if ((m_channelWidth >= 80) && (ruIndex > 19))
         {
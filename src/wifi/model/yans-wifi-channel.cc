@@ -14,6 +14,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -22,6 +23,9 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ns3
 {
 
@@ -46,11 +50,21 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "If positive, the distance (in meters) beyond which receivers are "
+                          "skipped when a PPDU is sent. This must be a conservative bound, "
+                          "beyond which the received power is certainly below the RX "
+                          "sensitivity (minus a margin, if needed) with the configured "
+                          "propagation loss model and TX power.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<meter_u>(0));
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_gridCellSize(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -61,6 +75,14 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    ClearGrid();
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -76,13 +98,19 @@ YansWifiChannel::SetPropagationDelayModel(const Ptr<PropagationDelayModel> delay
 }
 
 void
-YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const
+YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower)
 {
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    const auto senderPosition = senderMobility->GetPosition();
+
+    const auto& candidates = (m_maxRange > 0 ? GetCandidates(senderPosition) : m_candidates);
+    const auto nReceivers = (m_maxRange > 0 ? candidates.size() : m_phyList.size());
+
+    for (std::size_t n = 0; n < nReceivers; n++)
     {
+        auto i = m_phyList.cbegin() + (m_maxRange > 0 ? candidates[n] : n);
         if (sender != (*i))
         {
             // For now don't account for inter channel interference nor channel bonding
@@ -92,6 +120,12 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
             }
 
             auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
+            if (m_maxRange > 0 &&
+                CalculateDistance(senderPosition, receiverMobility->GetPosition()) > m_maxRange)
+            {
+                NS_LOG_DEBUG("receiver " << *i << " out of range");
+                continue;
+            }
             const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
             const auto rxPower = m_loss->CalcRxPower(txPower, senderMobility, receiverMobility);
             NS_LOG_DEBUG("propagation: txPower="
@@ -156,6 +190,129 @@ YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
     m_phyList.push_back(phy);
+    // the grid is rebuilt when the next PPDU is sent
+    ClearGrid();
+}
+
+YansWifiChannel::Cell
+YansWifiChannel::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_gridCellSize)),
+            static_cast<int64_t>(std::floor(position.y / m_gridCellSize)),
+            static_cast<int64_t>(std::floor(position.z / m_gridCellSize))};
+}
+
+void
+YansWifiChannel::BuildGrid()
+{
+    NS_LOG_FUNCTION(this);
+    ClearGrid();
+    m_gridCellSize = m_maxRange;
+    m_phyCells.resize(m_phyList.size());
+    m_trackedMobility.resize(m_phyList.size());
+    for (std::size_t index = 0; index < m_phyList.size(); index++)
+    {
+        auto mobility = m_phyList[index]->GetMobility();
+        if (!mobility)
+        {
+            // the mobility model may be set later on, hence always consider this PHY
+            m_movingPhys.insert(index);
+            continue;
+        }
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&YansWifiChannel::CourseChanged, this, index));
+        m_trackedMobility[index] = mobility;
+        CourseChanged(index, mobility);
+    }
+}
+
+void
+YansWifiChannel::ClearGrid()
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t index = 0; index < m_trackedMobility.size(); index++)
+    {
+        if (m_trackedMobility[index])
+        {
+            m_trackedMobility[index]->TraceDisconnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&YansWifiChannel::CourseChanged, this, index));
+        }
+    }
+    m_trackedMobility.clear();
+    m_grid.clear();
+    m_phyCells.clear();
+    m_movingPhys.clear();
+    m_gridCellSize = 0;
+}
+
+void
+YansWifiChannel::RemoveFromGrid(std::size_t index)
+{
+    if (auto& cell = m_phyCells[index]; cell.has_value())
+    {
+        auto it = m_grid.find(*cell);
+        NS_ASSERT(it != m_grid.end());
+        it->second.erase(std::find(it->second.begin(), it->second.end(), index));
+        if (it->second.empty())
+        {
+            m_grid.erase(it);
+        }
+        cell.reset();
+    }
+    m_movingPhys.erase(index);
+}
+
+void
+YansWifiChannel::CourseChanged(std::size_t index, Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << index << mobility);
+    RemoveFromGrid(index);
+    const auto velocity = mobility->GetVelocity();
+    if (velocity.x != 0 || velocity.y != 0 || velocity.z != 0)
+    {
+        // the position changes without notification, hence always consider this PHY
+        m_movingPhys.insert(index);
+        return;
+    }
+    const auto cell = GetCell(mobility->GetPosition());
+    m_grid[cell].push_back(index);
+    m_phyCells[index] = cell;
+}
+
+const std::vector<std::size_t>&
+YansWifiChannel::GetCandidates(const Vector& position)
+{
+    NS_LOG_FUNCTION(this << position);
+    if (m_gridCellSize != m_maxRange)
+    {
+        BuildGrid();
+    }
+
+    // the cell size is the maximum range, hence receivers in range are located
+    // in the cell of the sender or in one of the adjacent cells
+    m_candidates.assign(m_movingPhys.cbegin(), m_movingPhys.cend());
+    const auto [x, y, z] = GetCell(position);
+    for (auto dx : {-1, 0, 1})
+    {
+        for (auto dy : {-1, 0, 1})
+        {
+            for (auto dz : {-1, 0, 1})
+            {
+                if (auto it = m_grid.find({x + dx, y + dy, z + dz}); it != m_grid.end())
+                {
+                    m_candidates.insert(m_candidates.end(),
+                                        it->second.cbegin(),
+                                        it->second.cend());
+                }
+            }
+        }
+    }
+    // preserve the order of the PHY list, so that receptions are scheduled
+    // in the same order as without culling
+    std::sort(m_candidates.begin(), m_candidates.end());
+    return m_candidates;
 }
 
 int64_t
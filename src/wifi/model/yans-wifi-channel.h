@@ -12,10 +12,17 @@
 #include "wifi-units.h"
 
 #include "ns3/channel.h"
+#include "ns3/vector.h"
+
+#include <map>
+#include <optional>
+#include <set>
+#include <tuple>
 
 namespace ns3
 {
 
+class MobilityModel;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
@@ -32,6 +39,18 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, every transmission is delivered to all the other PHYs on the
+ * same channel number, however far they are.  If the MaxRange attribute is
+ * set to a positive value, receivers farther than MaxRange from the sender
+ * are skipped: neither the propagation loss nor a reception event are
+ * computed for them.  MaxRange is meant to be a conservative bound, beyond
+ * which the received power is certainly below the RX sensitivity (minus
+ * some margin, if signals below the RX sensitivity matter, e.g., for the
+ * SignalArrival trace).  The receivers are then looked up in a uniform grid
+ * whose cell size is MaxRange.  The grid is kept up to date through the
+ * CourseChange trace of the mobility models: receivers whose velocity is not
+ * null are always considered.
  */
 class YansWifiChannel : public Channel
 {
@@ -74,7 +93,7 @@ class YansWifiChannel : public Channel
      * attempts to deliver the PPDU to all other YansWifiPhy objects
      * on the channel (except for the sender).
      */
-    void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower) const;
+    void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
     /**
      * Assign a fixed random variable stream number to the random variables
@@ -104,9 +123,63 @@ class YansWifiChannel : public Channel
      */
     static void Receive(Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, dBm_u txPower);
 
+    void DoDispose() override;
+
+    /// The coordinates of a cell of the grid indexing the receivers
+    using Cell = std::tuple<int64_t, int64_t, int64_t>;
+
+    /**
+     * \param position a position
+     * \return the cell of the grid containing the given position
+     */
+    Cell GetCell(const Vector& position) const;
+
+    /**
+     * Index all the PHYs in the grid and connect to the CourseChange trace of
+     * their mobility models.
+     */
+    void BuildGrid();
+
+    /**
+     * Remove all the PHYs from the grid and disconnect from the CourseChange
+     * trace of their mobility models.
+     */
+    void ClearGrid();
+
+    /**
+     * Remove a PHY from the grid.
+     *
+     * \param index the index of the PHY in the PHY list
+     */
+    void RemoveFromGrid(std::size_t index);
+
+    /**
+     * Callback invoked when the mobility model of a PHY changes course, to
+     * update the position of the PHY in the grid.
+     *
+     * \param index the index of the PHY in the PHY list
+     * \param mobility the mobility model
+     */
+    void CourseChanged(std::size_t index, Ptr<const MobilityModel> mobility);
+
+    /**
+     * \param position the position of the sender
+     * \return the indices (in increasing order) of the PHYs that may be in
+     *         range of the sender, which are valid until the next call
+     */
+    const std::vector<std::size_t>& GetCandidates(const Vector& position);
+
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    meter_u m_maxRange;                 //!< distance beyond which receivers are skipped
+
+    meter_u m_gridCellSize;                            //!< grid cell size (0 if not built)
+    std::map<Cell, std::vector<std::size_t>> m_grid;   //!< indices of the PHYs per cell
+    std::vector<std::optional<Cell>> m_phyCells;       //!< cell of each PHY, if any
+    std::set<std::size_t> m_movingPhys;                //!< PHYs that are not in the grid
+    std::vector<Ptr<MobilityModel>> m_trackedMobility; //!< mobility model of each PHY
+    std::vector<std::size_t> m_candidates;             //!< receivers returned by GetCandidates
 };
 
 } // namespace ns3
@@ -8,6 +8,7 @@
 
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/attribute-container.h"
+#include "ns3/block-ack-window.h"
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/ctrl-headers.h"
@@ -36,6 +37,7 @@
 #include "ns3/wifi-phy.h"
 #include "ns3/yans-wifi-helper.h"
 
+#include <deque>
 #include <list>
 
 using namespace ns3;
@@ -664,6 +666,119 @@ OriginatorBlockAckWindowTest::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the word-level operations of the block ack window, and the copy of a
+ * window in the bitmap of a BlockAck frame, against a plain vector of bools.
+ */
+class BlockAckWindowWordTest : public TestCase
+{
+  public:
+    BlockAckWindowWordTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the given window has the same content as the given reference.
+     *
+     * \param window the block ack window
+     * \param ref the reference window
+     */
+    void CheckWindow(const BlockAckWindow& window, const std::deque<bool>& ref);
+};
+
+BlockAckWindowWordTest::BlockAckWindowWordTest()
+    : TestCase("Check the word-level operations of the block ack window")
+{
+}
+
+void
+BlockAckWindowWordTest::CheckWindow(const BlockAckWindow& window, const std::deque<bool>& ref)
+{
+    std::size_t nLeadingSet = 0;
+    while (nLeadingSet < ref.size() && ref[nLeadingSet])
+    {
+        nLeadingSet++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(window.GetNLeadingSet(), nLeadingSet, "Unexpected number of leading 1s");
+
+    for (std::size_t i = 0; i < ref.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(window.At(i), ref[i], "Unexpected element at distance " << i);
+        // check the word starting at some of the distances
+        if (i % 7 == 0)
+        {
+            uint64_t word = 0;
+            for (std::size_t j = 0; j < 64 && i + j < ref.size(); j++)
+            {
+                word |= uint64_t{ref[i + j]} << j;
+            }
+            NS_TEST_ASSERT_MSG_EQ(window.GetWord(i), word, "Unexpected word at distance " << i);
+        }
+    }
+}
+
+void
+BlockAckWindowWordTest::DoRun()
+{
+    for (const uint16_t winSize : {16, 100, 1024})
+    {
+        BlockAckWindow window;
+        window.Init(4000, winSize);
+        std::deque<bool> ref(winSize, false);
+
+        for (std::size_t k = 0; k < 500; k++)
+        {
+            // set an element or the first elements of the window
+            const auto distance = (k * 37 + 11) % winSize;
+            window.At(distance) = true;
+            ref[distance] = true;
+            if (k % 9 == 0)
+            {
+                for (std::size_t i = 0; i < std::min<std::size_t>(k % 70, winSize); i++)
+                {
+                    window.At(i) = true;
+                    ref[i] = true;
+                }
+            }
+
+            // advance the window, sometimes beyond its size
+            if (k % 3 == 0)
+            {
+                const auto count = (k * 13) % (winSize + winSize / 4);
+                window.Advance(count);
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    ref.pop_front();
+                    ref.push_back(false);
+                }
+            }
+            CheckWindow(window, ref);
+        }
+
+        // copy the window in the bitmap of a BlockAck frame acknowledging up to 1024 MPDUs
+        CtrlBAckResponseHeader blockAck;
+        blockAck.SetType({BlockAckType::COMPRESSED, {128}});
+        blockAck.SetStartingSequence(window.GetWinStart());
+        blockAck.ResetBitmap();
+        for (std::size_t i = 0; i < winSize; i += 64)
+        {
+            blockAck.SetReceivedPackets((window.GetWinStart() + i) % SEQNO_SPACE_SIZE,
+                                        window.GetWord(i));
+        }
+        for (std::size_t i = 0; i < winSize; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(
+                blockAck.IsPacketReceived((window.GetWinStart() + i) % SEQNO_SPACE_SIZE),
+                ref[i],
+                "Unexpected bit in position " << i << " of the bitmap");
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2258,6 +2373,7 @@ BlockAckTestSuite::BlockAckTestSuite()
     AddTestCase(new PacketBufferingCaseA, TestCase::Duration::QUICK);
     AddTestCase(new PacketBufferingCaseB, TestCase::Duration::QUICK);
     AddTestCase(new OriginatorBlockAckWindowTest, TestCase::Duration::QUICK);
+    AddTestCase(new BlockAckWindowWordTest, TestCase::Duration::QUICK);
     AddTestCase(new CtrlBAckResponseHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new BlockAckRecipientBufferTest(0), TestCase::Duration::QUICK);
     AddTestCase(new BlockAckRecipientBufferTest(4090), TestCase::Duration::QUICK);
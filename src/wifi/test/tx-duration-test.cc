@@ -1925,6 +1925,89 @@ PhyHeaderSectionsTest::DoRun()
     CheckPhyHeaderSections(phyEntity->GetPhyHeaderSections(txVector, ppduStart), sections);
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the TX durations of SU PPDUs served by the cache of
+ * WifiPhy::CalculateTxDuration match the computed ones.
+ */
+class TxDurationCacheTest : public TestCase
+{
+  public:
+    TxDurationCacheTest();
+
+  private:
+    void DoRun() override;
+};
+
+TxDurationCacheTest::TxDurationCacheTest()
+    : TestCase("Check the cache of TX durations")
+{
+}
+
+void
+TxDurationCacheTest::DoRun()
+{
+    std::vector<WifiTxVector> txVectors;
+    for (const auto& [mode, preamble, width] :
+         std::initializer_list<std::tuple<WifiMode, WifiPreamble, MHz_u>>{
+             {OfdmPhy::GetOfdmRate54Mbps(), WIFI_PREAMBLE_LONG, 20},
+             {HtPhy::GetHtMcs7(), WIFI_PREAMBLE_HT_MF, 40},
+             {VhtPhy::GetVhtMcs8(), WIFI_PREAMBLE_VHT_SU, 80},
+             {HePhy::GetHeMcs11(), WIFI_PREAMBLE_HE_SU, 160},
+             {EhtPhy::GetEhtMcs13(), WIFI_PREAMBLE_EHT_MU, 320}})
+    {
+        for (uint8_t nss : {1, 2})
+        {
+            for (const auto& gi : {NanoSeconds(800), NanoSeconds(3200)})
+            {
+                if (mode.GetModulationClass() < WIFI_MOD_CLASS_VHT && nss > 1)
+                {
+                    continue;
+                }
+                WifiTxVector txVector;
+                txVector.SetMode(mode);
+                txVector.SetPreambleType(preamble);
+                txVector.SetChannelWidth(width);
+                txVector.SetNss(nss);
+                txVector.SetGuardInterval(
+                    mode.GetModulationClass() < WIFI_MOD_CLASS_HE
+                        ? (gi == NanoSeconds(800) ? NanoSeconds(400) : NanoSeconds(800))
+                        : gi);
+                if (preamble == WIFI_PREAMBLE_EHT_MU)
+                {
+                    txVector.SetEhtPpduType(1); // EHT SU transmission
+                }
+                txVectors.push_back(txVector);
+            }
+        }
+    }
+
+    for (uint32_t size : {14, 1536, 11454})
+    {
+        for (const auto& txVector : txVectors)
+        {
+            const auto expected =
+                WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector) +
+                WifiPhy::GetPayloadDuration(size, txVector, WIFI_PHY_BAND_5GHZ);
+            // the first call may or may not hit the cache, the second call must
+            auto duration = WifiPhy::CalculateTxDuration(size, txVector, WIFI_PHY_BAND_5GHZ);
+            NS_TEST_EXPECT_MSG_EQ(duration, expected, "Unexpected TX duration " << txVector);
+            const auto nHits = WifiPhy::GetNTxDurationCacheHits();
+            const auto nMisses = WifiPhy::GetNTxDurationCacheMisses();
+            duration = WifiPhy::CalculateTxDuration(size, txVector, WIFI_PHY_BAND_5GHZ);
+            NS_TEST_EXPECT_MSG_EQ(duration, expected, "Unexpected cached TX duration " << txVector);
+            NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetNTxDurationCacheHits(),
+                                  nHits + 1,
+                                  "TX duration not found in the cache");
+            NS_TEST_EXPECT_MSG_EQ(WifiPhy::GetNTxDurationCacheMisses(),
+                                  nMisses,
+                                  "Unexpected cache miss");
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1944,6 +2027,8 @@ TxDurationTestSuite::TxDurationTestSuite()
 
     AddTestCase(new PhyHeaderSectionsTest, TestCase::Duration::QUICK);
 
+    AddTestCase(new TxDurationCacheTest, TestCase::Duration::QUICK);
+
     // 20 MHz band, HeSigBDurationTest::OFDMA, even number of users per HE-SIG-B content channel
     AddTestCase(new HeSigBDurationTest(
                     {{{HeRu::RU_106_TONE, 1, true}, 11, 1}, {{HeRu::RU_106_TONE, 2, true}, 10, 4}},
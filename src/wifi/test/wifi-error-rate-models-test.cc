@@ -14,6 +14,7 @@
 #include <gsl/gsl_sf_bessel.h>
 #endif
 
+#include "ns3/double.h"
 #include "ns3/dsss-error-rate-model.h"
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
@@ -385,6 +386,70 @@ WifiErrorRateModelsTestCaseNist::DoRun()
     NS_TEST_ASSERT_MSG_EQ_TOL(ps, 0.999, 0.001, "Not equal within tolerance");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the chunk success rates interpolated from the lookup tables of the
+ * NistErrorRateModel match the ones computed with the exact formulas.
+ */
+class WifiErrorRateModelsTestCaseNistLookupTable : public TestCase
+{
+  public:
+    WifiErrorRateModelsTestCaseNistLookupTable();
+
+  private:
+    void DoRun() override;
+};
+
+WifiErrorRateModelsTestCaseNistLookupTable::WifiErrorRateModelsTestCaseNistLookupTable()
+    : TestCase("WifiErrorRateModel test case NIST with lookup tables")
+{
+}
+
+void
+WifiErrorRateModelsTestCaseNistLookupTable::DoRun()
+{
+    auto exact = CreateObject<NistErrorRateModel>();
+    auto lookup = CreateObject<NistErrorRateModel>();
+    lookup->SetAttribute("LookupTableStep", DoubleValue(0.05));
+
+    std::vector<WifiMode> modes{WifiMode("OfdmRate6Mbps"),
+                                WifiMode("OfdmRate9Mbps"),
+                                WifiMode("OfdmRate12Mbps"),
+                                WifiMode("OfdmRate18Mbps"),
+                                WifiMode("OfdmRate24Mbps"),
+                                WifiMode("OfdmRate36Mbps"),
+                                WifiMode("OfdmRate48Mbps"),
+                                WifiMode("OfdmRate54Mbps")};
+    for (uint8_t mcs = 0; mcs <= 11; ++mcs)
+    {
+        modes.push_back(HePhy::GetHeMcs(mcs));
+    }
+
+    for (const auto& mode : modes)
+    {
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        for (uint64_t nbits : {24, 1500 * 8, 65535 * 8})
+        {
+            // cover SNRs that do not fall on the grid and SNRs out of the tables
+            for (dB_u snr{-15.0}; snr <= dB_u{65.0}; snr += dB_u{0.37})
+            {
+                const auto ratio = DbToRatio(snr);
+                const auto expected = exact->GetChunkSuccessRate(mode, txVector, ratio, nbits);
+                const auto actual = lookup->GetChunkSuccessRate(mode, txVector, ratio, nbits);
+                NS_TEST_ASSERT_MSG_EQ_TOL(actual,
+                                          expected,
+                                          1e-3,
+                                          "Unexpected chunk success rate for "
+                                              << mode << " at SNR " << snr << " dB for " << nbits
+                                              << " bits");
+            }
+        }
+    }
+}
+
 class TestInterferenceHelper : public InterferenceHelper
 {
   public:
@@ -1042,6 +1107,7 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
 {
     AddTestCase(new WifiErrorRateModelsTestCaseDsss, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseNist, TestCase::Duration::QUICK);
+    AddTestCase(new WifiErrorRateModelsTestCaseNistLookupTable, TestCase::Duration::QUICK);
     AddTestCase(new WifiErrorRateModelsTestCaseMimo, TestCase::Duration::QUICK);
     AddTestCase(new TableBasedErrorRateTestCase("DefaultTableBasedHtMcs0-1458bytes",
                                                 HtPhy::GetHtMcs0(),
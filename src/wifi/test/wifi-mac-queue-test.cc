@@ -160,7 +160,7 @@ WifiExtractExpiredMpdusTest::Enqueue(Mac48Address rxAddr, bool inflight, Time ex
 
     auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
     auto elemIt = m_container.insert(m_container.GetQueue(queueId).cend(), mpdu);
-    elemIt->expiryTime = expiryTime;
+    m_container.SetExpiryTime(elemIt, expiryTime);
     if (inflight)
     {
         elemIt->inflights.emplace(0, mpdu);
@@ -214,8 +214,15 @@ WifiExtractExpiredMpdusTest::DoRun()
     Enqueue(rxAddr2, false, MilliSeconds(70));
     Enqueue(rxAddr2, false, MilliSeconds(75));
 
+    // MPDUs 20, 21 and 22 are not enqueued in increasing order of expiry time
+    auto rxAddr3 = Mac48Address::Allocate();
+    Enqueue(rxAddr3, false, MilliSeconds(90));
+    Enqueue(rxAddr3, false, MilliSeconds(80));
+    Enqueue(rxAddr3, false, MilliSeconds(85));
+
     WifiContainerQueueId queueId1{WIFI_QOSDATA_QUEUE, WIFI_UNICAST, rxAddr1, 0};
     WifiContainerQueueId queueId2{WIFI_QOSDATA_QUEUE, WIFI_UNICAST, rxAddr2, 0};
+    WifiContainerQueueId queueId3{WIFI_QOSDATA_QUEUE, WIFI_UNICAST, rxAddr3, 0};
 
     Simulator::Schedule(MilliSeconds(25), [&]() {
         /**
@@ -413,6 +420,21 @@ WifiExtractExpiredMpdusTest::DoRun()
                               "There should be no other MPDU in container queue 2");
     });
 
+    Simulator::Schedule(MilliSeconds(85), [&]() {
+        // MPDUs 21 and 22 are expired, but they follow MPDU 20, which is not expired
+        auto [first, last] = m_container.ExtractExpiredMpdus(queueId3);
+        NS_TEST_EXPECT_MSG_EQ((first == last), true, "Did not expect expired MPDUs");
+    });
+
+    Simulator::Schedule(MilliSeconds(90), [&]() {
+        auto [first, last] = m_container.ExtractExpiredMpdus(queueId3);
+        NS_TEST_EXPECT_MSG_EQ(std::distance(first, last), 3, "Expected three MPDUs extracted");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetQueue(queueId3).empty(),
+                              true,
+                              "Container queue 3 should be empty");
+        NS_TEST_EXPECT_MSG_EQ(m_container.GetNBytes(queueId3), 0, "Unexpected size in bytes");
+    });
+
     Simulator::Run();
     Simulator::Destroy();
 }
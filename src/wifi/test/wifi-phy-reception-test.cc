@@ -31,6 +31,7 @@
 #include "ns3/spectrum-wifi-phy.h"
 #include "ns3/test.h"
 #include "ns3/threshold-preamble-detection-model.h"
+#include "ns3/uinteger.h"
 #include "ns3/wifi-bandwidth-filter.h"
 #include "ns3/wifi-mac-header.h"
 #include "ns3/wifi-mpdu.h"
@@ -95,8 +96,9 @@ class WifiPhyReceptionTest : public TestCase
      */
     void DoCheckPhyState(WifiPhyState expectedState);
 
-    Ptr<SpectrumWifiPhy> m_phy; //!< the PHY
-    uint64_t m_uid{0};          //!< the UID to use for the PPDU
+    Ptr<SpectrumWifiPhy> m_phy;              //!< the PHY
+    Ptr<InterferenceHelper> m_interference; //!< the interference helper of the PHY
+    uint64_t m_uid{0};                       //!< the UID to use for the PPDU
 };
 
 WifiPhyReceptionTest::WifiPhyReceptionTest(std::string test_name)
@@ -174,8 +176,8 @@ WifiPhyReceptionTest::DoSetup()
     Ptr<Node> node = CreateObject<Node>();
     Ptr<WifiNetDevice> dev = CreateObject<WifiNetDevice>();
     m_phy = CreateObject<SpectrumWifiPhy>();
-    Ptr<InterferenceHelper> interferenceHelper = CreateObject<InterferenceHelper>();
-    m_phy->SetInterferenceHelper(interferenceHelper);
+    m_interference = CreateObject<InterferenceHelper>();
+    m_phy->SetInterferenceHelper(m_interference);
     Ptr<ErrorRateModel> error = CreateObject<NistErrorRateModel>();
     m_phy->SetErrorRateModel(error);
     m_phy->SetDevice(dev);
@@ -191,6 +193,7 @@ WifiPhyReceptionTest::DoTeardown()
 {
     m_phy->Dispose();
     m_phy = nullptr;
+    m_interference = nullptr;
 }
 
 /**
@@ -5009,6 +5012,169 @@ TestPhyDropDueToTx::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the cache of chunk success rates of the InterferenceHelper
+ *
+ * The same PPDU is received twice at the same power without any interference: the chunk
+ * success rates computed for the first reception are found in the cache for the second one.
+ * The same PPDU is then received while it is overlapped by a weaker signal for its whole
+ * duration: the PER computations are not interference-free and the cache is not used.
+ */
+class TestChunkSuccessRateCache : public WifiPhyReceptionTest
+{
+  public:
+    TestChunkSuccessRateCache();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+
+    /**
+     * Spectrum wifi receive success function
+     * \param psdu the PSDU
+     * \param rxSignalInfo the info on the received signal (\see RxSignalInfo)
+     * \param txVector the transmit vector
+     * \param statusPerMpdu reception status per MPDU
+     */
+    void RxSuccess(Ptr<const WifiPsdu> psdu,
+                   RxSignalInfo rxSignalInfo,
+                   WifiTxVector txVector,
+                   std::vector<bool> statusPerMpdu);
+
+    /// Check the counters after the first interference-free reception
+    void CheckFirstReception();
+    /// Check the counters after the second interference-free reception
+    void CheckSecondReception();
+    /// Check the counters after the reception overlapped by another signal
+    void CheckOverlappedReception();
+
+    uint32_t m_countRxSuccess{0}; ///< count RX success
+    uint64_t m_nPers{0};          ///< number of PER computations for the first reception
+    uint64_t m_nMisses{0};        ///< number of cache misses for the first reception
+};
+
+TestChunkSuccessRateCache::TestChunkSuccessRateCache()
+    : WifiPhyReceptionTest("Cache of chunk success rates of interference-free receptions")
+{
+}
+
+void
+TestChunkSuccessRateCache::RxSuccess(Ptr<const WifiPsdu> psdu,
+                                     RxSignalInfo rxSignalInfo,
+                                     WifiTxVector txVector,
+                                     std::vector<bool> statusPerMpdu)
+{
+    NS_LOG_FUNCTION(this << *psdu << rxSignalInfo << txVector);
+    m_countRxSuccess++;
+}
+
+void
+TestChunkSuccessRateCache::DoSetup()
+{
+    WifiPhyReceptionTest::DoSetup();
+    m_interference->SetAttribute("ChunkSuccessRateCacheSize", UintegerValue(16));
+    m_phy->SetReceiveOkCallback(MakeCallback(&TestChunkSuccessRateCache::RxSuccess, this));
+}
+
+void
+TestChunkSuccessRateCache::CheckFirstReception()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_countRxSuccess, 1, "The first PPDU should have been received");
+    m_nPers = m_interference->GetNPerComputations();
+    m_nMisses = m_interference->GetNChunkSuccessRateCacheMisses();
+    NS_TEST_ASSERT_MSG_GT(m_nPers, 0, "PERs should have been computed");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNInterferenceFreePerComputations(),
+                          m_nPers,
+                          "All the PERs should have been computed for a single SNR");
+    NS_TEST_ASSERT_MSG_GT(m_nMisses, 0, "Chunk success rates should have been computed");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNChunkSuccessRateCacheHits(),
+                          0,
+                          "The cache should not have been hit yet");
+}
+
+void
+TestChunkSuccessRateCache::CheckSecondReception()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_countRxSuccess, 2, "The second PPDU should have been received");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNPerComputations(),
+                          2 * m_nPers,
+                          "The same PERs should have been computed for both PPDUs");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNInterferenceFreePerComputations(),
+                          2 * m_nPers,
+                          "All the PERs should have been computed for a single SNR");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNChunkSuccessRateCacheMisses(),
+                          m_nMisses,
+                          "No chunk success rate should have been computed again");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNChunkSuccessRateCacheHits(),
+                          m_nMisses,
+                          "All the chunk success rates should have been found in the cache");
+}
+
+void
+TestChunkSuccessRateCache::CheckOverlappedReception()
+{
+    NS_TEST_ASSERT_MSG_GT(m_interference->GetNPerComputations(),
+                          2 * m_nPers,
+                          "PERs should have been computed for the overlapped PPDU");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNInterferenceFreePerComputations(),
+                          2 * m_nPers,
+                          "The PERs of the overlapped PPDU are not for a single SNR");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNChunkSuccessRateCacheMisses(),
+                          m_nMisses,
+                          "The cache should not be looked up for the overlapped PPDU");
+    NS_TEST_ASSERT_MSG_EQ(m_interference->GetNChunkSuccessRateCacheHits(),
+                          m_nMisses,
+                          "The cache should not be used for the overlapped PPDU");
+}
+
+void
+TestChunkSuccessRateCache::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 0;
+    m_phy->AssignStreams(streamNumber);
+
+    const dBm_u rxPower = -50;
+
+    Simulator::Schedule(Seconds(1.0),
+                        &TestChunkSuccessRateCache::SendPacket,
+                        this,
+                        rxPower,
+                        1000,
+                        7);
+    Simulator::Schedule(Seconds(1.1), &TestChunkSuccessRateCache::CheckFirstReception, this);
+
+    Simulator::Schedule(Seconds(2.0),
+                        &TestChunkSuccessRateCache::SendPacket,
+                        this,
+                        rxPower,
+                        1000,
+                        7);
+    Simulator::Schedule(Seconds(2.1), &TestChunkSuccessRateCache::CheckSecondReception, this);
+
+    // a weaker signal, too weak to be detected, starts before the PPDU and ends after it
+    Simulator::Schedule(Seconds(3.0) - MicroSeconds(10),
+                        &TestChunkSuccessRateCache::SendPacket,
+                        this,
+                        rxPower - 40,
+                        1000,
+                        0);
+    Simulator::Schedule(Seconds(3.0),
+                        &TestChunkSuccessRateCache::SendPacket,
+                        this,
+                        rxPower,
+                        1000,
+                        7);
+    Simulator::Schedule(Seconds(3.1), &TestChunkSuccessRateCache::CheckOverlappedReception, this);
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -5029,6 +5195,7 @@ WifiPhyReceptionTestSuite::WifiPhyReceptionTestSuite()
     AddTestCase(new TestSimpleFrameCaptureModel, TestCase::Duration::QUICK);
     AddTestCase(new TestPhyHeadersReception, TestCase::Duration::QUICK);
     AddTestCase(new TestAmpduReception, TestCase::Duration::QUICK);
+    AddTestCase(new TestChunkSuccessRateCache, TestCase::Duration::QUICK);
     AddTestCase(new TestUnsupportedModulationReception(), TestCase::Duration::QUICK);
     AddTestCase(new TestUnsupportedBandwidthReception(), TestCase::Duration::QUICK);
     AddTestCase(new TestPrimary20CoveredByPpdu(), TestCase::Duration::QUICK);
@@ -14,6 +14,7 @@
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
+#include "ns3/double.h"
 #include "ns3/error-model.h"
 #include "ns3/fcfs-wifi-queue-scheduler.h"
 #include "ns3/he-frame-exchange-manager.h"
@@ -22,6 +23,7 @@
 #include "ns3/ht-configuration.h"
 #include "ns3/interference-helper.h"
 #include "ns3/mgt-headers.h"
+#include "ns3/minstrel-ht-wifi-manager.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/packet-socket-client.h"
@@ -32,6 +34,7 @@
 #include "ns3/rng-seed-manager.h"
 #include "ns3/socket.h"
 #include "ns3/spectrum-wifi-helper.h"
+#include "ns3/sta-wifi-mac.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/uinteger.h"
@@ -45,6 +48,7 @@
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
 #include "ns3/yans-error-rate-model.h"
+#include "ns3/yans-wifi-channel.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/yans-wifi-phy.h"
 
@@ -3956,6 +3960,597 @@ DsssModulationTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_received, 4, "Did not receive four DSSS packets");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that receivers beyond the MaxRange of a YansWifiChannel are skipped,
+ * including after they have moved.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+  public:
+    YansWifiChannelMaxRangeTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when a signal arrives at a PHY
+     * \param index the index of the receiving node
+     * \param ppdu the PPDU
+     * \param rxPowerDbm the received power (dBm)
+     * \param duration the duration of the signal
+     */
+    void SignalArrival(std::size_t index,
+                       Ptr<const WifiPpdu> ppdu,
+                       double rxPowerDbm,
+                       Time duration);
+
+    /**
+     * Send a broadcast packet
+     * \param device the transmitting device
+     */
+    void SendPacket(Ptr<NetDevice> device);
+
+    /**
+     * Check the number of signals that arrived at every node
+     * \param expected the expected number of signal arrivals per node
+     */
+    void CheckArrivals(std::vector<uint32_t> expected);
+
+    std::vector<uint32_t> m_arrivals; ///< number of signal arrivals per node
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest()
+    : TestCase("Test the MaxRange attribute of YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelMaxRangeTest::SignalArrival(std::size_t index,
+                                           Ptr<const WifiPpdu> ppdu,
+                                           double rxPowerDbm,
+                                           Time duration)
+{
+    m_arrivals[index]++;
+}
+
+void
+YansWifiChannelMaxRangeTest::SendPacket(Ptr<NetDevice> device)
+{
+    device->Send(Create<Packet>(100), Mac48Address::GetBroadcast(), 1);
+}
+
+void
+YansWifiChannelMaxRangeTest::CheckArrivals(std::vector<uint32_t> expected)
+{
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_arrivals[i],
+                              expected[i],
+                              "Unexpected number of signal arrivals at node " << i);
+    }
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(5);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    Ptr<YansWifiChannel> yansChannel = channel.Create();
+    yansChannel->SetAttribute("MaxRange", DoubleValue(100));
+    YansWifiPhyHelper phy;
+    phy.SetChannel(yansChannel);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+
+    // nodes 1 and 3 are in the grid cell of the sender, but node 3 is out of
+    // range; node 2 is in range, in an adjacent cell; node 4 is far away
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(10.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(-90.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(90.0, 90.0, 0.0));
+    positionAlloc->Add(Vector(1000.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    m_arrivals.assign(nodes.GetN(), 0);
+    for (std::size_t i = 0; i < nodes.GetN(); i++)
+    {
+        auto dev = DynamicCast<WifiNetDevice>(devices.Get(i));
+        dev->GetPhy()->TraceConnectWithoutContext(
+            "SignalArrival",
+            MakeCallback(&YansWifiChannelMaxRangeTest::SignalArrival, this).Bind(i));
+    }
+
+    Simulator::Schedule(Seconds(1),
+                        &YansWifiChannelMaxRangeTest::SendPacket,
+                        this,
+                        devices.Get(0));
+    Simulator::Schedule(Seconds(1.5),
+                        &YansWifiChannelMaxRangeTest::CheckArrivals,
+                        this,
+                        std::vector<uint32_t>{0, 1, 1, 0, 0});
+    // move node 4 in range of the sender and node 1 out of range
+    Simulator::Schedule(Seconds(2),
+                        &MobilityModel::SetPosition,
+                        nodes.Get(4)->GetObject<MobilityModel>(),
+                        Vector(50.0, 50.0, 0.0));
+    Simulator::Schedule(Seconds(2),
+                        &MobilityModel::SetPosition,
+                        nodes.Get(1)->GetObject<MobilityModel>(),
+                        Vector(150.0, 0.0, 0.0));
+    Simulator::Schedule(Seconds(3),
+                        &YansWifiChannelMaxRangeTest::SendPacket,
+                        this,
+                        devices.Get(0));
+    Simulator::Schedule(Seconds(3.5),
+                        &YansWifiChannelMaxRangeTest::CheckArrivals,
+                        this,
+                        std::vector<uint32_t>{0, 1, 2, 0, 1});
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the Beacon abstraction mode of ApWifiMac. An AP and two stations are
+ * simulated and one out of four Beacon frames is transmitted through the PHY when the
+ * Beacon abstraction mode is enabled. It is checked that the associated stations are
+ * notified of all the Beacon frames sent by the AP after association, while the AP
+ * transmits fewer Beacon frames through the PHY. The stations generate a new backoff
+ * value proactively and it is checked that every Beacon frame, abstracted or not, makes
+ * them generate one. The second station then sends a Disassociation frame to the AP
+ * (without changing its own state) and it is checked that it is only notified of the
+ * Beacon frames transmitted through the PHY afterwards.
+ */
+class BeaconAbstractionTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param abstraction whether the Beacon abstraction mode is enabled
+     */
+    BeaconAbstractionTest(bool abstraction);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when the AP PHY starts transmitting a PSDU
+     * \param psduMap the PSDU map
+     * \param txVector the TX vector
+     * \param txPowerW the TX power in Watts
+     */
+    void Transmit(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW);
+
+    /**
+     * Callback invoked when a station associates with the AP
+     * \param index the index of the station
+     * \param bssid the BSSID
+     */
+    void Assoc(std::size_t index, Mac48Address bssid);
+
+    /**
+     * Callback invoked when an associated station is notified of a Beacon frame
+     * \param index the index of the station
+     * \param time the arrival time
+     */
+    void BeaconArrival(std::size_t index, Time time);
+
+    /**
+     * Callback invoked when the first station generates a backoff value
+     * \param value the backoff value
+     * \param linkId the ID of the link
+     */
+    void Backoff(uint32_t value, uint8_t linkId);
+
+    /**
+     * Have the given station send a Disassociation frame to the AP
+     * \param staMac the MAC of the given station
+     * \param apAddr the MAC address of the AP
+     */
+    void SendDisassociation(Ptr<WifiMac> staMac, Mac48Address apAddr);
+
+    /**
+     * Callback invoked when the AP disassociates a station
+     * \param aid the AID of the station
+     * \param address the MAC address of the station
+     */
+    void DeAssoc(uint16_t aid, Mac48Address address);
+
+    bool m_abstraction;                        ///< whether the Beacon abstraction mode is enabled
+    std::vector<Time> m_phyBeacons;            ///< TX times of the Beacon frames sent via the PHY
+    std::vector<Time> m_assocTimes;            ///< association time of every station
+    std::vector<std::vector<Time>> m_arrivals; ///< Beacon arrival times at every station
+    std::vector<Time> m_backoffs;              ///< times the first station generated a backoff
+    Time m_deAssocTime{Time::Max()}; ///< time the AP disassociated the second station
+};
+
+BeaconAbstractionTest::BeaconAbstractionTest(bool abstraction)
+    : TestCase(std::string("Test Beacon abstraction mode ") + (abstraction ? "on" : "off")),
+      m_abstraction(abstraction)
+{
+}
+
+void
+BeaconAbstractionTest::Transmit(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW)
+{
+    if (psduMap.begin()->second->GetHeader(0).IsBeacon())
+    {
+        m_phyBeacons.push_back(Simulator::Now());
+    }
+}
+
+void
+BeaconAbstractionTest::Assoc(std::size_t index, Mac48Address bssid)
+{
+    m_assocTimes[index] = Simulator::Now();
+}
+
+void
+BeaconAbstractionTest::BeaconArrival(std::size_t index, Time time)
+{
+    m_arrivals[index].push_back(time);
+}
+
+void
+BeaconAbstractionTest::Backoff(uint32_t value, uint8_t linkId)
+{
+    m_backoffs.push_back(Simulator::Now());
+}
+
+void
+BeaconAbstractionTest::SendDisassociation(Ptr<WifiMac> staMac, Mac48Address apAddr)
+{
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_MGT_DISASSOCIATION);
+    hdr.SetAddr1(apAddr);
+    hdr.SetAddr2(staMac->GetAddress());
+    hdr.SetAddr3(apAddr);
+    hdr.SetDsNotFrom();
+    hdr.SetDsNotTo();
+    staMac->GetQosTxop(AC_VO)->Queue(Create<WifiMpdu>(Create<Packet>(), hdr));
+}
+
+void
+BeaconAbstractionTest::DeAssoc(uint16_t aid, Mac48Address address)
+{
+    m_deAssocTime = Simulator::Now();
+}
+
+void
+BeaconAbstractionTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer apNode(1);
+    NodeContainer staNodes(2);
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211n);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::ApWifiMac",
+                "EnableBeaconJitter",
+                BooleanValue(false),
+                "BeaconAbstraction",
+                BooleanValue(m_abstraction),
+                "BeaconAbstractionPhyPeriod",
+                UintegerValue(4));
+    auto apDevice = wifi.Install(phy, mac, apNode);
+    mac.SetType("ns3::StaWifiMac");
+    auto staDevices = wifi.Install(phy, mac, staNodes);
+    WifiHelper::AssignStreams(apDevice, 1);
+    WifiHelper::AssignStreams(staDevices, 2);
+
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(5.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(0.0, 5.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNodes);
+
+    auto apWifiDevice = DynamicCast<WifiNetDevice>(apDevice.Get(0));
+    apWifiDevice->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxPsduBegin",
+        MakeCallback(&BeaconAbstractionTest::Transmit, this));
+    apWifiDevice->GetMac()->TraceConnectWithoutContext(
+        "DeAssociatedSta",
+        MakeCallback(&BeaconAbstractionTest::DeAssoc, this));
+    m_assocTimes.assign(staNodes.GetN(), Time::Max());
+    m_arrivals.assign(staNodes.GetN(), {});
+    for (std::size_t i = 0; i < staNodes.GetN(); i++)
+    {
+        auto staMac = DynamicCast<WifiNetDevice>(staDevices.Get(i))->GetMac();
+        staMac->GetChannelAccessManager()->SetAttribute("ProactiveBackoff", BooleanValue(true));
+        staMac->TraceConnectWithoutContext(
+            "Assoc",
+            MakeCallback(&BeaconAbstractionTest::Assoc, this).Bind(i));
+        staMac->TraceConnectWithoutContext(
+            "BeaconArrival",
+            MakeCallback(&BeaconAbstractionTest::BeaconArrival, this).Bind(i));
+    }
+    auto sta0Mac = DynamicCast<WifiNetDevice>(staDevices.Get(0))->GetMac();
+    sta0Mac->GetQosTxop(AC_BE)->TraceConnectWithoutContext(
+        "BackoffTrace",
+        MakeCallback(&BeaconAbstractionTest::Backoff, this));
+
+    // Beacon frames are generated every 102.4 ms starting at time zero
+    const auto beaconInterval = MicroSeconds(102400);
+    const uint32_t nBeacons = 15;
+    // the second station sends a Disassociation frame between the 8th and the 9th Beacon frame
+    Simulator::Schedule(MilliSeconds(750),
+                        &BeaconAbstractionTest::SendDisassociation,
+                        this,
+                        DynamicCast<WifiNetDevice>(staDevices.Get(1))->GetMac(),
+                        apWifiDevice->GetMac()->GetAddress());
+    Simulator::Stop(beaconInterval * nBeacons - MilliSeconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    const uint32_t nPhyBeacons = m_phyBeacons.size();
+    if (m_abstraction)
+    {
+        NS_TEST_EXPECT_MSG_LT(nPhyBeacons,
+                              nBeacons,
+                              "Expected some Beacon frames not to be transmitted through the PHY");
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(nPhyBeacons,
+                                    nBeacons / 4,
+                                    "Expected one out of four Beacon frames to be transmitted "
+                                    "through the PHY");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(nPhyBeacons,
+                              nBeacons,
+                              "Expected all Beacon frames to be transmitted through the PHY");
+    }
+
+    NS_TEST_ASSERT_MSG_NE(m_deAssocTime, Time::Max(), "Station 1 not disassociated by the AP");
+    // the Beacon frames are notified to the second station until it is disassociated
+    const std::vector<Time> notifiedUntil{Time::Max(), m_deAssocTime};
+
+    for (std::size_t i = 0; i < staNodes.GetN(); i++)
+    {
+        NS_TEST_ASSERT_MSG_NE(m_assocTimes[i], Time::Max(), "Station " << i << " not associated");
+        // number of Beacon frames generated after association and before disassociation
+        const auto lastBeacon = std::min<int64_t>(nBeacons - 1,
+                                                  (notifiedUntil[i] / beaconInterval).GetHigh());
+        const uint32_t expected = lastBeacon - (m_assocTimes[i] / beaconInterval).GetHigh();
+        const auto nArrivals = std::count_if(m_arrivals[i].cbegin(),
+                                             m_arrivals[i].cend(),
+                                             [&](Time t) { return t < notifiedUntil[i]; });
+        NS_TEST_EXPECT_MSG_EQ(nArrivals,
+                              expected,
+                              "Unexpected number of Beacon frames notified to station " << i);
+    }
+
+    // after disassociation, the second station only receives Beacon frames through the PHY
+    const auto countAfterDeAssoc = [this](const std::vector<Time>& times) {
+        return std::count_if(times.cbegin(), times.cend(), [this](Time t) {
+            return t > m_deAssocTime;
+        });
+    };
+    NS_TEST_EXPECT_MSG_EQ(countAfterDeAssoc(m_arrivals[1]),
+                          countAfterDeAssoc(m_phyBeacons),
+                          "Abstracted Beacon frames notified to a disassociated station");
+
+    // every Beacon frame generated after the association of the first station made it
+    // proactively generate a new backoff value, be it abstracted or not
+    for (auto beacon = (m_assocTimes[0] / beaconInterval).GetHigh() + 1; beacon < nBeacons;
+         beacon++)
+    {
+        const auto tbtt = beaconInterval * beacon;
+        NS_TEST_EXPECT_MSG_EQ(std::any_of(m_backoffs.cbegin(),
+                                          m_backoffs.cend(),
+                                          [&](Time t) {
+                                              return t >= tbtt && t < tbtt + MilliSeconds(1);
+                                          }),
+                              true,
+                              "No backoff generated by station 0 for Beacon frame " << beacon);
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the tables of MCS groups of Minstrel-HT.
+ *
+ * Two Minstrel-HT managers operating in the same PHY band with the same frame length must
+ * share the transmission times of their MCS groups, which must be the same as the ones that
+ * each manager computes for itself; a manager with a different frame length must not share
+ * them. The group table of a station must only store the groups supported by the station.
+ */
+class MinstrelHtTxTimesTest : public TestCase
+{
+  public:
+    MinstrelHtTxTimesTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the transmission times of the MCS groups of a manager are the ones computed
+     * by the manager for its frame length.
+     *
+     * \param manager the Minstrel-HT manager
+     * \param phy the PHY of the manager
+     */
+    void CheckTxTimes(Ptr<MinstrelHtWifiManager> manager, Ptr<WifiPhy> phy);
+
+    /// Check the group table of a station
+    void CheckGroupTable();
+};
+
+MinstrelHtTxTimesTest::MinstrelHtTxTimesTest()
+    : TestCase("Check the MCS group tables of Minstrel-HT")
+{
+}
+
+void
+MinstrelHtTxTimesTest::CheckTxTimes(Ptr<MinstrelHtWifiManager> manager, Ptr<WifiPhy> phy)
+{
+    for (uint8_t groupId = 0; groupId < manager->m_minstrelGroups.size(); groupId++)
+    {
+        const auto& group = manager->m_minstrelGroups[groupId];
+        if (!group.isSupported)
+        {
+            continue;
+        }
+        NS_TEST_ASSERT_MSG_NE(group.txTimes, nullptr, "No TX times for a supported group");
+        const auto& firstMpduTxTimes = group.txTimes->ratesFirstMpduTxTimeTable;
+        NS_TEST_ASSERT_MSG_EQ(firstMpduTxTimes.size(),
+                              group.txTimes->ratesTxTimeTable.size(),
+                              "The tables of TX times have different sizes");
+        NS_TEST_ASSERT_MSG_GT(firstMpduTxTimes.size(), 0, "No TX times for a supported group");
+        for (uint8_t rateId = 0; rateId < firstMpduTxTimes.size(); rateId++)
+        {
+            if (firstMpduTxTimes[rateId].IsZero())
+            {
+                // not a valid rate for this group
+                continue;
+            }
+            WifiMode mode;
+            switch (group.type)
+            {
+            case WIFI_MINSTREL_GROUP_HT:
+                mode = HtPhy::GetHtMcs(rateId + (group.streams - 1) * MAX_HT_GROUP_RATES);
+                break;
+            case WIFI_MINSTREL_GROUP_VHT:
+                mode = VhtPhy::GetVhtMcs(rateId);
+                break;
+            case WIFI_MINSTREL_GROUP_HE:
+                mode = HePhy::GetHeMcs(rateId);
+                break;
+            }
+            NS_TEST_EXPECT_MSG_EQ(manager->GetFirstMpduTxTime(groupId, mode),
+                                  manager->CalculateMpduTxDuration(phy,
+                                                                   group.streams,
+                                                                   group.gi,
+                                                                   group.chWidth,
+                                                                   mode,
+                                                                   FIRST_MPDU_IN_AGGREGATE),
+                                  "Wrong TX time of the first MPDU for " << mode);
+            NS_TEST_EXPECT_MSG_EQ(manager->GetMpduTxTime(groupId, mode),
+                                  manager->CalculateMpduTxDuration(phy,
+                                                                   group.streams,
+                                                                   group.gi,
+                                                                   group.chWidth,
+                                                                   mode,
+                                                                   MIDDLE_MPDU_IN_AGGREGATE),
+                                  "Wrong TX time of the MPDUs for " << mode);
+        }
+    }
+}
+
+void
+MinstrelHtTxTimesTest::CheckGroupTable()
+{
+    McsGroupData groupsTable(10);
+    NS_TEST_EXPECT_MSG_EQ(groupsTable.GetNSupportedGroups(), 0, "Unexpected supported group");
+    groupsTable.AddSupportedGroup(3).m_maxTpRate = 30;
+    groupsTable.AddSupportedGroup(7).m_maxTpRate = 70;
+    NS_TEST_EXPECT_MSG_EQ(groupsTable.GetNSupportedGroups(), 2, "Wrong number of groups");
+    for (std::size_t groupId = 0; groupId < 10; groupId++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(groupsTable[groupId].m_supported,
+                              (groupId == 3 || groupId == 7),
+                              "Wrong support of group " << groupId);
+    }
+    groupsTable[7].m_ratesTable.resize(MAX_HE_GROUP_RATES);
+    NS_TEST_EXPECT_MSG_EQ(groupsTable[3].m_maxTpRate, 30, "Wrong information of group 3");
+    NS_TEST_EXPECT_MSG_EQ(groupsTable[7].m_maxTpRate, 70, "Wrong information of group 7");
+    NS_TEST_EXPECT_MSG_EQ(groupsTable[3].m_ratesTable.size(), 0, "Wrong rates of group 3");
+    NS_TEST_EXPECT_MSG_EQ(groupsTable[7].m_ratesTable.size(),
+                          MAX_HE_GROUP_RATES,
+                          "Wrong rates of group 7");
+}
+
+void
+MinstrelHtTxTimesTest::DoRun()
+{
+    NodeContainer nodes(3);
+
+    YansWifiPhyHelper phy;
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{0, 40, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager");
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, NodeContainer(nodes.Get(0), nodes.Get(1)));
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager",
+                                 "PacketLength",
+                                 UintegerValue(1500));
+    devices.Add(wifi.Install(phy, mac, nodes.Get(2)));
+
+    // the managers are initialized at the beginning of the simulation
+    Simulator::Stop(MicroSeconds(1));
+    Simulator::Run();
+
+    std::vector<Ptr<MinstrelHtWifiManager>> managers;
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        auto device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        managers.push_back(DynamicCast<MinstrelHtWifiManager>(device->GetRemoteStationManager()));
+        NS_TEST_ASSERT_MSG_NE(managers.back(), nullptr, "Not a Minstrel-HT manager");
+        CheckTxTimes(managers.back(), device->GetPhy());
+    }
+
+    const auto& groups = managers[0]->m_minstrelGroups;
+    NS_TEST_ASSERT_MSG_EQ(groups.size(),
+                          managers[1]->m_minstrelGroups.size(),
+                          "The managers have different groups");
+    std::size_t nSupported = 0;
+    for (std::size_t groupId = 0; groupId < groups.size(); groupId++)
+    {
+        if (!groups[groupId].isSupported)
+        {
+            continue;
+        }
+        nSupported++;
+        NS_TEST_EXPECT_MSG_EQ(groups[groupId].txTimes,
+                              managers[1]->m_minstrelGroups[groupId].txTimes,
+                              "Managers with the same frame length do not share TX times");
+        NS_TEST_EXPECT_MSG_NE(groups[groupId].txTimes,
+                              managers[2]->m_minstrelGroups[groupId].txTimes,
+                              "Managers with different frame lengths share TX times");
+    }
+    NS_TEST_EXPECT_MSG_GT(nSupported, 0, "No supported group");
+
+    Simulator::Destroy();
+
+    CheckGroupTable();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3990,6 +4585,10 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::Duration::QUICK);
     AddTestCase(new WifiMgtHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new DsssModulationTest, TestCase::Duration::QUICK);
+    AddTestCase(new YansWifiChannelMaxRangeTest, TestCase::Duration::QUICK);
+    AddTestCase(new BeaconAbstractionTest(false), TestCase::Duration::QUICK);
+    AddTestCase(new BeaconAbstractionTest(true), TestCase::Duration::QUICK);
+    AddTestCase(new MinstrelHtTxTimesTest, TestCase::Duration::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -298,6 +298,88 @@ WifiOfdmMaskSlopesTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test checks that transmit PSDs built from the same parameters with different
+ * transmit powers are scaled versions of each other and are distinct objects.
+ */
+class WifiTxPsdCacheTestCase : public TestCase
+{
+  public:
+    WifiTxPsdCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+WifiTxPsdCacheTestCase::WifiTxPsdCacheTestCase()
+    : TestCase("Check the cache of transmit PSDs")
+{
+}
+
+void
+WifiTxPsdCacheTestCase::DoRun()
+{
+    const std::vector<MHz_u> centerFrequencies{5250};
+    const MHz_u channelWidth{80};
+    const MHz_u guardBandwidth{channelWidth};
+    const std::vector<bool> puncturedSubchannels{false, true, false, false};
+
+    auto first =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                                    channelWidth,
+                                                                    0.1,
+                                                                    guardBandwidth,
+                                                                    -20,
+                                                                    -28,
+                                                                    -40,
+                                                                    puncturedSubchannels);
+    auto second =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                                    channelWidth,
+                                                                    0.04,
+                                                                    guardBandwidth,
+                                                                    -20,
+                                                                    -28,
+                                                                    -40,
+                                                                    puncturedSubchannels);
+    auto unpunctured =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                                    channelWidth,
+                                                                    0.1,
+                                                                    guardBandwidth);
+    NS_TEST_ASSERT_MSG_NE(first, second, "Transmit PSDs should be distinct objects");
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*first), 0.1, 1e-9, "Unexpected transmit power");
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*second), 0.04, 1e-9, "Unexpected transmit power");
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*unpunctured), 0.1, 1e-9, "Unexpected transmit power");
+
+    bool samePunctured = true;
+    for (auto it1 = first->ConstValuesBegin(), it2 = second->ConstValuesBegin(),
+              it3 = unpunctured->ConstValuesBegin();
+         it1 != first->ConstValuesEnd();
+         ++it1, ++it2, ++it3)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(*it2, *it1 * 0.4, *it1 * 1e-9, "Unexpected scaling");
+        samePunctured = samePunctured && (*it1 == *it3);
+    }
+    NS_TEST_EXPECT_MSG_EQ(samePunctured, false, "Puncturing should change the transmit PSD");
+
+    // modifying a returned transmit PSD does not affect the next ones
+    *first *= 0.0;
+    auto third =
+        WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity(centerFrequencies,
+                                                                    channelWidth,
+                                                                    0.1,
+                                                                    guardBandwidth,
+                                                                    -20,
+                                                                    -28,
+                                                                    -40,
+                                                                    puncturedSubchannels);
+    NS_TEST_EXPECT_MSG_EQ_TOL(Integral(*third), 0.1, 1e-9, "Unexpected transmit power");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1503,4 +1585,6 @@ WifiTransmitMaskTestSuite::WifiTransmitMaskTestSuite()
                                        prec,
                                        {false, false, false, false, false, false, true, true}),
         TestCase::Duration::QUICK);
+
+    AddTestCase(new WifiTxPsdCacheTestCase, TestCase::Duration::QUICK);
 }
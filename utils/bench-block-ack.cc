@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the Block Ack agreements, i.e., the
+// lookup of the recipient agreements, the update of the originator's transmit
+// window and of the recipient's scoreboard and the generation and processing
+// of BlockAck frames, with the 1024-MPDU windows allowed by EHT.
+// Sample usage:  ./ns3 run 'bench-block-ack --n=1000 --stations=8 --win-size=1024'
+
+#include "ns3/block-ack-manager.h"
+#include "ns3/command-line.h"
+#include "ns3/ctrl-headers.h"
+#include "ns3/mac-rx-middle.h"
+#include "ns3/mgt-action-headers.h"
+#include "ns3/originator-block-ack-agreement.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/wifi-utils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Sink of the MPDUs forwarded up by the MAC RX middle.
+ *
+ * \param mpdu the MPDU forwarded up
+ * \param linkId the ID of the link the MPDU was received on
+ */
+static void
+ForwardUp(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
+{
+}
+
+/**
+ * Perform the given number of A-MPDU/BlockAck exchanges on the Block Ack
+ * agreements established by the given number of stations with an AP, in a
+ * round robin fashion. Each A-MPDU fills the transmit window and one MPDU
+ * every <i>lossInterval</i> MPDUs is lost. Lost MPDUs are not retransmitted,
+ * the originator sends a BlockAckRequest to move the recipient window forward.
+ *
+ * \param n the number of A-MPDU/BlockAck exchanges
+ * \param nStations the number of stations
+ * \param winSize the size of the Block Ack window
+ * \param lossInterval the interval between two lost MPDUs (no loss if zero)
+ * \return the elapsed time in milliseconds
+ */
+static uint64_t
+benchBlockAck(uint32_t n, uint32_t nStations, uint16_t winSize, uint32_t lossInterval)
+{
+    auto rxMiddle = Create<MacRxMiddle>();
+    rxMiddle->SetForwardCallback(MakeCallback(&ForwardUp));
+    auto manager = CreateObject<BlockAckManager>();
+
+    std::vector<OriginatorBlockAckAgreement> originators;
+    std::vector<std::vector<Ptr<WifiMpdu>>> mpdus(nStations);
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        auto address = Mac48Address::Allocate();
+        // the AP is the recipient of an agreement for every TID
+        for (uint8_t tid = 0; tid < 8; tid++)
+        {
+            MgtAddBaResponseHeader respHdr;
+            respHdr.SetTid(tid);
+            respHdr.SetBufferSize(winSize);
+            respHdr.SetImmediateBlockAck();
+            respHdr.SetAmsduSupport(true);
+            manager->CreateRecipientAgreement(respHdr, address, 0, rxMiddle);
+        }
+        // but the station only transmits frames of TID (i % 8)
+        OriginatorBlockAckAgreement originator(Mac48Address("00:00:00:00:00:01"), i % 8);
+        originator.SetBufferSize(winSize);
+        originator.SetStartingSequence(0);
+        originator.InitTxWindow();
+        originators.push_back(originator);
+        // an MPDU for every sequence number
+        WifiMacHeader hdr;
+        hdr.SetType(WIFI_MAC_QOSDATA);
+        hdr.SetAddr1(Mac48Address("00:00:00:00:00:01"));
+        hdr.SetAddr2(address);
+        hdr.SetQosTid(i % 8);
+        for (uint16_t seq = 0; seq < SEQNO_SPACE_SIZE; seq++)
+        {
+            hdr.SetSequenceNumber(seq);
+            mpdus[i].push_back(Create<WifiMpdu>(Create<Packet>(100), hdr));
+        }
+    }
+
+    CtrlBAckResponseHeader blockAck;
+    blockAck.SetType({BlockAckType::COMPRESSED, {static_cast<uint8_t>(winSize / 8)}});
+    uint32_t nLost = 0;
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        auto& originator = originators[i % nStations];
+        const auto& queue = mpdus[i % nStations];
+        const auto ssn = originator.GetStartingSequence();
+
+        for (uint16_t j = 0; j < winSize; j++)
+        {
+            const auto& mpdu = queue[(ssn + j) % SEQNO_SPACE_SIZE];
+            originator.NotifyTransmittedMpdu(mpdu);
+            if (lossInterval > 0 && ++nLost % lossInterval == 0)
+            {
+                continue;
+            }
+            manager->NotifyGotMpdu(mpdu);
+        }
+
+        const auto& address = queue[0]->GetHeader().GetAddr2();
+        const auto tid = queue[0]->GetHeader().GetQosTid();
+        manager->GetAgreementAsRecipient(address, tid)->get().FillBlockAckBitmap(&blockAck);
+
+        for (uint16_t j = 0; j < winSize; j++)
+        {
+            const auto& mpdu = queue[(ssn + j) % SEQNO_SPACE_SIZE];
+            if (blockAck.IsPacketReceived(mpdu->GetHeader().GetSequenceNumber()))
+            {
+                originator.NotifyAckedMpdu(mpdu);
+            }
+            else
+            {
+                originator.NotifyDiscardedMpdu(mpdu);
+            }
+        }
+        manager->NotifyGotBlockAckRequest(address, tid, originator.GetStartingSequence());
+    }
+    return time.End();
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \param n the number of A-MPDU/BlockAck exchanges
+ * \param nStations the number of stations
+ * \param winSize the size of the Block Ack window
+ * \param lossInterval the interval between two lost MPDUs (no loss if zero)
+ * \param minIterations the number of runs
+ */
+static void
+runBench(uint32_t n,
+         uint32_t nStations,
+         uint16_t winSize,
+         uint32_t lossInterval,
+         uint32_t minIterations)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, benchBlockAck(n, nStations, winSize, lossInterval));
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " BlockAcks/s, " << ps * winSize << " MPDUs/s"
+              << " (" << minDelay << " ms elapsed)" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000;
+    uint32_t nStations = 8;
+    uint16_t winSize = 1024;
+    uint32_t lossInterval = 50;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the Block Ack agreements");
+    cmd.AddValue("n", "number of A-MPDU/BlockAck exchanges", n);
+    cmd.AddValue("stations", "number of stations", nStations);
+    cmd.AddValue("win-size", "size of the Block Ack window (64, 256 or 1024)", winSize);
+    cmd.AddValue("loss", "interval between two lost MPDUs (no loss if zero)", lossInterval);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (nStations == 0)
+    {
+        std::cerr << "Error-- the number of stations must be positive" << std::endl;
+        return 1;
+    }
+    if (winSize != 64 && winSize != 256 && winSize != 1024)
+    {
+        std::cerr << "Error-- the size of the Block Ack window must be 64, 256 or 1024"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-block-ack with n=" << n << ", " << nStations
+              << " stations, window size " << winSize << std::endl;
+
+    runBench(n, nStations, winSize, lossInterval, minIterations);
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the demultiplexing of the received
+// segments to the IPv4 endpoints of a server node hosting a given number of
+// TCP connections on the same local port, i.e., the endpoint lookups performed
+// by TCP for every received segment, along with the allocation and the
+// deallocation of the endpoints of the connections.
+// Sample usage:  ./ns3 run 'bench-end-point-demux --n=1000000 --connections=50000'
+
+#include "ns3/command-line.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Allocate the endpoints of the given number of connections to a listening
+ * endpoint, look up the given number of segments received on these
+ * connections, then deallocate the endpoints.
+ *
+ * \param n the number of lookups
+ * \param nConnections the number of connections
+ * \param[out] allocTime the time spent allocating and deallocating the endpoints
+ * \return the time spent looking up the endpoints, in milliseconds
+ */
+static uint64_t
+benchDemux(uint32_t n, uint32_t nConnections, uint64_t& allocTime)
+{
+    const Ipv4Address server("10.0.0.1");
+    const uint16_t serverPort = 80;
+    auto peerAddress = [](uint32_t i) { return Ipv4Address(0x0b000000 + i / 50000); };
+    auto peerPort = [](uint32_t i) { return static_cast<uint16_t>(1024 + i % 50000); };
+
+    Ipv4EndPointDemux demux;
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    std::vector<Ipv4EndPoint*> endPoints;
+    endPoints.reserve(nConnections);
+
+    SystemWallClockMs time;
+    time.Start();
+    demux.Allocate(nullptr, Ipv4Address::GetAny(), serverPort);
+    for (uint32_t i = 0; i < nConnections; i++)
+    {
+        endPoints.push_back(
+            demux.Allocate(nullptr, server, serverPort, peerAddress(i), peerPort(i)));
+    }
+    allocTime = time.End();
+
+    std::size_t nMatches = 0;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // one in a hundred segments opens a new connection
+        const uint32_t peer = (i % 100 == 0) ? nConnections + i : (i * 7919) % nConnections;
+        nMatches +=
+            demux.Lookup(server, serverPort, peerAddress(peer), peerPort(peer), interface).size();
+    }
+    const auto elapsed = time.End();
+
+    time.Start();
+    for (auto endPoint : endPoints)
+    {
+        demux.DeAllocate(endPoint);
+    }
+    allocTime += time.End();
+
+    // prevent the compiler from optimizing out the loop
+    if (nMatches != n)
+    {
+        std::cerr << "Error-- " << n - nMatches << " lookups failed" << std::endl;
+    }
+    return elapsed;
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \param n the number of lookups
+ * \param nConnections the number of connections
+ * \param minIterations the number of runs
+ */
+static void
+runBench(uint32_t n, uint32_t nConnections, uint32_t minIterations)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint64_t minAllocDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t allocDelay;
+        minDelay = std::min(minDelay, benchDemux(n, nConnections, allocDelay));
+        minAllocDelay = std::min(minAllocDelay, allocDelay);
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " lookups/s"
+              << " (" << minDelay << " ms elapsed)" << std::endl;
+    ps = nConnections;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minAllocDelay, 1);
+    std::cout << ps << " endpoint allocations and deallocations/s"
+              << " (" << minAllocDelay << " ms elapsed)" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t nConnections = 50000;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the demultiplexing of the IPv4 endpoints");
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.AddValue("connections", "number of connections", nConnections);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (nConnections == 0)
+    {
+        std::cerr << "Error-- the number of connections must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-end-point-demux with n=" << n << ", " << nConnections
+              << " connections" << std::endl;
+
+    runBench(n, nConnections, minIterations);
+
+    return 0;
+}
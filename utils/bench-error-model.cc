@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the RateErrorModel and
+// BurstErrorModel, either drawing their decision variable for every packet
+// or skipping ahead to the next error (SkipAhead attribute).
+// Sample usage:  ./ns3 run 'bench-error-model --n=1000000 --rate=1e-6'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/error-model.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Check a number of packets for errors.
+ *
+ * \param em the error model
+ * \param n the number of packets
+ * \param size the packet size
+ * \param [out] corrupted the number of corrupted packets
+ * \return the elapsed time in milliseconds
+ */
+static uint64_t
+benchErrorModel(Ptr<ErrorModel> em, uint32_t n, uint32_t size, uint32_t& corrupted)
+{
+    Ptr<Packet> p = Create<Packet>(size);
+    corrupted = 0;
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (em->IsCorrupt(p))
+        {
+            corrupted++;
+        }
+    }
+    return time.End();
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \param em the error model
+ * \param n the number of packets
+ * \param size the packet size
+ * \param minIterations the number of runs
+ * \param name the name of the benchmark
+ */
+static void
+runBench(Ptr<ErrorModel> em, uint32_t n, uint32_t size, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint32_t corrupted = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, benchErrorModel(em, n, size, corrupted));
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " packets/s"
+              << " (" << minDelay << " ms elapsed, " << corrupted << " corrupted)\t" << name
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t size = 1000;
+    double rate = 1e-6;
+    double burstRate = 1e-3;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the SkipAhead mode of RateErrorModel and BurstErrorModel");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("size", "packet size in bytes", size);
+    cmd.AddValue("rate", "bit error rate of the RateErrorModel", rate);
+    cmd.AddValue("burst-rate", "error rate of the BurstErrorModel", burstRate);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    std::cout << "Running bench-error-model with n=" << n << ", size=" << size
+              << ", rate=" << rate << ", burst-rate=" << burstRate << std::endl;
+
+    for (bool skipAhead : {false, true})
+    {
+        Ptr<RateErrorModel> rem = CreateObject<RateErrorModel>();
+        rem->SetUnit(RateErrorModel::ERROR_UNIT_BIT);
+        rem->SetRate(rate);
+        rem->SetAttribute("SkipAhead", BooleanValue(skipAhead));
+        runBench(rem,
+                 n,
+                 size,
+                 minIterations,
+                 skipAhead ? "RateErrorModel (SkipAhead)" : "RateErrorModel");
+
+        Ptr<BurstErrorModel> bem = CreateObject<BurstErrorModel>();
+        bem->SetBurstRate(burstRate);
+        bem->SetAttribute("SkipAhead", BooleanValue(skipAhead));
+        runBench(bem,
+                 n,
+                 size,
+                 minIterations,
+                 skipAhead ? "BurstErrorModel (SkipAhead)" : "BurstErrorModel");
+    }
+
+    return 0;
+}
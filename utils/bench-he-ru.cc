@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the HE RU tables, i.e., the operations
+// performed by an OFDMA scheduler (such as the round robin multi-user
+// scheduler) every time it computes an RU allocation: the selection of the RU
+// type, the retrieval of the RUs of that type and of the central 26-tone RUs,
+// their subcarrier groups and the overlap checks.
+// Sample usage:  ./ns3 run 'bench-he-ru --n=100000 --stations=9'
+
+#include "ns3/command-line.h"
+#include "ns3/he-ru.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Compute the given number of RU allocations for the given number of
+ * stations, cycling over the 20, 40, 80 and 160 MHz channel widths.
+ *
+ * \param n the number of RU allocations
+ * \param nStations the number of stations
+ * \return the elapsed time in milliseconds
+ */
+static uint64_t
+benchHeRu(uint32_t n, std::size_t nStations)
+{
+    const std::vector<MHz_u> widths{20, 40, 80, 160};
+    std::size_t nSubcarriers = 0;
+    std::size_t nOverlaps = 0;
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const auto bw = widths[i % widths.size()];
+        auto nRus = nStations;
+        std::size_t nCentral26TonesRus;
+        const auto ruType = HeRu::GetEqualSizedRusForStations(bw, nRus, nCentral26TonesRus);
+
+        const auto& ruSet = HeRu::GetRusOfType(bw, ruType);
+        std::vector<HeRu::RuSpec> assigned(ruSet.begin(), ruSet.begin() + nRus);
+        if (nCentral26TonesRus > 0)
+        {
+            const auto& central26TonesRus = HeRu::GetCentral26TonesRus(bw, ruType);
+            assigned.insert(assigned.end(),
+                            central26TonesRus.begin(),
+                            central26TonesRus.begin() + nCentral26TonesRus);
+        }
+
+        for (const auto& ru : assigned)
+        {
+            const auto& group =
+                HeRu::GetSubcarrierGroup(bw, ru.GetRuType(), ru.GetPhyIndex(bw, 0));
+            nSubcarriers += group.back().second - group.front().first + 1;
+            nOverlaps += HeRu::DoesOverlap(bw, ru, {assigned.front()}) ? 1 : 0;
+        }
+    }
+    const auto elapsed = time.End();
+    // prevent the compiler from optimizing out the loop
+    if (nSubcarriers == 0 || nOverlaps == 0)
+    {
+        std::cerr << "Error-- no RU has been allocated" << std::endl;
+    }
+    return elapsed;
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \param n the number of RU allocations
+ * \param nStations the number of stations
+ * \param minIterations the number of runs
+ */
+static void
+runBench(uint32_t n, std::size_t nStations, uint32_t minIterations)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, benchHeRu(n, nStations));
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " RU allocations/s"
+              << " (" << minDelay << " ms elapsed)" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 100000;
+    uint32_t nStations = 9;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the HE RU tables");
+    cmd.AddValue("n", "number of RU allocations", n);
+    cmd.AddValue("stations", "number of stations", nStations);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (nStations == 0)
+    {
+        std::cerr << "Error-- the number of stations must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-he-ru with n=" << n << ", " << nStations << " stations"
+              << std::endl;
+
+    runBench(n, nStations, minIterations);
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the containers that store the items
+// of a DropTailQueue, namely the default RingBuffer and std::list, on a
+// number of queues kept at a given depth.
+// Sample usage:  ./ns3 run 'bench-queue --n=1000000 --queues=100 --depth=50'
+
+#include "ns3/command-line.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/packet.h"
+#include "ns3/ring-buffer.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <vector>
+
+using namespace ns3;
+
+namespace ns3
+{
+
+/// std::list container of packets, i.e., the container used before RingBuffer
+using PacketList = std::list<Ptr<Packet>>;
+
+NS_OBJECT_TEMPLATE_CLASS_TWO_DEFINE(DropTailQueue, Packet, PacketList);
+
+} // namespace ns3
+
+/**
+ * Enqueue and dequeue packets on a set of queues, each one holding about
+ * the given number of packets, in a round robin fashion.
+ *
+ * \tparam Container \explicit the container storing the queue items
+ * \param n the number of enqueue/dequeue operations
+ * \param nQueues the number of queues
+ * \param depth the number of packets kept in each queue
+ * \return the elapsed time in milliseconds
+ */
+template <typename Container>
+static uint64_t
+benchQueue(uint32_t n, uint32_t nQueues, uint32_t depth)
+{
+    std::vector<Ptr<DropTailQueue<Packet, Container>>> queues;
+    for (uint32_t i = 0; i < nQueues; i++)
+    {
+        auto queue = CreateObject<DropTailQueue<Packet, Container>>();
+        queue->SetAttribute("MaxSize", StringValue(std::to_string(depth + 1) + "p"));
+        for (uint32_t j = 0; j < depth; j++)
+        {
+            queue->Enqueue(Create<Packet>(100));
+        }
+        queues.push_back(queue);
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        auto& queue = queues[i % nQueues];
+        queue->Enqueue(queue->Dequeue());
+    }
+    return time.End();
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \tparam Container \explicit the container storing the queue items
+ * \param n the number of enqueue/dequeue operations
+ * \param nQueues the number of queues
+ * \param depth the number of packets kept in each queue
+ * \param minIterations the number of runs
+ * \param name the name of the container
+ */
+template <typename Container>
+static void
+runBench(uint32_t n, uint32_t nQueues, uint32_t depth, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, benchQueue<Container>(n, nQueues, depth));
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " packets/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 1000000;
+    uint32_t nQueues = 100;
+    uint32_t depth = 50;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the containers of DropTailQueue");
+    cmd.AddValue("n", "number of enqueue/dequeue operations", n);
+    cmd.AddValue("queues", "number of queues", nQueues);
+    cmd.AddValue("depth", "number of packets stored in each queue", depth);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (nQueues == 0)
+    {
+        std::cerr << "Error-- the number of queues must be positive" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-queue with n=" << n << ", " << nQueues << " queues of " << depth
+              << " packets" << std::endl;
+
+    runBench<RingBuffer<Ptr<Packet>>>(n, nQueues, depth, minIterations, "RingBuffer");
+    runBench<PacketList>(n, nQueues, depth, minIterations, "std::list");
+
+    return 0;
+}
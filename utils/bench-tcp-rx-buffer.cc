@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the TCP receiver buffer with a large
+// window, as the one of a flow with a large bandwidth-delay product: a window
+// of segments is received, one segment out of a given number is lost and
+// received again after the rest of the window. The SACK list of each ACK is
+// built, and the in-order data is extracted as soon as it is available, as
+// TcpSocketBase and an application reading the socket would.
+// Sample usage:  ./ns3 run 'bench-tcp-rx-buffer --segments=100000 --loss-interval=100'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-rx-buffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Receive a window of segments, the lost segments last, building the SACK
+ * list of each ACK and extracting the in-order data.
+ *
+ * \param nSegments the number of segments in the window
+ * \param lossInterval one segment out of lossInterval is lost
+ * \param segmentSize the segment size
+ * \param[out] nSegmentsAdded the number of segments added to the buffer
+ * \return the time spent processing the segments, in milliseconds
+ */
+static uint64_t
+benchRxBuffer(uint32_t nSegments,
+              uint32_t lossInterval,
+              uint32_t segmentSize,
+              uint32_t& nSegmentsAdded)
+{
+    Ptr<TcpRxBuffer> rxBuf = CreateObject<TcpRxBuffer>();
+    const SequenceNumber32 head(1);
+    rxBuf->SetNextRxSequence(head);
+    rxBuf->SetMaxBufferSize(nSegments * segmentSize);
+    Ptr<Packet> segment = Create<Packet>(segmentSize);
+    TcpHeader tcpHeader;
+    uint32_t extracted = 0;
+    auto receive = [&](uint32_t i) {
+        tcpHeader.SetSequenceNumber(head + SequenceNumber32(i * segmentSize));
+        rxBuf->Add(segment, tcpHeader);
+        rxBuf->GetSackList(); // the SACK option of the ACK
+        while (Ptr<Packet> p = rxBuf->Extract(std::numeric_limits<uint32_t>::max()))
+        {
+            extracted += p->GetSize();
+        }
+    };
+
+    SystemWallClockMs time;
+    time.Start();
+    for (uint32_t i = 0; i < nSegments; i++)
+    {
+        if (i % lossInterval != lossInterval / 2)
+        {
+            receive(i);
+        }
+    }
+    // the retransmissions are received
+    for (uint32_t i = lossInterval / 2; i < nSegments; i += lossInterval)
+    {
+        receive(i);
+    }
+    uint64_t elapsed = time.End();
+
+    NS_ABORT_MSG_UNLESS(extracted == nSegments * segmentSize, "Data missing from the buffer");
+    nSegmentsAdded = nSegments;
+    return elapsed;
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \param nSegments the number of segments in the window
+ * \param lossInterval one segment out of lossInterval is lost
+ * \param segmentSize the segment size
+ * \param minIterations the number of runs
+ */
+static void
+runBench(uint32_t nSegments, uint32_t lossInterval, uint32_t segmentSize, uint32_t minIterations)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint32_t nSegmentsAdded = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay,
+                            benchRxBuffer(nSegments, lossInterval, segmentSize, nSegmentsAdded));
+    }
+    double ps = nSegmentsAdded;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " segments/s"
+              << " (" << nSegmentsAdded << " segments, " << minDelay << " ms elapsed)"
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nSegments = 100000;
+    uint32_t lossInterval = 100;
+    uint32_t segmentSize = 1448;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the TCP receiver buffer with a large window");
+    cmd.AddValue("segments", "number of segments in the window", nSegments);
+    cmd.AddValue("loss-interval", "one segment out of loss-interval is lost", lossInterval);
+    cmd.AddValue("segment-size", "segment size, in bytes", segmentSize);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (nSegments == 0 || lossInterval == 0 || segmentSize == 0 ||
+        static_cast<uint64_t>(nSegments) * segmentSize > std::numeric_limits<int32_t>::max())
+    {
+        std::cerr << "Error-- the window must be positive and smaller than 2 GB" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-tcp-rx-buffer with " << nSegments << " segments of "
+              << segmentSize << " bytes, one lost out of " << lossInterval << std::endl;
+
+    runBench(nSegments, lossInterval, segmentSize, minIterations);
+
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the scoreboard of the TCP sender
+// buffer with a large window, as the one of a flow with a large
+// bandwidth-delay product: a window of segments is sent, one segment out of a
+// given number is lost, and the ACKs of the received segments, carrying SACK
+// blocks, are processed as TcpSocketBase would, retransmitting the lost
+// segments as they are detected.
+// Sample usage:  ./ns3 run 'bench-tcp-tx-buffer --segments=100000 --loss-interval=100'
+
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-tx-buffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * \return an unlimited receiver window
+ */
+static uint32_t
+GetRWnd()
+{
+    return std::numeric_limits<uint32_t>::max();
+}
+
+/**
+ * Send a window of segments, process the ACKs of the received segments and
+ * retransmit the lost segments, then process the ACK of the whole window.
+ *
+ * \param nSegments the number of segments in the window
+ * \param lossInterval one segment out of lossInterval is lost
+ * \param segmentSize the segment size
+ * \param[out] nAcks the number of ACKs processed
+ * \return the time spent processing the ACKs, in milliseconds
+ */
+static uint64_t
+benchTxBuffer(uint32_t nSegments, uint32_t lossInterval, uint32_t segmentSize, uint32_t& nAcks)
+{
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&GetRWnd));
+    txBuf->SetMaxBufferSize(nSegments * segmentSize);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(3);
+    const SequenceNumber32 head(1);
+    txBuf->SetHeadSequence(head);
+    auto segment = [&head, segmentSize](uint32_t i) { return head + i * segmentSize; };
+
+    for (uint32_t i = 0; i < nSegments; i++)
+    {
+        txBuf->Add(Create<Packet>(segmentSize));
+    }
+    for (uint32_t i = 0; i < nSegments; i++)
+    {
+        txBuf->CopyFromSequence(segmentSize, segment(i));
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    nAcks = 0;
+    TcpOptionSack::SackList sackList;
+    uint32_t runStart = 0;
+    for (uint32_t i = 0; i < nSegments; i++)
+    {
+        if (i % lossInterval == lossInterval / 2)
+        {
+            // the segment is lost: a new SACK block starts after it
+            runStart = i + 1;
+            continue;
+        }
+        nAcks++;
+        if (i < lossInterval / 2)
+        {
+            // no hole yet, the segment is cumulatively acked
+            txBuf->DiscardUpTo(segment(i + 1));
+            continue;
+        }
+
+        // the block of the latest segment first, then the previous blocks
+        sackList.remove_if([&](const TcpOptionSack::SackBlock& block) {
+            return block.first == segment(runStart);
+        });
+        sackList.emplace_front(segment(runStart), segment(i + 1));
+        if (sackList.size() > 3)
+        {
+            sackList.pop_back();
+        }
+        txBuf->Update(sackList);
+
+        // send what the scoreboard allows, as TcpSocketBase does
+        SequenceNumber32 next;
+        SequenceNumber32 nextHigh;
+        while (txBuf->BytesInFlight() < nSegments * segmentSize &&
+               txBuf->NextSeg(&next, &nextHigh, true))
+        {
+            txBuf->CopyFromSequence(segmentSize, next);
+        }
+    }
+
+    // the retransmissions are received
+    txBuf->DiscardUpTo(segment(nSegments));
+    nAcks++;
+    return time.End();
+}
+
+/**
+ * Run a benchmark a number of times and print the best result.
+ *
+ * \param nSegments the number of segments in the window
+ * \param lossInterval one segment out of lossInterval is lost
+ * \param segmentSize the segment size
+ * \param minIterations the number of runs
+ */
+static void
+runBench(uint32_t nSegments, uint32_t lossInterval, uint32_t segmentSize, uint32_t minIterations)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint32_t nAcks = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, benchTxBuffer(nSegments, lossInterval, segmentSize, nAcks));
+    }
+    double ps = nAcks;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " ACKs/s"
+              << " (" << nAcks << " ACKs, " << minDelay << " ms elapsed)" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nSegments = 100000;
+    uint32_t lossInterval = 100;
+    uint32_t segmentSize = 1448;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the scoreboard of the TCP sender buffer with a large window");
+    cmd.AddValue("segments", "number of segments in the window", nSegments);
+    cmd.AddValue("loss-interval", "one segment out of loss-interval is lost", lossInterval);
+    cmd.AddValue("segment-size", "segment size, in bytes", segmentSize);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (nSegments == 0 || lossInterval == 0 || segmentSize == 0 ||
+        static_cast<uint64_t>(nSegments) * segmentSize > std::numeric_limits<int32_t>::max())
+    {
+        std::cerr << "Error-- the window must be positive and smaller than 2 GB" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Running bench-tcp-tx-buffer with " << nSegments << " segments of "
+              << segmentSize << " bytes, one lost out of " << lossInterval << std::endl;
+
+    runBench(nSegments, lossInterval, segmentSize, minIterations);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program converts a binary trace file written by BinaryTraceFile (see
+// AsciiTraceHelper::CreateBinaryFileStream) to the text that the default
+// ASCII trace sinks would have written.
+// Sample usage:  ./ns3 run 'binary-trace-to-ascii --input=trace.btr --output=trace.tr'
+//
+// The program links all the ns-3 libraries so that the headers found in the
+// captured packets can be printed.
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    std::string input;
+    std::string output;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Convert a binary trace file to an ASCII trace file");
+    cmd.AddValue("input", "the binary trace file", input);
+    cmd.AddValue("output", "the ASCII trace file (standard output if empty)", output);
+    cmd.Parse(argc, argv);
+
+    if (input.empty())
+    {
+        std::cerr << "Error-- the binary trace file must be specified "
+                  << "by command-line argument --input=(file name)" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    std::ostream* os = &std::cout;
+    if (!output.empty())
+    {
+        file.open(output);
+        if (!file.is_open())
+        {
+            std::cerr << "Error-- unable to open " << output << std::endl;
+            return 1;
+        }
+        os = &file;
+    }
+
+    // The captured packets carry their metadata, which is only interpreted
+    // when packet printing is enabled
+    Packet::EnablePrinting();
+
+    BinaryTraceFileReader reader(input);
+    BinaryTraceFileReader::Record record;
+    while (reader.Read(record))
+    {
+        reader.PrintAscii(*os, record);
+    }
+
+    return 0;
+}